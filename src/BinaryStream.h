@@ -0,0 +1,37 @@
+#ifndef _BINARYSTREAM_H
+#define _BINARYSTREAM_H
+
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+/**
+ * Write the raw bytes of a trivially copyable value to a binary output stream.
+ * Doubles are written bit for bit so values read back with readBinary are identical to the originals
+ *
+ * @param outs Reference to the output stream opened in binary mode
+ * @param value Value to write into the output stream
+ */
+template <typename T>
+inline void writeBinary(std::ostream &outs, const T &value) {
+    outs.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * Read the raw bytes of a trivially copyable value from a binary input stream
+ *
+ * @param ins Reference to the input stream opened in binary mode
+ * @return Value read from the input stream
+ */
+template <typename T>
+inline T readBinary(std::istream &ins) {
+    T value;
+    ins.read(reinterpret_cast<char *>(&value), sizeof(T));
+
+    if (!ins)
+        throw std::runtime_error("Unexpected end of binary input stream");
+
+    return value;
+}
+
+#endif //QUANTUMFOUNDRY_BINARYSTREAM_H
@@ -0,0 +1,212 @@
+#include "BrickGrid.h"
+
+template <typename Scalar>
+const int BasicBrickGrid<Scalar>::numComponents;
+
+template <typename Scalar>
+const int BasicBrickGrid<Scalar>::paddedSize;
+
+template <typename Scalar>
+const std::size_t BasicBrickGrid<Scalar>::paddedVolume;
+
+template <typename Scalar>
+BasicBrickGrid<Scalar>::BasicBrickGrid(PointManager *pm) {
+    if (pm->isGraded())
+        throw std::invalid_argument("The grid needs evenly spaced points");
+
+    if (pm->getDifferenceScheme() != PointManager::SecondOrder)
+        throw std::invalid_argument("The grid only supports second order differences");
+
+    for (int face = PointManager::IStartFace; face <= PointManager::KEndFace; face++)
+        if (pm->getSymmetry((PointManager::Face) face) != PointManager::NoSymmetry)
+            throw std::invalid_argument("The grid does not support symmetry planes");
+
+    this->numI = this->numJ = this->numK = pm->getNumPointsPerAxis();
+    this->spacingDelta = pm->getSpacingDelta();
+
+    for (int axis = 0; axis < 3; axis++) {
+        int numPoints = getNumPoints((PointManager::Axis) axis);
+
+        this->periodic[axis] = pm->isPeriodic((PointManager::Axis) axis);
+        this->numBricks[axis] = (numPoints + BRICK_SIZE - 1) / BRICK_SIZE;
+
+        if (periodic[axis] && numPoints % BRICK_SIZE != 0)
+            throw std::invalid_argument("The number of points along a periodic axis must be a multiple of the brick size");
+    }
+
+    brickIndex.assign(getTotalNumberBricks(), -1);
+    points.assign((std::size_t) numI * numJ * numK, nullptr);
+
+    for (const auto &p : *pm->getCollectionOfPoints()) {
+        int i = pm->getAxisIndex(p.first.getI());
+        int j = pm->getAxisIndex(p.first.getJ());
+        int k = pm->getAxisIndex(p.first.getK());
+
+        if (i < 0 || i >= numI || j < 0 || j >= numJ || k < 0 || k >= numK) // point lies outside of the bounds
+            continue;
+
+        points[((std::size_t) i * numJ + j) * numK + k] = p.second;
+    }
+}
+
+template <typename Scalar>
+int BasicBrickGrid<Scalar>::getNumPoints(PointManager::Axis axis) const {
+    switch (axis) {
+        case PointManager::IAxis:
+            return numI;
+        case PointManager::JAxis:
+            return numJ;
+        default:
+            return numK;
+    }
+}
+
+template <typename Scalar>
+int BasicBrickGrid<Scalar>::getNumBricks(PointManager::Axis axis) const { return numBricks[axis]; }
+
+template <typename Scalar>
+std::size_t BasicBrickGrid<Scalar>::getTotalNumberBricks() const {
+    return (std::size_t) numBricks[0] * numBricks[1] * numBricks[2];
+}
+
+template <typename Scalar>
+std::size_t BasicBrickGrid<Scalar>::getNumActiveBricks() const { return bricks.size(); }
+
+template <typename Scalar>
+double BasicBrickGrid<Scalar>::getSpacingDelta() const { return this->spacingDelta; }
+
+template <typename Scalar>
+bool BasicBrickGrid<Scalar>::isPeriodic(PointManager::Axis axis) const { return this->periodic[axis]; }
+
+template <typename Scalar>
+int BasicBrickGrid<Scalar>::getBrick(int bi, int bj, int bk) const {
+    int position[] = {bi, bj, bk};
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (periodic[axis])
+            position[axis] = (position[axis] + numBricks[axis]) % numBricks[axis];
+        else if (position[axis] < 0 || position[axis] >= numBricks[axis])
+            return -1;
+    }
+
+    return brickIndex[((std::size_t) position[0] * numBricks[1] + position[1]) * numBricks[2] + position[2]];
+}
+
+template <typename Scalar>
+int BasicBrickGrid<Scalar>::activateBrick(int bi, int bj, int bk) {
+    int position[] = {bi, bj, bk};
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (periodic[axis])
+            position[axis] = (position[axis] + numBricks[axis]) % numBricks[axis];
+        else if (position[axis] < 0 || position[axis] >= numBricks[axis])
+            return -1;
+    }
+
+    int &index = brickIndex[((std::size_t) position[0] * numBricks[1] + position[1]) * numBricks[2] + position[2]];
+
+    if (index >= 0) // already active
+        return index;
+
+    Brick brick;
+    std::copy(position, position + 3, brick.position);
+
+    for (auto &component : brick.components)
+        component.assign(paddedVolume, Scalar(0));
+
+    index = (int) bricks.size();
+    bricks.push_back(std::move(brick));
+
+    return index;
+}
+
+template <typename Scalar>
+std::size_t BasicBrickGrid<Scalar>::getPaddedStride(PointManager::Axis axis) {
+    switch (axis) {
+        case PointManager::IAxis:
+            return (std::size_t) paddedSize * paddedSize;
+        case PointManager::JAxis:
+            return paddedSize;
+        default:
+            return 1;
+    }
+}
+
+template <typename Scalar>
+Scalar BasicBrickGrid<Scalar>::getValue(Component component, int i, int j, int k) const {
+    int brick = getBrick(i / BRICK_SIZE, j / BRICK_SIZE, k / BRICK_SIZE);
+
+    if (brick < 0)
+        return Scalar(0);
+
+    return bricks[brick].components[component][getPaddedIndex(i % BRICK_SIZE, j % BRICK_SIZE, k % BRICK_SIZE)];
+}
+
+template <typename Scalar>
+void BasicBrickGrid<Scalar>::setValue(Component component, int i, int j, int k, Scalar value) {
+    int brick = activateBrick(i / BRICK_SIZE, j / BRICK_SIZE, k / BRICK_SIZE);
+
+    if (brick < 0)
+        throw std::invalid_argument("The point lies outside of the grid");
+
+    bricks[brick].components[component][getPaddedIndex(i % BRICK_SIZE, j % BRICK_SIZE, k % BRICK_SIZE)] = value;
+}
+
+template <typename Scalar>
+void BasicBrickGrid<Scalar>::fillHalos(const Component *components, int numExchanged, bool ahead) {
+    int haloPlane = ahead ? BRICK_SIZE : -1; // plane of the halo within the brick
+    int sourcePlane = ahead ? 0 : BRICK_SIZE - 1; // plane of the neighbor the halo mirrors
+
+    for (auto &brick : bricks) {
+        for (int axis = 0; axis < 3; axis++) {
+            int neighborPosition[] = {brick.position[0], brick.position[1], brick.position[2]};
+            neighborPosition[axis] += ahead ? 1 : -1;
+
+            int neighbor = getBrick(neighborPosition[0], neighborPosition[1], neighborPosition[2]);
+
+            for (int component = 0; component < numExchanged; component++) {
+                Scalar *halo = brick.components[components[component]].data();
+                const Scalar *source = neighbor < 0 ? nullptr : bricks[neighbor].components[components[component]].data();
+
+                for (int u = 0; u < BRICK_SIZE; u++) {
+                    for (int v = 0; v < BRICK_SIZE; v++) {
+                        int haloPoint[] = {u, u, u}, sourcePoint[] = {u, u, u};
+
+                        // u and v run over the two axes other than the exchange axis
+                        haloPoint[(axis + 2) % 3] = sourcePoint[(axis + 2) % 3] = v;
+                        haloPoint[axis] = haloPlane;
+                        sourcePoint[axis] = sourcePlane;
+
+                        std::size_t index = getPaddedIndex(haloPoint[0], haloPoint[1], haloPoint[2]);
+                        halo[index] = source ? source[getPaddedIndex(sourcePoint[0], sourcePoint[1], sourcePoint[2])]
+                                             : Scalar(0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename Scalar>
+double BasicBrickGrid<Scalar>::getPermittivity(int i, int j, int k) const {
+    Point *p = getPoint(i, j, k);
+
+    return p ? p->getPermittivity() : 1.0; // missing points are a vacuum like in a FieldGrid
+}
+
+template <typename Scalar>
+double BasicBrickGrid<Scalar>::getConductivity(int i, int j, int k) const {
+    Point *p = getPoint(i, j, k);
+
+    return p ? p->getConductivity() : 0.0;
+}
+
+template <typename Scalar>
+double BasicBrickGrid<Scalar>::getVoltage(int i, int j, int k) const {
+    Point *p = getPoint(i, j, k);
+
+    return p ? p->getVoltage() : 0.0;
+}
+
+template class BasicBrickGrid<double>;
+template class BasicBrickGrid<float>;
@@ -0,0 +1,207 @@
+#ifndef _BRICKGRID_H
+#define _BRICKGRID_H
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+#include "PointManager.h"
+#include "Coordinates.h"
+
+#define BRICK_SIZE 8 // points along each axis of a brick
+
+/**
+ * Class BasicBrickGrid holds the fields of a regular grid of points in cubic bricks of BRICK_SIZE^3 points. A brick is
+ * only allocated once it is activated, inactive bricks hold zero fields, so memory follows the region where the fields
+ * are non-zero instead of the whole cube.
+ * Every brick stores its components with one halo point on each side and the k index varying fastest, so the row
+ * kernels of the Yee solver run on bricks exactly like on a FieldGrid once the halos are filled from the neighboring
+ * bricks. Materials and voltages are read from the PointManager's points when they are needed, the grid only keeps a
+ * pointer per point
+ */
+template <typename Scalar>
+class BasicBrickGrid {
+public:
+    typedef Scalar ScalarType;
+
+    // same components in the same order as BasicFieldGrid
+    typedef enum {
+        ElectricI, ElectricJ, ElectricK, MagneticI, MagneticJ, MagneticK, CurrentI, CurrentJ, CurrentK
+    } Component;
+
+    static const int numComponents = 9;
+    static const int paddedSize = BRICK_SIZE + 2; // points along each axis of a brick including both halos
+    static const std::size_t paddedVolume = (std::size_t) paddedSize * paddedSize * paddedSize;
+
+    /**
+     * Construct a grid covering all points of a PointManager without any active brick. Periodic axes wrap around
+     * between the first and the last brick, so their number of points must be a multiple of BRICK_SIZE
+     *
+     * @param pm PointManager containing the points of the simulation
+     */
+    explicit BasicBrickGrid(PointManager *pm);
+
+    /**
+     * Get the number of points along an axis
+     *
+     * @param axis Axis to get the number of points along
+     * @return Number of points along the axis
+     */
+    int getNumPoints(PointManager::Axis axis) const;
+
+    /**
+     * Get the number of bricks along an axis, the last brick may extend past the last point
+     *
+     * @param axis Axis to get the number of bricks along
+     * @return Number of bricks along the axis
+     */
+    int getNumBricks(PointManager::Axis axis) const;
+
+    /**
+     * Get the number of bricks covering the grid, active or not
+     *
+     * @return Total number of bricks
+     */
+    std::size_t getTotalNumberBricks() const;
+
+    /**
+     * Get the number of allocated bricks. Active bricks are numbered from 0 in the order they were activated
+     *
+     * @return Number of active bricks
+     */
+    std::size_t getNumActiveBricks() const;
+
+    /**
+     * Get the spacing between neighboring points
+     *
+     * @return Spacing delta between points
+     */
+    double getSpacingDelta() const;
+
+    /**
+     * Check if an axis wraps around
+     *
+     * @param axis Axis to check
+     * @return true if the axis was periodic when the grid was constructed
+     */
+    bool isPeriodic(PointManager::Axis axis) const;
+
+    /**
+     * Get the active brick at a brick position. Positions past the bricks of a periodic axis wrap around
+     *
+     * @param bi Position of the brick along the i axis
+     * @param bj Position of the brick along the j axis
+     * @param bk Position of the brick along the k axis
+     * @return Number of the active brick, -1 if the brick is inactive or lies outside of a bounded axis
+     */
+    int getBrick(int bi, int bj, int bk) const;
+
+    /**
+     * Activate the brick at a brick position, its fields start at zero
+     *
+     * @param bi Position of the brick along the i axis
+     * @param bj Position of the brick along the j axis
+     * @param bk Position of the brick along the k axis
+     * @return Number of the active brick, -1 if the position lies outside of a bounded axis
+     */
+    int activateBrick(int bi, int bj, int bk);
+
+    /**
+     * Get the position of an active brick
+     *
+     * @param brick Number of the active brick
+     * @param axis Axis of the position
+     * @return Position of the brick along the axis, i.e. its first point lies at position * BRICK_SIZE
+     */
+    inline int getBrickPosition(int brick, PointManager::Axis axis) const { return bricks[brick].position[axis]; }
+
+    /**
+     * Get the index of a point of a brick in the brick's component arrays
+     *
+     * @param i Index of the point within the brick along the i axis, -1 and BRICK_SIZE are the halos
+     * @param j Index of the point within the brick along the j axis, -1 and BRICK_SIZE are the halos
+     * @param k Index of the point within the brick along the k axis, -1 and BRICK_SIZE are the halos
+     * @return Index of the point in the brick's arrays
+     */
+    static inline std::size_t getPaddedIndex(int i, int j, int k) {
+        return ((std::size_t) (i + 1) * paddedSize + (j + 1)) * paddedSize + (k + 1);
+    }
+
+    /**
+     * Get the distance in a brick's arrays between a point and its next neighbor along an axis
+     *
+     * @param axis Axis of the neighbor
+     * @return Array stride along the axis
+     */
+    static std::size_t getPaddedStride(PointManager::Axis axis);
+
+    /**
+     * Get the array holding one component of a field in an active brick
+     *
+     * @param brick Number of the active brick
+     * @param component Field component to get
+     * @return Pointer to the first element of the brick's padded array
+     */
+    inline Scalar *getComponent(int brick, Component component) { return bricks[brick].components[component].data(); }
+
+    inline const Scalar *getComponent(int brick, Component component) const {
+        return bricks[brick].components[component].data();
+    }
+
+    /**
+     * Get the value of a component at a point
+     *
+     * @return Value at the point, 0 if its brick is inactive
+     */
+    Scalar getValue(Component component, int i, int j, int k) const;
+
+    /**
+     * Set the value of a component at a point, activating its brick if needed
+     */
+    void setValue(Component component, int i, int j, int k, Scalar value);
+
+    /**
+     * Copy the boundary planes of the neighboring bricks into the halos of every active brick. The halos of bricks
+     * without an active neighbor are zeroed
+     *
+     * @param components Components to exchange
+     * @param numExchanged Number of components to exchange
+     * @param ahead true to fill the halos after the last point of each axis, false for the ones before the first point
+     */
+    void fillHalos(const Component *components, int numExchanged, bool ahead);
+
+    /**
+     * Get the Point of the PointManager at a grid position
+     *
+     * @return Pointer to the Point, nullptr if the point does not exist
+     */
+    inline Point *getPoint(int i, int j, int k) const { return points[((std::size_t) i * numJ + j) * numK + k]; }
+
+    double getPermittivity(int i, int j, int k) const;
+
+    double getConductivity(int i, int j, int k) const;
+
+    double getVoltage(int i, int j, int k) const;
+
+private:
+    /**
+     * An allocated brick and its position in bricks along each axis
+     */
+    struct Brick {
+        int position[3];
+        std::vector<Scalar> components[numComponents];
+    };
+
+    int numI, numJ, numK;
+    int numBricks[3];
+    bool periodic[3];
+    double spacingDelta;
+    std::vector<int> brickIndex; // number of the active brick at each brick position, -1 if inactive
+    std::vector<Brick> bricks;
+    std::vector<Point *> points;
+};
+
+typedef BasicBrickGrid<double> BrickGrid;
+typedef BasicBrickGrid<float> SinglePrecisionBrickGrid;
+
+#endif //QUANTUMFOUNDRY_BRICKGRID_H
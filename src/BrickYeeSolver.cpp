@@ -0,0 +1,496 @@
+#include "BrickYeeSolver.h"
+
+template <typename Scalar, typename Accumulator>
+BasicBrickYeeSolver<Scalar, Accumulator>::BasicBrickYeeSolver(PointManager *pm, double timeStep,
+                                                              double drudeScatteringTime) : grid(pm) {
+    for (int face = PointManager::IStartFace; face <= PointManager::KEndFace; face++)
+        if (pm->getAbsorbingLayerThickness((PointManager::Face) face) > 0)
+            throw std::invalid_argument("The brick solver does not support absorbing layers");
+
+    this->pm = pm;
+    this->timeStep = timeStep;
+    this->currentTime = 0.0;
+    this->drudeScatteringTime = drudeScatteringTime;
+    this->initEFieldCalculated = false;
+
+    const PointManager::Axis axes[] = {PointManager::IAxis, PointManager::JAxis, PointManager::KAxis};
+    int numPoints[] = {grid.getNumPoints(PointManager::IAxis), grid.getNumPoints(PointManager::JAxis),
+                       grid.getNumPoints(PointManager::KAxis)};
+
+    // conductors carry current, and a voltage makes the edges to and from its point hold an initial electric field
+    for (int i = 0; i < numPoints[0]; i++) {
+        for (int j = 0; j < numPoints[1]; j++) {
+            for (int k = 0; k < numPoints[2]; k++) {
+                if (grid.getConductivity(i, j, k) == 0 && grid.getVoltage(i, j, k) == 0)
+                    continue;
+
+                grid.activateBrick(i / BRICK_SIZE, j / BRICK_SIZE, k / BRICK_SIZE);
+
+                for (int axis = 0; axis < 3; axis++) {
+                    int previous[] = {i, j, k};
+
+                    if (!hasPrev(axes[axis], previous[axis]))
+                        continue;
+
+                    previous[axis] = (previous[axis] - 1 + numPoints[axis]) % numPoints[axis];
+                    grid.activateBrick(previous[0] / BRICK_SIZE, previous[1] / BRICK_SIZE, previous[2] / BRICK_SIZE);
+                }
+            }
+        }
+    }
+
+    updateCoefficients();
+}
+
+template <typename Scalar, typename Accumulator>
+bool BasicBrickYeeSolver<Scalar, Accumulator>::hasNext(PointManager::Axis axis, int position) const {
+    return position < grid.getNumPoints(axis) - 1 || grid.isPeriodic(axis);
+}
+
+template <typename Scalar, typename Accumulator>
+bool BasicBrickYeeSolver<Scalar, Accumulator>::hasPrev(PointManager::Axis axis, int position) const {
+    return position > 0 || grid.isPeriodic(axis);
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicBrickYeeSolver<Scalar, Accumulator>::updateCoefficients() {
+    const PointManager::Axis axes[] = {PointManager::IAxis, PointManager::JAxis, PointManager::KAxis};
+    int numPoints[] = {grid.getNumPoints(PointManager::IAxis), grid.getNumPoints(PointManager::JAxis),
+                       grid.getNumPoints(PointManager::KAxis)};
+
+    currentDecay = std::exp(-timeStep / drudeScatteringTime);
+    double gainFactor = -std::expm1(-timeStep / drudeScatteringTime); // 1 - currentDecay
+
+    for (int brick = (int) coefficients.size(); brick < (int) grid.getNumActiveBricks(); brick++) {
+        BrickCoefficients brickCoefficients;
+        int origin[3];
+
+        for (int axis = 0; axis < 3; axis++) {
+            origin[axis] = grid.getBrickPosition(brick, axes[axis]) * BRICK_SIZE;
+            brickCoefficients.electricCoefficient[axis].assign(Grid::paddedVolume, 0.0);
+            brickCoefficients.currentGain[axis].assign(Grid::paddedVolume, 0.0);
+        }
+
+        for (int i = 0; i < BRICK_SIZE && origin[0] + i < numPoints[0]; i++) {
+            for (int j = 0; j < BRICK_SIZE && origin[1] + j < numPoints[1]; j++) {
+                for (int k = 0; k < BRICK_SIZE && origin[2] + k < numPoints[2]; k++) {
+                    int point[] = {origin[0] + i, origin[1] + j, origin[2] + k};
+
+                    for (int axis = 0; axis < 3; axis++) {
+                        if (!hasNext(axes[axis], point[axis])) // no edge past the last point
+                            continue;
+
+                        int next[] = {point[0], point[1], point[2]};
+                        next[axis] = (next[axis] + 1) % numPoints[axis];
+
+                        double permittivity = (grid.getPermittivity(point[0], point[1], point[2]) +
+                                               grid.getPermittivity(next[0], next[1], next[2])) / 2;
+                        double conductivityA = grid.getConductivity(point[0], point[1], point[2]);
+                        double conductivityB = grid.getConductivity(next[0], next[1], next[2]);
+
+                        // an edge only conducts if both of its points do, the harmonic mean is zero otherwise
+                        double conductivity = conductivityA + conductivityB == 0 ? 0 :
+                                              2 * conductivityA * conductivityB / (conductivityA + conductivityB);
+
+                        std::size_t index = Grid::getPaddedIndex(i, j, k);
+                        brickCoefficients.electricCoefficient[axis][index] =
+                                timeStep * SPEED_OF_LIGHT_SQUARED / permittivity;
+                        brickCoefficients.currentGain[axis][index] = conductivity * gainFactor;
+                    }
+                }
+            }
+        }
+
+        coefficients.push_back(std::move(brickCoefficients));
+    }
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicBrickYeeSolver<Scalar, Accumulator>::calculateAndSetInitialElectricField() {
+    if (initEFieldCalculated)
+        throw std::invalid_argument("The initial electric field was already calculated");
+
+    const typename Grid::Component components[] = {Grid::ElectricI, Grid::ElectricJ, Grid::ElectricK};
+    const PointManager::Axis axes[] = {PointManager::IAxis, PointManager::JAxis, PointManager::KAxis};
+    int numPoints[] = {grid.getNumPoints(PointManager::IAxis), grid.getNumPoints(PointManager::JAxis),
+                       grid.getNumPoints(PointManager::KAxis)};
+    double spacingDelta = grid.getSpacingDelta();
+
+    for (int brick = 0; brick < (int) grid.getNumActiveBricks(); brick++) {
+        int origin[] = {grid.getBrickPosition(brick, PointManager::IAxis) * BRICK_SIZE,
+                        grid.getBrickPosition(brick, PointManager::JAxis) * BRICK_SIZE,
+                        grid.getBrickPosition(brick, PointManager::KAxis) * BRICK_SIZE};
+
+        for (int i = 0; i < BRICK_SIZE && origin[0] + i < numPoints[0]; i++) {
+            for (int j = 0; j < BRICK_SIZE && origin[1] + j < numPoints[1]; j++) {
+                for (int k = 0; k < BRICK_SIZE && origin[2] + k < numPoints[2]; k++) {
+                    int point[] = {origin[0] + i, origin[1] + j, origin[2] + k};
+
+                    for (int axis = 0; axis < 3; axis++) {
+                        if (!hasNext(axes[axis], point[axis])) // no edge past the last point
+                            continue;
+
+                        int next[] = {point[0], point[1], point[2]};
+                        next[axis] = (next[axis] + 1) % numPoints[axis];
+
+                        double voltageDifference = grid.getVoltage(point[0], point[1], point[2]) -
+                                                   grid.getVoltage(next[0], next[1], next[2]);
+                        grid.getComponent(brick, components[axis])[Grid::getPaddedIndex(i, j, k)] =
+                                (Scalar) (voltageDifference / spacingDelta);
+                    }
+                }
+            }
+        }
+    }
+
+    this->initEFieldCalculated = true;
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicBrickYeeSolver<Scalar, Accumulator>::calculateNextFields() {
+    const typename Grid::Component electric[] = {Grid::ElectricI, Grid::ElectricJ, Grid::ElectricK};
+    const typename Grid::Component magnetic[] = {Grid::MagneticI, Grid::MagneticJ, Grid::MagneticK};
+
+    // the fields may reach into the neighbors of the bricks during this step, including fields set through the grid
+    activateNeighborBricks();
+    updateCoefficients();
+
+    // B takes forward differences of E and E backward differences of B across the brick faces
+    grid.fillHalos(electric, 3, true);
+    calculateNextMagneticField();
+    calculateNextCurrentField();
+    grid.fillHalos(magnetic, 3, false);
+    calculateNextElectricField();
+
+    this->currentTime = getNextTime();
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicBrickYeeSolver<Scalar, Accumulator>::activateNeighborBricks() {
+    std::size_t numActiveBricks = grid.getNumActiveBricks(); // bricks activated here hold no fields yet
+
+    for (int brick = 0; brick < (int) numActiveBricks; brick++) {
+        bool faceActive[3][2] = {{false, false}, {false, false}, {false, false}}; // first and last plane of each axis
+
+        for (int component = Grid::ElectricI; component <= Grid::MagneticK; component++) {
+            const Scalar *values = grid.getComponent(brick, (typename Grid::Component) component);
+
+            for (int axis = 0; axis < 3; axis++) {
+                for (int side = 0; side < 2; side++) {
+                    for (int u = 0; u < BRICK_SIZE && !faceActive[axis][side]; u++) {
+                        for (int v = 0; v < BRICK_SIZE; v++) {
+                            int point[] = {u, u, u};
+                            point[(axis + 2) % 3] = v;
+                            point[axis] = side == 0 ? 0 : BRICK_SIZE - 1;
+
+                            if (std::fabs((double) values[Grid::getPaddedIndex(point[0], point[1], point[2])]) >
+                                BRICK_ACTIVATION_THRESHOLD) {
+                                faceActive[axis][side] = true;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // within a step the fields reach one point along any axis, and through the curl of the curl one point along
+        // two axes at once, so edge and corner neighbors are activated when both or all three faces are
+        for (int di = -1; di <= 1; di++) {
+            for (int dj = -1; dj <= 1; dj++) {
+                for (int dk = -1; dk <= 1; dk++) {
+                    int offset[] = {di, dj, dk};
+                    bool reached = di != 0 || dj != 0 || dk != 0;
+
+                    for (int axis = 0; axis < 3 && reached; axis++)
+                        reached = offset[axis] == 0 || faceActive[axis][offset[axis] < 0 ? 0 : 1];
+
+                    if (reached)
+                        grid.activateBrick(grid.getBrickPosition(brick, PointManager::IAxis) + di,
+                                           grid.getBrickPosition(brick, PointManager::JAxis) + dj,
+                                           grid.getBrickPosition(brick, PointManager::KAxis) + dk);
+                }
+            }
+        }
+    }
+}
+
+template <typename Scalar, typename Accumulator>
+double BasicBrickYeeSolver<Scalar, Accumulator>::calculateStableTimeStep(double safetyFactor) const {
+    double minPermittivity = std::numeric_limits<double>::max();
+    double maxPlasmaFrequencySquared = 0.0;
+
+    for (int i = 0; i < grid.getNumPoints(PointManager::IAxis); i++) {
+        for (int j = 0; j < grid.getNumPoints(PointManager::JAxis); j++) {
+            for (int k = 0; k < grid.getNumPoints(PointManager::KAxis); k++) {
+                double permittivity = grid.getPermittivity(i, j, k);
+                minPermittivity = std::min(minPermittivity, permittivity);
+
+                // w_p^2 = c^2 * mu0 * conductivity / (permittivity * tau)
+                double plasmaFrequencySquared = SPEED_OF_LIGHT_SQUARED * VACUUM_PERMEABILITY *
+                        grid.getConductivity(i, j, k) / (permittivity * drudeScatteringTime);
+                maxPlasmaFrequencySquared = std::max(maxPlasmaFrequencySquared, plasmaFrequencySquared);
+            }
+        }
+    }
+
+    double maxWaveSpeed = std::sqrt(SPEED_OF_LIGHT_SQUARED / minPermittivity);
+    double stableTimeStep = grid.getSpacingDelta() / (std::sqrt(3.0) * maxWaveSpeed);
+
+    if (maxPlasmaFrequencySquared > 0)
+        stableTimeStep = std::min(stableTimeStep, 2 / std::sqrt(maxPlasmaFrequencySquared));
+
+    return safetyFactor * stableTimeStep;
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicBrickYeeSolver<Scalar, Accumulator>::setTimeStep(double timeStep) {
+    if (timeStep <= 0)
+        throw std::invalid_argument("Time step must be positive");
+
+    this->timeStep = timeStep;
+    coefficients.clear();
+    updateCoefficients();
+}
+
+template <typename Scalar, typename Accumulator>
+double BasicBrickYeeSolver<Scalar, Accumulator>::getTimeStep() const { return timeStep; }
+
+template <typename Scalar, typename Accumulator>
+double BasicBrickYeeSolver<Scalar, Accumulator>::getNextTime() const { return currentTime + timeStep; }
+
+template <typename Scalar, typename Accumulator>
+double BasicBrickYeeSolver<Scalar, Accumulator>::getCurrentTime() const { return currentTime; }
+
+template <typename Scalar, typename Accumulator>
+const typename BasicBrickYeeSolver<Scalar, Accumulator>::Grid &BasicBrickYeeSolver<Scalar, Accumulator>::getGrid() const {
+    return grid;
+}
+
+template <typename Scalar, typename Accumulator>
+typename BasicBrickYeeSolver<Scalar, Accumulator>::Grid &BasicBrickYeeSolver<Scalar, Accumulator>::getGrid() {
+    return grid;
+}
+
+template <typename Scalar, typename Accumulator>
+double BasicBrickYeeSolver<Scalar, Accumulator>::calculateFieldEnergy() const {
+    int numPoints[] = {grid.getNumPoints(PointManager::IAxis), grid.getNumPoints(PointManager::JAxis),
+                       grid.getNumPoints(PointManager::KAxis)};
+    Accumulator electricEnergy = 0, magneticEnergy = 0;
+
+    for (int brick = 0; brick < (int) grid.getNumActiveBricks(); brick++) {
+        int origin[] = {grid.getBrickPosition(brick, PointManager::IAxis) * BRICK_SIZE,
+                        grid.getBrickPosition(brick, PointManager::JAxis) * BRICK_SIZE,
+                        grid.getBrickPosition(brick, PointManager::KAxis) * BRICK_SIZE};
+
+        for (int component = Grid::ElectricI; component <= Grid::MagneticK; component++) {
+            const Scalar *field = grid.getComponent(brick, (typename Grid::Component) component);
+
+            for (int i = 0; i < BRICK_SIZE && origin[0] + i < numPoints[0]; i++) {
+                for (int j = 0; j < BRICK_SIZE && origin[1] + j < numPoints[1]; j++) {
+                    for (int k = 0; k < BRICK_SIZE && origin[2] + k < numPoints[2]; k++) {
+                        Accumulator value = field[Grid::getPaddedIndex(i, j, k)];
+
+                        if (component <= Grid::ElectricK)
+                            electricEnergy += (Accumulator) grid.getPermittivity(origin[0] + i, origin[1] + j,
+                                                                                 origin[2] + k) * value * value;
+                        else
+                            magneticEnergy += value * value;
+                    }
+                }
+            }
+        }
+    }
+
+    double volume = std::pow(grid.getSpacingDelta(), 3);
+
+    return 0.5 * ((double) electricEnergy + SPEED_OF_LIGHT_SQUARED * (double) magneticEnergy) * volume;
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicBrickYeeSolver<Scalar, Accumulator>::calculateNextMagneticField() {
+    typedef RowKernels<Scalar, Accumulator> Kernels;
+    int numI = grid.getNumPoints(PointManager::IAxis);
+    int numJ = grid.getNumPoints(PointManager::JAxis);
+    int numK = grid.getNumPoints(PointManager::KAxis);
+    std::ptrdiff_t strideI = Grid::getPaddedStride(PointManager::IAxis);
+    std::ptrdiff_t strideJ = Grid::getPaddedStride(PointManager::JAxis);
+    Accumulator scale = timeStep / grid.getSpacingDelta();
+
+    // dB/dt = -curl E on the rows along k of every active brick, the E halos ahead of the brick hold its neighbors
+    for (int brick = 0; brick < (int) grid.getNumActiveBricks(); brick++) {
+        const Scalar *eI = grid.getComponent(brick, Grid::ElectricI);
+        const Scalar *eJ = grid.getComponent(brick, Grid::ElectricJ);
+        const Scalar *eK = grid.getComponent(brick, Grid::ElectricK);
+        Scalar *bI = grid.getComponent(brick, Grid::MagneticI);
+        Scalar *bJ = grid.getComponent(brick, Grid::MagneticJ);
+        Scalar *bK = grid.getComponent(brick, Grid::MagneticK);
+        int originI = grid.getBrickPosition(brick, PointManager::IAxis) * BRICK_SIZE;
+        int originJ = grid.getBrickPosition(brick, PointManager::JAxis) * BRICK_SIZE;
+        int originK = grid.getBrickPosition(brick, PointManager::KAxis) * BRICK_SIZE;
+        int numRowPoints = std::min(BRICK_SIZE, numK - originK);
+        int numRowEdges = hasNext(PointManager::KAxis, originK + numRowPoints - 1) ? numRowPoints : numRowPoints - 1;
+
+        for (int i = 0; i < BRICK_SIZE && originI + i < numI; i++) {
+            for (int j = 0; j < BRICK_SIZE && originJ + j < numJ; j++) {
+                std::size_t row = Grid::getPaddedIndex(i, j, 0);
+                bool nextI = hasNext(PointManager::IAxis, originI + i);
+                bool nextJ = hasNext(PointManager::JAxis, originJ + j);
+
+                if (nextJ && numRowEdges > 0)
+                    Kernels::updateMagneticRow(bI + row, eK + row, strideJ, eJ + row, 1, scale, numRowEdges);
+
+                if (nextI && numRowEdges > 0)
+                    Kernels::updateMagneticRow(bJ + row, eI + row, 1, eK + row, strideI, scale, numRowEdges);
+
+                if (nextI && nextJ)
+                    Kernels::updateMagneticRow(bK + row, eJ + row, strideI, eI + row, strideJ, scale, numRowPoints);
+            }
+        }
+    }
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicBrickYeeSolver<Scalar, Accumulator>::calculateNextCurrentField() {
+    const typename Grid::Component eComponents[] = {Grid::ElectricI, Grid::ElectricJ, Grid::ElectricK};
+    const typename Grid::Component jComponents[] = {Grid::CurrentI, Grid::CurrentJ, Grid::CurrentK};
+
+    // J(t + dt / 2) = J(t - dt / 2) * exp(-dt / tau) + conductivity * E(t) * (1 - exp(-dt / tau)), the halos and the
+    // points past the last point have no gain and stay zero
+    for (int brick = 0; brick < (int) grid.getNumActiveBricks(); brick++)
+        for (int axis = 0; axis < 3; axis++)
+            RowKernels<Scalar, Accumulator>::updateCurrentRow(grid.getComponent(brick, jComponents[axis]),
+                                                              coefficients[brick].currentGain[axis].data(),
+                                                              grid.getComponent(brick, eComponents[axis]),
+                                                              currentDecay, Grid::paddedVolume);
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicBrickYeeSolver<Scalar, Accumulator>::calculateNextElectricField() {
+    typedef RowKernels<Scalar, Accumulator> Kernels;
+    int numI = grid.getNumPoints(PointManager::IAxis);
+    int numJ = grid.getNumPoints(PointManager::JAxis);
+    int numK = grid.getNumPoints(PointManager::KAxis);
+    std::ptrdiff_t strideI = Grid::getPaddedStride(PointManager::IAxis);
+    std::ptrdiff_t strideJ = Grid::getPaddedStride(PointManager::JAxis);
+    Accumulator inverseSpacing = 1 / grid.getSpacingDelta();
+    Accumulator permeability = VACUUM_PERMEABILITY;
+
+    // dE/dt = c^2 / permittivity * (curl B - mu0 * J), the B halos behind the brick hold its neighbors. The tangential
+    // components on the faces of bounded axes are not updated
+    for (int brick = 0; brick < (int) grid.getNumActiveBricks(); brick++) {
+        const Scalar *bI = grid.getComponent(brick, Grid::MagneticI);
+        const Scalar *bJ = grid.getComponent(brick, Grid::MagneticJ);
+        const Scalar *bK = grid.getComponent(brick, Grid::MagneticK);
+        const Scalar *jI = grid.getComponent(brick, Grid::CurrentI);
+        const Scalar *jJ = grid.getComponent(brick, Grid::CurrentJ);
+        const Scalar *jK = grid.getComponent(brick, Grid::CurrentK);
+        Scalar *eI = grid.getComponent(brick, Grid::ElectricI);
+        Scalar *eJ = grid.getComponent(brick, Grid::ElectricJ);
+        Scalar *eK = grid.getComponent(brick, Grid::ElectricK);
+        const Scalar *coefficientI = coefficients[brick].electricCoefficient[0].data();
+        const Scalar *coefficientJ = coefficients[brick].electricCoefficient[1].data();
+        const Scalar *coefficientK = coefficients[brick].electricCoefficient[2].data();
+        int originI = grid.getBrickPosition(brick, PointManager::IAxis) * BRICK_SIZE;
+        int originJ = grid.getBrickPosition(brick, PointManager::JAxis) * BRICK_SIZE;
+        int originK = grid.getBrickPosition(brick, PointManager::KAxis) * BRICK_SIZE;
+        int numRowPoints = std::min(BRICK_SIZE, numK - originK);
+        int numRowEdges = hasNext(PointManager::KAxis, originK + numRowPoints - 1) ? numRowPoints : numRowPoints - 1;
+        int firstK = hasPrev(PointManager::KAxis, originK) ? 0 : 1; // the first point of a bounded k axis is a face
+        int numInteriorK = numRowEdges - firstK;
+
+        for (int i = 0; i < BRICK_SIZE && originI + i < numI; i++) {
+            for (int j = 0; j < BRICK_SIZE && originJ + j < numJ; j++) {
+                std::size_t row = Grid::getPaddedIndex(i, j, 0);
+                bool edgeI = hasNext(PointManager::IAxis, originI + i);
+                bool edgeJ = hasNext(PointManager::JAxis, originJ + j);
+                bool interiorI = edgeI && hasPrev(PointManager::IAxis, originI + i);
+                bool interiorJ = edgeJ && hasPrev(PointManager::JAxis, originJ + j);
+                std::size_t first = row + firstK;
+
+                if (edgeI && interiorJ && numInteriorK > 0)
+                    Kernels::updateElectricRow(eI + first, coefficientI + first, jI + first, bK + first, strideJ,
+                                               bJ + first, 1, inverseSpacing, permeability, numInteriorK);
+
+                if (edgeJ && interiorI && numInteriorK > 0)
+                    Kernels::updateElectricRow(eJ + first, coefficientJ + first, jJ + first, bI + first, 1,
+                                               bK + first, strideI, inverseSpacing, permeability, numInteriorK);
+
+                if (interiorI && interiorJ && numRowEdges > 0)
+                    Kernels::updateElectricRow(eK + row, coefficientK + row, jK + row, bJ + row, strideI, bI + row,
+                                               strideJ, inverseSpacing, permeability, numRowEdges);
+            }
+        }
+    }
+}
+
+template <typename Scalar, typename Accumulator>
+double BasicBrickYeeSolver<Scalar, Accumulator>::averageAroundPoint(typename Grid::Component component, int i, int j,
+                                                                    int k, int offsets) const {
+    int position[] = {i, j, k};
+    int numPoints[] = {grid.getNumPoints(PointManager::IAxis), grid.getNumPoints(PointManager::JAxis),
+                       grid.getNumPoints(PointManager::KAxis)};
+    double sum = 0.0;
+    int count = 0;
+
+    // visit the 1, 2 or 4 staggered locations surrounding the point
+    for (int corner = 0; corner < 8; corner++) {
+        if (corner & ~offsets)
+            continue;
+
+        int index[3];
+        bool exists = true;
+
+        for (int axis = 0; axis < 3; axis++) {
+            index[axis] = position[axis] - ((corner >> axis) & 1);
+
+            if (grid.isPeriodic((PointManager::Axis) axis)) { // the location before the first point is the last one
+                index[axis] = (index[axis] + numPoints[axis]) % numPoints[axis];
+                continue;
+            }
+
+            // staggered along this axis: valid locations lie between the first and the last point
+            int lastIndex = (offsets >> axis) & 1 ? numPoints[axis] - 2 : numPoints[axis] - 1;
+            exists = exists && index[axis] >= 0 && index[axis] <= lastIndex;
+        }
+
+        if (exists) {
+            sum += grid.getValue(component, index[0], index[1], index[2]);
+            count++;
+        }
+    }
+
+    return count == 0 ? 0.0 : sum / count;
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicBrickYeeSolver<Scalar, Accumulator>::exportFieldsToPointManager() {
+    for (int i = 0; i < grid.getNumPoints(PointManager::IAxis); i++) {
+        for (int j = 0; j < grid.getNumPoints(PointManager::JAxis); j++) {
+            for (int k = 0; k < grid.getNumPoints(PointManager::KAxis); k++) {
+                Point *p = grid.getPoint(i, j, k);
+
+                if (!p)
+                    continue;
+
+                // E components sit half a spacing ahead along their own axis, B components along the other two
+                p->setElectricField(FieldVector(averageAroundPoint(Grid::ElectricI, i, j, k, 1),
+                                                averageAroundPoint(Grid::ElectricJ, i, j, k, 2),
+                                                averageAroundPoint(Grid::ElectricK, i, j, k, 4)), currentTime);
+
+                p->setMagneticField(FieldVector(averageAroundPoint(Grid::MagneticI, i, j, k, 6),
+                                                averageAroundPoint(Grid::MagneticJ, i, j, k, 5),
+                                                averageAroundPoint(Grid::MagneticK, i, j, k, 3)), currentTime);
+
+                if (grid.getConductivity(i, j, k) != 0)
+                    p->setCurrentField(FieldVector(averageAroundPoint(Grid::CurrentI, i, j, k, 1),
+                                                   averageAroundPoint(Grid::CurrentJ, i, j, k, 2),
+                                                   averageAroundPoint(Grid::CurrentK, i, j, k, 4)), currentTime);
+            }
+        }
+    }
+}
+
+template class BasicBrickYeeSolver<double>;
+template class BasicBrickYeeSolver<float>;
+template class BasicBrickYeeSolver<float, double>;
@@ -0,0 +1,166 @@
+#ifndef _BRICKYEESOLVER_H
+#define _BRICKYEESOLVER_H
+
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+
+#include "FieldSolver.h"
+#include "BrickGrid.h"
+#include "SimdKernels.h"
+#include "PointManager.h"
+
+#define BRICK_ACTIVATION_THRESHOLD 0.0 // fields up to this magnitude on a brick's faces do not activate its neighbors
+
+/**
+ * Class BasicBrickYeeSolver advances the fields with the same staggered finite difference time domain scheme as
+ * BasicYeeSolver, but on a BasicBrickGrid: only the bricks holding non-zero fields or conductors are allocated and
+ * swept. The fields of a step reach at most one point further, so before every step the neighbors of each brick with
+ * non-zero fields on its faces are activated, ahead of the wavefront. With the default activation threshold of 0 the
+ * fields are identical to a BasicYeeSolver run, while memory and sweep cost follow the active region.
+ * Absorbing layers are not supported
+ */
+template <typename Scalar, typename Accumulator = Scalar>
+class BasicBrickYeeSolver {
+public:
+    typedef BasicBrickGrid<Scalar> Grid;
+
+    /**
+     * Construct a new BasicBrickYeeSolver object and activate the bricks holding conducting points or voltages
+     *
+     * @param pm PointManager that contains all points for the simulation
+     * @param timeStep Time step to take when calculating each field
+     * @param drudeScatteringTime Drude scattering time constant
+     */
+    BasicBrickYeeSolver(PointManager *pm, double timeStep, double drudeScatteringTime);
+
+    /**
+     * Calculate the initial electric field on every edge of the active bricks from the voltages of the two points the
+     * edge connects
+     */
+    void calculateAndSetInitialElectricField();
+
+    /**
+     * Activate the bricks the fields may spread into during the step, then advance all fields by one time step like
+     * BasicYeeSolver::calculateNextFields
+     */
+    void calculateNextFields();
+
+    /**
+     * Get the next time step that will be calculated upon the next call of calculateNextFields
+     *
+     * @return double representing the next time for which all fields will be calculated at
+     */
+    double getNextTime() const;
+
+    /**
+     * Get the time of the electric field currently held by the solver
+     *
+     * @return Current time of the electric field, the magnetic field is half a time step ahead of it
+     */
+    double getCurrentTime() const;
+
+    /**
+     * Calculate the largest stable time step, see BasicYeeSolver::calculateStableTimeStep
+     *
+     * @param safetyFactor Fraction of the stability limit to return
+     * @return Largest stable time step scaled by the safety factor
+     */
+    double calculateStableTimeStep(double safetyFactor = 0.9) const;
+
+    /**
+     * Set the time step of the following calls of calculateNextFields and recompute the update coefficients
+     *
+     * @param timeStep Time step to take
+     */
+    void setTimeStep(double timeStep);
+
+    /**
+     * Get the time step of the next call of calculateNextFields
+     *
+     * @return Time step to take
+     */
+    double getTimeStep() const;
+
+    /**
+     * Calculate the electromagnetic energy held by the active bricks, see BasicYeeSolver::calculateFieldEnergy
+     *
+     * @return Electromagnetic energy of the grid
+     */
+    double calculateFieldEnergy() const;
+
+    /**
+     * Interpolate the staggered fields onto the points and store them in the PointManager at the current time, see
+     * BasicYeeSolver::exportFieldsToPointManager. Points of inactive bricks get zero fields
+     */
+    void exportFieldsToPointManager();
+
+    /**
+     * Get the grid holding the staggered fields
+     *
+     * @return Reference to the solver's grid
+     */
+    const Grid &getGrid() const;
+
+    /**
+     * Get the grid holding the staggered fields, e.g. to start from fields that do not follow from the initial
+     * voltages. Bricks activated through the grid get their update coefficients and neighbors at the next step
+     *
+     * @return Reference to the solver's grid
+     */
+    Grid &getGrid();
+
+private:
+    /**
+     * Update coefficients of an active brick, laid out like its padded component arrays
+     */
+    struct BrickCoefficients {
+        std::vector<Scalar> electricCoefficient[3]; // timeStep * c^2 / permittivity on each edge
+        std::vector<Scalar> currentGain[3]; // conductivity * (1 - currentDecay) on each edge
+    };
+
+    PointManager *pm;
+    Grid grid;
+    double timeStep, currentTime, drudeScatteringTime, currentDecay;
+    bool initEFieldCalculated;
+    std::vector<BrickCoefficients> coefficients; // indexed by active brick
+
+    /**
+     * Check if a point has a next neighbor along an axis, wrapping around on periodic axes
+     */
+    bool hasNext(PointManager::Axis axis, int position) const;
+
+    /**
+     * Check if a point has a previous neighbor along an axis, wrapping around on periodic axes
+     */
+    bool hasPrev(PointManager::Axis axis, int position) const;
+
+    /**
+     * Precompute the update coefficients of the bricks activated since the coefficients were last calculated
+     */
+    void updateCoefficients();
+
+    /**
+     * Activate the neighbors of every brick holding fields above BRICK_ACTIVATION_THRESHOLD on the faces towards them
+     */
+    void activateNeighborBricks();
+
+    void calculateNextMagneticField();
+
+    void calculateNextCurrentField();
+
+    void calculateNextElectricField();
+
+    /**
+     * Average the values of a staggered component that exist around a point, see BasicYeeSolver::averageAroundPoint
+     */
+    double averageAroundPoint(typename Grid::Component component, int i, int j, int k, int offsets) const;
+};
+
+typedef BasicBrickYeeSolver<double> BrickYeeSolver;
+typedef BasicBrickYeeSolver<float> SinglePrecisionBrickYeeSolver;
+typedef BasicBrickYeeSolver<float, double> MixedPrecisionBrickYeeSolver;
+
+#endif //QUANTUMFOUNDRY_BRICKYEESOLVER_H
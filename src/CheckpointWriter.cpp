@@ -0,0 +1,35 @@
+#include "CheckpointWriter.h"
+
+CheckpointWriter::CheckpointWriter() = default;
+
+CheckpointWriter::~CheckpointWriter() {
+    if (pendingWrite.valid())
+        pendingWrite.wait(); // don't throw from the destructor, the last write is lost if it failed
+}
+
+void CheckpointWriter::writeAsync(const std::string &filePath, std::string data) {
+    wait();
+
+    pendingWrite = std::async(std::launch::async, [filePath](const std::string &buffer) {
+        writeToFile(filePath, buffer);
+    }, std::move(data));
+}
+
+void CheckpointWriter::wait() {
+    if (pendingWrite.valid())
+        pendingWrite.get();
+}
+
+void CheckpointWriter::writeToFile(const std::string &filePath, const std::string &data) {
+    std::string tempPath = filePath + ".tmp";
+    std::ofstream checkpointFile(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!checkpointFile.is_open())
+        throw std::invalid_argument("File path to write checkpoint does not exist");
+
+    checkpointFile.write(data.data(), data.size());
+    checkpointFile.close();
+
+    if (!checkpointFile || std::rename(tempPath.c_str(), filePath.c_str()) != 0)
+        throw std::runtime_error("Failed to write checkpoint to " + filePath);
+}
@@ -0,0 +1,55 @@
+#ifndef _CHECKPOINTWRITER_H
+#define _CHECKPOINTWRITER_H
+
+#include <string>
+#include <future>
+#include <fstream>
+#include <cstdio>
+#include <stdexcept>
+
+/**
+ * Class CheckpointWriter is responsible for writing serialized checkpoints to disk on a background thread,
+ * so the time loop only pays for copying the solver state into memory
+ */
+class CheckpointWriter {
+public:
+    /**
+     * Construct a CheckpointWriter with no pending writes
+     */
+    CheckpointWriter();
+
+    /**
+     * Destructor, blocks until any pending checkpoint has been written
+     */
+    ~CheckpointWriter();
+
+    /**
+     * Write a serialized checkpoint to a file on a background thread.
+     * If a previous checkpoint is still being written this call waits for it to finish first.
+     * The data is written to a temporary file which is then renamed, so an interrupted write never
+     * corrupts the last complete checkpoint
+     *
+     * @param filePath Path of the checkpoint file
+     * @param data Serialized checkpoint, ownership is moved to the writer
+     */
+    void writeAsync(const std::string &filePath, std::string data);
+
+    /**
+     * Block until any pending checkpoint has been written.
+     * Errors raised while writing the checkpoint are rethrown here
+     */
+    void wait();
+
+private:
+    std::future<void> pendingWrite;
+
+    /**
+     * Write the serialized checkpoint to disk, runs on the background thread
+     *
+     * @param filePath Path of the checkpoint file
+     * @param data Serialized checkpoint
+     */
+    static void writeToFile(const std::string &filePath, const std::string &data);
+};
+
+#endif //QUANTUMFOUNDRY_CHECKPOINTWRITER_H
@@ -1,14 +1,46 @@
 #include "CoordinateHasher.h"
 
+namespace {
+    /**
+     * Spread the lowest MORTON_BITS_PER_AXIS bits of a value out to every third bit
+     */
+    inline std::uint64_t spreadBits(std::uint64_t value) {
+        value &= (1ULL << MORTON_BITS_PER_AXIS) - 1;
+        value = (value | value << 32) & 0x1F00000000FFFFULL;
+        value = (value | value << 16) & 0x1F0000FF0000FFULL;
+        value = (value | value << 8) & 0x100F00F00F00F00FULL;
+        value = (value | value << 4) & 0x10C30C30C30C30C3ULL;
+        value = (value | value << 2) & 0x1249249249249249ULL;
+
+        return value;
+    }
+
+    /**
+     * Check that a coordinate is a lattice index the Morton key can hold once offset. The range is checked before the
+     * cast, casting a double beyond the range of the integer is undefined
+     */
+    inline bool isLatticeIndex(double coordinate) {
+        return coordinate >= -LATTICE_INDEX_OFFSET && coordinate < LATTICE_INDEX_OFFSET &&
+               coordinate == (double) (std::int64_t) coordinate;
+    }
+
+    /**
+     * Offset a lattice index to the unsigned range of the Morton key
+     */
+    inline std::uint32_t offsetIndex(double coordinate) {
+        return (std::uint32_t) ((std::int64_t) coordinate + LATTICE_INDEX_OFFSET);
+    }
+}
+
 std::size_t CoordinateHasher::operator ()(const Coordinates &p) const {
+    if (isLatticeIndex(p.getI()) && isLatticeIndex(p.getJ()) && isLatticeIndex(p.getK()))
+        return (std::size_t) interleave(offsetIndex(p.getI()), offsetIndex(p.getJ()), offsetIndex(p.getK()));
+
     return ((std::hash<double>()(p.getI())
             ^ (std::hash<double>()(p.getJ()) << 1)) >> 1)
             ^ (std::hash<double>()(p.getK()) << 1);
+}
 
-
-//    std::ostringstream strStream;
-//    strStream << p.getI() << p.getJ() << p.getK();
-//
-//    std::hash<std::string> strHash;
-//    return strHash(strStream.str());
+std::uint64_t CoordinateHasher::interleave(std::uint32_t i, std::uint32_t j, std::uint32_t k) {
+    return spreadBits(i) | spreadBits(j) << 1 | spreadBits(k) << 2;
 }
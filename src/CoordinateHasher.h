@@ -1,12 +1,20 @@
 #ifndef _COORDINATEHASHER_H
 #define _COORDINATEHASHER_H
 
+#include <cstdint>
+#include <cstddef>
 #include <sstream>
 #include <ostream>
 #include "Point.h"
 
+#define MORTON_BITS_PER_AXIS 21 // three interleaved axes fill 63 bits of the key
+#define LATTICE_INDEX_OFFSET (1 << 20) // lattice indices from -2^20 on hash by their Morton key, ghosts included
+
 /**
  * Class responsible for hashing Coordinate objects.
+ * Coordinates on the integer lattice, as the points of a uniform grid and their ghosts are, hash to the Morton key of
+ * their indices, so the hashes of a grid are dense and neighboring points share nearby buckets. Other coordinates,
+ * e.g. the positions of a graded grid, fall back to combining the hashes of the components
  */
 class CoordinateHasher {
 public:
@@ -18,6 +26,16 @@ public:
      */
     size_t operator() (const Coordinates &c) const;
 
+    /**
+     * Interleave lattice indices into a Morton key, i in the lowest bit, then j and k
+     *
+     * @param i Index along the i axis, below 2^MORTON_BITS_PER_AXIS
+     * @param j Index along the j axis, below 2^MORTON_BITS_PER_AXIS
+     * @param k Index along the k axis, below 2^MORTON_BITS_PER_AXIS
+     * @return Morton key
+     */
+    static std::uint64_t interleave(std::uint32_t i, std::uint32_t j, std::uint32_t k);
+
 };
 
 #endif //QUANTUMFOUNDRY_COORDINATEHASHER_H
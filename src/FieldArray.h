@@ -0,0 +1,187 @@
+#ifndef _FIELDARRAY_H
+#define _FIELDARRAY_H
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * Class FieldArrayExpression is the base of every FieldArray arithmetic expression.
+ * Like FieldVectorExpression, arithmetic on FieldArrays only records its operands and the whole expression is evaluated
+ * in a single loop over the values when it is assigned to a FieldArray, e.g.
+ *
+ *     u = u + (timeStep / 6) * (k1 + 2 * k2 + 2 * k3 + k4);
+ *
+ * reads every operand once and writes u once, without any temporary arrays
+ */
+template <typename Expression>
+class FieldArrayExpression {
+public:
+    inline double operator[](std::size_t index) const { return static_cast<const Expression &>(*this)[index]; }
+
+    inline std::size_t size() const { return static_cast<const Expression &>(*this).size(); }
+};
+
+class FieldArray;
+
+/**
+ * FieldArrays are held by reference, expressions by value
+ */
+template <typename Expression>
+struct FieldArrayOperand {
+    typedef const Expression type;
+};
+
+template <>
+struct FieldArrayOperand<FieldArray> {
+    typedef const FieldArray &type;
+};
+
+/**
+ * Class FieldArray holds the values of a batch of fields in one contiguous array, e.g. one component of a field over
+ * a whole grid, and supports fused arithmetic through FieldArrayExpression
+ */
+class FieldArray : public FieldArrayExpression<FieldArray> {
+public:
+    /**
+     * Construct a FieldArray of zeros
+     *
+     * @param size Number of values
+     */
+    explicit FieldArray(std::size_t size = 0) : values(size, 0.0) {}
+
+    /**
+     * Construct a FieldArray by evaluating an arithmetic expression
+     *
+     * @param expression Expression to evaluate
+     */
+    template <typename Expression>
+    FieldArray(const FieldArrayExpression<Expression> &expression) : values(expression.size()) {
+        assign(expression);
+    }
+
+    /**
+     * Evaluate an arithmetic expression into the FieldArray. Every operation is element wise, so the expression may
+     * contain the FieldArray itself
+     *
+     * @param expression Expression to evaluate, must have the same size as the FieldArray
+     * @return Reference to the FieldArray
+     */
+    template <typename Expression>
+    FieldArray &operator=(const FieldArrayExpression<Expression> &expression) {
+        if (expression.size() != values.size())
+            throw std::invalid_argument("Field arrays of different sizes can not be combined");
+
+        assign(expression);
+
+        return *this;
+    }
+
+    template <typename Expression>
+    FieldArray &operator+=(const FieldArrayExpression<Expression> &expression) {
+        return *this = *this + expression;
+    }
+
+    inline double operator[](std::size_t index) const { return values[index]; }
+
+    inline double &operator[](std::size_t index) { return values[index]; }
+
+    inline std::size_t size() const { return values.size(); }
+
+    inline double *data() { return values.data(); }
+
+    inline const double *data() const { return values.data(); }
+
+private:
+    std::vector<double> values;
+
+    template <typename Expression>
+    void assign(const FieldArrayExpression<Expression> &expression) {
+        const Expression &evaluated = static_cast<const Expression &>(expression);
+        double *output = values.data();
+        std::size_t size = values.size();
+
+        for (std::size_t index = 0; index < size; index++)
+            output[index] = evaluated[index];
+    }
+};
+
+/**
+ * Expression node for the element wise sum of two expressions
+ */
+template <typename Lhs, typename Rhs>
+class FieldArraySum : public FieldArrayExpression<FieldArraySum<Lhs, Rhs> > {
+public:
+    FieldArraySum(const Lhs &lhs, const Rhs &rhs) : lhs(lhs), rhs(rhs) {
+        if (lhs.size() != rhs.size())
+            throw std::invalid_argument("Field arrays of different sizes can not be combined");
+    }
+
+    inline double operator[](std::size_t index) const { return lhs[index] + rhs[index]; }
+
+    inline std::size_t size() const { return lhs.size(); }
+
+private:
+    typename FieldArrayOperand<Lhs>::type lhs;
+    typename FieldArrayOperand<Rhs>::type rhs;
+};
+
+/**
+ * Expression node for the element wise difference of two expressions
+ */
+template <typename Lhs, typename Rhs>
+class FieldArrayDifference : public FieldArrayExpression<FieldArrayDifference<Lhs, Rhs> > {
+public:
+    FieldArrayDifference(const Lhs &lhs, const Rhs &rhs) : lhs(lhs), rhs(rhs) {
+        if (lhs.size() != rhs.size())
+            throw std::invalid_argument("Field arrays of different sizes can not be combined");
+    }
+
+    inline double operator[](std::size_t index) const { return lhs[index] - rhs[index]; }
+
+    inline std::size_t size() const { return lhs.size(); }
+
+private:
+    typename FieldArrayOperand<Lhs>::type lhs;
+    typename FieldArrayOperand<Rhs>::type rhs;
+};
+
+/**
+ * Expression node for an expression multiplied by a scalar
+ */
+template <typename Operand>
+class FieldArrayScaled : public FieldArrayExpression<FieldArrayScaled<Operand> > {
+public:
+    FieldArrayScaled(double scalar, const Operand &operand) : scalar(scalar), operand(operand) {}
+
+    inline double operator[](std::size_t index) const { return scalar * operand[index]; }
+
+    inline std::size_t size() const { return operand.size(); }
+
+private:
+    double scalar;
+    typename FieldArrayOperand<Operand>::type operand;
+};
+
+template <typename Lhs, typename Rhs>
+inline FieldArraySum<Lhs, Rhs> operator+(const FieldArrayExpression<Lhs> &lhs, const FieldArrayExpression<Rhs> &rhs) {
+    return FieldArraySum<Lhs, Rhs>(static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+inline FieldArrayDifference<Lhs, Rhs> operator-(const FieldArrayExpression<Lhs> &lhs,
+                                                const FieldArrayExpression<Rhs> &rhs) {
+    return FieldArrayDifference<Lhs, Rhs>(static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename Operand>
+inline FieldArrayScaled<Operand> operator*(double scalar, const FieldArrayExpression<Operand> &operand) {
+    return FieldArrayScaled<Operand>(scalar, static_cast<const Operand &>(operand));
+}
+
+template <typename Operand>
+inline FieldArrayScaled<Operand> operator*(const FieldArrayExpression<Operand> &operand, double scalar) {
+    return FieldArrayScaled<Operand>(scalar, static_cast<const Operand &>(operand));
+}
+
+#endif //QUANTUMFOUNDRY_FIELDARRAY_H
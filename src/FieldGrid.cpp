@@ -0,0 +1,107 @@
+#include "FieldGrid.h"
+
+template <typename Scalar>
+const int BasicFieldGrid<Scalar>::numComponents;
+
+template <typename Scalar>
+BasicFieldGrid<Scalar>::BasicFieldGrid(int numI, int numJ, int numK, double spacingDelta) {
+    if (numI <= 0 || numJ <= 0 || numK <= 0)
+        throw std::invalid_argument("A field grid needs at least one point along each axis");
+
+    this->numI = numI;
+    this->numJ = numJ;
+    this->numK = numK;
+    this->spacingDelta = spacingDelta;
+
+    allocate();
+}
+
+template <typename Scalar>
+BasicFieldGrid<Scalar>::BasicFieldGrid(PointManager *pm) {
+    if (pm->isGraded())
+        throw std::invalid_argument("The grid needs evenly spaced points");
+
+    if (pm->getDifferenceScheme() != PointManager::SecondOrder)
+        throw std::invalid_argument("The grid only supports second order differences");
+
+    for (int face = PointManager::IStartFace; face <= PointManager::KEndFace; face++)
+        if (pm->getSymmetry((PointManager::Face) face) != PointManager::NoSymmetry)
+            throw std::invalid_argument("The grid does not support symmetry planes");
+
+    this->numI = this->numJ = this->numK = pm->getNumPointsPerAxis();
+    this->spacingDelta = pm->getSpacingDelta();
+
+    allocate();
+    points.assign(getTotalNumberPoints(), nullptr);
+
+    for (const auto &p : *pm->getCollectionOfPoints()) {
+        int i = pm->getAxisIndex(p.first.getI());
+        int j = pm->getAxisIndex(p.first.getJ());
+        int k = pm->getAxisIndex(p.first.getK());
+
+        if (i < 0 || i >= numI || j < 0 || j >= numJ || k < 0 || k >= numK) // point lies outside of the bounds
+            continue;
+
+        std::size_t index = getIndex(i, j, k);
+        permittivity[index] = p.second->getPermittivity();
+        conductivity[index] = p.second->getConductivity();
+        voltage[index] = p.second->getVoltage();
+        points[index] = p.second;
+    }
+}
+
+template <typename Scalar>
+void BasicFieldGrid<Scalar>::copyMaterials() {
+    for (std::size_t index = 0; index < points.size(); index++) {
+        if (!points[index])
+            continue;
+
+        permittivity[index] = points[index]->getPermittivity();
+        conductivity[index] = points[index]->getConductivity();
+    }
+}
+
+template <typename Scalar>
+void BasicFieldGrid<Scalar>::allocate() {
+    std::size_t totalNumPoints = getTotalNumberPoints();
+
+    for (auto &component : components)
+        component.assign(totalNumPoints, Scalar(0));
+
+    permittivity.assign(totalNumPoints, 1.0);
+    conductivity.assign(totalNumPoints, 0.0);
+    voltage.assign(totalNumPoints, 0.0);
+}
+
+template <typename Scalar>
+std::size_t BasicFieldGrid<Scalar>::getStride(PointManager::Axis axis) const {
+    switch (axis) {
+        case PointManager::IAxis:
+            return (std::size_t) numJ * numK;
+        case PointManager::JAxis:
+            return numK;
+        default:
+            return 1;
+    }
+}
+
+template <typename Scalar>
+int BasicFieldGrid<Scalar>::getNumPoints(PointManager::Axis axis) const {
+    switch (axis) {
+        case PointManager::IAxis:
+            return numI;
+        case PointManager::JAxis:
+            return numJ;
+        default:
+            return numK;
+    }
+}
+
+template <typename Scalar>
+std::size_t BasicFieldGrid<Scalar>::getTotalNumberPoints() const { return (std::size_t) numI * numJ * numK; }
+
+template <typename Scalar>
+double BasicFieldGrid<Scalar>::getSpacingDelta() const { return this->spacingDelta; }
+
+template class BasicFieldGrid<double>;
+template class BasicFieldGrid<float>;
@@ -0,0 +1,133 @@
+#ifndef _FIELDGRID_H
+#define _FIELDGRID_H
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+#include "PointManager.h"
+#include "Coordinates.h"
+
+/**
+ * Class BasicFieldGrid holds the fields and materials of a regular grid of points in contiguous arrays, one array per
+ * field component, with the k index varying fastest.
+ * Unlike PointManager it only holds a single time level of each field, which is what the grid based solvers need.
+ * Field components are stored as Scalar (float or double), materials and voltages are always kept in double since they
+ * are only read while setting up a solver
+ */
+template <typename Scalar>
+class BasicFieldGrid {
+public:
+    typedef Scalar ScalarType;
+
+    typedef enum {
+        ElectricI, ElectricJ, ElectricK, MagneticI, MagneticJ, MagneticK, CurrentI, CurrentJ, CurrentK
+    } Component;
+
+    static const int numComponents = 9;
+
+    /**
+     * Construct a grid of zero fields in a vacuum
+     *
+     * @param numI Number of points along the i axis
+     * @param numJ Number of points along the j axis
+     * @param numK Number of points along the k axis
+     * @param spacingDelta Spacing between neighboring points
+     */
+    BasicFieldGrid(int numI, int numJ, int numK, double spacingDelta);
+
+    /**
+     * Construct a grid covering all points of a PointManager and copy each point's permittivity, conductivity and
+     * voltage. Fields start at zero
+     *
+     * @param pm PointManager containing the points of the simulation
+     */
+    explicit BasicFieldGrid(PointManager *pm);
+
+    /**
+     * Get the index of a point in the component and material arrays
+     *
+     * @param i Index of the point along the i axis
+     * @param j Index of the point along the j axis
+     * @param k Index of the point along the k axis
+     * @return Index of the point in the contiguous arrays
+     */
+    inline std::size_t getIndex(int i, int j, int k) const { return ((std::size_t) i * numJ + j) * numK + k; }
+
+    /**
+     * Get the distance in the contiguous arrays between a point and its next neighbor along an axis
+     *
+     * @param axis Axis of the neighbor
+     * @return Array stride along the axis
+     */
+    std::size_t getStride(PointManager::Axis axis) const;
+
+    /**
+     * Get the number of points along an axis
+     *
+     * @param axis Axis to get the number of points along
+     * @return Number of points along the axis
+     */
+    int getNumPoints(PointManager::Axis axis) const;
+
+    /**
+     * Get the total number of points in the grid
+     *
+     * @return Total number of points
+     */
+    std::size_t getTotalNumberPoints() const;
+
+    /**
+     * Get the spacing between neighboring points
+     *
+     * @return Spacing delta between points
+     */
+    double getSpacingDelta() const;
+
+    /**
+     * Get the contiguous array holding one component of a field
+     *
+     * @param component Field component to get
+     * @return Pointer to the first element of the component's array
+     */
+    inline Scalar *getComponent(Component component) { return components[component].data(); }
+
+    inline const Scalar *getComponent(Component component) const { return components[component].data(); }
+
+    inline double getPermittivity(std::size_t index) const { return permittivity[index]; }
+
+    inline double getConductivity(std::size_t index) const { return conductivity[index]; }
+
+    inline double getVoltage(std::size_t index) const { return voltage[index]; }
+
+    /**
+     * Get the Point of the PointManager the grid was built from at a given grid index
+     *
+     * @param index Index of the point in the contiguous arrays
+     * @return Pointer to the Point, nullptr if the grid was not built from a PointManager or the point does not exist
+     */
+    inline Point *getPoint(std::size_t index) const { return points.empty() ? nullptr : points[index]; }
+
+    /**
+     * Copy the permittivity and conductivity of every point of the PointManager the grid was built from again, e.g.
+     * after the conductivity of a point changed. Does nothing if the grid was not built from a PointManager
+     */
+    void copyMaterials();
+
+private:
+    int numI, numJ, numK;
+    double spacingDelta;
+    std::vector<Scalar> components[numComponents];
+    std::vector<double> permittivity, conductivity, voltage;
+    std::vector<Point *> points;
+
+    /**
+     * Allocate all component and material arrays, fields are zeroed and the material is a vacuum
+     */
+    void allocate();
+};
+
+typedef BasicFieldGrid<double> FieldGrid;
+typedef BasicFieldGrid<float> SinglePrecisionFieldGrid;
+
+#endif //QUANTUMFOUNDRY_FIELDGRID_H
@@ -0,0 +1,66 @@
+#include "FieldHistoryPool.h"
+
+FieldHistoryPool::FieldHistoryPool() {
+    for (auto &freeList : freeLists)
+        freeList = nullptr;
+
+    this->blockCursor = this->blockEnd = nullptr;
+    this->numAllocations = this->numDeallocations = this->numUnpooled = 0;
+}
+
+FieldHistoryPool::~FieldHistoryPool() {
+    for (char *block : blocks)
+        ::operator delete(block);
+}
+
+void *FieldHistoryPool::allocate(std::size_t size) {
+    if (size > FIELD_HISTORY_MAX_POOLED_SIZE) {
+        numUnpooled++;
+        return ::operator new(size);
+    }
+
+    // round up to the size class, so consecutive entries stay aligned and can hold the free list pointer
+    std::size_t sizeClass = size == 0 ? 0 : (size - 1) / FIELD_HISTORY_ALIGNMENT;
+    std::size_t classSize = (sizeClass + 1) * FIELD_HISTORY_ALIGNMENT;
+
+    numAllocations++;
+
+    if (freeLists[sizeClass]) {
+        void *p = freeLists[sizeClass];
+        freeLists[sizeClass] = *static_cast<void **>(p);
+
+        return p;
+    }
+
+    if ((std::size_t) (blockEnd - blockCursor) < classSize) { // the rest of the block is left unused
+        blocks.push_back(static_cast<char *>(::operator new(FIELD_HISTORY_BLOCK_SIZE)));
+        blockCursor = blocks.back();
+        blockEnd = blockCursor + FIELD_HISTORY_BLOCK_SIZE;
+    }
+
+    void *p = blockCursor;
+    blockCursor += classSize;
+
+    return p;
+}
+
+void FieldHistoryPool::deallocate(void *p, std::size_t size) {
+    if (size > FIELD_HISTORY_MAX_POOLED_SIZE) {
+        ::operator delete(p);
+        return;
+    }
+
+    std::size_t sizeClass = size == 0 ? 0 : (size - 1) / FIELD_HISTORY_ALIGNMENT;
+
+    numDeallocations++;
+    *static_cast<void **>(p) = freeLists[sizeClass];
+    freeLists[sizeClass] = p;
+}
+
+std::uint64_t FieldHistoryPool::getNumAllocations() const { return numAllocations; }
+
+std::uint64_t FieldHistoryPool::getNumLiveAllocations() const { return numAllocations - numDeallocations; }
+
+std::uint64_t FieldHistoryPool::getNumSystemAllocations() const { return blocks.size() + numUnpooled; }
+
+std::size_t FieldHistoryPool::getReservedBytes() const { return blocks.size() * FIELD_HISTORY_BLOCK_SIZE; }
@@ -0,0 +1,117 @@
+#ifndef _FIELDHISTORYPOOL_H
+#define _FIELDHISTORYPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#define FIELD_HISTORY_BLOCK_SIZE (1 << 18) // bytes requested from the system allocator at a time
+#define FIELD_HISTORY_MAX_POOLED_SIZE 256 // larger allocations go to the system allocator
+#define FIELD_HISTORY_ALIGNMENT alignof(std::max_align_t) // granularity of the size classes
+
+/**
+ * Class FieldHistoryPool hands out the storage of the field histories of Points: the maps of each point and their tree
+ * nodes, one per time level. These are small and of a handful of sizes, so they are carved out of large blocks and
+ * recycled through one free list per size instead of going through the system allocator one by one. Destroying the
+ * pool releases every block at once, the histories using it must not be touched afterwards
+ */
+class FieldHistoryPool {
+public:
+    FieldHistoryPool();
+
+    ~FieldHistoryPool();
+
+    FieldHistoryPool(const FieldHistoryPool &) = delete;
+
+    FieldHistoryPool &operator=(const FieldHistoryPool &) = delete;
+
+    /**
+     * Allocate storage, from the system allocator if it is larger than FIELD_HISTORY_MAX_POOLED_SIZE
+     *
+     * @param size Size in bytes
+     * @return Pointer to uninitialized storage
+     */
+    void *allocate(std::size_t size);
+
+    /**
+     * Return storage to the pool
+     *
+     * @param p Pointer returned by allocate
+     * @param size Size the storage was allocated with
+     */
+    void deallocate(void *p, std::size_t size);
+
+    /**
+     * Get the number of allocations served by the pool so far
+     *
+     * @return Number of allocations
+     */
+    std::uint64_t getNumAllocations() const;
+
+    /**
+     * Get the number of allocations served by the pool and not returned yet
+     *
+     * @return Number of live allocations
+     */
+    std::uint64_t getNumLiveAllocations() const;
+
+    /**
+     * Get the number of requests made to the system allocator, blocks and allocations too large to pool
+     *
+     * @return Number of system allocations
+     */
+    std::uint64_t getNumSystemAllocations() const;
+
+    /**
+     * Get the number of bytes held in blocks
+     *
+     * @return Bytes reserved from the system allocator
+     */
+    std::size_t getReservedBytes() const;
+
+private:
+    void *freeLists[FIELD_HISTORY_MAX_POOLED_SIZE / FIELD_HISTORY_ALIGNMENT]; // each free entry points to the next
+    char *blockCursor, *blockEnd; // the part of the newest block not handed out yet
+    std::vector<char *> blocks;
+    std::uint64_t numAllocations, numDeallocations, numUnpooled;
+};
+
+/**
+ * Allocator of the field history maps, drawing their nodes from a FieldHistoryPool. Without a pool it falls back to
+ * the system allocator, e.g. for Points created outside of a PointManager
+ */
+template <typename T>
+class FieldHistoryAllocator {
+public:
+    typedef T value_type;
+
+    FieldHistoryAllocator(FieldHistoryPool *pool = nullptr) noexcept : pool(pool) {}
+
+    template <typename U>
+    FieldHistoryAllocator(const FieldHistoryAllocator<U> &other) noexcept : pool(other.pool) {}
+
+    inline T *allocate(std::size_t n) {
+        if (pool)
+            return static_cast<T *>(pool->allocate(n * sizeof(T)));
+
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    inline void deallocate(T *p, std::size_t n) {
+        if (pool)
+            pool->deallocate(p, n * sizeof(T));
+        else
+            ::operator delete(p);
+    }
+
+    template <typename U>
+    inline bool operator==(const FieldHistoryAllocator<U> &rhs) const { return pool == rhs.pool; }
+
+    template <typename U>
+    inline bool operator!=(const FieldHistoryAllocator<U> &rhs) const { return pool != rhs.pool; }
+
+    FieldHistoryPool *pool;
+};
+
+#endif //QUANTUMFOUNDRY_FIELDHISTORYPOOL_H
@@ -1,353 +1,723 @@
 #include "FieldSolver.h"
 
 FieldSolver::FieldSolver(){
-    this->pm = nullptr;
-    this->timeStep = 0.0;
-    this->currentTime = 0.0;
-    this->initEFieldCalculated = false;
-    this->drudeScatteringTime = 0.01;
+    initializeState();
 }
 
 FieldSolver::FieldSolver(PointManager *pm, double timeStep, double drudeScatteringTime) {
+    initializeState();
+
     this->pm = pm;
     this->timeStep = timeStep;
+    this->drudeScatteringTime = drudeScatteringTime;
+}
+
+FieldSolver::FieldSolver(PointManager *pm, std::istream &checkpoint) {
+    initializeState();
+
+    this->pm = pm;
+    this->timeStep = readBinary<double>(checkpoint);
+    this->currentTime = readBinary<double>(checkpoint);
+    this->drudeScatteringTime = readBinary<double>(checkpoint);
+    this->initEFieldCalculated = readBinary<std::uint8_t>(checkpoint) != 0;
+    this->stepCount = readBinary<std::uint64_t>(checkpoint);
+
+    if (pm->getCheckpointVersion() >= 4) { // the numerics, versions before reset them to the defaults
+        this->currentIntegrator = static_cast<CurrentIntegrator>(readBinary<std::int32_t>(checkpoint));
+        this->integrator = LowStorageRungeKutta(
+                static_cast<LowStorageRungeKutta::Scheme>(readBinary<std::int32_t>(checkpoint)));
+        this->adaptiveTimeStepping = readBinary<std::uint8_t>(checkpoint) != 0;
+        this->relativeTolerance = readBinary<double>(checkpoint);
+        this->stabilitySafetyFactor = readBinary<double>(checkpoint);
+        this->rejectedStepCount = readBinary<std::uint64_t>(checkpoint);
+    }
+
+    pm->fillGhostFields(currentTime);
+}
+
+void FieldSolver::initializeState() {
+    this->pm = nullptr;
+    this->timeStep = 0.0;
     this->currentTime = 0.0;
     this->initEFieldCalculated = false;
-    this->drudeScatteringTime = drudeScatteringTime;
+    this->drudeScatteringTime = 0.01;
+    this->stepCount = 0;
+    this->checkpointInterval = 0;
+    this->probes = nullptr;
+    this->scheduler = nullptr;
+    this->conductingPointsRevision = std::numeric_limits<std::uint64_t>::max();
+    this->absorbingPointsRevision = std::numeric_limits<std::uint64_t>::max();
+    this->currentIntegrator = Exponential;
+    this->currentDecay = 0.0;
+    this->currentCoefficientsTimeStep = 0.0;
+    this->adaptiveTimeStepping = false;
+    this->relativeTolerance = 0.0;
+    this->stabilitySafetyFactor = 0.9;
+    this->stableTimeStep = 0.0;
+    this->stableTimeStepRevision = std::numeric_limits<std::uint64_t>::max();
+    this->rejectedStepCount = 0;
+    this->stableTimeStepScheme = PointManager::SecondOrder;
+    this->derivativeLinesRevision = std::numeric_limits<std::uint64_t>::max();
+    invalidateCurlDerivatives();
 }
 
-// TODO change to use point reference instead of const coordinate reference
 FieldVector FieldSolver::calculateCurl(FieldSolver::Field field, const Coordinates &target, double time) {
-    FieldVector nextINeighborField, prevINeighborField, nextJNeighborField, prevJNeighborField, nextKNeighborField, prevKNeighborField;
+    if (pm->getDifferenceScheme() == PointManager::CompactFourthOrder && field != CurrentField) {
+        FieldAccessor accessor = field == ElectricField ? &Point::getElectricField : &Point::getMagneticField;
+        std::vector<FieldVector> &derivatives = curlDerivatives[field];
+
+        updateDerivativeLines(); // drops the kept derivatives if the layout changed
+
+        // every point's curl comes out of the same solve
+        if (curlDerivativesTime[field] != time || curlDerivativesRevision[field] != pm->getFieldRevision()) {
+            calculateCompactDerivatives([accessor, time](Point *p) { return *(p->*accessor)(time); }, derivatives);
+            curlDerivativesTime[field] = time;
+            curlDerivativesRevision[field] = pm->getFieldRevision();
+        }
+
+        auto index = stencilIndices.find(pm->getPointerToPoint(target));
+
+        if (index != stencilIndices.end())
+            return assembleCurl(&derivatives[3 * index->second]);
+    }
+
+    switch (field) {
+        case ElectricField:
+            return calculateCurl(&Point::getElectricField, pm->getStencil(target), time);
+        case MagneticField:
+            return calculateCurl(&Point::getMagneticField, pm->getStencil(target), time);
+        default:
+            return FieldVector(INT_MIN, INT_MIN, INT_MIN);
+    }
+}
+
+inline FieldVector FieldSolver::calculateDerivative(FieldAccessor field, const PointManager::Stencil &stencil,
+                                                    PointManager::Axis axis, double time) const {
+    const FieldVector &next = *(stencil.neighbors[2 * axis]->*field)(time);
+    const FieldVector &prev = *(stencil.neighbors[2 * axis + 1]->*field)(time);
+    const PointManager::AxisWeights &weights = pm->getAxisWeights(stencil, axis);
+    FieldVector derivative = (weights.gradient[0] * next) + (weights.gradient[1] * prev);
+
+    if (weights.gradientCenter != 0) // the point itself only counts between unequal spacings
+        derivative += weights.gradientCenter * *(stencil.point->*field)(time);
+
+    if (stencil.farNeighbors[2 * axis]) // fourth order differences away from the bounded faces
+        derivative += (weights.farGradient[0] * *(stencil.farNeighbors[2 * axis]->*field)(time)) +
+                      (weights.farGradient[1] * *(stencil.farNeighbors[2 * axis + 1]->*field)(time));
+
+    return derivative;
+}
+
+inline FieldVector FieldSolver::assembleCurl(const FieldVector derivatives[3]) {
+    const FieldVector &dI = derivatives[0], &dJ = derivatives[1], &dK = derivatives[2];
+
+    return FieldVector(dJ.getKComp() - dK.getJComp(), dK.getIComp() - dI.getKComp(), dI.getJComp() - dJ.getIComp());
+}
+
+inline FieldVector FieldSolver::calculateCurl(FieldAccessor field, const PointManager::Stencil &stencil,
+                                              double time) const {
+    const FieldVector derivatives[] = {calculateDerivative(field, stencil, PointManager::IAxis, time),
+                                       calculateDerivative(field, stencil, PointManager::JAxis, time),
+                                       calculateDerivative(field, stencil, PointManager::KAxis, time)};
 
-    switch(field){
-        case ElectricField: {
-            auto initEField = *pm->getElectricField(target, time);
-            prevINeighborField = initEField;
-            nextINeighborField = initEField;
+    return assembleCurl(derivatives);
+}
 
-            prevJNeighborField = initEField;
-            nextJNeighborField = initEField;
+void FieldSolver::updateDerivativeLines() {
+    if (derivativeLinesRevision == pm->getLayoutRevision())
+        return;
 
-            prevKNeighborField = initEField;
-            nextKNeighborField = initEField;
+    const std::vector<PointManager::Stencil> &stencils = pm->getStencils();
 
-            if (!pm->getNextINeighbor(target))
-                nextINeighborField = *pm->getNextINeighbor(target)->getElectricField(time);
+    stencilIndices.clear();
+    invalidateCurlDerivatives(); // the derivatives are ordered like the old stencils
 
-            if(!pm->getPrevINeighbor(target))
-                prevINeighborField = *pm->getPrevINeighbor(target)->getElectricField(time);
+    for (std::size_t index = 0; index < stencils.size(); index++)
+        stencilIndices[stencils[index].point] = index;
 
-            if(!pm->getNextJNeighbor(target))
-                nextJNeighborField = *pm->getNextJNeighbor(target)->getElectricField(time);
+    for (int axis = 0; axis < 3; axis++) {
+        derivativeLines[axis].clear();
 
-            if(!pm->getPrevJNeighbor(target))
-                prevJNeighborField = *pm->getPrevJNeighbor(target)->getElectricField(time);
+        for (const auto &stencil : stencils) {
+            if (stencil.neighbors[2 * axis + 1]->getClassification() != Point::Ghost) // not the start of a line
+                continue;
 
-            if(!pm->getNextKNeighbor(target))
-                nextKNeighborField = *pm->getNextKNeighbor(target)->getElectricField(time);
+            DerivativeLine line;
+            line.periodic = pm->isPeriodic((PointManager::Axis) axis);
 
-            if(!pm->getPrevKNeighbor(target))
-                prevKNeighborField = *pm->getPrevKNeighbor(target)->getElectricField(time);
+            for (Point *p = stencil.point; p->getClassification() != Point::Ghost;) {
+                std::size_t index = stencilIndices.at(p);
 
-            break;
+                line.stencils.push_back(index);
+                p = stencils[index].neighbors[2 * axis];
+            }
+
+            derivativeLines[axis].push_back(line);
         }
-        case MagneticField: {
-            auto initBField = *pm->getMagneticField(target, time);
+    }
 
-            nextINeighborField = initBField;
-            prevINeighborField = initBField;
+    derivativeLinesRevision = pm->getLayoutRevision();
+}
+
+/**
+ * Solve a tridiagonal system with the Thomas algorithm, overwriting the right hand side with the solution.
+ * lower[0] and upper[n - 1] lie outside of the matrix and are ignored
+ */
+template <typename T>
+static void solveTridiagonal(const std::vector<double> &lower, const std::vector<double> &diagonal,
+                             const std::vector<double> &upper, std::vector<T> &rhs, std::vector<double> &scratch) {
+    std::size_t n = rhs.size();
+    double pivot = diagonal[0];
+
+    scratch.resize(n);
+    rhs[0] = (1 / pivot) * rhs[0];
+
+    for (std::size_t row = 1; row < n; row++) {
+        scratch[row] = upper[row - 1] / pivot;
+        pivot = diagonal[row] - lower[row] * scratch[row];
+        rhs[row] = (1 / pivot) * (rhs[row] - lower[row] * rhs[row - 1]);
+    }
+
+    for (std::size_t row = n - 1; row > 0; row--)
+        rhs[row - 1] = rhs[row - 1] - scratch[row] * rhs[row];
+}
 
-            nextJNeighborField = initBField;
-            prevJNeighborField = initBField;
+/**
+ * Solve a periodic tridiagonal system with 1 on the diagonal and offDiagonal next to it and in the corners,
+ * overwriting the right hand side with the solution. The corners are a rank one update of a tridiagonal matrix, which
+ * the Sherman-Morrison formula removes with a second solve
+ */
+template <typename T>
+static void solveCyclicTridiagonal(double offDiagonal, std::vector<T> &rhs, std::vector<double> &scratch) {
+    std::size_t n = rhs.size();
+    double gamma = -1.0;
+    std::vector<double> offDiagonals(n, offDiagonal), diagonal(n, 1.0), correction(n, 0.0);
+
+    diagonal[0] -= gamma;
+    diagonal[n - 1] -= offDiagonal * offDiagonal / gamma;
+    correction[0] = gamma;
+    correction[n - 1] = offDiagonal;
+
+    solveTridiagonal(offDiagonals, diagonal, offDiagonals, rhs, scratch);
+    solveTridiagonal(offDiagonals, diagonal, offDiagonals, correction, scratch);
+
+    double factor = 1 / (1 + correction[0] + offDiagonal * correction[n - 1] / gamma);
+    T projection = factor * (rhs[0] + (offDiagonal / gamma) * rhs[n - 1]);
+
+    for (std::size_t row = 0; row < n; row++)
+        rhs[row] = rhs[row] - correction[row] * projection;
+}
+
+template <typename T, typename Value>
+void FieldSolver::calculateCompactDerivatives(Value value, std::vector<T> &derivatives) {
+    const std::vector<PointManager::Stencil> &stencils = pm->getStencils();
+    double rhsWeight = 3 / (4 * pm->getSpacingDelta());
+    std::vector<double> lower, diagonal, upper, scratch;
+    std::vector<T> rhs;
+
+    updateDerivativeLines();
+    derivatives.resize(3 * stencils.size());
+
+    for (int axis = 0; axis < 3; axis++) {
+        for (const auto &line : derivativeLines[axis]) {
+            std::size_t n = line.stencils.size();
+            bool cyclic = line.periodic && n >= 3; // shorter periodic lines are left to the second order differences
+
+            lower.assign(n, 0.25);
+            diagonal.assign(n, 1.0);
+            upper.assign(n, 0.25);
+            rhs.resize(n);
+
+            for (std::size_t row = 0; row < n; row++) {
+                const PointManager::Stencil &stencil = stencils[line.stencils[row]];
+                T next = value(stencil.neighbors[2 * axis]), prev = value(stencil.neighbors[2 * axis + 1]);
+
+                if (cyclic || (!line.periodic && row > 0 && row + 1 < n)) {
+                    rhs[row] = rhsWeight * (next - prev);
+                } else { // closed by the second order difference through the ghost
+                    lower[row] = upper[row] = 0.0;
+                    const PointManager::AxisWeights &weights = pm->getAxisWeights(stencil, (PointManager::Axis) axis);
+                    rhs[row] = weights.gradient[0] * next + weights.gradient[1] * prev;
+                }
+            }
+
+            if (cyclic)
+                solveCyclicTridiagonal(0.25, rhs, scratch);
+            else
+                solveTridiagonal(lower, diagonal, upper, rhs, scratch);
+
+            for (std::size_t row = 0; row < n; row++)
+                derivatives[3 * line.stencils[row] + axis] = rhs[row];
+        }
+    }
+}
+
+void FieldSolver::calculateAndSetInitialElectricField() {
+    if(initEFieldCalculated)
+        throw std::invalid_argument("The initial electric field was already calculated");
 
-            nextKNeighborField = initBField;
-            prevKNeighborField = initBField;
+    pm->fillGhostVoltages();
 
-            if(!pm->getNextINeighbor(target))
-                nextINeighborField = *pm->getNextINeighbor(target)->getMagneticField(time);
+    // E = -grad V
+    if (pm->getDifferenceScheme() == PointManager::CompactFourthOrder) {
+        const std::vector<PointManager::Stencil> &stencils = pm->getStencils();
+        std::vector<double> gradients;
 
-            if(!pm->getPrevINeighbor(target))
-                prevINeighborField = *pm->getPrevINeighbor(target)->getMagneticField(time);
+        calculateCompactDerivatives([](Point *p) { return p->getVoltage(); }, gradients);
 
-            if(!pm->getNextJNeighbor(target))
-                nextJNeighborField = *pm->getNextJNeighbor(target)->getMagneticField(time);
+        for (std::size_t index = 0; index < stencils.size(); index++)
+            stencils[index].point->setElectricField(FieldVector(-gradients[3 * index], -gradients[3 * index + 1],
+                                                                -gradients[3 * index + 2]), 0);
+    } else {
+        for (const auto &stencil : pm->getStencils()) {
+            double gradient[3];
 
-            if(!pm->getPrevJNeighbor(target))
-                prevJNeighborField = *pm->getPrevJNeighbor(target)->getMagneticField(time);
+            for (int axis = 0; axis < 3; axis++) {
+                const PointManager::AxisWeights &weights = pm->getAxisWeights(stencil, (PointManager::Axis) axis);
 
-            if(!pm->getNextKNeighbor(target))
-                nextKNeighborField = *pm->getNextKNeighbor(target)->getMagneticField(time);
+                gradient[axis] = weights.gradient[0] * stencil.neighbors[2 * axis]->getVoltage() +
+                                 weights.gradient[1] * stencil.neighbors[2 * axis + 1]->getVoltage() +
+                                 weights.gradientCenter * stencil.point->getVoltage();
 
-            if(!pm->getPrevKNeighbor(target))
-                prevKNeighborField = *pm->getPrevJNeighbor(target)->getMagneticField(time);
+                if (stencil.farNeighbors[2 * axis])
+                    gradient[axis] += weights.farGradient[0] * stencil.farNeighbors[2 * axis]->getVoltage() +
+                                      weights.farGradient[1] * stencil.farNeighbors[2 * axis + 1]->getVoltage();
+            }
 
-            break;
+            stencil.point->setElectricField(FieldVector(-gradient[0], -gradient[1], -gradient[2]), 0);
         }
-        case RK4Y1: {
-            auto initField = pm->getPointerToPoint(target)->getRk4Y1();
+    }
 
-            nextINeighborField = initField;
-            prevINeighborField = initField;
+    pm->fillGhostFields(0);
+    invalidateCurlDerivatives();
+    this->initEFieldCalculated = true;
+}
 
-            nextJNeighborField = initField;
-            prevJNeighborField = initField;
+void FieldSolver::calculateNextFields() {
+    double error = 0.0;
 
-            nextKNeighborField = initField;
-            prevJNeighborField = initField;
+    if (adaptiveTimeStepping)
+        timeStep = std::min(timeStep, calculateStableTimeStep(stabilitySafetyFactor));
 
-            if(!pm->getNextINeighbor(target))
-                nextINeighborField = pm->getNextINeighbor(target)->getRk4Y1();
+    // the local error of a scheme of order p scales with the step to the power p + 1
+    double errorExponent = -1.0 / (integrator.getOrder() + 1);
 
-            if(!pm->getPrevINeighbor(target))
-                prevINeighborField = pm->getPrevINeighbor(target)->getRk4Y1();
+    // calculate and set next magnetic and electric fields for all points
+    if (adaptiveTimeStepping) {
+        double initialTimeStep = timeStep;
+        int retries = 0;
 
-            if(!pm->getNextJNeighbor(target))
-                nextJNeighborField = pm->getNextJNeighbor(target)->getRk4Y1();
+        error = calculateStepDoubling();
 
-            if(!pm->getPrevJNeighbor(target))
-                prevJNeighborField = pm->getPrevJNeighbor(target)->getRk4Y1();
+        while (!(error <= 1.0)) { // repeat the step with a smaller time step, also when the error is not a number
+            eraseFields(getNextTime());
 
-            if(!pm->getNextKNeighbor(target))
-                nextKNeighborField = pm->getNextKNeighbor(target)->getRk4Y1();
+            if (retries++ == MAX_STEP_RETRIES) {
+                timeStep = initialTimeStep;
+                throw std::runtime_error("The adaptive time step was still rejected after " +
+                                         std::to_string(MAX_STEP_RETRIES) + " retries, the tolerance can not be met");
+            }
 
-            if(!pm->getPrevKNeighbor(target))
-                prevKNeighborField = pm->getPrevKNeighbor(target)->getRk4Y1();
+            timeStep *= std::isnan(error) ? 0.2 : std::max(0.2, 0.9 * std::pow(error, errorExponent));
+            rejectedStepCount++;
 
-            break;
+            error = calculateStepDoubling();
         }
-        case RK4Y2: {
-            auto initField = pm->getPointerToPoint(target)->getRk4Y2();
+    } else {
+        calculateNextElectromagneticFields(currentTime, getNextTime());
+    }
+
+    // then the current from the field at this time
+    calculateNextCurrentField(currentTime);
+
+    this->currentTime = getNextTime();
+    this->stepCount++;
+
+    if (adaptiveTimeStepping) {
+        double growth = error == 0 ? 5.0 : std::min(5.0, std::max(0.2, 0.9 * std::pow(error, errorExponent)));
+        timeStep = std::min(timeStep * growth, calculateStableTimeStep(stabilitySafetyFactor));
+    }
+
+    if (probes)
+        probes->sample(currentTime);
 
-            nextINeighborField = initField;
-            prevINeighborField = initField;
+    if (scheduler)
+        scheduler->update(stepCount, currentTime);
 
-            nextJNeighborField = initField;
-            prevJNeighborField = initField;
+    if (checkpointInterval > 0 && stepCount % checkpointInterval == 0)
+        saveCheckpoint(checkpointPath);
+}
 
-            nextKNeighborField = initField;
-            prevJNeighborField = initField;
+void FieldSolver::setCheckpointInterval(int stepInterval, const std::string &checkpointPath) {
+    if (stepInterval < 0)
+        throw std::invalid_argument("Checkpoint interval must not be negative");
+
+    this->checkpointInterval = stepInterval;
+    this->checkpointPath = checkpointPath;
+}
 
-            if(!pm->getNextINeighbor(target))
-                nextINeighborField = pm->getNextINeighbor(target)->getRk4Y2();
+void FieldSolver::writeCheckpoint(std::ostream &outs) {
+    pm->writeCheckpoint(outs, currentTime);
+
+    writeBinary(outs, timeStep);
+    writeBinary(outs, currentTime);
+    writeBinary(outs, drudeScatteringTime);
+    writeBinary(outs, (std::uint8_t) initEFieldCalculated);
+    writeBinary(outs, stepCount);
+
+    writeBinary(outs, (std::int32_t) currentIntegrator);
+    writeBinary(outs, (std::int32_t) integrator.getScheme());
+    writeBinary(outs, (std::uint8_t) adaptiveTimeStepping);
+    writeBinary(outs, relativeTolerance);
+    writeBinary(outs, stabilitySafetyFactor);
+    writeBinary(outs, rejectedStepCount);
+}
+
+void FieldSolver::saveCheckpoint(const std::string &checkpointPath) {
+    // Serialize on the calling thread so the fields can't change underneath the writer
+    std::ostringstream snapshot(std::ios::out | std::ios::binary);
+    writeCheckpoint(snapshot);
+
+    checkpointWriter.writeAsync(checkpointPath, snapshot.str());
+}
 
-            if(!pm->getPrevINeighbor(target))
-                prevINeighborField = pm->getPrevINeighbor(target)->getRk4Y2();
+void FieldSolver::waitForCheckpoint() {
+    checkpointWriter.wait();
+}
 
-            if(!pm->getNextJNeighbor(target))
-                nextJNeighborField = pm->getNextJNeighbor(target)->getRk4Y2();
+void FieldSolver::attachProbeManager(ProbeManager *probes) { this->probes = probes; }
 
-            if(!pm->getPrevJNeighbor(target))
-                prevJNeighborField = pm->getPrevJNeighbor(target)->getRk4Y2();
+void FieldSolver::attachOutputScheduler(OutputScheduler *scheduler) {
+    this->scheduler = scheduler;
 
-            if(!pm->getNextKNeighbor(target))
-                nextKNeighborField = pm->getNextKNeighbor(target)->getRk4Y2();
+    if (scheduler)
+        scheduler->update(stepCount, currentTime);
+}
 
-            if(!pm->getPrevKNeighbor(target))
-                prevKNeighborField = pm->getPrevKNeighbor(target)->getRk4Y2();
+inline double FieldSolver::getNextTime() const { return currentTime + timeStep;}
 
-            break;
-        }case RK4Y3: {
-            auto initField = pm->getPointerToPoint(target)->getRk4Y3();
+void FieldSolver::calculateNextElectromagneticFields(double time, double nextTime) {
+    double step = nextTime - time;
+    FieldVector zeroVector = FieldVector(0, 0, 0);
 
-            nextINeighborField = initField;
-            prevINeighborField = initField;
+    updateAbsorbingPoints();
+    invalidateCurlDerivatives();
 
-            nextJNeighborField = initField;
-            prevJNeighborField = initField;
+    // The fields at the next time start as a copy of the current fields and are advanced in place by every stage
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        p.second->setElectricField(*p.second->getElectricField(time), nextTime);
+        p.second->setMagneticField(*p.second->getMagneticField(time), nextTime);
+        p.second->getElectricFieldRegister() = zeroVector;
+        p.second->getMagneticFieldRegister() = zeroVector;
+    }
 
-            nextKNeighborField = initField;
-            prevJNeighborField = initField;
+    for (int stage = 0; stage < integrator.getNumStages(); stage++) {
+        double a = integrator.getA(stage);
 
-            if (!pm->getNextINeighbor(target))
-                nextINeighborField = pm->getNextINeighbor(target)->getRk4Y3();
+        pm->fillGhostFields(nextTime);
 
-            if (!pm->getPrevINeighbor(target))
-                prevINeighborField = pm->getPrevINeighbor(target)->getRk4Y3();
+        // dU = A * dU + step * L(U) for every point, before any point's U is changed
+        if (pm->getDifferenceScheme() == PointManager::CompactFourthOrder) {
+            const std::vector<PointManager::Stencil> &stencils = pm->getStencils();
 
-            if (!pm->getNextJNeighbor(target))
-                nextJNeighborField = pm->getNextJNeighbor(target)->getRk4Y3();
+            calculateCompactDerivatives([nextTime](Point *p) { return *p->getElectricField(nextTime); },
+                                        electricDerivatives);
+            calculateCompactDerivatives([nextTime](Point *p) { return *p->getMagneticField(nextTime); },
+                                        magneticDerivatives);
 
-            if (!pm->getPrevJNeighbor(target))
-                prevJNeighborField = pm->getPrevJNeighbor(target)->getRk4Y3();
+            for (std::size_t index = 0; index < stencils.size(); index++)
+                calculateStageRegisters(stencils[index].point, assembleCurl(&electricDerivatives[3 * index]),
+                                        assembleCurl(&magneticDerivatives[3 * index]), a, step);
+        } else {
+            for (const auto &stencil : pm->getStencils())
+                calculateStageRegisters(stencil.point, calculateCurl(&Point::getElectricField, stencil, nextTime),
+                                        calculateCurl(&Point::getMagneticField, stencil, nextTime), a, step);
+        }
 
-            if (!pm->getNextKNeighbor(target))
-                nextKNeighborField = pm->getNextKNeighbor(target)->getRk4Y3();
+        double b = integrator.getB(stage);
 
-            if (!pm->getPrevKNeighbor(target))
-                prevKNeighborField = pm->getPrevKNeighbor(target)->getRk4Y3();
+        // U = U + B * dU
+        for (auto &p : *pm->getCollectionOfPoints()) {
+            FieldVector *eField = p.second->getElectricField(nextTime);
+            FieldVector *bField = p.second->getMagneticField(nextTime);
 
-            break;
+            *eField += b * p.second->getElectricFieldRegister();
+            *bField += b * p.second->getMagneticFieldRegister();
         }
-        default:
-            return FieldVector(INT_MIN, INT_MIN, INT_MIN);
     }
 
-    double i = nextJNeighborField.getKComp() -
-               prevJNeighborField.getKComp() -
-               nextKNeighborField.getJComp() +
-               prevKNeighborField.getJComp();
+    // dE/dt = -rate * E and dB/dt = -rate * B inside the absorbing layers, integrated exactly so the steep rates at
+    // the outer side of a layer don't limit the time step
+    for (const auto &absorbingPoint : absorbingPoints) {
+        Point *p = absorbingPoint.point;
+        double decay = std::exp(-step * absorbingPoint.dampingRate);
 
-    double j = nextKNeighborField.getIComp() -
-               prevKNeighborField.getIComp() -
-               nextINeighborField.getKComp() +
-               prevINeighborField.getKComp();
+        *p->getElectricField(nextTime) = decay * *p->getElectricField(nextTime);
+        *p->getMagneticField(nextTime) = decay * *p->getMagneticField(nextTime);
+    }
+
+    pm->fillGhostFields(nextTime); // keep the ghost layer consistent with the finished step
+}
 
-    double k = nextINeighborField.getJComp() -
-               prevINeighborField.getJComp() -
-               nextJNeighborField.getIComp() +
-               prevJNeighborField.getIComp();
+inline void FieldSolver::calculateStageRegisters(Point *p, const FieldVector &eCurl, const FieldVector &bCurl, double a,
+                                                double step) {
+    FieldVector *jField = p->getCurrentField(currentTime);
+    double scalar = p->getMaterial().waveSpeedSquared; // c^2 / permittivity, precomputed per material
 
-    double denom = 2 * pm->getSpacingDelta();
+    // dB/dt = -curl E
+    FieldVector &bRegister = p->getMagneticFieldRegister();
+    bRegister = (a * bRegister) - (step * eCurl);
 
-    return FieldVector(i / denom, j / denom, k / denom);
+    // dE/dt = c^2 / permittivity * (curl B - mu0 * J), the current is held at its value at the start of the time step
+    FieldVector &eRegister = p->getElectricFieldRegister();
+
+    if (jField)
+        eRegister = (a * eRegister) + ((step * scalar) * (bCurl - VACUUM_PERMEABILITY * *jField));
+    else // non conducting points carry no current
+        eRegister = (a * eRegister) + ((step * scalar) * bCurl);
 }
 
-void FieldSolver::calculateAndSetInitialElectricField() {
-    if(initEFieldCalculated)
-        throw std::invalid_argument("The initial electric field was already calculated");
+void FieldSolver::calculateNextCurrentField(double time){
+    updateConductingPoints();
 
-    double spacingDelta = this->pm->getSpacingDelta();
-    double gradientDenom = 2 * spacingDelta;
+    if (currentIntegrator == Exponential)
+        calculateNextCurrentFieldExponential(time);
+    else
+        calculateNextCurrentFieldRK4(time);
+}
 
-    for (const auto &p : *(pm->getCollectionOfPoints())) {
-        double iComp = pm->getPrevINeighbor(p.first)->getVoltage() - pm->getNextINeighbor(p.first)->getVoltage();
-        double jComp = pm->getPrevJNeighbor(p.first)->getVoltage() - pm->getNextJNeighbor(p.first)->getVoltage();
-        double kComp = pm->getPrevKNeighbor(p.first)->getVoltage() - pm->getNextKNeighbor(p.first)->getVoltage();
+void FieldSolver::calculateNextCurrentFieldRK4(double time) {
+    double scalar = 1 / drudeScatteringTime;
+    double intermediateTimeStep = timeStep / 2;
+    double nextTime = getNextTime();
+    FieldVector zeroVector= FieldVector(0, 0, 0);
 
-        // Set the pointer reference's electric field instead of p.second which is only a reference
-        FieldVector result = (1 / gradientDenom) * FieldVector(iComp, jComp, kComp);
-        pm->getPointerToPoint(p.first)->setElectricField(result, 0);
+    for(const auto &c : conductingPoints){ // loop through all conducting points and calculate k1 and y1
+        Point *p = c.point;
+        FieldVector *jField = p->getCurrentField(time);
+        FieldVector initJField = jField ? *jField : zeroVector; // point just started conducting
+        FieldVector drivingField = *p->getElectricField(time) * p->getConductivity();
+
+        FieldVector k1 = scalar * (drivingField - initJField);
+        FieldVector y1 = initJField + (k1 * intermediateTimeStep);
+
+        FieldVector k2 = scalar * (drivingField - y1);
+        FieldVector y2 = initJField + (k2 * intermediateTimeStep);
+
+        FieldVector k3 = scalar * (drivingField - y2);
+        FieldVector y3 = initJField + (k3 * timeStep);
+
+        FieldVector k4 = scalar * (drivingField - y3);
+
+        FieldVector result = initJField + ((timeStep / 6) * (k1 + (2 * k2) + (2 * k3) + k4));
+        p->setCurrentField(result, nextTime);
     }
-    this->initEFieldCalculated = true;
 }
 
-void FieldSolver::calculateNextFields() {
-    double newTime = getNextTime();
+void FieldSolver::calculateNextCurrentFieldExponential(double time) {
+    double nextTime = getNextTime();
+    FieldVector zeroVector = FieldVector(0, 0, 0);
 
-    // calculate and set next magnetic field for all points
-    calculateNextMagneticField(currentTime);
-    calculateNextElectricField(currentTime);
-    calculateNextCurrentField(currentTime);
+    updateCurrentCoefficients();
 
-    this->currentTime = newTime;
+    // J(t + dt) = J(t) * exp(-dt / tau) + conductivity * E(t) * (1 - exp(-dt / tau))
+    for (const auto &c : conductingPoints) {
+        FieldVector *jField = c.point->getCurrentField(time);
+        FieldVector initJField = jField ? *jField : zeroVector; // point just started conducting
+
+        FieldVector result = (currentDecay * initJField) + (c.currentGain * *c.point->getElectricField(time));
+        c.point->setCurrentField(result, nextTime);
+    }
 }
 
-inline double FieldSolver::getNextTime() const { return currentTime + timeStep;}
+void FieldSolver::updateAbsorbingPoints() {
+    if (absorbingPointsRevision == pm->getAbsorbingLayerRevision())
+        return;
 
-void FieldSolver::calculateNextMagneticField(double time) {
-    FieldVector zeroVector = FieldVector(0, 0 ,0);
+    absorbingPoints.clear();
 
-    for(auto &p : *pm->getCollectionOfPoints()){
-        FieldVector k1 = calculateCurl(Field::ElectricField, p.first, time);
-        if(k1 != zeroVector)
-            k1 = -1.0 * k1;
+    for (const auto &p : *pm->getCollectionOfPoints()) {
+        if (pm->classifyAbsorbingLayerPoint(p.first) == Point::Normal)
+            continue;
 
-        FieldVector y1 = *p.second->getElectricField(time) + (k1 * (timeStep / 2));
+        // equal damping of E and B keeps the layer's impedance matched to the medium it borders
+        double waveSpeed = p.second->getMaterial().waveSpeed;
+        double dampingRate = waveSpeed * pm->calculateAbsorbingLayerAttenuation(p.first);
 
-        // set k1 and y1
-        p.second->setRk4K1(k1);
-        p.second->setRk4Y1(y1);
+        if (dampingRate > 0)
+            absorbingPoints.push_back(AbsorbingPoint{p.second, dampingRate});
     }
 
-    for(auto &p: *pm->getCollectionOfPoints()){
-        FieldVector k2 = calculateCurl(Field::RK4Y1, p.first);
-        if(k2 != zeroVector)
-            k2 = -1.0 * k2;
+    absorbingPointsRevision = pm->getAbsorbingLayerRevision();
+}
+
+void FieldSolver::updateConductingPoints() {
+    if (conductingPointsRevision == pm->getConductivityRevision())
+        return;
 
-        FieldVector y2 = *p.second->getElectricField(time) + (k2 * (timeStep / 2));
+    conductingPoints.clear();
 
-        // set k2 and y2
-        p.second->setRk4K2(k2);
-        p.second->setRk4Y2(y2);
+    for (const auto &p : *pm->getCollectionOfPoints()) {
+        if (p.second->getConductivity() != 0)
+            conductingPoints.push_back(ConductingPoint{p.second, 0.0});
     }
 
-    for(auto &p : *pm->getCollectionOfPoints()){
-        FieldVector k3 = calculateCurl(Field::RK4Y2, p.first);
-        if(k3 != zeroVector)
-            k3 = -1.0 * k3;
+    conductingPointsRevision = pm->getConductivityRevision();
+    currentCoefficientsTimeStep = 0.0; // new points need their coefficients
+}
+
+void FieldSolver::updateCurrentCoefficients() {
+    if (currentCoefficientsTimeStep == timeStep)
+        return;
 
-        FieldVector y3 = *p.second->getElectricField(time) + (k3 * timeStep);
+    currentDecay = std::exp(-timeStep / drudeScatteringTime);
 
-        // set k3 and y3
-        p.second->setRk4K3(k3);
-        p.second->setRk4Y3(y3);
-    }
+    // points made of the same material share one coefficient
+    std::map<double, double> gainByConductivity;
 
-    for(auto &p: *pm->getCollectionOfPoints()){
-        FieldVector k4 = calculateCurl(Field::RK4Y3, p.first);
-        if(k4 != zeroVector)
-            k4 = -1.0 * k4;
+    for (auto &c : conductingPoints) {
+        double conductivity = c.point->getConductivity();
+        auto gain = gainByConductivity.find(conductivity);
 
-        // set k4
-        p.second->setRk4K4(k4);
+        if (gain == gainByConductivity.end()) {
+            double currentGain = -conductivity * std::expm1(-timeStep / drudeScatteringTime); // sigma * (1 - decay)
+            gain = gainByConductivity.insert(std::make_pair(conductivity, currentGain)).first;
+        }
+
+        c.currentGain = gain->second;
     }
 
-    double nextTime = getNextTime();
+    currentCoefficientsTimeStep = timeStep;
+}
+
+void FieldSolver::setCurrentIntegrator(CurrentIntegrator integrator) { this->currentIntegrator = integrator; }
+
+void FieldSolver::setTimeIntegrator(LowStorageRungeKutta::Scheme scheme) {
+    this->integrator = LowStorageRungeKutta(scheme);
+    this->stableTimeStepRevision = std::numeric_limits<std::uint64_t>::max(); // stability region changed
+}
+
+double FieldSolver::calculateStableTimeStep(double safetyFactor) {
+    if (stableTimeStepRevision != pm->getConductivityRevision() || stableTimeStepScheme != pm->getDifferenceScheme()) {
+        double minPermittivity = std::numeric_limits<double>::max();
+        double maxPlasmaFrequencySquared = 0.0;
 
-    for(auto &p : *pm->getCollectionOfPoints()){
-        FieldVector weightedAvg = (timeStep / 6) * (p.second->getRk4K1() +
-                (2 * p.second->getRk4K2()) + (2 * p.second->getRk4K3()) + p.second->getRk4K4());
+        for (const auto &p : *pm->getCollectionOfPoints()) {
+            double permittivity = p.second->getPermittivity();
+            minPermittivity = std::min(minPermittivity, permittivity);
 
-        FieldVector result = *p.second->getMagneticField(time) + weightedAvg;
-        p.second->setMagneticField(result, nextTime);
+            // w_p^2 = c^2 * mu0 * conductivity / (permittivity * tau)
+            double plasmaFrequencySquared = SPEED_OF_LIGHT_SQUARED * VACUUM_PERMEABILITY * p.second->getConductivity() /
+                    (permittivity * drudeScatteringTime);
+            maxPlasmaFrequencySquared = std::max(maxPlasmaFrequencySquared, plasmaFrequencySquared);
+        }
+
+        double maxWaveSpeed = std::sqrt(SPEED_OF_LIGHT_SQUARED / minPermittivity);
+        double maxCurlEigenvalue = std::sqrt(3.0) * maxWaveSpeed / pm->getSpacingDelta();
+
+        // largest modified wavenumber times the spacing, (8 sin x - sin 2x) / 6 and 3 sin x / (2 + cos x) at their peaks
+        if (pm->getDifferenceScheme() == PointManager::FourthOrder)
+            maxCurlEigenvalue *= 1.3722;
+        else if (pm->getDifferenceScheme() == PointManager::CompactFourthOrder)
+            maxCurlEigenvalue *= std::sqrt(3.0);
+
+        stableTimeStep = integrator.getImaginaryStabilityLimit() / maxCurlEigenvalue;
+
+        if (maxPlasmaFrequencySquared > 0)
+            stableTimeStep = std::min(stableTimeStep, 2 / std::sqrt(maxPlasmaFrequencySquared));
+
+        stableTimeStepRevision = pm->getConductivityRevision();
+        stableTimeStepScheme = pm->getDifferenceScheme();
     }
+
+    return safetyFactor * stableTimeStep;
 }
 
-void FieldSolver::calculateNextElectricField(double time) {
-    double intermediateTimeStep = timeStep / 2;
-    double nextTime = getNextTime();
-    FieldVector zeroVector = FieldVector(0,0,0);
+void FieldSolver::setTimeStep(double timeStep) {
+    if (timeStep <= 0)
+        throw std::invalid_argument("Time step must be positive");
 
-    for(auto &p : *pm->getCollectionOfPoints()){
-//        if(p.second->getConductivity() > 0) // ignore points on the device
-//            p.second->setElectricField(zeroVector, nextTime);
+    this->timeStep = timeStep;
+}
 
-        double scalar = SPEED_OF_LIGHT_SQUARED / p.second->getPermittivity();
-        FieldVector initEField = *p.second->getElectricField(time);
+double FieldSolver::getTimeStep() const { return this->timeStep; }
 
-        FieldVector k1 = scalar * (calculateCurl(Field::MagneticField, p.first, time)
-                - VACUUM_PERMEABILITY * *p.second->getCurrentField(time));
+double FieldSolver::getCurrentTime() const { return this->currentTime; }
 
-        FieldVector y1 = initEField + (k1 * (intermediateTimeStep));
+void FieldSolver::enableAdaptiveTimeStepping(double relativeTolerance, double safetyFactor) {
+    if (relativeTolerance <= 0)
+        throw std::invalid_argument("Adaptive time stepping tolerance must be positive");
 
-        FieldVector k2 = scalar * y1;
-        FieldVector y2 = initEField + (k2 * intermediateTimeStep);
+    this->adaptiveTimeStepping = true;
+    this->relativeTolerance = relativeTolerance;
+    this->stabilitySafetyFactor = safetyFactor;
+}
 
-        FieldVector k3 = scalar * y2;
-        FieldVector y3 = initEField + (k3 * timeStep);
+void FieldSolver::disableAdaptiveTimeStepping() {
+    this->adaptiveTimeStepping = false;
+    this->fullStepFields.clear();
+    this->fullStepFields.shrink_to_fit();
+}
 
-        FieldVector k4 = scalar * y3;
+std::uint64_t FieldSolver::getRejectedStepCount() const { return this->rejectedStepCount; }
 
-        FieldVector result = initEField + ((timeStep / 6) * (k1 + (2 * k2) + (2 * k3) + k4));
-        p.second->setElectricField( result, nextTime);
-    }
+void FieldSolver::invalidateCurlDerivatives() {
+    for (double &curlTime : curlDerivativesTime)
+        curlTime = std::numeric_limits<double>::quiet_NaN(); // equal to no time
 }
 
-void FieldSolver::calculateNextCurrentField(double time){
-    double scalar = 1 / DRUDE_SCATTERING_TIME;
-    double intermediateTimeStep = timeStep / 2;
-    double nextTime = getNextTime();
-    FieldVector zeroVector= FieldVector(0, 0, 0);
+void FieldSolver::eraseFields(double time) {
+    for (auto &p : *pm->getCollectionOfPoints())
+        p.second->eraseFields(time);
 
-    for(auto &p : *pm->getCollectionOfPoints()){ // loop through all points and calculate k1 and y1
-        if(p.second->getConductivity() == 0) // ignore points not on the device
-            p.second->setCurrentField(zeroVector, nextTime);
+    for (const auto &ghost : pm->getGhosts())
+        ghost.point->eraseFields(time);
+}
 
-        FieldVector initJField = *p.second->getCurrentField(time);
+double FieldSolver::calculateStepDoubling() {
+    double nextTime = getNextTime(), midTime = currentTime + timeStep / 2;
 
-        FieldVector k1 = scalar * (*p.second->getElectricField(time) * (p.second->getConductivity()) - *p.second->getCurrentField(time));
-        FieldVector y1 = initJField + (k1 * intermediateTimeStep);
+    // the whole step first, kept aside while the two half steps overwrite the fields at the next time
+    calculateNextElectromagneticFields(currentTime, nextTime);
 
-        FieldVector k2 = scalar * y1;
-        FieldVector y2 = initJField + (k1 * (intermediateTimeStep));
+    fullStepFields.resize(2 * pm->getTotalNumberPoints());
+    std::size_t index = 0;
 
-        FieldVector k3 = scalar * y2;
-        FieldVector y3 = initJField + (k3 * timeStep);
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        fullStepFields[index++] = *p.second->getElectricField(nextTime);
+        fullStepFields[index++] = *p.second->getMagneticField(nextTime);
+    }
 
-        FieldVector k4 = scalar * y3;
+    eraseFields(nextTime);
+    calculateNextElectromagneticFields(currentTime, midTime);
+    calculateNextElectromagneticFields(midTime, nextTime);
+    eraseFields(midTime); // only the fields at the start and end of a step are kept
+
+    // the half steps' error is (U_half - U_full) / (2^p - 1), Richardson's estimate for a scheme of order p
+    double richardsonFactor = 1.0 / (std::pow(2.0, integrator.getOrder()) - 1);
+    double maxDifference[2] = {0.0, 0.0}, maxMagnitude[2] = {0.0, 0.0};
+    index = 0;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        Point *point = p.second;
+        const FieldVector *fields[2][2] = {{point->getElectricField(currentTime), point->getElectricField(nextTime)},
+                                           {point->getMagneticField(currentTime), point->getMagneticField(nextTime)}};
+
+        for (int field = 0; field < 2; field++) {
+            FieldVector difference = *fields[field][1] - fullStepFields[index++];
+            maxDifference[field] = std::max(maxDifference[field], calculateMaxComponent(difference));
+            maxMagnitude[field] = std::max(maxMagnitude[field], std::max(calculateMaxComponent(*fields[field][0]),
+                                                                         calculateMaxComponent(*fields[field][1])));
+        }
+    }
 
-        FieldVector result = initJField + ((timeStep / 6) * (k1 + (2 * k2) + (2 * k3) + k4));
-        p.second->setCurrentField(result, nextTime);
+    double error = 0.0;
+
+    for (int field = 0; field < 2; field++) {
+        if (maxDifference[field] > 0) // a field that is zero everywhere is exact
+            error = std::max(error, richardsonFactor * maxDifference[field] /
+                                    (relativeTolerance * maxMagnitude[field]));
     }
+
+    return error;
 }
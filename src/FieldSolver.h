@@ -1,23 +1,35 @@
 #ifndef _FIELDSOLVER_H
 #define _FIELDSOLVER_H
 
-#define SPEED_OF_LIGHT 3 *(int)1.0e8
-#define SPEED_OF_LIGHT_SQUARED std::pow(SPEED_OF_LIGHT, 2)
-#define VACUUM_PERMEABILITY (4 * M_PI) * 1.0e-7
 #define DRUDE_SCATTERING_TIME 0.25
+#define MAX_STEP_RETRIES 50 // rejections of a single adaptive step before calculateNextFields gives up
 
+#include "PhysicalConstants.h"
 #include "PointManager.h"
 #include "Coordinates.h"
 #include "FieldVector.h"
+#include "CheckpointWriter.h"
+#include "ProbeManager.h"
+#include "OutputScheduler.h"
+#include "LowStorageRungeKutta.h"
+#include "BinaryStream.h"
 
 #include <climits>
 #include <stdexcept>
 #include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
 
 
 class FieldSolver {
 public:
-    typedef enum{ElectricField, MagneticField, CurrentField, RK4Y1, RK4Y2, RK4Y3} Field;
+    typedef enum{ElectricField, MagneticField, CurrentField} Field;
+    typedef enum{RungeKutta4, Exponential} CurrentIntegrator;
 
     /**
      * Default constructor, sets all member variables to default values
@@ -34,7 +46,22 @@ public:
     FieldSolver(PointManager *pm, double timeStep, double drudeScatteringTime);
 
     /**
-     * Calculate the curl of a given field at a given point at a given time
+     * Construct a FieldSolver that resumes from a checkpoint.
+     * The PointManager must have been restored from the same stream first, see PointManager(std::istream &)
+     *
+     * @param pm PointManager restored from the checkpoint
+     * @param checkpoint Binary input stream positioned just after the PointManager's part of the checkpoint
+     */
+    FieldSolver(PointManager *pm, std::istream &checkpoint);
+
+    /**
+     * Calculate the curl of a given field at a given point at a given time, with the differences selected by
+     * PointManager::setDifferenceScheme. The compact differences couple the point to every point of the lines through
+     * it, so they are solved over the whole grid, once per field and time: the derivatives are kept for the calls at
+     * the same time until the solver or the PointManager changes the fields or the layout of the grid. Fields set on
+     * the points directly are not noticed.
+     * Points outside of the simulation are ghost points taking the field of the point they border, i.e. the field does
+     * not change across the boundary
      *
      * @param field The field to calculate the curl with ( del x field )
      * @param target Point to calculate the curl at
@@ -57,16 +84,314 @@ public:
      */
     double getNextTime() const;
 
+    /**
+     * Get the time of the most recently calculated fields
+     *
+     * @return Current time of the solver
+     */
+    double getCurrentTime() const;
+
+    /**
+     * Write a checkpoint every stepInterval calls of calculateNextFields.
+     * Checkpoints are written on a background thread and each one replaces the previous one at checkpointPath
+     *
+     * @param stepInterval Number of time steps between checkpoints, 0 disables checkpointing
+     * @param checkpointPath Path of the checkpoint file
+     */
+    void setCheckpointInterval(int stepInterval, const std::string &checkpointPath);
+
+    /**
+     * Serialize the grid, materials, fields at the current time and the solver parameters into a binary stream. The
+     * parameters include the current and time integrators and the adaptive time stepping settings, so a restored run
+     * continues exactly like the uninterrupted one
+     *
+     * @param outs Binary output stream to write the checkpoint to
+     */
+    void writeCheckpoint(std::ostream &outs);
+
+    /**
+     * Snapshot the current state in memory and write it to a checkpoint file on a background thread
+     *
+     * @param checkpointPath Path of the checkpoint file
+     */
+    void saveCheckpoint(const std::string &checkpointPath);
+
+    /**
+     * Block until the checkpoint currently being written, if any, is on disk
+     */
+    void waitForCheckpoint();
+
+    /**
+     * Attach a ProbeManager which samples its probes after every call of calculateNextFields
+     *
+     * @param probes ProbeManager to sample, nullptr detaches the current one. The FieldSolver does not take ownership
+     */
+    void attachProbeManager(ProbeManager *probes);
+
+    /**
+     * Attach an OutputScheduler which logs every field that is due after each call of calculateNextFields. The fields
+     * due at the current step are logged right away, so rules starting with step 0 include the initial fields
+     *
+     * @param scheduler OutputScheduler to update, nullptr detaches the current one. The FieldSolver does not take
+     * ownership
+     */
+    void attachOutputScheduler(OutputScheduler *scheduler);
+
+    /**
+     * Select the method used to advance the Drude current density,
+     * dJ/dt = (conductivity * E - J) / drudeScatteringTime. Exponential (the default) integrates the equation exactly
+     * with the electric field held constant over the step, so it stays stable for any time step. RungeKutta4 is
+     * limited to time steps of about 2.8 * drudeScatteringTime
+     *
+     * @param integrator Method used to advance the current density
+     */
+    void setCurrentIntegrator(CurrentIntegrator integrator);
+
+    /**
+     * Select the low storage Runge-Kutta scheme used to advance the electric and magnetic fields.
+     * Every scheme needs a single register per field and point, the default is the 4th order CarpenterKennedy4 scheme
+     *
+     * @param scheme Low storage Runge-Kutta scheme
+     */
+    void setTimeIntegrator(LowStorageRungeKutta::Scheme scheme);
+
+    /**
+     * Calculate the largest stable time step for the grid spacing, the materials and the selected time integrator.
+     * The fastest wave travels at c / sqrt(smallest permittivity) and the central difference curl has eigenvalues up to
+     * sqrt(3) * speed / spacingDelta, which have to stay inside the integrator's stability region. The fourth order
+     * differences resolve shorter waves, which raises the largest eigenvalue by 1.372 and the compact ones by
+     * sqrt(3). The explicit coupling between current and electric field also limits the step to
+     * 2 / (largest plasma frequency)
+     *
+     * @param safetyFactor Fraction of the stability limit to return
+     * @return Largest stable time step scaled by the safety factor
+     */
+    double calculateStableTimeStep(double safetyFactor = 0.9);
+
+    /**
+     * Set the time step of the next call of calculateNextFields
+     *
+     * @param timeStep Time step to take
+     */
+    void setTimeStep(double timeStep);
+
+    /**
+     * Get the time step of the next call of calculateNextFields
+     *
+     * @return Time step to take
+     */
+    double getTimeStep() const;
+
+    /**
+     * Adapt the time step during the run. The low storage schemes have no embedded pair, so every step is taken once
+     * whole and once in two halves, three times the work of a fixed step, and the local error of the halves follows
+     * from their difference by Richardson extrapolation. Steps with an error above the tolerance are repeated with a
+     * smaller step and the next step is grown or shrunk to meet the tolerance, never beyond the stable time step.
+     * calculateNextFields throws std::runtime_error when a step is still rejected after MAX_STEP_RETRIES retries, e.g.
+     * because the fields diverged or the tolerance is below the rounding error, leaving the fields, the time and the
+     * time step as they were before the step
+     *
+     * @param relativeTolerance Largest accepted error relative to the largest field magnitude on the grid
+     * @param safetyFactor Fraction of the stability limit the step may reach, see calculateStableTimeStep
+     */
+    void enableAdaptiveTimeStepping(double relativeTolerance, double safetyFactor = 0.9);
+
+    /**
+     * Go back to taking the fixed time step set with setTimeStep or the constructor
+     */
+    void disableAdaptiveTimeStepping();
+
+    /**
+     * Get the number of time steps that were rejected and repeated by the adaptive time stepping
+     *
+     * @return Number of rejected time steps
+     */
+    std::uint64_t getRejectedStepCount() const;
+
 private:
     PointManager *pm;
     double timeStep, currentTime, drudeScatteringTime;
     bool initEFieldCalculated;
+    std::uint64_t stepCount;
+    int checkpointInterval;
+    std::string checkpointPath;
+    CheckpointWriter checkpointWriter;
+    ProbeManager *probes;
+    OutputScheduler *scheduler;
+    LowStorageRungeKutta integrator;
 
-    void calculateNextMagneticField(double time);
+    /**
+     * A point with a non zero conductivity and the coefficient of its material in the exponential current update
+     */
+    struct ConductingPoint {
+        Point *point;
+        double currentGain; // conductivity * (1 - currentDecay)
+    };
 
-    void calculateNextElectricField(double time);
+    std::vector<ConductingPoint> conductingPoints;
+    std::uint64_t conductingPointsRevision;
+
+    /**
+     * A point inside an absorbing layer and the rate its electric and magnetic fields are damped with
+     */
+    struct AbsorbingPoint {
+        Point *point;
+        double dampingRate; // local wave speed * attenuation per unit length
+    };
+
+    std::vector<AbsorbingPoint> absorbingPoints;
+    std::uint64_t absorbingPointsRevision;
+    CurrentIntegrator currentIntegrator;
+    double currentDecay; // exp(-timeStep / drudeScatteringTime)
+    double currentCoefficientsTimeStep; // time step currentDecay was built for
+
+    bool adaptiveTimeStepping;
+    double relativeTolerance, stabilitySafetyFactor, stableTimeStep;
+    std::uint64_t stableTimeStepRevision, rejectedStepCount;
+    PointManager::DifferenceScheme stableTimeStepScheme; // difference scheme the stable time step was calculated for
+    std::vector<FieldVector> fullStepFields; // E and B of every point after a whole step, only kept when adapting
+
+    /**
+     * The simulated points along a line parallel to an axis, the compact differences couple their derivatives
+     */
+    struct DerivativeLine {
+        std::vector<std::size_t> stencils; // indices into PointManager::getStencils, in the order of the axis
+        bool periodic; // the last point of the line neighbors the first one
+    };
+
+    std::vector<DerivativeLine> derivativeLines[3]; // indexed by Axis, rebuilt when the layout revision changes
+    std::uint64_t derivativeLinesRevision; // layout revision of the PointManager the lines were built for
+    std::unordered_map<const Point *, std::size_t> stencilIndices; // of every simulated point, built with the lines
+    std::vector<FieldVector> curlDerivatives[2]; // compact derivatives of E and B by Field, for single point curls
+    double curlDerivativesTime[2]; // time curlDerivatives hold, NaN when they are stale
+    std::uint64_t curlDerivativesRevision[2]; // field revision of the PointManager curlDerivatives were taken at
+    std::vector<FieldVector> electricDerivatives, magneticDerivatives; // along each axis for every stencil
+
+    /**
+     * Set the members shared by all constructors to their defaults: no PointManager, time 0, the exponential current
+     * update, fixed time steps, nothing attached and every cached coefficient or derivative stale
+     */
+    void initializeState();
+
+    /**
+     * Advance the coupled electric and magnetic fields from a given time to a later time with the selected low
+     * storage Runge-Kutta scheme, holding the current at its value at the current time
+     *
+     * @param time Time of the fields to advance
+     * @param nextTime Time to advance the fields to
+     */
+    void calculateNextElectromagneticFields(double time, double nextTime);
+
+    /**
+     * Advance the electric and magnetic fields by the time step once as a whole and once in two halves, keeping the
+     * more accurate result of the halves, and estimate its local error by Richardson extrapolation
+     *
+     * @return Error relative to the tolerance, the step is accepted if it is at most 1
+     */
+    double calculateStepDoubling();
+
+    /**
+     * Mark the compact derivatives kept for calculateCurl as stale, whenever the fields they were taken of change
+     */
+    void invalidateCurlDerivatives();
+
+    /**
+     * Erase the fields of every point and ghost point at a given time
+     *
+     * @param time Time of the fields to erase
+     */
+    void eraseFields(double time);
 
     void calculateNextCurrentField(double time);
+
+    typedef FieldVector *(Point::*FieldAccessor)(double);
+
+    /**
+     * Calculate the derivative of a field along an axis with the stencil's gradient weights
+     *
+     * @param field Accessor of the field to differentiate
+     * @param stencil Stencil of the point
+     * @param axis Axis to differentiate along
+     * @param time Time of the field
+     * @return Derivative of every component of the field along the axis
+     */
+    FieldVector calculateDerivative(FieldAccessor field, const PointManager::Stencil &stencil, PointManager::Axis axis,
+                                    double time) const;
+
+    /**
+     * Assemble a curl from the derivatives of a field
+     *
+     * @param derivatives Derivatives of the field along the i, j and k axis
+     * @return Curl of the field
+     */
+    static FieldVector assembleCurl(const FieldVector derivatives[3]);
+
+    /**
+     * Collect the lines of points along every axis for the compact differences, unless they are collected already
+     * for the current layout of the PointManager
+     */
+    void updateDerivativeLines();
+
+    /**
+     * Calculate the derivatives along every axis at every point with the compact fourth order differences
+     * (d(x-h) + 4 d(x) + d(x+h)) / 4 = 3 (f(x+h) - f(x-h)) / 4h, solving a tridiagonal system per line. Bounded lines
+     * are closed at their end points by the second order differences through the ghosts
+     *
+     * @param value Function returning the value to differentiate at a point, a double or a FieldVector
+     * @param derivatives Receives the derivative along axis a of the stencil at index s at 3 * s + a
+     */
+    template <typename T, typename Value>
+    void calculateCompactDerivatives(Value value, std::vector<T> &derivatives);
+
+    /**
+     * Calculate the curl of a field at a point with central differences, weighted by the distances to the neighbors
+     * on a graded grid and reaching to the second neighbors with fourth order differences. Neighbors outside of the
+     * simulation are ghost points, so no neighbor is checked, the ghost fields must have been filled at the given time
+     *
+     * @param field Accessor of the field to calculate the curl with
+     * @param stencil Stencil of the point
+     * @param time Time to calculate the curl at
+     * @return Curl of the field at the point
+     */
+    FieldVector calculateCurl(FieldAccessor field, const PointManager::Stencil &stencil, double time) const;
+
+    /**
+     * dU = A * dU + step * L(U) for the electric and magnetic stage registers of a point, with the current held at its
+     * value at the current time
+     *
+     * @param p Point to update
+     * @param eCurl Curl of the electric field at the point
+     * @param bCurl Curl of the magnetic field at the point
+     * @param a Coefficient of the stage
+     * @param step Length of the step the stage belongs to
+     */
+    void calculateStageRegisters(Point *p, const FieldVector &eCurl, const FieldVector &bCurl, double a, double step);
+
+    /**
+     * Rebuild the list of points with a non zero conductivity if any conductivity changed since it was last built.
+     * Only these points carry a current, every other point's current is implicitly zero and never stored
+     */
+    void updateConductingPoints();
+
+    /**
+     * Rebuild the list of points inside the absorbing layers if any layer changed since it was last built
+     */
+    void updateAbsorbingPoints();
+
+    /**
+     * Precompute the exponential current update coefficients, shared per conductivity value, for the current time step
+     */
+    void updateCurrentCoefficients();
+
+    /**
+     * Advance the current density of all conducting points with the classical RK4 method
+     */
+    void calculateNextCurrentFieldRK4(double time);
+
+    /**
+     * Advance the current density of all conducting points with the exact exponential update
+     */
+    void calculateNextCurrentFieldExponential(double time);
 };
 
 #endif //QUANTUM_FOUNDRY_FIELDSOLVER_H
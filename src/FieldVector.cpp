@@ -1 +1,6 @@
 #include "FieldVector.h"
+
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<FieldVector>::value,
+              "FieldVector must stay trivially copyable so it can be copied and serialized as raw memory");
@@ -2,18 +2,53 @@
 #define QUANTUMFOUNDRY_FIELDVECTOR_H
 
 #include <ostream>
+#include <cmath>
+#include <algorithm>
+
+/**
+ * Class FieldVectorExpression is the base of every FieldVector arithmetic expression.
+ * Arithmetic on FieldVectors does not compute anything, it builds a small expression object that records the operands.
+ * The expression is evaluated component by component when it is assigned to a FieldVector, so a combination such as
+ * y + (h / 6) * (k1 + 2 * k2 + 2 * k3 + k4) compiles to three fused loops over its operands without any temporaries.
+ * Every operation is component wise, so an expression may safely be assigned to one of its own operands
+ */
+template <typename Expression>
+class FieldVectorExpression {
+public:
+    inline double getIComp() const { return static_cast<const Expression &>(*this).getIComp(); }
+
+    inline double getJComp() const { return static_cast<const Expression &>(*this).getJComp(); }
+
+    inline double getKComp() const { return static_cast<const Expression &>(*this).getKComp(); }
+};
+
+class FieldVector;
+
+/**
+ * Operands are held by reference when they are FieldVectors, which outlive the full expression, and by value when they
+ * are expressions, which are temporaries
+ */
+template <typename Expression>
+struct FieldVectorOperand {
+    typedef const Expression type;
+};
+
+template <>
+struct FieldVectorOperand<FieldVector> {
+    typedef const FieldVector &type;
+};
 
-//TODO extract all member functions to FieldVector.cpp but mark as inline for efficiency
 /**
  * Class FieldVector is responsible for holding the components of a vector for a given field (i.e electric, magnetic, current)
- * All of the member functions have been inlined to support faster execution time when accessing/setting components of the FieldVector
+ * All of the member functions have been inlined to support faster execution time when accessing/setting components of the FieldVector.
+ * FieldVector is trivially copyable, arithmetic is evaluated lazily through FieldVectorExpression
  */
-class FieldVector {
+class FieldVector : public FieldVectorExpression<FieldVector> {
 public:
     /**
      * Construct a default FieldVector, all vector components are set to 0
      */
-    FieldVector() : i(0.0), j(0.00), k(0.0) {}
+    FieldVector() : i(0.0), j(0.0), k(0.0) {}
 
     /**
      * Construct a FieldVector with given components
@@ -24,6 +59,42 @@ public:
      */
     FieldVector(double iComp, double jComp, double kComp) : i(iComp), j(jComp), k(kComp) {}
 
+    /**
+     * Construct a FieldVector by evaluating an arithmetic expression
+     *
+     * @param expression Expression to evaluate
+     */
+    template <typename Expression>
+    FieldVector(const FieldVectorExpression<Expression> &expression)
+            : i(expression.getIComp()), j(expression.getJComp()), k(expression.getKComp()) {}
+
+    /**
+     * Evaluate an arithmetic expression into the FieldVector
+     *
+     * @param expression Expression to evaluate
+     * @return Reference to the FieldVector
+     */
+    template <typename Expression>
+    FieldVector &operator=(const FieldVectorExpression<Expression> &expression) {
+        double iComp = expression.getIComp(), jComp = expression.getJComp(), kComp = expression.getKComp();
+
+        this->i = iComp;
+        this->j = jComp;
+        this->k = kComp;
+
+        return *this;
+    }
+
+    template <typename Expression>
+    FieldVector &operator+=(const FieldVectorExpression<Expression> &expression) {
+        return *this = *this + expression;
+    }
+
+    template <typename Expression>
+    FieldVector &operator-=(const FieldVectorExpression<Expression> &expression) {
+        return *this = *this - expression;
+    }
+
     /**
      * Get the I component of the FieldVector
      *
@@ -59,54 +130,118 @@ public:
         return outs;
     }
 
-    /**
-     * Overload the + operator, to easily support addition of Field Vectors
-     *
-     * @param lhs const reference to the FieldVector on the left hand side of the + operator
-     * @param rhs const reference to the FieldVector on the right hand side of the + operator
-     * @return FieldVector containing the results of the addition operation
-     */
-    friend FieldVector operator+(const FieldVector &lhs, const FieldVector &rhs) {
-        double iComp = lhs.i + rhs.i;
-        double jComp = lhs.j + rhs.j;
-        double kComp = lhs.k + rhs.k;
-
-        return FieldVector(iComp, jComp, kComp);
+    inline friend bool operator==(const FieldVector &lhs, const FieldVector &rhs){
+        return (lhs.i == rhs.i) && (lhs.j == rhs.j) && (lhs.k == rhs.k);
     }
 
-    inline friend FieldVector operator*(double scalar, const FieldVector &rhs) {
-        return FieldVector(scalar * rhs.i, scalar * rhs.j, scalar * rhs.k);
+    inline friend bool operator!=(const FieldVector &lhs, const FieldVector &rhs){
+        return !(lhs == rhs);
     }
 
-    inline friend FieldVector operator*(const FieldVector &lhs, double scalar){
-        return scalar * lhs;
-    }
+private:
+    double i, j, k;
+};
 
-    friend FieldVector operator-(const FieldVector &lhs, const FieldVector &rhs){
-        return lhs + (-1.0 * rhs);
-    }
+/**
+ * Expression node for the component wise sum of two expressions
+ */
+template <typename Lhs, typename Rhs>
+class FieldVectorSum : public FieldVectorExpression<FieldVectorSum<Lhs, Rhs> > {
+public:
+    FieldVectorSum(const Lhs &lhs, const Rhs &rhs) : lhs(lhs), rhs(rhs) {}
 
-    FieldVector& operator=(const FieldVector& rhs){
-        if(this == &rhs)
-            return *this;
+    inline double getIComp() const { return lhs.getIComp() + rhs.getIComp(); }
 
-        this->i = rhs.i;
-        this->j = rhs.j;
-        this->k = rhs.k;
+    inline double getJComp() const { return lhs.getJComp() + rhs.getJComp(); }
 
-        return *this;
-    }
+    inline double getKComp() const { return lhs.getKComp() + rhs.getKComp(); }
 
-    inline friend bool operator==(const FieldVector &lhs, const FieldVector &rhs){
-        return (lhs.i == rhs.i) && (lhs.j == rhs.j) && (lhs.k == rhs.k);
-    }
+private:
+    typename FieldVectorOperand<Lhs>::type lhs;
+    typename FieldVectorOperand<Rhs>::type rhs;
+};
 
-    inline friend bool operator!=(const FieldVector &lhs, const FieldVector &rhs){
-        return !(lhs == rhs);
-    }
+/**
+ * Expression node for the component wise difference of two expressions
+ */
+template <typename Lhs, typename Rhs>
+class FieldVectorDifference : public FieldVectorExpression<FieldVectorDifference<Lhs, Rhs> > {
+public:
+    FieldVectorDifference(const Lhs &lhs, const Rhs &rhs) : lhs(lhs), rhs(rhs) {}
+
+    inline double getIComp() const { return lhs.getIComp() - rhs.getIComp(); }
+
+    inline double getJComp() const { return lhs.getJComp() - rhs.getJComp(); }
+
+    inline double getKComp() const { return lhs.getKComp() - rhs.getKComp(); }
 
 private:
-    double i, j, k;
+    typename FieldVectorOperand<Lhs>::type lhs;
+    typename FieldVectorOperand<Rhs>::type rhs;
 };
 
+/**
+ * Expression node for an expression multiplied by a scalar
+ */
+template <typename Operand>
+class FieldVectorScaled : public FieldVectorExpression<FieldVectorScaled<Operand> > {
+public:
+    FieldVectorScaled(double scalar, const Operand &operand) : scalar(scalar), operand(operand) {}
+
+    inline double getIComp() const { return scalar * operand.getIComp(); }
+
+    inline double getJComp() const { return scalar * operand.getJComp(); }
+
+    inline double getKComp() const { return scalar * operand.getKComp(); }
+
+private:
+    double scalar;
+    typename FieldVectorOperand<Operand>::type operand;
+};
+
+/**
+ * Overload the + operator, to easily support addition of Field Vectors
+ *
+ * @param lhs const reference to the expression on the left hand side of the + operator
+ * @param rhs const reference to the expression on the right hand side of the + operator
+ * @return Expression evaluating to the sum of both sides
+ */
+template <typename Lhs, typename Rhs>
+inline FieldVectorSum<Lhs, Rhs> operator+(const FieldVectorExpression<Lhs> &lhs, const FieldVectorExpression<Rhs> &rhs) {
+    return FieldVectorSum<Lhs, Rhs>(static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+inline FieldVectorDifference<Lhs, Rhs> operator-(const FieldVectorExpression<Lhs> &lhs,
+                                                 const FieldVectorExpression<Rhs> &rhs) {
+    return FieldVectorDifference<Lhs, Rhs>(static_cast<const Lhs &>(lhs), static_cast<const Rhs &>(rhs));
+}
+
+template <typename Operand>
+inline FieldVectorScaled<Operand> operator-(const FieldVectorExpression<Operand> &operand) {
+    return FieldVectorScaled<Operand>(-1.0, static_cast<const Operand &>(operand));
+}
+
+template <typename Operand>
+inline FieldVectorScaled<Operand> operator*(double scalar, const FieldVectorExpression<Operand> &operand) {
+    return FieldVectorScaled<Operand>(scalar, static_cast<const Operand &>(operand));
+}
+
+template <typename Operand>
+inline FieldVectorScaled<Operand> operator*(const FieldVectorExpression<Operand> &operand, double scalar) {
+    return FieldVectorScaled<Operand>(scalar, static_cast<const Operand &>(operand));
+}
+
+/**
+ * Get the largest absolute component of a FieldVector or of an expression, the norm the solvers and tests compare
+ * fields by
+ *
+ * @param v Expression to measure, evaluated once per component
+ * @return Largest absolute component
+ */
+template <typename Expression>
+inline double calculateMaxComponent(const FieldVectorExpression<Expression> &v) {
+    return std::max(std::abs(v.getIComp()), std::max(std::abs(v.getJComp()), std::abs(v.getKComp())));
+}
+
 #endif //QUANTUMFOUNDRY_FIELDVECTOR_H
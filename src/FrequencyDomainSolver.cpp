@@ -0,0 +1,464 @@
+#include "FrequencyDomainSolver.h"
+
+FrequencyDomainSolver::FrequencyDomainSolver(PointManager *pm, double drudeScatteringTime) : grid(pm) {
+    for (int face = PointManager::IStartFace; face <= PointManager::KEndFace; face++)
+        if (pm->getAbsorbingLayerThickness((PointManager::Face) face) > 0)
+            throw std::invalid_argument("The frequency domain solver does not support absorbing layers");
+
+    this->pm = pm;
+    this->drudeScatteringTime = drudeScatteringTime;
+
+    for (int axis = 0; axis < 3; axis++) {
+        this->periodic[axis] = pm->isPeriodic((PointManager::Axis) axis);
+        this->sourceCurrent[axis].assign(grid.getTotalNumberPoints(), 0.0);
+    }
+
+    collectUnknowns();
+}
+
+std::ptrdiff_t FrequencyDomainSolver::getNextOffset(PointManager::Axis axis, int position) const {
+    std::ptrdiff_t stride = grid.getStride(axis);
+    int numPoints = grid.getNumPoints(axis);
+
+    if (position < numPoints - 1)
+        return stride;
+
+    return periodic[axis] ? -(numPoints - 1) * stride : 0;
+}
+
+std::ptrdiff_t FrequencyDomainSolver::getPrevOffset(PointManager::Axis axis, int position) const {
+    std::ptrdiff_t stride = grid.getStride(axis);
+    int numPoints = grid.getNumPoints(axis);
+
+    if (position > 0)
+        return stride;
+
+    return periodic[axis] ? -(numPoints - 1) * stride : 0;
+}
+
+void FrequencyDomainSolver::collectUnknowns() {
+    for (int axis = 0; axis < 3; axis++) {
+        edges[axis].clear();
+
+        for (int i = 0; i < grid.getNumPoints(PointManager::IAxis); i++) {
+            for (int j = 0; j < grid.getNumPoints(PointManager::JAxis); j++) {
+                for (int k = 0; k < grid.getNumPoints(PointManager::KAxis); k++) {
+                    const int position[] = {i, j, k};
+                    std::ptrdiff_t next = getNextOffset((PointManager::Axis) axis, position[axis]);
+
+                    if (next == 0) // no edge past the last point
+                        continue;
+
+                    Edge edge;
+                    bool tangential = false;
+
+                    // an edge on a bounded face is tangential to it and held at 0
+                    for (int other = 0; other < 3; other++) {
+                        edge.prevOffsets[other] = 0;
+
+                        if (other == axis)
+                            continue;
+
+                        edge.prevOffsets[other] = getPrevOffset((PointManager::Axis) other, position[other]);
+                        tangential = tangential || edge.prevOffsets[other] == 0 ||
+                                     getNextOffset((PointManager::Axis) other, position[other]) == 0;
+                    }
+
+                    if (tangential)
+                        continue;
+
+                    edge.index = grid.getIndex(i, j, k);
+
+                    double conductivityA = grid.getConductivity(edge.index);
+                    double conductivityB = grid.getConductivity(edge.index + next);
+
+                    edge.permittivity = (grid.getPermittivity(edge.index) + grid.getPermittivity(edge.index + next)) /
+                                        (2 * SPEED_OF_LIGHT_SQUARED);
+                    // an edge only conducts if both of its points do, the harmonic mean is zero otherwise
+                    edge.conductivity = conductivityA + conductivityB == 0 ? 0 :
+                                        2 * conductivityA * conductivityB / (conductivityA + conductivityB);
+
+                    edges[axis].push_back(edge);
+                }
+            }
+        }
+    }
+}
+
+void FrequencyDomainSolver::addSourceCurrent(const Coordinates &target, const FieldVector &amplitude) {
+    const int position[] = {pm->getAxisIndex(target.getI()), pm->getAxisIndex(target.getJ()),
+                            pm->getAxisIndex(target.getK())};
+    const double components[] = {amplitude.getIComp(), amplitude.getJComp(), amplitude.getKComp()};
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (position[axis] < 0 || position[axis] >= grid.getNumPoints((PointManager::Axis) axis))
+            throw std::invalid_argument("The source current lies outside of the grid");
+    }
+
+    std::size_t index = grid.getIndex(position[0], position[1], position[2]);
+
+    for (int axis = 0; axis < 3; axis++) {
+        std::ptrdiff_t next = getNextOffset((PointManager::Axis) axis, position[axis]);
+        std::ptrdiff_t prev = getPrevOffset((PointManager::Axis) axis, position[axis]);
+        int numEdges = (next != 0) + (prev != 0);
+
+        if (numEdges == 0)
+            continue;
+
+        // the edge after the point starts at it, the edge before it starts at the previous point
+        if (next != 0)
+            sourceCurrent[axis][index] += components[axis] / numEdges;
+
+        if (prev != 0)
+            sourceCurrent[axis][index - prev] += components[axis] / numEdges;
+    }
+}
+
+void FrequencyDomainSolver::clearSourceCurrents() {
+    for (auto &current : sourceCurrent)
+        std::fill(current.begin(), current.end(), 0.0);
+}
+
+FrequencyDomainSolver::Complex FrequencyDomainSolver::calculateMassCoefficient(int frequency, double edgePermittivity,
+                                                                               double edgeConductivity) const {
+    double w = frequencies[frequency];
+    Complex drudeConductivity = edgeConductivity / Complex(1.0, w * drudeScatteringTime);
+
+    return -w * w * edgePermittivity + Complex(0.0, w * VACUUM_PERMEABILITY) * drudeConductivity;
+}
+
+void FrequencyDomainSolver::calculateCurl(const std::vector<Complex> &input, std::vector<Complex> &output,
+                                          int numFrequencies, const std::vector<char> *active) const {
+    std::size_t totalNumPoints = grid.getTotalNumberPoints();
+    double inverseSpacing = 1.0 / grid.getSpacingDelta();
+    const Complex *eI = input.data();
+    const Complex *eJ = eI + totalNumPoints * numFrequencies;
+    const Complex *eK = eJ + totalNumPoints * numFrequencies;
+    Complex *fI = output.data();
+    Complex *fJ = fI + totalNumPoints * numFrequencies;
+    Complex *fK = fJ + totalNumPoints * numFrequencies;
+
+    // each face holds the curl of the four edges around it, like B in the magnetic update of YeeSolver
+    for (int i = 0; i < grid.getNumPoints(PointManager::IAxis); i++) {
+        std::ptrdiff_t nextI = getNextOffset(PointManager::IAxis, i) * numFrequencies;
+
+        for (int j = 0; j < grid.getNumPoints(PointManager::JAxis); j++) {
+            std::ptrdiff_t nextJ = getNextOffset(PointManager::JAxis, j) * numFrequencies;
+
+            for (int k = 0; k < grid.getNumPoints(PointManager::KAxis); k++) {
+                std::ptrdiff_t nextK = getNextOffset(PointManager::KAxis, k) * numFrequencies;
+                std::size_t base = grid.getIndex(i, j, k) * numFrequencies;
+
+                for (int s = 0; s < numFrequencies; s++) {
+                    if (active && !(*active)[s])
+                        continue;
+
+                    std::size_t n = base + s;
+
+                    if (nextJ && nextK)
+                        fI[n] = (eK[n + nextJ] - eK[n] - eJ[n + nextK] + eJ[n]) * inverseSpacing;
+
+                    if (nextI && nextK)
+                        fJ[n] = (eI[n + nextK] - eI[n] - eK[n + nextI] + eK[n]) * inverseSpacing;
+
+                    if (nextI && nextJ)
+                        fK[n] = (eJ[n + nextI] - eJ[n] - eI[n + nextJ] + eI[n]) * inverseSpacing;
+                }
+            }
+        }
+    }
+}
+
+void FrequencyDomainSolver::applyOperator(const std::vector<Complex> &input, std::vector<Complex> &output,
+                                          std::vector<Complex> &faces, const std::vector<char> &active) const {
+    int numFrequencies = (int) frequencies.size();
+    std::size_t totalNumPoints = grid.getTotalNumberPoints();
+    double inverseSpacing = 1.0 / grid.getSpacingDelta();
+    std::vector<Complex> massCoefficients(numFrequencies);
+
+    calculateCurl(input, faces, numFrequencies, &active);
+
+    for (int axis = 0; axis < 3; axis++) {
+        int first = (axis + 1) % 3, second = (axis + 2) % 3;
+        const Complex *fFirst = faces.data() + first * totalNumPoints * numFrequencies;
+        const Complex *fSecond = faces.data() + second * totalNumPoints * numFrequencies;
+
+        // (curl F)_axis = d F_second / d first - d F_first / d second, from the faces before and after the edge
+        for (const Edge &edge : edges[axis]) {
+            std::ptrdiff_t prevFirst = edge.prevOffsets[first] * numFrequencies;
+            std::ptrdiff_t prevSecond = edge.prevOffsets[second] * numFrequencies;
+
+            for (int s = 0; s < numFrequencies; s++) {
+                if (!active[s])
+                    continue;
+
+                std::size_t n = edge.index * numFrequencies + s;
+                std::size_t v = getVectorIndex(axis, edge.index, s);
+                Complex curl = (fSecond[n] - fSecond[n - prevFirst] - fFirst[n] + fFirst[n - prevSecond]) *
+                               inverseSpacing;
+
+                output[v] = curl + calculateMassCoefficient(s, edge.permittivity, edge.conductivity) * input[v];
+            }
+        }
+    }
+}
+
+bool FrequencyDomainSolver::solve(const std::vector<double> &angularFrequencies) {
+    for (double w : angularFrequencies)
+        if (!(w > 0))
+            throw std::invalid_argument("The angular frequencies must be positive");
+
+    this->frequencies = angularFrequencies;
+
+    int numFrequencies = (int) frequencies.size();
+    std::size_t size = 3 * grid.getTotalNumberPoints() * numFrequencies;
+    double diagonal = 4 / (grid.getSpacingDelta() * grid.getSpacingDelta()); // of the curl-curl at every edge
+
+    numIterations.assign(numFrequencies, 0);
+    residuals.assign(numFrequencies, 0.0);
+    solution.assign(size, Complex(0.0));
+
+    // BiCGStab right preconditioned by the diagonal, each frequency keeps its own scalars. The edges that are not
+    // solved for stay 0 in every vector, so the operator never reads anything else from them
+    std::vector<Complex> r(size), rHat(size), p(size), v(size), y(size), z(size), t(size), faces(size);
+    std::vector<Complex> rho(numFrequencies, 1.0), alpha(numFrequencies, 1.0), omega(numFrequencies, 1.0);
+    std::vector<Complex> dotA(numFrequencies), dotB(numFrequencies);
+    std::vector<double> rhsNorm(numFrequencies, 0.0), norm(numFrequencies);
+    std::vector<char> active(numFrequencies, 1);
+
+    // the right hand side -i * w * mu0 * Js is the starting residual of x = 0
+    for (int axis = 0; axis < 3; axis++) {
+        for (const Edge &edge : edges[axis]) {
+            for (int s = 0; s < numFrequencies; s++) {
+                std::size_t n = getVectorIndex(axis, edge.index, s);
+
+                r[n] = Complex(0.0, -frequencies[s] * VACUUM_PERMEABILITY) * sourceCurrent[axis][edge.index];
+                rHat[n] = r[n];
+                rhsNorm[s] += std::norm(r[n]);
+            }
+        }
+    }
+
+    int numActive = 0;
+
+    for (int s = 0; s < numFrequencies; s++) {
+        rhsNorm[s] = std::sqrt(rhsNorm[s]);
+        active[s] = rhsNorm[s] > 0; // without a source the solution is 0
+        numActive += active[s];
+    }
+
+    // visit every unknown of the active frequencies
+    auto forEachUnknown = [&](const std::function<void(std::size_t, int, const Edge &, int)> &visit) {
+        for (int axis = 0; axis < 3; axis++)
+            for (const Edge &edge : edges[axis])
+                for (int s = 0; s < numFrequencies; s++)
+                    if (active[s])
+                        visit(getVectorIndex(axis, edge.index, s), s, edge, axis);
+    };
+
+    // conj(a) . b for every active frequency
+    auto dot = [&](const std::vector<Complex> &a, const std::vector<Complex> &b, std::vector<Complex> &result) {
+        std::fill(result.begin(), result.end(), Complex(0.0));
+        forEachUnknown([&](std::size_t n, int s, const Edge &, int) { result[s] += std::conj(a[n]) * b[n]; });
+    };
+
+    auto precondition = [&](const std::vector<Complex> &input, std::vector<Complex> &output) {
+        forEachUnknown([&](std::size_t n, int s, const Edge &edge, int) {
+            output[n] = input[n] / (diagonal + calculateMassCoefficient(s, edge.permittivity, edge.conductivity));
+        });
+    };
+
+    // record the residual of the frequencies that converged or broke down and drop them from the batch
+    auto retire = [&](const std::vector<Complex> &residual, int iteration) {
+        std::fill(norm.begin(), norm.end(), 0.0);
+        forEachUnknown([&](std::size_t n, int s, const Edge &, int) { norm[s] += std::norm(residual[n]); });
+
+        for (int s = 0; s < numFrequencies; s++) {
+            if (!active[s])
+                continue;
+
+            residuals[s] = std::sqrt(norm[s]) / rhsNorm[s];
+            numIterations[s] = iteration;
+
+            if (residuals[s] < FREQUENCY_DOMAIN_TOLERANCE) {
+                active[s] = 0;
+                numActive--;
+            }
+        }
+    };
+
+    for (int iteration = 1; iteration <= FREQUENCY_DOMAIN_MAX_ITERATIONS && numActive > 0; iteration++) {
+        dot(rHat, r, dotA);
+
+        for (int s = 0; s < numFrequencies; s++) {
+            if (active[s] && dotA[s] == Complex(0.0)) { // breakdown, keep the last iterate
+                active[s] = 0;
+                numActive--;
+            }
+        }
+
+        forEachUnknown([&](std::size_t n, int s, const Edge &, int) {
+            Complex beta = (dotA[s] / rho[s]) * (alpha[s] / omega[s]);
+            p[n] = r[n] + beta * (p[n] - omega[s] * v[n]);
+        });
+
+        for (int s = 0; s < numFrequencies; s++)
+            rho[s] = dotA[s];
+
+        precondition(p, y);
+        applyOperator(y, v, faces, active);
+        dot(rHat, v, dotA);
+
+        for (int s = 0; s < numFrequencies; s++)
+            alpha[s] = active[s] ? rho[s] / dotA[s] : 0.0;
+
+        // r becomes the intermediate residual s of BiCGStab
+        forEachUnknown([&](std::size_t n, int s, const Edge &, int) {
+            solution[n] += alpha[s] * y[n];
+            r[n] -= alpha[s] * v[n];
+        });
+
+        retire(r, iteration);
+
+        precondition(r, z);
+        applyOperator(z, t, faces, active);
+        dot(t, r, dotA);
+        dot(t, t, dotB);
+
+        for (int s = 0; s < numFrequencies; s++)
+            omega[s] = active[s] ? dotA[s] / dotB[s] : 1.0;
+
+        forEachUnknown([&](std::size_t n, int s, const Edge &, int) {
+            solution[n] += omega[s] * z[n];
+            r[n] -= omega[s] * t[n];
+        });
+
+        retire(r, iteration);
+    }
+
+    return numActive == 0;
+}
+
+int FrequencyDomainSolver::getNumFrequencies() const {
+    return (int) frequencies.size();
+}
+
+double FrequencyDomainSolver::getAngularFrequency(int frequency) const {
+    return frequencies.at(frequency);
+}
+
+int FrequencyDomainSolver::getNumIterations(int frequency) const {
+    return numIterations.at(frequency);
+}
+
+double FrequencyDomainSolver::getRelativeResidual(int frequency) const {
+    return residuals.at(frequency);
+}
+
+FrequencyDomainSolver::Complex FrequencyDomainSolver::getElectricField(int frequency, PointManager::Axis axis,
+                                                                       std::size_t index) const {
+    if (frequency < 0 || frequency >= getNumFrequencies() || index >= grid.getTotalNumberPoints())
+        throw std::invalid_argument("No such edge or frequency");
+
+    return solution[getVectorIndex(axis, index, frequency)];
+}
+
+const FieldGrid &FrequencyDomainSolver::getGrid() const {
+    return grid;
+}
+
+double FrequencyDomainSolver::averageAroundPoint(const Complex *values, const int position[3], int offsets,
+                                                 Complex phase) const {
+    int numPoints[] = {grid.getNumPoints(PointManager::IAxis), grid.getNumPoints(PointManager::JAxis),
+                       grid.getNumPoints(PointManager::KAxis)};
+    Complex sum = 0.0;
+    int count = 0;
+
+    // visit the 1, 2 or 4 staggered locations surrounding the point
+    for (int corner = 0; corner < 8; corner++) {
+        if (corner & ~offsets)
+            continue;
+
+        int index[3];
+        bool exists = true;
+
+        for (int axis = 0; axis < 3; axis++) {
+            index[axis] = position[axis] - ((corner >> axis) & 1);
+
+            if (periodic[axis]) { // the location before the first point is the one after the last point
+                index[axis] = (index[axis] + numPoints[axis]) % numPoints[axis];
+                continue;
+            }
+
+            // staggered along this axis: valid locations lie between the first and the last point
+            int lastIndex = (offsets >> axis) & 1 ? numPoints[axis] - 2 : numPoints[axis] - 1;
+            exists = exists && index[axis] >= 0 && index[axis] <= lastIndex;
+        }
+
+        if (exists) {
+            sum += values[grid.getIndex(index[0], index[1], index[2])];
+            count++;
+        }
+    }
+
+    return count == 0 ? 0.0 : std::real(sum * phase) / count;
+}
+
+void FrequencyDomainSolver::exportFieldsToPointManager(int frequency, double time) {
+    if (frequency < 0 || frequency >= getNumFrequencies())
+        throw std::invalid_argument("No such frequency");
+
+    std::size_t totalNumPoints = grid.getTotalNumberPoints();
+    double w = frequencies[frequency];
+    Complex phase = std::polar(1.0, w * time);
+    Complex drudeFactor = 1.0 / Complex(1.0, w * drudeScatteringTime);
+    std::vector<Complex> eField(3 * totalNumPoints, 0.0), bField(3 * totalNumPoints, 0.0);
+    std::vector<Complex> current(3 * totalNumPoints, 0.0);
+
+    for (int axis = 0; axis < 3; axis++) {
+        for (const Edge &edge : edges[axis]) {
+            Complex e = solution[getVectorIndex(axis, edge.index, frequency)];
+
+            eField[axis * totalNumPoints + edge.index] = e;
+            current[axis * totalNumPoints + edge.index] = edge.conductivity * drudeFactor * e;
+        }
+    }
+
+    // i * w * B = -curl E
+    calculateCurl(eField, bField, 1, nullptr);
+
+    for (Complex &b : bField)
+        b *= Complex(0.0, 1.0 / w);
+
+    for (int i = 0; i < grid.getNumPoints(PointManager::IAxis); i++) {
+        for (int j = 0; j < grid.getNumPoints(PointManager::JAxis); j++) {
+            for (int k = 0; k < grid.getNumPoints(PointManager::KAxis); k++) {
+                std::size_t index = grid.getIndex(i, j, k);
+                Point *p = grid.getPoint(index);
+                const int position[] = {i, j, k};
+
+                if (!p)
+                    continue;
+
+                p->eraseFields(time); // the fields of an earlier export at the same time
+
+                // E components sit half a spacing ahead along their own axis, B components along the other two
+                p->setElectricField(FieldVector(averageAroundPoint(&eField[0], position, 1, phase),
+                                                averageAroundPoint(&eField[totalNumPoints], position, 2, phase),
+                                                averageAroundPoint(&eField[2 * totalNumPoints], position, 4, phase)),
+                                    time);
+
+                p->setMagneticField(FieldVector(averageAroundPoint(&bField[0], position, 6, phase),
+                                                averageAroundPoint(&bField[totalNumPoints], position, 5, phase),
+                                                averageAroundPoint(&bField[2 * totalNumPoints], position, 3, phase)),
+                                    time);
+
+                if (grid.getConductivity(index) != 0)
+                    p->setCurrentField(FieldVector(averageAroundPoint(&current[0], position, 1, phase),
+                                                   averageAroundPoint(&current[totalNumPoints], position, 2, phase),
+                                                   averageAroundPoint(&current[2 * totalNumPoints], position, 4,
+                                                                      phase)), time);
+            }
+        }
+    }
+}
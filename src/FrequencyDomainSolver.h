@@ -0,0 +1,212 @@
+#ifndef _FREQUENCYDOMAINSOLVER_H
+#define _FREQUENCYDOMAINSOLVER_H
+
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+
+#include "FieldSolver.h"
+#include "FieldGrid.h"
+#include "PointManager.h"
+#include "Coordinates.h"
+
+#define FREQUENCY_DOMAIN_TOLERANCE 1.0e-10 // residual of a converged solution relative to its right hand side
+#define FREQUENCY_DOMAIN_MAX_ITERATIONS 20000
+
+/**
+ * Class FrequencyDomainSolver finds the steady state of the fields driven by a sinusoidal source current directly,
+ * instead of marching calculateNextFields until the transients die out. Every field is a phasor X with the physical
+ * field Re(X * exp(i * w * t)), so the equations of the time domain solvers become the curl-curl equation
+ *     curl curl E - w^2 * permittivity / c^2 * E + i * w * mu0 * conductivity / (1 + i * w * drudeScatteringTime) * E
+ *         = -i * w * mu0 * Js
+ * with the Drude current J = conductivity / (1 + i * w * drudeScatteringTime) * E.
+ * E lives on the edges of the staggered grid of YeeSolver, so the operator is the curl-curl the leapfrog applies and
+ * the tangential E on the faces of bounded axes is 0. The operator is applied without storing a matrix and solved with
+ * BiCGStab, preconditioned by its diagonal. Several frequencies are solved in one batched run: their unknowns are
+ * interleaved, so every sweep over the grid reads the materials once and applies the operator of all frequencies
+ */
+class FrequencyDomainSolver {
+public:
+    typedef std::complex<double> Complex;
+
+    /**
+     * Construct a new FrequencyDomainSolver object without sources
+     *
+     * @param pm PointManager that contains all points for the simulation
+     * @param drudeScatteringTime Drude scattering time constant
+     */
+    FrequencyDomainSolver(PointManager *pm, double drudeScatteringTime);
+
+    /**
+     * Add a sinusoidal source current density at a point, oscillating in phase at every frequency. Each component is
+     * shared by the edges along its axis the point ends, like the fields are averaged onto the points
+     *
+     * @param target Coordinates of the point
+     * @param amplitude Amplitude of the source current density
+     */
+    void addSourceCurrent(const Coordinates &target, const FieldVector &amplitude);
+
+    /**
+     * Remove all source currents
+     */
+    void clearSourceCurrents();
+
+    /**
+     * Solve the steady state at each of the given angular frequencies in a single batched run. Frequencies whose
+     * residual falls below FREQUENCY_DOMAIN_TOLERANCE drop out of the batch, the others stop after
+     * FREQUENCY_DOMAIN_MAX_ITERATIONS iterations
+     *
+     * @param angularFrequencies Positive angular frequencies, in radians per second
+     * @return true if every frequency converged
+     */
+    bool solve(const std::vector<double> &angularFrequencies);
+
+    /**
+     * Get the number of frequencies solved by the last call of solve
+     *
+     * @return Number of frequencies
+     */
+    int getNumFrequencies() const;
+
+    /**
+     * Get an angular frequency solved by the last call of solve
+     *
+     * @param frequency Index of the frequency in the batch
+     * @return Angular frequency
+     */
+    double getAngularFrequency(int frequency) const;
+
+    /**
+     * Get the number of BiCGStab iterations a frequency took
+     *
+     * @param frequency Index of the frequency in the batch
+     * @return Number of iterations
+     */
+    int getNumIterations(int frequency) const;
+
+    /**
+     * Get the residual of a frequency's solution relative to its right hand side
+     *
+     * @param frequency Index of the frequency in the batch
+     * @return Relative residual
+     */
+    double getRelativeResidual(int frequency) const;
+
+    /**
+     * Get the phasor of the electric field on an edge
+     *
+     * @param frequency Index of the frequency in the batch
+     * @param axis Axis of the edge
+     * @param index Index of the point the edge starts at in the arrays of the FieldGrid
+     * @return Phasor of E along the edge
+     */
+    Complex getElectricField(int frequency, PointManager::Axis axis, std::size_t index) const;
+
+    /**
+     * Store the fields of a frequency at a time of its period in the points of the PointManager, overwriting the
+     * fields stored at that time, so the PointManager loggers write the steady state. The staggered fields are averaged
+     * onto the points like YeeSolver::exportFieldsToPointManager, the current is only stored on conducting points
+     *
+     * @param frequency Index of the frequency in the batch
+     * @param time Time to evaluate Re(X * exp(i * w * t)) at
+     */
+    void exportFieldsToPointManager(int frequency, double time);
+
+    /**
+     * Get the grid holding the materials of the edges
+     *
+     * @return Reference to the solver's grid
+     */
+    const FieldGrid &getGrid() const;
+
+private:
+    PointManager *pm;
+    FieldGrid grid;
+    double drudeScatteringTime;
+    bool periodic[3];
+
+    /**
+     * An edge that is solved for, with the offsets to the faces before it along the other two axes
+     */
+    typedef struct {
+        std::size_t index; // grid index of the point the edge starts at
+        std::ptrdiff_t prevOffsets[3]; // indexed by Axis, 0 along the edge's own axis
+        double permittivity; // permittivity / c^2, averaged over the two points of the edge
+        double conductivity; // harmonic mean of the two points, like YeeSolver
+    } Edge;
+
+    std::vector<Edge> edges[3]; // indexed by the axis of the edges
+    std::vector<double> sourceCurrent[3]; // source current density on each edge, indexed by grid index
+    std::vector<double> frequencies;
+    std::vector<int> numIterations;
+    std::vector<double> residuals;
+    std::vector<Complex> solution; // interleaved, see getVectorIndex
+
+    /**
+     * Get the location of an edge's value in a batched vector. The frequencies of an edge are adjacent, followed by the
+     * next edge, and the edges along i come first, then j and k
+     *
+     * @param axis Axis of the edge
+     * @param index Grid index of the point the edge starts at
+     * @param frequency Index of the frequency in the batch
+     * @return Index into the batched vector
+     */
+    inline std::size_t getVectorIndex(int axis, std::size_t index, int frequency) const {
+        return ((std::size_t) axis * grid.getTotalNumberPoints() + index) * frequencies.size() + frequency;
+    }
+
+    std::ptrdiff_t getNextOffset(PointManager::Axis axis, int position) const;
+
+    std::ptrdiff_t getPrevOffset(PointManager::Axis axis, int position) const;
+
+    /**
+     * Collect the edges that are solved for and their materials, the tangential edges on the faces of bounded axes
+     * are left out
+     */
+    void collectUnknowns();
+
+    /**
+     * Take the curl of the fields on the edges onto the faces of the grid, like the magnetic update of YeeSolver
+     *
+     * @param input Vector of fields on the edges, interleaving numFrequencies frequencies like getVectorIndex
+     * @param output Receives the curl on the faces in the same layout, the faces past the last point are not written
+     * @param numFrequencies Number of interleaved frequencies
+     * @param active Frequencies to take the curl of, all if nullptr
+     */
+    void calculateCurl(const std::vector<Complex> &input, std::vector<Complex> &output, int numFrequencies,
+                       const std::vector<char> *active) const;
+
+    /**
+     * Apply the curl-curl operator of every active frequency in the batch to a batched vector. Only the unknown edges
+     * of output are written
+     *
+     * @param input Batched vector to apply the operator to, 0 on the edges that are not unknown
+     * @param output Receives the result
+     * @param faces Scratch space for the curl on the faces, the size of a batched vector
+     * @param active Frequencies of the batch that have not converged yet
+     */
+    void applyOperator(const std::vector<Complex> &input, std::vector<Complex> &output, std::vector<Complex> &faces,
+                       const std::vector<char> &active) const;
+
+    /**
+     * Get the coefficient of the mass term of an edge, -w^2 * permittivity / c^2 + i * w * mu0 * Drude conductivity
+     */
+    Complex calculateMassCoefficient(int frequency, double edgePermittivity, double edgeConductivity) const;
+
+    /**
+     * Average the phasors of a staggered component that exist around a point and evaluate them at a time
+     *
+     * @param values Phasors of the component of a single frequency, indexed by grid index
+     * @param position Indices of the point
+     * @param offsets Bit mask of the axes (1 = i, 2 = j, 4 = k) along which the component sits half a spacing ahead
+     * @param phase exp(i * w * t)
+     * @return Real field of the average at the time
+     */
+    double averageAroundPoint(const Complex *values, const int position[3], int offsets, Complex phase) const;
+};
+
+#endif //QUANTUMFOUNDRY_FREQUENCYDOMAINSOLVER_H
@@ -8,66 +8,95 @@ void InitialVoltageCalculator::calculateInitialVoltage() {
     calculateVoltageOverAllPoints();
 }
 
-//TODO test making this an IMF
-double InitialVoltageCalculator::calculateVoltage(const Coordinates &point) {
-    return (pointManager->getNextINeighbor(point)->getVoltage() +
-            pointManager->getPrevINeighbor(point)->getVoltage() +
-            pointManager->getNextJNeighbor(point)->getVoltage() +
-            pointManager->getPrevJNeighbor(point)->getVoltage() +
-            pointManager->getNextKNeighbor(point)->getVoltage() +
-            pointManager->getPrevKNeighbor(point)->getVoltage()) / 6;
+double InitialVoltageCalculator::calculateVoltage(const PointManager::Stencil &stencil) {
+    double neighborSum = 0.0, centerWeight = 0.0;
+
+    // the Laplacian vanishes, i.e. the weighted neighbors balance the point, the average of the six on an even grid
+    for (int axis = 0; axis < 3; axis++) {
+        const PointManager::AxisWeights &weights = pointManager->getAxisWeights(stencil, (PointManager::Axis) axis);
+
+        neighborSum += weights.laplacian[0] * stencil.neighbors[2 * axis]->getVoltage() +
+                       weights.laplacian[1] * stencil.neighbors[2 * axis + 1]->getVoltage();
+
+        if (stencil.farNeighbors[2 * axis]) // fourth order differences away from the bounded faces
+            neighborSum += weights.farLaplacian[0] * stencil.farNeighbors[2 * axis]->getVoltage() +
+                           weights.farLaplacian[1] * stencil.farNeighbors[2 * axis + 1]->getVoltage();
+
+        centerWeight += weights.laplacianCenter;
+    }
+
+    return -neighborSum / centerWeight;
 }
 
-//TODO test making this an IMF
-double InitialVoltageCalculator::calculateVoltageEdgeCase(const Coordinates &p) {
-    Point::Classification ptClassification = pointManager->getClassification(p);  // get the classification of the point
-
-    if (ptClassification == Point::Top) {
-        auto twinBottomPt = Coordinates(p.getI(), p.getJ(), pointManager->getStartBound()); // create PointTuple of the bottom twin point coordinates
-        double nextKVoltage = pointManager->getVoltage(
-                twinBottomPt);  // get the voltage of the corresponding twin point at the bottom of the cube
-
-        return (pointManager->getNextINeighbor(p)->getVoltage() +
-                pointManager->getPrevINeighbor(p)->getVoltage() +
-                pointManager->getNextJNeighbor(p)->getVoltage() +
-                pointManager->getPrevJNeighbor(p)->getVoltage() +
-                nextKVoltage +
-                pointManager->getPrevKNeighbor(p)->getVoltage()) / 6;
-
-    } else if (ptClassification == Point::Bottom) {
-        auto twinTopPt = Coordinates(p.getI(), p.getJ(), pointManager->getEndBound());  // create PointTuple of the top twin point coordinates
-        double prevKVoltage = pointManager->getVoltage(twinTopPt);  // get the voltage of the corresponding twin point at the top of the cube
-
-        return (pointManager->getNextINeighbor(p)->getVoltage() +
-                pointManager->getPrevINeighbor(p)->getVoltage() +
-                pointManager->getNextJNeighbor(p)->getVoltage() +
-                pointManager->getPrevJNeighbor(p)->getVoltage() +
-                pointManager->getNextKNeighbor(p)->getVoltage() +
-                prevKVoltage) / 6;
-    } else { // Side face, by default, voltage is 0 if the point does not exist
-        return this->calculateVoltage(p);
+double InitialVoltageCalculator::calculateCompactVoltage(const PointManager::Stencil &stencil,
+                                                         const EdgeNeighbors &edges) {
+    double faceSum = 0.0, edgeSum = 0.0;
+
+    for (int neighbor = 0; neighbor < 6; neighbor++)
+        faceSum += stencil.neighbors[neighbor]->getVoltage();
+
+    for (int neighbor = 0; neighbor < 12; neighbor++)
+        edgeSum += edges.neighbors[neighbor]->getVoltage();
+
+    return (2 * faceSum + edgeSum) / 24;
+}
+
+bool InitialVoltageCalculator::collectEdgeNeighbors(const PointManager::Stencil &stencil, EdgeNeighbors &edges) {
+    Coordinates center = stencil.point->getCoordinates();
+    double h = pointManager->getSpacingDelta();
+    int count = 0;
+
+    for (int first = 0; first < 3; first++) {
+        for (int second = first + 1; second < 3; second++) {
+            for (int corner = 0; corner < 4; corner++) {
+                double coordinates[] = {center.getI(), center.getJ(), center.getK()};
+                coordinates[first] += corner % 2 == 0 ? h : -h;
+                coordinates[second] += corner / 2 == 0 ? h : -h;
+
+                edges.neighbors[count] = pointManager->getPointerToPoint(
+                        Coordinates(coordinates[0], coordinates[1], coordinates[2]));
+
+                if (!edges.neighbors[count++])
+                    return false;
+            }
+        }
     }
+
+    return true;
 }
 
-//TODO test making this an IMF
 void InitialVoltageCalculator::calculateVoltageOverAllPoints(){
+    std::vector<PointManager::Stencil> stencils, compactStencils;
+    std::vector<EdgeNeighbors> compactEdges;
+    bool compact = pointManager->getDifferenceScheme() == PointManager::CompactFourthOrder;
+
+    // electrodes keep their voltage, so they are left out of the sweeps
+    for (const auto &stencil : pointManager->getStencils()) {
+        EdgeNeighbors edges;
+
+        if (stencil.point->getConductivity() > 0)
+            continue;
+
+        if (compact && collectEdgeNeighbors(stencil, edges)) {
+            compactStencils.push_back(stencil);
+            compactEdges.push_back(edges);
+        } else { // the edges of the cube keep the second order weights
+            stencils.push_back(stencil);
+        }
+    }
+
     int nonConvergedPts = 0;
     bool converged = false;
 
     while(!converged){
-        for(const auto &p : *pointManager->getCollectionOfPoints()){
-            auto pCoordinates = p.first;
+        pointManager->fillGhostVoltages(); // boundary conditions, from the voltages of the last sweep
 
-            if(this->pointManager->getConductivity(pCoordinates) > 0)  // point is an electrode, keep voltage the same
-                continue;
+        for(const auto &stencil : stencils)
+            updateVoltage(stencil.point, calculateVoltage(stencil), nonConvergedPts);
 
-            double voltage = pointManager->getClassification(pCoordinates) == Point::Normal ? calculateVoltage(pCoordinates) : calculateVoltageEdgeCase(pCoordinates);
-
-            if(!compareTo3DecimalPlaces(voltage, pointManager->getVoltage(pCoordinates))){  // voltages are not equal, set new voltage and increment counter
-                pointManager->setVoltage(pCoordinates, voltage);
-                nonConvergedPts++;
-            }
-        }
+        for (std::size_t index = 0; index < compactStencils.size(); index++)
+            updateVoltage(compactStencils[index].point, calculateCompactVoltage(compactStencils[index],
+                                                                                compactEdges[index]), nonConvergedPts);
 
         std::cout << nonConvergedPts << std::endl;
 
@@ -77,6 +106,13 @@ void InitialVoltageCalculator::calculateVoltageOverAllPoints(){
     }
 }
 
+void InitialVoltageCalculator::updateVoltage(Point *p, double voltage, int &nonConvergedPts) {
+    if(!compareTo3DecimalPlaces(voltage, p->getVoltage())){  // voltages are not equal, set new voltage and increment counter
+        p->setVoltage(voltage);
+        nonConvergedPts++;
+    }
+}
+
 double InitialVoltageCalculator::truncate(double d) {
     return (d > 0) ? std::floor(d) : std::ceil(d);
 }
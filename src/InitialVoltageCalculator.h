@@ -33,28 +33,56 @@ private:
     PointManager *pointManager;
 
     /**
-     * Calculate the voltage at a given point
+     * The twelve diagonal neighbors of a point, one point apart along two axes
+     */
+    typedef struct {
+        Point *neighbors[12];
+    } EdgeNeighbors;
+
+    /**
+     * Calculate the voltage at a given point from its six neighbors, weighted by their distances on a graded grid,
+     * and the second neighbors with fourth order differences.
+     * Points outside of the simulation are ghost points holding the boundary voltage
+     *
+     * @param stencil Stencil of the point to calculate the voltage at
+     * @return Calculated voltage at the given point
+     */
+    inline double calculateVoltage(const PointManager::Stencil &stencil);
+
+    /**
+     * Calculate the voltage at a given point with the compact fourth order Laplacian, which weighs the six neighbors
+     * twice as much as the twelve diagonal ones: (2 * faces + diagonals - 24 * V) / 6h^2 vanishes up to fourth order
+     * wherever the Laplacian does
      *
-     * @param p Reference to Coordinates object representing the coordinates of the point to calculate the voltage at
+     * @param stencil Stencil of the point to calculate the voltage at
+     * @param edges Diagonal neighbors of the point
      * @return Calculated voltage at the given point
      */
-    inline double calculateVoltage(const Coordinates &p);
+    inline double calculateCompactVoltage(const PointManager::Stencil &stencil, const EdgeNeighbors &edges);
+
+    /**
+     * Collect the diagonal neighbors of a point
+     *
+     * @param stencil Stencil of the point
+     * @param edges Receives the diagonal neighbors
+     * @return true if all of them exist, the ghost layer leaves out the diagonals beyond the edges of the cube
+     */
+    bool collectEdgeNeighbors(const PointManager::Stencil &stencil, EdgeNeighbors &edges);
 
     /**
-     * Calculate the voltage over all points
+     * Calculate the voltage over all points, filling the ghost layer before every sweep
      *
      */
     void calculateVoltageOverAllPoints();
 
     /**
-     * Calculate the voltage of a point if it is considered to be an edge case.
-     * A point is considered to be an edge case if it's Classification is not equal to Normal.
-     * Please see Point::Classification for all possibilities
+     * Set the voltage of a point and count it as not converged if it changed in the first 3 decimal places
      *
-     * @param p Const reference to the edge case point.
-     * @return Voltage of the edge case point
+     * @param p Point to update
+     * @param voltage New voltage of the point
+     * @param nonConvergedPts Counter of points that did not converge yet
      */
-    inline double calculateVoltageEdgeCase(const Coordinates &p);
+    inline void updateVoltage(Point *p, double voltage, int &nonConvergedPts);
 
     /**
      * Truncate a double, if it is less than 0 the ceiling of the double is returned,
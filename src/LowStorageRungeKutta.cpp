@@ -0,0 +1,78 @@
+#include "LowStorageRungeKutta.h"
+
+LowStorageRungeKutta::LowStorageRungeKutta(Scheme scheme) {
+    this->scheme = scheme;
+
+    switch (scheme) {
+        case Williamson3:
+            this->order = 3;
+            this->a = {0.0, -5.0 / 9.0, -153.0 / 128.0};
+            this->b = {1.0 / 3.0, 15.0 / 16.0, 8.0 / 15.0};
+            this->c = {0.0, 1.0 / 3.0, 3.0 / 4.0};
+            break;
+        case CarpenterKennedy4:
+            this->order = 4;
+            this->a = {0.0,
+                       -567301805773.0 / 1357537059087.0,
+                       -2404267990393.0 / 2016746695238.0,
+                       -3550918686646.0 / 2091501179385.0,
+                       -1275806237668.0 / 842570457699.0};
+            this->b = {1432997174477.0 / 9575080441274.0,
+                       5161836677717.0 / 13612068292357.0,
+                       1720146321549.0 / 2090206949498.0,
+                       3134564353537.0 / 4481467310338.0,
+                       2277821191437.0 / 14882151754819.0};
+            this->c = {0.0,
+                       1432997174477.0 / 9575080441274.0,
+                       2526269341429.0 / 6820363266361.0,
+                       2006345519317.0 / 3224310063776.0,
+                       2802321613138.0 / 2924317926251.0};
+            break;
+        default:
+            throw std::invalid_argument("Unknown low storage Runge-Kutta scheme");
+    }
+
+    this->imaginaryStabilityLimit = calculateImaginaryStabilityLimit();
+}
+
+LowStorageRungeKutta::Scheme LowStorageRungeKutta::getScheme() const { return this->scheme; }
+
+int LowStorageRungeKutta::getNumStages() const { return this->a.size(); }
+
+int LowStorageRungeKutta::getOrder() const { return this->order; }
+
+double LowStorageRungeKutta::getImaginaryStabilityLimit() const { return this->imaginaryStabilityLimit; }
+
+std::complex<double> LowStorageRungeKutta::calculateAmplificationFactor(std::complex<double> z) const {
+    std::complex<double> u = 1.0, du = 0.0;
+
+    for (int stage = 0; stage < getNumStages(); stage++) {
+        du = a[stage] * du + z * u;
+        u += b[stage] * du;
+    }
+
+    return u;
+}
+
+double LowStorageRungeKutta::calculateImaginaryStabilityLimit() const {
+    const double searchStep = 1.0e-3, tolerance = 1.0e-12;
+    double y = 0.0;
+
+    // coarse scan for the first unstable point, stop at 10 which is beyond any scheme offered here
+    while (y < 10.0 && std::abs(calculateAmplificationFactor(std::complex<double>(0.0, y + searchStep))) <= 1.0 + tolerance)
+        y += searchStep;
+
+    // refine the boundary by bisection
+    double stable = y, unstable = y + searchStep;
+
+    for (int n = 0; n < 40; n++) {
+        double mid = (stable + unstable) / 2;
+
+        if (std::abs(calculateAmplificationFactor(std::complex<double>(0.0, mid))) <= 1.0 + tolerance)
+            stable = mid;
+        else
+            unstable = mid;
+    }
+
+    return stable;
+}
@@ -0,0 +1,107 @@
+#ifndef _LOWSTORAGERUNGEKUTTA_H
+#define _LOWSTORAGERUNGEKUTTA_H
+
+#include <vector>
+#include <complex>
+#include <stdexcept>
+
+/**
+ * Class LowStorageRungeKutta holds the coefficients of a 2N-storage Runge-Kutta scheme in Williamson form.
+ * A step of dU/dt = L(U) only needs the solution U and a single register dU per unknown:
+ *
+ *     for each stage s:  dU = A[s] * dU + timeStep * L(U)
+ *                        U  = U + B[s] * dU
+ *
+ * where stage s evaluates L at time t + C[s] * timeStep
+ */
+class LowStorageRungeKutta {
+public:
+    typedef enum {
+        Williamson3, // 3 stage, 3rd order scheme of Williamson (1980)
+        CarpenterKennedy4 // 5 stage, 4th order scheme RK4(3)5[2N] of Carpenter and Kennedy (1994)
+    } Scheme;
+
+    /**
+     * Construct the coefficients of a given scheme
+     *
+     * @param scheme Low storage scheme to use
+     */
+    explicit LowStorageRungeKutta(Scheme scheme = CarpenterKennedy4);
+
+    /**
+     * Get the scheme the coefficients belong to
+     *
+     * @return Low storage scheme
+     */
+    Scheme getScheme() const;
+
+    /**
+     * Get the number of stages, i.e. evaluations of L, per time step
+     *
+     * @return Number of stages
+     */
+    int getNumStages() const;
+
+    /**
+     * Get the order of accuracy of the scheme
+     *
+     * @return Order of accuracy
+     */
+    int getOrder() const;
+
+    /**
+     * Get the coefficient scaling the register at the start of a stage
+     *
+     * @param stage Stage index, starting at 0
+     * @return A coefficient of the stage, always 0 for the first stage
+     */
+    inline double getA(int stage) const { return a[stage]; }
+
+    /**
+     * Get the coefficient scaling the register when it is added to the solution
+     *
+     * @param stage Stage index, starting at 0
+     * @return B coefficient of the stage
+     */
+    inline double getB(int stage) const { return b[stage]; }
+
+    /**
+     * Get the fraction of the time step at which a stage evaluates L
+     *
+     * @param stage Stage index, starting at 0
+     * @return C coefficient of the stage
+     */
+    inline double getC(int stage) const { return c[stage]; }
+
+    /**
+     * Get the largest y for which the scheme is stable on dU/dt = i * (y / timeStep) * U, i.e. how far its stability
+     * region reaches along the imaginary axis. Wave equations without losses have purely imaginary eigenvalues, so a
+     * time step is stable when timeStep * (largest eigenvalue magnitude) stays below this limit
+     *
+     * @return Extent of the stability region along the imaginary axis
+     */
+    double getImaginaryStabilityLimit() const;
+
+private:
+    Scheme scheme;
+    int order;
+    std::vector<double> a, b, c;
+    double imaginaryStabilityLimit;
+
+    /**
+     * Apply a single step of the scheme to dU/dt = z * U with U = 1 and timeStep = 1
+     *
+     * @param z Eigenvalue times time step
+     * @return Amplification factor of the scheme at z
+     */
+    std::complex<double> calculateAmplificationFactor(std::complex<double> z) const;
+
+    /**
+     * Search the imaginary axis for the point where the amplification factor first exceeds 1
+     *
+     * @return Extent of the stability region along the imaginary axis
+     */
+    double calculateImaginaryStabilityLimit() const;
+};
+
+#endif //QUANTUMFOUNDRY_LOWSTORAGERUNGEKUTTA_H
@@ -0,0 +1,93 @@
+#include "MaterialTable.h"
+#include "PhysicalConstants.h"
+
+const MaterialTable::Id MaterialTable::Vacuum;
+const MaterialTable::Id MaterialTable::GalliumArsenide;
+
+// the default materials are constant initialized, so points created during the static initialization of any other
+// translation unit already find them. The wave speed of gallium arsenide is sqrt(c^2 / 12) spelled out
+Material MaterialTable::materials[MAX_MATERIALS] = {
+        {1.0, 0.0, SPEED_OF_LIGHT_SQUARED, (double) SPEED_OF_LIGHT},
+        {12.0, 0.0, SPEED_OF_LIGHT_SQUARED / 12.0, 86602540.37844387}
+};
+std::size_t MaterialTable::numMaterials = 2;
+std::mutex MaterialTable::mutex;
+
+std::string *MaterialTable::getNames() {
+    static std::string names[MAX_MATERIALS] = {"vacuum", "gallium arsenide"};
+
+    return names;
+}
+
+void MaterialTable::setMaterial(Id id, double permittivity, double conductivity) {
+    if (!(permittivity > 0))
+        throw std::invalid_argument("The permittivity of a material must be positive");
+
+    materials[id].permittivity = permittivity;
+    materials[id].conductivity = conductivity;
+    materials[id].waveSpeedSquared = SPEED_OF_LIGHT_SQUARED / permittivity;
+    materials[id].waveSpeed = std::sqrt(materials[id].waveSpeedSquared);
+}
+
+MaterialTable::Id MaterialTable::addMaterial(const std::string &name, double permittivity, double conductivity) {
+    if (numMaterials == MAX_MATERIALS)
+        throw std::length_error("The material table is full");
+
+    auto id = (Id) numMaterials;
+    setMaterial(id, permittivity, conductivity);
+    getNames()[id] = name;
+    numMaterials++; // publish the material once it is complete
+
+    return id;
+}
+
+MaterialTable::Id MaterialTable::defineMaterial(const std::string &name, double permittivity, double conductivity) {
+    if (name.empty())
+        throw std::invalid_argument("A material needs a name");
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (std::size_t id = 0; id < numMaterials; id++) {
+        if (getNames()[id] != name)
+            continue;
+
+        if (materials[id].permittivity != permittivity || materials[id].conductivity != conductivity)
+            throw std::invalid_argument("Material " + name + " is already defined with other properties");
+
+        return (Id) id;
+    }
+
+    return addMaterial(name, permittivity, conductivity);
+}
+
+MaterialTable::Id MaterialTable::getMaterialId(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (std::size_t id = 0; id < numMaterials; id++)
+        if (getNames()[id] == name)
+            return (Id) id;
+
+    throw std::invalid_argument("No material named " + name);
+}
+
+MaterialTable::Id MaterialTable::findMaterial(double permittivity) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (std::size_t id = 0; id < numMaterials; id++)
+        if (materials[id].permittivity == permittivity)
+            return (Id) id;
+
+    return addMaterial("", permittivity, 0.0);
+}
+
+std::string MaterialTable::getMaterialName(Id id) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return getNames()[id];
+}
+
+std::size_t MaterialTable::getNumMaterials() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return numMaterials;
+}
@@ -0,0 +1,113 @@
+#ifndef _MATERIALTABLE_H
+#define _MATERIALTABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <string>
+#include <mutex>
+#include <stdexcept>
+
+#define MAX_MATERIALS 256 // a point stores its material as a single byte
+
+/**
+ * The properties of one material together with the update coefficients the solvers derive from them
+ */
+typedef struct {
+    double permittivity; // relative permittivity
+    double conductivity; // given to points when they are set to the material, each point then keeps its own
+    double waveSpeedSquared; // c^2 / permittivity
+    double waveSpeed; // sqrt(waveSpeedSquared)
+} Material;
+
+/**
+ * Class MaterialTable holds every material of the process, so a Point only keeps the byte sized ID of its material
+ * instead of its permittivity, and the solvers read the precomputed coefficients instead of recomputing them for every
+ * point. Vacuum and gallium arsenide are always defined, further materials are defined by name. Points given a
+ * permittivity directly share an unnamed material with every other point of the same permittivity. Conductivities are
+ * not interned, they vary from point to point, e.g. when imported, and are kept by the points themselves. IDs and the
+ * properties behind them never change once assigned, so the table is shared by all PointManagers
+ */
+class MaterialTable {
+public:
+    typedef std::uint8_t Id;
+
+    static const Id Vacuum = 0;
+    static const Id GalliumArsenide = 1;
+
+    /**
+     * Define a named material. Defining an existing name again with the same properties returns its ID, a material
+     * can not be redefined with different properties as points of every PointManager may already be made of it
+     *
+     * @param name Name of the material
+     * @param permittivity Relative permittivity of the material
+     * @param conductivity Conductivity given to points set to the material
+     * @return ID of the material
+     */
+    static Id defineMaterial(const std::string &name, double permittivity, double conductivity = 0.0);
+
+    /**
+     * Get the ID of a named material
+     *
+     * @param name Name of the material
+     * @return ID of the material
+     */
+    static Id getMaterialId(const std::string &name);
+
+    /**
+     * Get the ID of the first material with the given permittivity. An unnamed material is added if no material has
+     * it yet, so only the number of distinct permittivities is limited by the size of the table
+     *
+     * @param permittivity Relative permittivity
+     * @return ID of the material
+     */
+    static Id findMaterial(double permittivity);
+
+    /**
+     * Get the properties and coefficients of a material
+     *
+     * @param id ID of the material
+     * @return Reference to the material, valid for the lifetime of the process
+     */
+    static inline const Material &getMaterial(Id id) { return materials[id]; }
+
+    /**
+     * Get the name of a material
+     *
+     * @param id ID of the material
+     * @return Name of the material, empty for an unnamed material
+     */
+    static std::string getMaterialName(Id id);
+
+    /**
+     * Get the number of materials defined so far, named or not
+     *
+     * @return Number of materials
+     */
+    static std::size_t getNumMaterials();
+
+private:
+    static Material materials[MAX_MATERIALS]; // constant initialized with the default materials
+    static std::size_t numMaterials;
+    static std::mutex mutex; // guards adding materials, lookups of existing IDs need no lock
+
+    /**
+     * Get the names of the materials. They are constructed on first use, so a material can be defined during the
+     * static initialization of another translation unit
+     *
+     * @return Array of MAX_MATERIALS names
+     */
+    static std::string *getNames();
+
+    /**
+     * Store the properties of a material and derive its coefficients
+     */
+    static void setMaterial(Id id, double permittivity, double conductivity);
+
+    /**
+     * Take the next free ID, the caller holds the mutex
+     */
+    static Id addMaterial(const std::string &name, double permittivity, double conductivity);
+};
+
+#endif //QUANTUMFOUNDRY_MATERIALTABLE_H
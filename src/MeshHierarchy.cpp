@@ -0,0 +1,597 @@
+#include "MeshHierarchy.h"
+
+/**
+ * Set a field of a point at a given time, overwriting a previous value at that time
+ */
+static void setField(FieldVector *(Point::*getField)(double), void (Point::*setField)(FieldVector, double), Point *p,
+                     const FieldVector &value, double time) {
+    FieldVector *field = (p->*getField)(time);
+
+    if (field)
+        *field = value;
+    else
+        (p->*setField)(value, time);
+}
+
+/**
+ * Divide an index by the refinement ratio, rounding towards negative infinity for the ghosts before the cube
+ */
+static int divideByRatio(int index) {
+    return index >= 0 ? index / REFINEMENT_RATIO : -((REFINEMENT_RATIO - 1 - index) / REFINEMENT_RATIO);
+}
+
+MeshHierarchy::MeshHierarchy(PointManager *coarse, double timeStep, double drudeScatteringTime)
+        : coarseSolver(coarse, timeStep, drudeScatteringTime) {
+    if (coarse->isGraded())
+        throw std::invalid_argument("The coarse level needs evenly spaced points");
+
+    if (coarse->getDifferenceScheme() != PointManager::SecondOrder)
+        throw std::invalid_argument("The mesh hierarchy only supports second order differences");
+
+    for (int face = PointManager::IStartFace; face <= PointManager::KEndFace; face++)
+        if (coarse->getSymmetry((PointManager::Face) face) != PointManager::NoSymmetry)
+            throw std::invalid_argument("The mesh hierarchy does not support symmetry planes");
+
+    this->coarse = coarse;
+    this->timeStep = timeStep;
+    this->drudeScatteringTime = drudeScatteringTime;
+    this->numCoarse = coarse->getNumPointsPerAxis();
+    this->coarsePadding = coarse->getGhostWidth();
+    this->regridInterval = 0;
+    this->stepCount = 0;
+    std::fill(this->numBlocks, this->numBlocks + 3, (numCoarse + REFINEMENT_BLOCK_SIZE - 1) / REFINEMENT_BLOCK_SIZE);
+
+    std::size_t width = numCoarse + 2 * coarsePadding;
+    coarsePoints.assign(width * width * width, nullptr);
+
+    auto addCoarsePoint = [this](const Coordinates &coor, Point *p) {
+        int i = this->coarse->getAxisIndex(coor.getI());
+        int j = this->coarse->getAxisIndex(coor.getJ());
+        int k = this->coarse->getAxisIndex(coor.getK());
+        int low = -coarsePadding, high = numCoarse - 1 + coarsePadding;
+
+        if (i >= low && i <= high && j >= low && j <= high && k >= low && k <= high)
+            coarsePoints[getCoarseIndex(i, j, k)] = p;
+    };
+
+    for (const auto &p : *coarse->getCollectionOfPoints())
+        addCoarsePoint(p.first, p.second);
+
+    for (const auto &ghost : coarse->getGhosts())
+        addCoarsePoint(ghost.point->getCoordinates(), ghost.point);
+
+    regrid();
+}
+
+MeshHierarchy::~MeshHierarchy() {
+    for (auto &patch : patches)
+        deletePatch(patch);
+}
+
+Point *MeshHierarchy::getCoarsePoint(int i, int j, int k) const {
+    int low = -coarsePadding, high = numCoarse - 1 + coarsePadding;
+
+    if (i < low || i > high || j < low || j > high || k < low || k > high)
+        return nullptr;
+
+    return coarsePoints[getCoarseIndex(i, j, k)];
+}
+
+Point *MeshHierarchy::getPatchPoint(const Patch &patch, int i, int j, int k) const {
+    int index[] = {i - patch.lowIndex[0], j - patch.lowIndex[1], k - patch.lowIndex[2]};
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (index[axis] < 0 || index[axis] >= patch.numPoints[axis])
+            return nullptr;
+    }
+
+    return patch.points[((std::size_t) index[0] * patch.numPoints[1] + index[1]) * patch.numPoints[2] + index[2]];
+}
+
+Point *MeshHierarchy::findPatchPoint(const int fineIndex[3]) const {
+    std::size_t block = 0;
+
+    for (int axis = 0; axis < 3; axis++) {
+        int position = fineIndex[axis] < 0 ? -1 : fineIndex[axis] / (REFINEMENT_BLOCK_SIZE * REFINEMENT_RATIO);
+
+        if (position < 0 || position >= numBlocks[axis])
+            return nullptr;
+
+        block = block * numBlocks[axis] + position;
+    }
+
+    int patch = block < blockPatches.size() ? blockPatches[block] : -1;
+
+    return patch < 0 ? nullptr : getPatchPoint(patches[patch], fineIndex[0], fineIndex[1], fineIndex[2]);
+}
+
+void MeshHierarchy::getFineIndex(const Patch &patch, const Point *p, int fineIndex[3]) const {
+    Coordinates coor = p->getCoordinates();
+
+    fineIndex[0] = patch.pm->getAxisIndex(coor.getI());
+    fineIndex[1] = patch.pm->getAxisIndex(coor.getJ());
+    fineIndex[2] = patch.pm->getAxisIndex(coor.getK());
+}
+
+void MeshHierarchy::regrid() {
+    double time = getCurrentTime();
+    int blockWidth[] = {numBlocks[1] * numBlocks[2], numBlocks[2], 1};
+    std::vector<bool> refine((std::size_t) numBlocks[0] * numBlocks[1] * numBlocks[2], false);
+    double maxField = 0.0;
+
+    for (const auto &p : *coarse->getCollectionOfPoints()) {
+        FieldVector *eField = p.second->getElectricField(time);
+
+        if (eField)
+            maxField = std::max(maxField, calculateMaxComponent(*eField));
+    }
+
+    for (int i = 0; i < numCoarse; i++) {
+        for (int j = 0; j < numCoarse; j++) {
+            for (int k = 0; k < numCoarse; k++) {
+                Point *p = getCoarsePoint(i, j, k);
+
+                if (!p)
+                    continue;
+
+                bool flagged = p->getConductivity() != 0;
+                FieldVector *eField = p->getElectricField(time);
+
+                if (!flagged && eField && maxField > 0) { // compare with the next neighbor along every axis
+                    Point *neighbors[] = {getCoarsePoint(i + 1, j, k), getCoarsePoint(i, j + 1, k),
+                                          getCoarsePoint(i, j, k + 1)};
+
+                    for (Point *neighbor : neighbors) {
+                        FieldVector *neighborField = neighbor ? neighbor->getElectricField(time) : nullptr;
+
+                        if (neighborField && calculateMaxComponent(*neighborField - *eField) >
+                                             REFINEMENT_GRADIENT_FRACTION * maxField)
+                            flagged = true;
+                    }
+                }
+
+                if (!flagged)
+                    continue;
+
+                for (int di = -REFINEMENT_BUFFER; di <= REFINEMENT_BUFFER; di++) {
+                    for (int dj = -REFINEMENT_BUFFER; dj <= REFINEMENT_BUFFER; dj++) {
+                        for (int dk = -REFINEMENT_BUFFER; dk <= REFINEMENT_BUFFER; dk++) {
+                            int position[] = {i + di, j + dj, k + dk};
+                            std::size_t block = 0;
+
+                            for (int axis = 0; axis < 3; axis++) {
+                                position[axis] = std::min(std::max(position[axis], 0), numCoarse - 1);
+                                block += (std::size_t) (position[axis] / REFINEMENT_BLOCK_SIZE) * blockWidth[axis];
+                            }
+
+                            refine[block] = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // blocks that stay refined keep their patches, the coarse points of the others already hold the restricted fields
+    std::vector<Patch> refined;
+    blockPatches.assign(refine.size(), -1); // new patches start from the coarse level alone
+
+    for (auto &patch : patches) {
+        std::size_t block = 0;
+
+        for (int axis = 0; axis < 3; axis++)
+            block += (std::size_t) patch.block[axis] * blockWidth[axis];
+
+        if (refine[block]) {
+            refined.push_back(patch);
+            refine[block] = false; // already refined
+        } else {
+            deletePatch(patch);
+        }
+    }
+
+    for (int bi = 0; bi < numBlocks[0]; bi++) {
+        for (int bj = 0; bj < numBlocks[1]; bj++) {
+            for (int bk = 0; bk < numBlocks[2]; bk++) {
+                int block[] = {bi, bj, bk};
+
+                if (refine[(std::size_t) bi * blockWidth[0] + bj * blockWidth[1] + bk])
+                    refined.push_back(createPatch(block));
+            }
+        }
+    }
+
+    patches.swap(refined);
+
+    for (std::size_t patch = 0; patch < patches.size(); patch++) {
+        std::size_t block = 0;
+
+        for (int axis = 0; axis < 3; axis++)
+            block += (std::size_t) patches[patch].block[axis] * blockWidth[axis];
+
+        blockPatches[block] = (int) patch;
+    }
+}
+
+void MeshHierarchy::setRegridInterval(int stepInterval) {
+    if (stepInterval < 0)
+        throw std::invalid_argument("Regrid interval must not be negative");
+
+    this->regridInterval = stepInterval;
+}
+
+MeshHierarchy::Patch MeshHierarchy::createPatch(const int block[3]) {
+    Patch patch;
+    int firstCoarse[3];
+
+    for (int axis = 0; axis < 3; axis++) {
+        firstCoarse[axis] = block[axis] * REFINEMENT_BLOCK_SIZE;
+
+        // the fine points up to the first point of the next block, or up to the last point of the cube
+        int lastIndex = std::min((firstCoarse[axis] + REFINEMENT_BLOCK_SIZE) * REFINEMENT_RATIO - 1,
+                                 (numCoarse - 1) * REFINEMENT_RATIO);
+
+        patch.block[axis] = block[axis];
+        patch.lowIndex[axis] = firstCoarse[axis] * REFINEMENT_RATIO;
+        patch.numPoints[axis] = lastIndex - patch.lowIndex[axis] + 1;
+    }
+
+    Point *corner = getCoarsePoint(firstCoarse[0], firstCoarse[1], firstCoarse[2]);
+
+    if (!corner)
+        throw std::invalid_argument("The coarse level is missing the first point of a refined block");
+
+    patch.pm = new PointManager(coarse->getSpacingDelta() / REFINEMENT_RATIO, coarse->getStartBound(),
+                                coarse->getEndBound(), corner->getCoordinates(), patch.numPoints);
+    patch.pm->setExternalGhostFill(true);
+
+    for (int face = 0; face < 6; face++)
+        patch.pm->setAbsorbingLayerThickness((PointManager::Face) face,
+                                             coarse->getAbsorbingLayerThickness((PointManager::Face) face));
+
+    patch.points.assign((std::size_t) patch.numPoints[0] * patch.numPoints[1] * patch.numPoints[2], nullptr);
+    patch.startTime = getCurrentTime();
+
+    for (const auto &p : *patch.pm->getCollectionOfPoints()) {
+        int fineIndex[3];
+        getFineIndex(patch, p.second, fineIndex);
+
+        int index[3];
+        for (int axis = 0; axis < 3; axis++)
+            index[axis] = fineIndex[axis] - patch.lowIndex[axis];
+
+        patch.points[((std::size_t) index[0] * patch.numPoints[1] + index[1]) * patch.numPoints[2] + index[2]] = p.second;
+
+        // a fine point conducts if all coarse points around it do, with the lowest of their conductivities
+        Point *stencil[8];
+        double weights[8];
+        int count = getInterpolationStencil(fineIndex, stencil, weights);
+        double conductivity = count > 0 ? stencil[0]->getConductivity() : 0.0;
+
+        for (int n = 1; n < count; n++)
+            conductivity = std::abs(stencil[n]->getConductivity()) < std::abs(conductivity) ?
+                           stencil[n]->getConductivity() : conductivity;
+
+        if (conductivity != 0)
+            patch.pm->setConductivity(p.first, conductivity);
+
+        p.second->setVoltage(interpolateVoltage(fineIndex));
+
+        double time = patch.startTime;
+        setField(&Point::getElectricField, &Point::setElectricField, p.second,
+                 interpolateField(&Point::getElectricField, fineIndex, time, time, 0.0), 0);
+        setField(&Point::getMagneticField, &Point::setMagneticField, p.second,
+                 interpolateField(&Point::getMagneticField, fineIndex, time, time, 0.0), 0);
+
+        if (conductivity != 0)
+            p.second->setCurrentField(interpolateField(&Point::getCurrentField, fineIndex, time, time, 0.0), 0);
+    }
+
+    patch.solver = new FieldSolver(patch.pm, coarseSolver.getTimeStep() / REFINEMENT_RATIO, drudeScatteringTime);
+
+    fillPatchGhostVoltages(patch);
+    fillPatchGhostFields(patch, 0, patch.startTime, patch.startTime);
+
+    return patch;
+}
+
+void MeshHierarchy::deletePatch(Patch &patch) {
+    delete patch.solver;
+    delete patch.pm;
+
+    patch.solver = nullptr;
+    patch.pm = nullptr;
+}
+
+int MeshHierarchy::getInterpolationStencil(const int fineIndex[3], Point *points[8], double weights[8]) const {
+    int base[3];
+    double fraction[3];
+
+    for (int axis = 0; axis < 3; axis++) {
+        base[axis] = divideByRatio(fineIndex[axis]);
+        fraction[axis] = (fineIndex[axis] - base[axis] * REFINEMENT_RATIO) / (double) REFINEMENT_RATIO;
+    }
+
+    int count = 0;
+    double totalWeight = 0.0;
+
+    for (int corner = 0; corner < 8; corner++) {
+        int index[3];
+        double weight = 1.0;
+
+        for (int axis = 0; axis < 3; axis++) {
+            bool upper = (corner >> (2 - axis)) & 1;
+
+            index[axis] = base[axis] + upper;
+            weight *= upper ? fraction[axis] : 1 - fraction[axis];
+        }
+
+        Point *p = weight == 0 ? nullptr : getCoarsePoint(index[0], index[1], index[2]);
+
+        if (!p)
+            continue;
+
+        points[count] = p;
+        weights[count++] = weight;
+        totalWeight += weight;
+    }
+
+    for (int n = 0; n < count; n++)
+        weights[n] /= totalWeight;
+
+    return count;
+}
+
+double MeshHierarchy::interpolateVoltage(const int fineIndex[3]) const {
+    Point *stencil[8];
+    double weights[8];
+    int count = getInterpolationStencil(fineIndex, stencil, weights);
+    double voltage = 0.0;
+
+    for (int n = 0; n < count; n++)
+        voltage += weights[n] * stencil[n]->getVoltage();
+
+    return voltage;
+}
+
+FieldVector MeshHierarchy::interpolateField(FieldVector *(Point::*field)(double), const int fineIndex[3],
+                                            double startTime, double endTime, double weight) const {
+    Point *stencil[8];
+    double weights[8];
+    int count = getInterpolationStencil(fineIndex, stencil, weights);
+    FieldVector result(0, 0, 0);
+
+    for (int n = 0; n < count; n++) {
+        FieldVector *start = (stencil[n]->*field)(startTime);
+        FieldVector *end = (stencil[n]->*field)(endTime);
+
+        if (start)
+            result += ((1 - weight) * weights[n]) * *start;
+
+        if (end)
+            result += (weight * weights[n]) * *end;
+    }
+
+    return result;
+}
+
+void MeshHierarchy::fillPatchGhostVoltages(Patch &patch) {
+    for (const auto &ghost : patch.pm->getGhosts()) {
+        int fineIndex[3];
+        getFineIndex(patch, ghost.point, fineIndex);
+
+        Point *neighbor = findPatchPoint(fineIndex);
+        ghost.point->setVoltage(neighbor ? neighbor->getVoltage() : interpolateVoltage(fineIndex));
+    }
+}
+
+void MeshHierarchy::fillPatchGhostFields(Patch &patch, double patchTime, double startTime, double endTime) {
+    double weight = 0.0;
+
+    if (endTime > startTime)
+        weight = std::min(1.0, std::max(0.0, (patch.startTime + patchTime - startTime) / (endTime - startTime)));
+
+    for (const auto &ghost : patch.pm->getGhosts()) {
+        int fineIndex[3];
+        getFineIndex(patch, ghost.point, fineIndex);
+
+        setField(&Point::getElectricField, &Point::setElectricField, ghost.point,
+                 interpolateField(&Point::getElectricField, fineIndex, startTime, endTime, weight), patchTime);
+        setField(&Point::getMagneticField, &Point::setMagneticField, ghost.point,
+                 interpolateField(&Point::getMagneticField, fineIndex, startTime, endTime, weight), patchTime);
+    }
+}
+
+void MeshHierarchy::restrictVoltages(const Patch &patch) {
+    for (int i = divideByRatio(patch.lowIndex[0] + REFINEMENT_RATIO - 1);
+         i * REFINEMENT_RATIO < patch.lowIndex[0] + patch.numPoints[0]; i++) {
+        for (int j = divideByRatio(patch.lowIndex[1] + REFINEMENT_RATIO - 1);
+             j * REFINEMENT_RATIO < patch.lowIndex[1] + patch.numPoints[1]; j++) {
+            for (int k = divideByRatio(patch.lowIndex[2] + REFINEMENT_RATIO - 1);
+                 k * REFINEMENT_RATIO < patch.lowIndex[2] + patch.numPoints[2]; k++) {
+                Point *p = getCoarsePoint(i, j, k);
+
+                if (!p || p->getConductivity() > 0) // electrodes keep their voltage
+                    continue;
+
+                double voltage = 0.0, totalWeight = 0.0;
+
+                // full weighting, the fine points halfway to the coarse neighbors count half along each axis
+                for (int di = -1; di <= 1; di++) {
+                    for (int dj = -1; dj <= 1; dj++) {
+                        for (int dk = -1; dk <= 1; dk++) {
+                            Point *fine = getPatchPoint(patch, i * REFINEMENT_RATIO + di, j * REFINEMENT_RATIO + dj,
+                                                        k * REFINEMENT_RATIO + dk);
+
+                            if (!fine)
+                                continue;
+
+                            double weight = (di == 0 ? 2 : 1) * (dj == 0 ? 2 : 1) * (dk == 0 ? 2 : 1);
+                            voltage += weight * fine->getVoltage();
+                            totalWeight += weight;
+                        }
+                    }
+                }
+
+                p->setVoltage(voltage / totalWeight);
+            }
+        }
+    }
+}
+
+void MeshHierarchy::restrictFields(const Patch &patch, double patchTime, double time) {
+    for (int i = divideByRatio(patch.lowIndex[0] + REFINEMENT_RATIO - 1);
+         i * REFINEMENT_RATIO < patch.lowIndex[0] + patch.numPoints[0]; i++) {
+        for (int j = divideByRatio(patch.lowIndex[1] + REFINEMENT_RATIO - 1);
+             j * REFINEMENT_RATIO < patch.lowIndex[1] + patch.numPoints[1]; j++) {
+            for (int k = divideByRatio(patch.lowIndex[2] + REFINEMENT_RATIO - 1);
+                 k * REFINEMENT_RATIO < patch.lowIndex[2] + patch.numPoints[2]; k++) {
+                Point *p = getCoarsePoint(i, j, k);
+
+                if (!p)
+                    continue;
+
+                FieldVector eField(0, 0, 0), bField(0, 0, 0);
+                double totalWeight = 0.0;
+
+                // full weighting like restrictVoltages, so the coarse point holds the average over its volume
+                for (int di = -1; di <= 1; di++) {
+                    for (int dj = -1; dj <= 1; dj++) {
+                        for (int dk = -1; dk <= 1; dk++) {
+                            Point *fine = getPatchPoint(patch, i * REFINEMENT_RATIO + di, j * REFINEMENT_RATIO + dj,
+                                                        k * REFINEMENT_RATIO + dk);
+
+                            if (!fine)
+                                continue;
+
+                            double weight = (di == 0 ? 2 : 1) * (dj == 0 ? 2 : 1) * (dk == 0 ? 2 : 1);
+                            eField += weight * *fine->getElectricField(patchTime);
+                            bField += weight * *fine->getMagneticField(patchTime);
+                            totalWeight += weight;
+                        }
+                    }
+                }
+
+                setField(&Point::getElectricField, &Point::setElectricField, p, (1 / totalWeight) * eField, time);
+                setField(&Point::getMagneticField, &Point::setMagneticField, p, (1 / totalWeight) * bField, time);
+            }
+        }
+    }
+}
+
+void MeshHierarchy::calculateInitialVoltage() {
+    InitialVoltageCalculator coarseCalculator(coarse);
+    coarseCalculator.calculateInitialVoltage();
+    coarse->fillGhostVoltages();
+
+    // start from the coarse solution, the fine electrodes keep the voltages they were created with
+    for (auto &patch : patches) {
+        for (const auto &p : *patch.pm->getCollectionOfPoints()) {
+            if (p.second->getConductivity() > 0)
+                continue;
+
+            int fineIndex[3];
+            getFineIndex(patch, p.second, fineIndex);
+            p.second->setVoltage(interpolateVoltage(fineIndex));
+        }
+    }
+
+    for (int pass = 0; pass < REFINEMENT_VOLTAGE_PASSES; pass++) {
+        for (auto &patch : patches) {
+            fillPatchGhostVoltages(patch);
+
+            InitialVoltageCalculator patchCalculator(patch.pm);
+            patchCalculator.calculateInitialVoltage();
+        }
+    }
+
+    for (const auto &patch : patches)
+        restrictVoltages(patch);
+
+    coarse->fillGhostVoltages();
+}
+
+void MeshHierarchy::calculateAndSetInitialElectricField() {
+    double time = getCurrentTime();
+
+    coarseSolver.calculateAndSetInitialElectricField();
+
+    for (auto &patch : patches) {
+        fillPatchGhostVoltages(patch);
+        patch.solver->calculateAndSetInitialElectricField();
+        restrictFields(patch, patch.solver->getCurrentTime(), time);
+    }
+
+    coarse->fillGhostFields(time);
+
+    for (auto &patch : patches)
+        fillPatchGhostFields(patch, patch.solver->getCurrentTime(), time, time);
+}
+
+void MeshHierarchy::calculateNextFields() {
+    double startTime = getCurrentTime();
+
+    coarseSolver.calculateNextFields();
+
+    double endTime = getCurrentTime();
+
+    for (auto &patch : patches) {
+        // follow the coarse step, it may have been shortened by adaptive time stepping
+        patch.solver->setTimeStep((endTime - startTime) / REFINEMENT_RATIO);
+
+        for (int subStep = 0; subStep < REFINEMENT_RATIO; subStep++) {
+            double nextTime = patch.solver->getCurrentTime() + patch.solver->getTimeStep();
+
+            fillPatchGhostFields(patch, nextTime, startTime, endTime);
+            patch.solver->calculateNextFields();
+        }
+
+        restrictFields(patch, patch.solver->getCurrentTime(), endTime);
+    }
+
+    coarse->fillGhostFields(endTime); // the restricted points may be the sources of coarse ghosts
+
+    stepCount++;
+
+    if (regridInterval > 0 && stepCount % regridInterval == 0)
+        regrid();
+}
+
+double MeshHierarchy::calculateStableTimeStep(double safetyFactor) {
+    double stableTimeStep = coarseSolver.calculateStableTimeStep(safetyFactor);
+
+    for (auto &patch : patches)
+        stableTimeStep = std::min(stableTimeStep, REFINEMENT_RATIO * patch.solver->calculateStableTimeStep(safetyFactor));
+
+    return stableTimeStep;
+}
+
+void MeshHierarchy::setTimeStep(double timeStep) {
+    coarseSolver.setTimeStep(timeStep);
+
+    for (auto &patch : patches)
+        patch.solver->setTimeStep(timeStep / REFINEMENT_RATIO);
+
+    this->timeStep = timeStep;
+}
+
+double MeshHierarchy::getTimeStep() const { return coarseSolver.getTimeStep(); }
+
+double MeshHierarchy::getCurrentTime() const { return coarseSolver.getCurrentTime(); }
+
+FieldSolver &MeshHierarchy::getCoarseSolver() { return this->coarseSolver; }
+
+int MeshHierarchy::getNumPatches() const { return (int) patches.size(); }
+
+PointManager *MeshHierarchy::getPatch(int patch) { return patches.at(patch).pm; }
+
+double MeshHierarchy::getPatchStartTime(int patch) const { return patches.at(patch).startTime; }
+
+std::size_t MeshHierarchy::getTotalNumberPoints() const {
+    std::size_t total = coarse->getTotalNumberPoints();
+
+    for (const auto &patch : patches)
+        total += patch.pm->getTotalNumberPoints();
+
+    return total;
+}
@@ -0,0 +1,269 @@
+#ifndef _MESHHIERARCHY_H
+#define _MESHHIERARCHY_H
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+
+#include "PointManager.h"
+#include "FieldSolver.h"
+#include "InitialVoltageCalculator.h"
+#include "Coordinates.h"
+#include "FieldVector.h"
+
+#define REFINEMENT_RATIO 2 // spacing of the coarse level over the spacing of its patches
+#define REFINEMENT_BLOCK_SIZE 8 // coarse points along each axis of the block a patch refines
+#define REFINEMENT_GRADIENT_FRACTION 0.25 // refine where E changes by this fraction of its largest magnitude per point
+#define REFINEMENT_BUFFER 1 // coarse points around a flagged point whose blocks are refined as well
+#define REFINEMENT_VOLTAGE_PASSES 3 // sweeps over the patches, exchanging the voltages along their shared faces
+
+/**
+ * Class MeshHierarchy refines a PointManager with block structured patches of REFINEMENT_RATIO times finer spacing.
+ * The coarse cube is split into blocks of REFINEMENT_BLOCK_SIZE^3 points, and every block holding a conducting point or
+ * a steep electric field gets a patch, i.e. a box shaped PointManager covering the block at the fine spacing. The
+ * vacuum away from the devices stays at the coarse spacing.
+ * Each level runs its own InitialVoltageCalculator and FieldSolver. The fine levels take REFINEMENT_RATIO sub steps
+ * per coarse step, with their ghost layers interpolated from the coarse level in space and time, and afterwards the
+ * coarse points covered by a patch are replaced by the volume weighted average of the fine points around them
+ */
+class MeshHierarchy {
+public:
+    /**
+     * Construct the hierarchy over a coarse PointManager whose materials, voltages and boundary conditions are set up,
+     * and refine the blocks holding conducting points
+     *
+     * @param coarse PointManager of the coarse level
+     * @param timeStep Time step of the coarse level, the patches take REFINEMENT_RATIO steps of timeStep / REFINEMENT_RATIO
+     * @param drudeScatteringTime Drude scattering time constant
+     */
+    MeshHierarchy(PointManager *coarse, double timeStep, double drudeScatteringTime);
+
+    /**
+     * MeshHierarchy destructor, responsible for releasing the patches and their solvers. The coarse PointManager is
+     * left to its owner
+     */
+    ~MeshHierarchy();
+
+    /**
+     * Flag the coarse points that are conducting or lie at a steep electric field at the current time, then refine the
+     * blocks within REFINEMENT_BUFFER points of a flag and coarsen the others. Patches of blocks that stay refined keep
+     * their fields, new patches are interpolated from the coarse level
+     */
+    void regrid();
+
+    /**
+     * Regrid automatically every given number of coarse steps
+     *
+     * @param stepInterval Number of steps between regrids, 0 disables regridding
+     */
+    void setRegridInterval(int stepInterval);
+
+    /**
+     * Calculate the initial voltages on the coarse level, then on every patch starting from the interpolated coarse
+     * voltages, and restrict the patches back onto the coarse level. The ghosts of a patch take the voltages of the
+     * neighboring patch where there is one and the interpolated coarse voltages elsewhere, so the patches are swept
+     * REFINEMENT_VOLTAGE_PASSES times for the voltages to spread between them
+     */
+    void calculateInitialVoltage();
+
+    /**
+     * Calculate the initial electric field on every level from its voltages, see
+     * FieldSolver::calculateAndSetInitialElectricField
+     */
+    void calculateAndSetInitialElectricField();
+
+    /**
+     * Advance the coarse level by one time step and every patch by REFINEMENT_RATIO sub steps, then restrict the
+     * patches onto the coarse points they cover
+     */
+    void calculateNextFields();
+
+    /**
+     * Calculate the largest time step stable on the coarse level and, divided into sub steps, on every patch
+     *
+     * @param safetyFactor Fraction of the stability limit to return
+     * @return Largest stable coarse time step scaled by the safety factor
+     */
+    double calculateStableTimeStep(double safetyFactor = 0.9);
+
+    /**
+     * Set the coarse time step, the patches take REFINEMENT_RATIO steps of a fraction of it
+     *
+     * @param timeStep Time step of the coarse level
+     */
+    void setTimeStep(double timeStep);
+
+    double getTimeStep() const;
+
+    /**
+     * Get the time of the coarse level
+     *
+     * @return Current time of the coarse level
+     */
+    double getCurrentTime() const;
+
+    /**
+     * Get the solver of the coarse level, e.g. to attach probes or select integrators
+     *
+     * @return Reference to the coarse FieldSolver
+     */
+    FieldSolver &getCoarseSolver();
+
+    /**
+     * Get the number of refined blocks
+     *
+     * @return Number of patches
+     */
+    int getNumPatches() const;
+
+    /**
+     * Get the PointManager of a patch, e.g. to place device features at the fine spacing.
+     * Patches are renumbered by regrid
+     *
+     * @param patch Number of the patch
+     * @return PointManager holding the fine points of the patch
+     */
+    PointManager *getPatch(int patch);
+
+    /**
+     * Get the time of a patch's fields on the coarse level's clock. The fields of a patch are stored at the time of
+     * its own solver, which started at zero when the patch was created
+     *
+     * @param patch Number of the patch
+     * @return Offset to add to the times of the patch's fields
+     */
+    double getPatchStartTime(int patch) const;
+
+    /**
+     * Get the number of points on all levels, coarse points covered by a patch count as well
+     *
+     * @return Total number of points of the hierarchy
+     */
+    std::size_t getTotalNumberPoints() const;
+
+private:
+    /**
+     * A refined block and the solver advancing its points
+     */
+    struct Patch {
+        int block[3]; // position of the block along each axis
+        int lowIndex[3], numPoints[3]; // box of fine point indices along each axis
+        PointManager *pm;
+        FieldSolver *solver;
+        double startTime; // coarse time at which the patch was created, its solver's time 0
+        std::vector<Point *> points; // points of the box, the k index varying fastest
+    };
+
+    PointManager *coarse;
+    FieldSolver coarseSolver;
+    double timeStep, drudeScatteringTime;
+    int numCoarse, coarsePadding, numBlocks[3];
+    int regridInterval, stepCount;
+    std::vector<Point *> coarsePoints; // coarse points and ghosts, indexed like getCoarseIndex
+    std::vector<Patch> patches;
+    std::vector<int> blockPatches; // number of the patch refining each block, -1 if the block is not refined
+
+    /**
+     * Get the index of a coarse point, or a ghost within coarsePadding of the cube, in coarsePoints
+     */
+    inline std::size_t getCoarseIndex(int i, int j, int k) const {
+        std::size_t width = numCoarse + 2 * coarsePadding;
+
+        return ((std::size_t) (i + coarsePadding) * width + (j + coarsePadding)) * width + (k + coarsePadding);
+    }
+
+    /**
+     * Get a coarse point or ghost by its indices
+     *
+     * @return Pointer to the point, nullptr if there is none
+     */
+    Point *getCoarsePoint(int i, int j, int k) const;
+
+    /**
+     * Get a fine point of a patch by its fine indices
+     *
+     * @return Pointer to the point, nullptr if it lies outside of the patch
+     */
+    Point *getPatchPoint(const Patch &patch, int i, int j, int k) const;
+
+    /**
+     * Get the fine point of any patch at fine indices
+     *
+     * @return Pointer to the point, nullptr if no patch holds it
+     */
+    Point *findPatchPoint(const int fineIndex[3]) const;
+
+    /**
+     * Create the patch refining a block and interpolate its materials, voltages and fields from the coarse level
+     */
+    Patch createPatch(const int block[3]);
+
+    void deletePatch(Patch &patch);
+
+    /**
+     * Collect the coarse points around a fine point with their trilinear interpolation weights. Coarse points that do
+     * not exist are left out and the weights of the others are scaled to add up to 1
+     *
+     * @param fineIndex Fine indices of the point along each axis
+     * @param points Receives the coarse points with a non-zero weight
+     * @param weights Receives the weights of the coarse points
+     * @return Number of coarse points collected
+     */
+    int getInterpolationStencil(const int fineIndex[3], Point *points[8], double weights[8]) const;
+
+    /**
+     * Interpolate the voltage of the coarse level at a fine point, coarse points that do not exist are left out
+     *
+     * @param fineIndex Fine indices of the point along each axis
+     * @return Trilinear interpolation of the voltages around the point
+     */
+    double interpolateVoltage(const int fineIndex[3]) const;
+
+    /**
+     * Interpolate a field of the coarse level at a fine point, linearly in time between two coarse times
+     *
+     * @param field Accessor of the field to interpolate
+     * @param fineIndex Fine indices of the point along each axis
+     * @param startTime Coarse time before the point's time
+     * @param endTime Coarse time after the point's time
+     * @param weight Weight of the end time
+     * @return Trilinear interpolation of the field around the point, fields not calculated count as zero
+     */
+    FieldVector interpolateField(FieldVector *(Point::*field)(double), const int fineIndex[3], double startTime,
+                                 double endTime, double weight) const;
+
+    /**
+     * Get the fine indices of a point of a patch
+     */
+    void getFineIndex(const Patch &patch, const Point *p, int fineIndex[3]) const;
+
+    /**
+     * Fill the ghost voltages of a patch from the neighboring patches, or from the coarse voltages where there is none
+     */
+    void fillPatchGhostVoltages(Patch &patch);
+
+    /**
+     * Fill the ghost fields of a patch at a time of its solver from the coarse fields at the start and end of the
+     * coarse step
+     */
+    void fillPatchGhostFields(Patch &patch, double patchTime, double startTime, double endTime);
+
+    /**
+     * Replace the voltages of the non conducting coarse points covered by a patch by the average of the fine voltages
+     */
+    void restrictVoltages(const Patch &patch);
+
+    /**
+     * Replace the electric and magnetic fields of the coarse points covered by a patch by the average of the fine
+     * fields around them
+     *
+     * @param patch Patch to restrict
+     * @param patchTime Time of the fine fields on the patch's clock
+     * @param time Time of the coarse fields to replace
+     */
+    void restrictFields(const Patch &patch, double patchTime, double time);
+};
+
+#endif //QUANTUMFOUNDRY_MESHHIERARCHY_H
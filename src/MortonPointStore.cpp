@@ -0,0 +1,127 @@
+#include "MortonPointStore.h"
+
+namespace {
+    const std::uint64_t axisMask = 0x1249249249249249ULL; // every third bit, the bits of the i index
+
+    /**
+     * Gather every third bit of a value back into its lowest MORTON_BITS_PER_AXIS bits
+     */
+    inline std::uint32_t compactBits(std::uint64_t value) {
+        value &= axisMask;
+        value = (value ^ (value >> 2)) & 0x10C30C30C30C30C3ULL;
+        value = (value ^ (value >> 4)) & 0x100F00F00F00F00FULL;
+        value = (value ^ (value >> 8)) & 0x1F0000FF0000FFULL;
+        value = (value ^ (value >> 16)) & 0x1F00000000FFFFULL;
+        value = (value ^ (value >> 32)) & 0x1FFFFFULL;
+
+        return (std::uint32_t) value;
+    }
+}
+
+MortonPointStore::MortonPointStore(PointManager *pm) {
+    const std::uint32_t maxIndex = (1U << MORTON_BITS_PER_AXIS) - 1;
+
+    entries.reserve(pm->getCollectionOfPoints()->size());
+
+    for (const auto &p : *pm->getCollectionOfPoints()) {
+        int i = pm->getAxisIndex(PointManager::IAxis, p.first.getI());
+        int j = pm->getAxisIndex(PointManager::JAxis, p.first.getJ());
+        int k = pm->getAxisIndex(PointManager::KAxis, p.first.getK());
+
+        if (i < 0 || j < 0 || k < 0 || (std::uint32_t) i > maxIndex || (std::uint32_t) j > maxIndex ||
+            (std::uint32_t) k > maxIndex)
+            throw std::invalid_argument("The lattice is too large for Morton keys");
+
+        entries.push_back(Entry{encode(i, j, k), p.second});
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.key < b.key; });
+
+    buildSlots();
+}
+
+void MortonPointStore::buildSlots() {
+    this->slotBits = 1;
+
+    while ((double) entries.size() > MORTON_MAX_LOAD_FACTOR * (1ULL << slotBits))
+        slotBits++;
+
+    slots.assign((std::size_t) 1 << slotBits, 0);
+    std::size_t mask = slots.size() - 1;
+
+    for (std::size_t position = 0; position < entries.size(); position++) {
+        std::size_t slot = getSlot(entries[position].key);
+
+        while (slots[slot] != 0) // linear probing
+            slot = (slot + 1) & mask;
+
+        slots[slot] = (std::uint32_t) position + 1;
+    }
+}
+
+std::uint64_t MortonPointStore::encode(std::uint32_t i, std::uint32_t j, std::uint32_t k) {
+    return CoordinateHasher::interleave(i, j, k);
+}
+
+void MortonPointStore::decode(std::uint64_t key, std::uint32_t &i, std::uint32_t &j, std::uint32_t &k) {
+    i = compactBits(key);
+    j = compactBits(key >> 1);
+    k = compactBits(key >> 2);
+}
+
+bool MortonPointStore::getNeighborKey(std::uint64_t key, PointManager::Neighbor direction,
+                                      std::uint64_t &neighborKey) {
+    std::uint64_t mask = axisMask << (direction / 2); // NextI and PrevI move along i, NextJ and PrevJ along j, ...
+    std::uint64_t axisBits = key & mask;
+    bool next = direction % 2 == 0;
+
+    if (next ? axisBits == mask : axisBits == 0) // past the largest or below the smallest index
+        return false;
+
+    // filling the bits of the other axes with ones carries an increment straight across them
+    axisBits = next ? ((key | ~mask) + 1) & mask : (axisBits - 1) & mask;
+    neighborKey = (key & ~mask) | axisBits;
+
+    return true;
+}
+
+Point *MortonPointStore::find(int i, int j, int k) const {
+    const std::uint32_t maxIndex = (1U << MORTON_BITS_PER_AXIS) - 1;
+
+    if (i < 0 || j < 0 || k < 0 || (std::uint32_t) i > maxIndex || (std::uint32_t) j > maxIndex ||
+        (std::uint32_t) k > maxIndex)
+        return nullptr;
+
+    return find(encode(i, j, k));
+}
+
+Point *MortonPointStore::find(std::uint64_t key) const {
+    std::size_t mask = slots.size() - 1;
+
+    for (std::size_t slot = getSlot(key); slots[slot] != 0; slot = (slot + 1) & mask) {
+        const Entry &entry = entries[slots[slot] - 1];
+
+        if (entry.key == key)
+            return entry.point;
+    }
+
+    return nullptr;
+}
+
+Point *MortonPointStore::findNeighbor(std::uint64_t key, PointManager::Neighbor direction) const {
+    std::uint64_t neighborKey;
+
+    return getNeighborKey(key, direction, neighborKey) ? find(neighborKey) : nullptr;
+}
+
+std::size_t MortonPointStore::size() const {
+    return entries.size();
+}
+
+MortonPointStore::const_iterator MortonPointStore::begin() const {
+    return entries.begin();
+}
+
+MortonPointStore::const_iterator MortonPointStore::end() const {
+    return entries.end();
+}
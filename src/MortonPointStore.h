@@ -0,0 +1,126 @@
+#ifndef _MORTONPOINTSTORE_H
+#define _MORTONPOINTSTORE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Point.h"
+#include "PointManager.h"
+#include "CoordinateHasher.h"
+
+#define MORTON_MAX_LOAD_FACTOR 0.5 // fraction of the open addressed slots in use at most
+
+/**
+ * Class MortonPointStore is a keyed point store for integer lattice indices. Each point's key interleaves the bits of
+ * its i, j and k indices (Morton or Z-order), so points that are close on the lattice are mostly close in key order.
+ * The points are kept sorted by key, so iterating over them walks the lattice block by block instead of in the
+ * effectively random order of the PointManager's hash map. Lookups go through an open addressed table of positions in
+ * the sorted array, and neighbors are found by incrementing one axis of a key directly, without decoding it
+ */
+class MortonPointStore {
+public:
+    typedef struct {
+        std::uint64_t key;
+        Point *point;
+    } Entry;
+
+    typedef std::vector<Entry>::const_iterator const_iterator;
+
+    /**
+     * Construct a store of every point of a PointManager, keyed by its indices along the axes of the PointManager.
+     * Ghost points are left out
+     *
+     * @param pm PointManager containing the points
+     */
+    explicit MortonPointStore(PointManager *pm);
+
+    /**
+     * Interleave lattice indices into a key, i in the lowest bit, then j and k
+     *
+     * @param i Index along the i axis, below 2^MORTON_BITS_PER_AXIS
+     * @param j Index along the j axis, below 2^MORTON_BITS_PER_AXIS
+     * @param k Index along the k axis, below 2^MORTON_BITS_PER_AXIS
+     * @return Morton key
+     */
+    static std::uint64_t encode(std::uint32_t i, std::uint32_t j, std::uint32_t k);
+
+    /**
+     * Separate a key into its lattice indices
+     *
+     * @param key Morton key
+     * @param i Receives the index along the i axis
+     * @param j Receives the index along the j axis
+     * @param k Receives the index along the k axis
+     */
+    static void decode(std::uint64_t key, std::uint32_t &i, std::uint32_t &j, std::uint32_t &k);
+
+    /**
+     * Get the key of the neighbor of a key along an axis
+     *
+     * @param key Morton key
+     * @param direction Neighbor to get the key of
+     * @param neighborKey Receives the key of the neighbor
+     * @return false if the neighbor would lie outside of the range of the keys
+     */
+    static bool getNeighborKey(std::uint64_t key, PointManager::Neighbor direction, std::uint64_t &neighborKey);
+
+    /**
+     * Find the point at lattice indices
+     *
+     * @return Pointer to the point, nullptr if there is none
+     */
+    Point *find(int i, int j, int k) const;
+
+    /**
+     * Find the point with a key
+     *
+     * @param key Morton key of the point
+     * @return Pointer to the point, nullptr if there is none
+     */
+    Point *find(std::uint64_t key) const;
+
+    /**
+     * Find the neighbor of the point with a key
+     *
+     * @param key Morton key of the point
+     * @param direction Neighbor to find
+     * @return Pointer to the neighbor, nullptr if there is none
+     */
+    Point *findNeighbor(std::uint64_t key, PointManager::Neighbor direction) const;
+
+    /**
+     * Get the number of points in the store
+     *
+     * @return Number of points
+     */
+    std::size_t size() const;
+
+    /**
+     * Iterate over the points in Morton order
+     */
+    const_iterator begin() const;
+
+    const_iterator end() const;
+
+private:
+    std::vector<Entry> entries; // sorted by key
+    std::vector<std::uint32_t> slots; // position in entries + 1 of the entry hashed to each slot, 0 if empty
+    int slotBits; // the number of slots is 2^slotBits
+
+    /**
+     * Get the first slot to probe for a key
+     */
+    inline std::size_t getSlot(std::uint64_t key) const {
+        return (std::size_t) ((key * 0x9E3779B97F4A7C15ULL) >> (64 - slotBits)); // Fibonacci hashing
+    }
+
+    /**
+     * Build the open addressed table over the sorted entries
+     */
+    void buildSlots();
+};
+
+#endif //QUANTUMFOUNDRY_MORTONPOINTSTORE_H
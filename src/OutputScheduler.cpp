@@ -0,0 +1,166 @@
+#include "OutputScheduler.h"
+
+#include <algorithm>
+#include <memory>
+
+OutputScheduler::OutputScheduler(PointManager *pm) {
+    this->pm = pm;
+}
+
+OutputScheduler::Rule OutputScheduler::createRule(Field field, Trigger trigger, const std::string &pathPrefix) {
+    Rule rule;
+    rule.field = field;
+    rule.trigger = trigger;
+    rule.pathPrefix = pathPrefix;
+    rule.stepInterval = 1;
+    rule.nextTimeIndex = 0;
+    rule.wallClockInterval = std::chrono::steady_clock::duration::zero();
+    rule.lastWallClockLog = std::chrono::steady_clock::now();
+    rule.threshold = 0.0;
+
+    return rule;
+}
+
+void OutputScheduler::addEveryNStepsRule(Field field, int stepInterval, const std::string &pathPrefix) {
+    if (stepInterval <= 0)
+        throw std::invalid_argument("Step interval must be positive");
+
+    Rule rule = createRule(field, EveryNSteps, pathPrefix);
+    rule.stepInterval = stepInterval;
+    rules.push_back(rule);
+}
+
+void OutputScheduler::addAtTimesRule(Field field, std::vector<double> times, const std::string &pathPrefix) {
+    Rule rule = createRule(field, AtTimes, pathPrefix);
+    std::sort(times.begin(), times.end());
+    rule.times = times;
+    rules.push_back(rule);
+}
+
+void OutputScheduler::addWallClockRule(Field field, double seconds, const std::string &pathPrefix) {
+    if (seconds <= 0)
+        throw std::invalid_argument("Wall clock interval must be positive");
+
+    Rule rule = createRule(field, WallClock, pathPrefix);
+    rule.wallClockInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(seconds));
+    rules.push_back(rule);
+}
+
+void OutputScheduler::addThresholdRule(Field field, double threshold, const std::string &pathPrefix, int stepInterval) {
+    if (stepInterval <= 0)
+        throw std::invalid_argument("Step interval must be positive");
+
+    Rule rule = createRule(field, Threshold, pathPrefix);
+    rule.threshold = threshold;
+    rule.stepInterval = stepInterval;
+    rules.push_back(rule);
+}
+
+int OutputScheduler::update(std::uint64_t step, double time) {
+    auto now = std::chrono::steady_clock::now();
+    double maxMagnitude[3] = {-1.0, -1.0, -1.0}; // per field diagnostic, only calculated when a threshold rule needs it
+    std::vector<Rule *> dueRules;
+
+    for (auto &rule : rules) {
+        bool due = false;
+
+        switch (rule.trigger) {
+            case EveryNSteps:
+                due = step % rule.stepInterval == 0;
+                break;
+            case AtTimes:
+                // several requested times can fall within one step, they are all covered by this log
+                while (rule.nextTimeIndex < rule.times.size() && rule.times[rule.nextTimeIndex] <= time) {
+                    rule.nextTimeIndex++;
+                    due = true;
+                }
+                break;
+            case WallClock:
+                if (now - rule.lastWallClockLog >= rule.wallClockInterval) {
+                    rule.lastWallClockLog = now;
+                    due = true;
+                }
+                break;
+            case Threshold:
+                if (step % rule.stepInterval == 0) {
+                    if (maxMagnitude[rule.field] < 0)
+                        maxMagnitude[rule.field] = calculateMaxMagnitude(rule.field, time);
+
+                    due = maxMagnitude[rule.field] > rule.threshold;
+                }
+                break;
+        }
+
+        // two rules logging the same field at the same step would write the same file twice
+        for (Rule *other : dueRules) {
+            if (due && other->field == rule.field && other->pathPrefix == rule.pathPrefix)
+                due = false;
+        }
+
+        if (due)
+            dueRules.push_back(&rule);
+    }
+
+    if (dueRules.empty())
+        return 0;
+
+    std::vector<std::unique_ptr<std::fstream>> logFiles;
+
+    for (Rule *rule : dueRules) {
+        logFiles.emplace_back(new std::fstream(rule->pathPrefix + std::to_string(step), std::ios::out));
+
+        if (!logFiles.back()->is_open())
+            throw std::invalid_argument("File path to log scheduled output does not exist");
+    }
+
+    // single pass over the grid for every field that is due at this step, mirrored if the full domain is logged
+    for (const auto &p : *pm->getCollectionOfPoints()) {
+        std::vector<PointManager::MirrorImage> images = pm->getMirrorImages(p.first);
+
+        for (std::size_t r = 0; r < dueRules.size(); r++) {
+            FieldVector value = getField(p.second, dueRules[r]->field, time);
+
+            for (const auto &image : images)
+                *logFiles[r] << image.coordinates << " "
+                             << pm->reflectField(value, image, dueRules[r]->field == MagneticField) << "\n";
+        }
+    }
+
+    for (auto &logFile : logFiles)
+        logFile->close();
+
+    return dueRules.size();
+}
+
+FieldVector OutputScheduler::getField(Point *p, Field field, double time) {
+    FieldVector *value = nullptr;
+
+    switch (field) {
+        case ElectricField:
+            value = p->getElectricField(time);
+            break;
+        case MagneticField:
+            value = p->getMagneticField(time);
+            break;
+        case CurrentField:
+            value = p->getCurrentField(time);
+            break;
+    }
+
+    return value ? *value : FieldVector(0, 0, 0);
+}
+
+double OutputScheduler::calculateMaxMagnitude(Field field, double time) {
+    double maxSquared = 0.0;
+
+    for (const auto &p : *pm->getCollectionOfPoints()) {
+        FieldVector value = getField(p.second, field, time);
+        double squared = value.getIComp() * value.getIComp() + value.getJComp() * value.getJComp() +
+                         value.getKComp() * value.getKComp();
+
+        maxSquared = std::max(maxSquared, squared);
+    }
+
+    return std::sqrt(maxSquared);
+}
@@ -0,0 +1,115 @@
+#ifndef _OUTPUTSCHEDULER_H
+#define _OUTPUTSCHEDULER_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <cmath>
+#include <cstdint>
+
+#include "PointManager.h"
+#include "FieldVector.h"
+
+/**
+ * Class OutputScheduler is responsible for deciding which fields are logged at which time steps.
+ * Each rule logs one field to a file named {path prefix}{step} whenever its trigger fires, using the same line format
+ * as the PointManager loggers. The step index keeps the names unique however small the time step, where the time
+ * printed to a few digits would not. All rules that are due at the same step are written in a single pass over the
+ * grid
+ */
+class OutputScheduler {
+public:
+    typedef enum {ElectricField, MagneticField, CurrentField} Field;
+
+    /**
+     * Construct an OutputScheduler without any rules
+     *
+     * @param pm PointManager that contains all points for the simulation
+     */
+    explicit OutputScheduler(PointManager *pm);
+
+    /**
+     * Log a field every stepInterval time steps, starting with step 0 if the scheduler is updated at step 0, e.g. by
+     * attaching it to a FieldSolver before the first step
+     *
+     * @param field Field to log
+     * @param stepInterval Number of steps between logs
+     * @param pathPrefix Prefix of the log file path, the step is appended to it
+     */
+    void addEveryNStepsRule(Field field, int stepInterval, const std::string &pathPrefix);
+
+    /**
+     * Log a field at specific times, each time is logged at the first step reaching or passing it
+     *
+     * @param field Field to log
+     * @param times Times to log the field at
+     * @param pathPrefix Prefix of the log file path, the step is appended to it
+     */
+    void addAtTimesRule(Field field, std::vector<double> times, const std::string &pathPrefix);
+
+    /**
+     * Log a field at the first step after each interval of wall clock time has passed
+     *
+     * @param field Field to log
+     * @param seconds Wall clock seconds between logs
+     * @param pathPrefix Prefix of the log file path, the step is appended to it
+     */
+    void addWallClockRule(Field field, double seconds, const std::string &pathPrefix);
+
+    /**
+     * Log a field whenever the largest field magnitude on the grid exceeds a threshold.
+     * The magnitude is checked every stepInterval steps
+     *
+     * @param field Field to log and whose magnitude is checked
+     * @param threshold Magnitude that has to be exceeded for the field to be logged
+     * @param pathPrefix Prefix of the log file path, the step is appended to it
+     * @param stepInterval Number of steps between checks
+     */
+    void addThresholdRule(Field field, double threshold, const std::string &pathPrefix, int stepInterval = 1);
+
+    /**
+     * Log every field whose rule is due at the given step
+     *
+     * @param step Number of time steps taken so far
+     * @param time Simulation time of the step
+     * @return Number of fields that were logged
+     */
+    int update(std::uint64_t step, double time);
+
+private:
+    typedef enum {EveryNSteps, AtTimes, WallClock, Threshold} Trigger;
+
+    struct Rule {
+        Field field;
+        Trigger trigger;
+        std::string pathPrefix;
+        int stepInterval;
+        std::vector<double> times;
+        std::size_t nextTimeIndex;
+        std::chrono::steady_clock::duration wallClockInterval;
+        std::chrono::steady_clock::time_point lastWallClockLog;
+        double threshold;
+    };
+
+    PointManager *pm;
+    std::vector<Rule> rules;
+
+    /**
+     * Create a rule with default trigger parameters
+     */
+    Rule createRule(Field field, Trigger trigger, const std::string &pathPrefix);
+
+    /**
+     * Get a field of a point at a given time, missing fields are reported as the zero vector
+     */
+    static FieldVector getField(Point *p, Field field, double time);
+
+    /**
+     * Calculate the largest magnitude of a field over the whole grid
+     */
+    double calculateMaxMagnitude(Field field, double time);
+};
+
+#endif //QUANTUMFOUNDRY_OUTPUTSCHEDULER_H
@@ -0,0 +1,11 @@
+#ifndef _PHYSICALCONSTANTS_H
+#define _PHYSICALCONSTANTS_H
+
+#include <cmath>
+
+// constant expressions, so static tables built from them such as the default materials are constant initialized
+#define SPEED_OF_LIGHT 3 *(int)1.0e8
+#define SPEED_OF_LIGHT_SQUARED ((double) SPEED_OF_LIGHT * SPEED_OF_LIGHT)
+#define VACUUM_PERMEABILITY (4 * M_PI) * 1.0e-7
+
+#endif //QUANTUMFOUNDRY_PHYSICALCONSTANTS_H
@@ -4,57 +4,43 @@ Point::Point(){
     this->i = 0.0;
     this->j = 0.0;
     this->k = 0.0;
+    this->material = MaterialTable::Vacuum;
+    this->conductivity = 0.0;
+    this->fields = createFieldHistories(nullptr);
 }
 
-Point::Point(double i, double j, double k, Classification c, int permittivity) {
+Point::Point(double i, double j, double k, Classification c, MaterialTable::Id material,
+             FieldHistoryPool *historyPool) {
     this->i = i;
     this->j = j;
     this->k = k;
 
-    this->permittivity = permittivity;
-    this->voltage = this->conductivity = 0.0;
-    this->classification = c;
+    this->material = material;
+    this->conductivity = getMaterial().conductivity;
+    this->voltage = 0.0;
+    this->classification = (std::uint8_t) c;
 
-    this->eField = new std::map<double, FieldVector>();
-    this->bField = new std::map<double, FieldVector>();
-    this->currentField = new std::map<double, FieldVector>();
+    this->fields = createFieldHistories(historyPool);
 
     //initialize to be the zero vector
     FieldVector zeroVector(0.0, 0.0, 0.0);
 
     FieldMapEntry initFieldEntry(0, zeroVector);
-    this->bField->insert(initFieldEntry);
-    this->currentField->insert(initFieldEntry);
+    this->fields->bField.insert(initFieldEntry);
 }
 
 Point::Point(const Point &p){
     this->i = p.i;
     this->j = p.j;
     this->k = p.k;
-    this->permittivity = p.permittivity;
-    this->voltage = p.voltage;
+    this->material = p.material;
     this->conductivity = p.conductivity;
+    this->voltage = p.voltage;
     this->classification = p.classification;
 
-    // Allocate space for all field vectors
-    this->eField = new std::map<double, FieldVector>();
-    this->bField = new std::map<double, FieldVector>();
-    this->currentField = new std::map<double, FieldVector>();
-
-    // Deep copy of p's eField
-    for(const auto &e : *(p.eField)){
-        this->eField->insert(FieldMapEntry(e.first, e.second));
-    }
-
-    // Deep copy of p's bField
-    for(const auto &b : *(p.bField)){
-        this->bField->insert(FieldMapEntry(b.first, b.second));
-    }
-
-    // Deep copy of p's currentField
-    for(const auto &jField : *(p.currentField)){
-        this->currentField->insert(FieldMapEntry(jField.first, jField.second));
-    }
+    // Deep copy of p's fields, drawn from the same pool
+    this->fields = createFieldHistories(p.fields->eField.get_allocator().pool);
+    *this->fields = *p.fields;
 }
 
 Point& Point::operator=(const Point &rhs){
@@ -65,46 +51,32 @@ Point& Point::operator=(const Point &rhs){
     this->i = rhs.i;
     this->j = rhs.j;
     this->k = rhs.k;
-    this->permittivity = rhs.permittivity;
-    this->voltage = rhs.voltage;
+    this->material = rhs.material;
     this->conductivity = rhs.conductivity;
+    this->voltage = rhs.voltage;
     this->classification = rhs.classification;
 
-    delete this->eField;
-    delete this->eField;
-    delete this->currentField;
+    // Deep copy of rhs fields, the entries stay in this point's pool
+    *this->fields = *rhs.fields;
 
-    // Clear eField, bField, currentField for new entries
-    this->eField = new std::map<double, FieldVector>();
-    this->bField = new std::map<double, FieldVector>();
-    this->currentField = new std::map<double, FieldVector>();
-
-    this->eField->clear();
-    this->bField->clear();
-    this->currentField->clear();
-
-    // Deep copy of rhs eField
-    for(const auto &e : *(rhs.eField)){
-        this->eField->insert(FieldMapEntry(e.first, e.second));
-    }
+    return *this;
+}
 
-    // Deep copy of rhs bField
-    for(const auto &b : *(rhs.bField)){
-        this->bField->insert(FieldMapEntry(b.first, b.second));
-    }
+Point::~Point(){
+    destroyFieldHistories();
+}
 
-    // Deep copy of rhs currentField
-    for(const auto &jField : *(rhs.currentField)){
-        this->currentField->insert(FieldMapEntry(jField.first, jField.second));
-    }
+Point::FieldHistories *Point::createFieldHistories(FieldHistoryPool *pool) {
+    FieldHistoryAllocator<FieldHistories> allocator(pool);
 
-    return *this;
+    return new (allocator.allocate(1)) FieldHistories(pool);
 }
 
-Point::~Point(){
-    delete this->eField;
-    delete this->bField;
-    delete this->currentField;
+void Point::destroyFieldHistories() {
+    FieldHistoryAllocator<FieldHistories> allocator(this->fields->eField.get_allocator());
+
+    this->fields->~FieldHistories();
+    allocator.deallocate(this->fields, 1);
 }
 
 double Point::getVoltage() { return this->voltage; }
@@ -116,32 +88,48 @@ void Point::setVoltage(double voltage) { this->voltage = voltage; }
 void Point::setConductivity(double conductivity) { this->conductivity = conductivity; }
 
 void Point::setElectricField(FieldVector eField, double time) {
-    this->eField->insert(FieldMapEntry(time, eField));
+    this->fields->eField.insert(FieldMapEntry(time, eField));
 }
 
 FieldVector *Point::getElectricField(double time) {
-    return this->eField->find(time) == eField->end() ? nullptr : &this->eField->at(time);
+    auto e = this->fields->eField.find(time);
+
+    return e == this->fields->eField.end() ? nullptr : &e->second;
 }
 
 FieldVector* Point::getCurrentField(double time){
-    auto a = currentField->find(time) == currentField->end() ? nullptr : &currentField->at(time);
+    auto jField = this->fields->currentField.find(time); // empty if no current has ever been set at this point
 
-    return currentField->find(time) == currentField->end() ? nullptr : &currentField->at(time);
+    return jField == this->fields->currentField.end() ? nullptr : &jField->second;
 }
 
 void Point::setMagneticField(FieldVector bField, double time) {
-    this->bField->insert(FieldMapEntry(time, bField));
+    this->fields->bField.insert(FieldMapEntry(time, bField));
 }
 
 void Point::setCurrentField(FieldVector jField, double time) {
-    this->currentField->insert(FieldMapEntry(time, jField));
+    this->fields->currentField.insert(FieldMapEntry(time, jField));
 }
 
 FieldVector* Point::getMagneticField(double time) {
-    return this->bField->find(time) == this->bField->end() ? nullptr : &this->bField->at(time);
+    auto b = this->fields->bField.find(time);
+
+    return b == this->fields->bField.end() ? nullptr : &b->second;
 }
 
-Point::Classification Point::getClassification() { return this->classification; }
+void Point::clearFieldHistory() {
+    this->fields->eField.clear();
+    this->fields->bField.clear();
+    this->fields->currentField.clear();
+}
+
+void Point::eraseFields(double time) {
+    this->fields->eField.erase(time);
+    this->fields->bField.erase(time);
+    this->fields->currentField.erase(time);
+}
+
+Point::Classification Point::getClassification() { return (Classification) this->classification; }
 
 bool Point::operator==(const Point &p1) const {
     return this->i == p1.i && this->j == p1.j && this->k == p1.k;
@@ -152,7 +140,17 @@ Coordinates Point::getCoordinates() const{
 }
 
 double Point::getPermittivity() const {
-    return this->permittivity;
+    return getMaterial().permittivity;
+}
+
+void Point::setPermittivity(double permittivity) {
+    if (permittivity != getMaterial().permittivity)
+        this->material = MaterialTable::findMaterial(permittivity);
+}
+
+void Point::setMaterial(MaterialTable::Id material) {
+    this->material = material;
+    this->conductivity = getMaterial().conductivity;
 }
 
 int operator==(const Point &p1, const Point &p2){
@@ -2,11 +2,14 @@
 #define _POINT_H
 
 #include <cmath>
+#include <cstdint>
 #include <map>
 #include <iostream>
 
 #include "Coordinates.h"
 #include "FieldVector.h"
+#include "MaterialTable.h"
+#include "FieldHistoryPool.h"
 
 /**
  * Point class is a point representation in 3 dimensional space with
@@ -15,9 +18,12 @@
 class Point {
 public:
     typedef enum {
-        Normal, Top, Bottom, Corner, Side_Face, Edge, Unclassified, Null
+        Normal, Top, Bottom, Corner, Side_Face, Edge, Unclassified, Ghost
     } Classification;
 
+    typedef std::map<double, FieldVector, std::less<double>,
+                     FieldHistoryAllocator<std::pair<const double, FieldVector>>> FieldHistory;
+
     Point();
 
     /**
@@ -27,9 +33,11 @@ public:
      * @param j J coordinate of the point
      * @param k K coordinate of the point
      * @param edgeCase Boolean whether the point is an edge case
-     * @param permittivity permittivity of the points location, defaults to 0
+     * @param material ID of the material at the points location in the MaterialTable, defaults to a vacuum
+     * @param historyPool Pool to allocate the field histories and their entries from, the system allocator if nullptr
      */
-    Point(double i, double j, double k, Classification c = Unclassified, int permittivity = 0);
+    Point(double i, double j, double k, Classification c = Unclassified,
+          MaterialTable::Id material = MaterialTable::Vacuum, FieldHistoryPool *historyPool = nullptr);
 
     /**
      * Copy constructor, create a Point based on a pre existing Point
@@ -39,7 +47,7 @@ public:
     Point(const Point &p);
 
     /**
-     * Destructor, responsible for freeing all memory used by the Point class
+     * Destructor, returns the field histories to their pool
      */
     ~Point();
 
@@ -70,7 +78,7 @@ public:
     void setVoltage(double voltage);
 
     /**
-     * Set the conductivity of this point
+     * Set the conductivity of this point, keeping its material
      */
     void setConductivity(double);
 
@@ -110,10 +118,23 @@ public:
      * Get the current field at a given time
      *
      * @param time Tune to get the corresponding current field
-     * @return Pointer to the FieldVector representing the current field at the given time
+     * @return Pointer to the FieldVector representing the current field at the given time, nullptr if no current was
+     * set at the given time. Points that never conduct don't store a current, their current is implicitly zero
      */
     FieldVector* getCurrentField(double time);
 
+    /**
+     * Remove every stored electric, magnetic and current field entry at all times
+     */
+    void clearFieldHistory();
+
+    /**
+     * Remove the electric, magnetic and current field entries at a single time, e.g. after a rejected time step
+     *
+     * @param time Time of the entries to remove
+     */
+    void eraseFields(double time);
+
     /**
      * Get the points classification, i.e. whether it is is on the top/bottom face, edge, corner, etc.
      *
@@ -143,6 +164,36 @@ public:
      */
     double getPermittivity() const;
 
+    /**
+     * Set the relative permittivity of this point, e.g. to fill the cube with a single material, keeping its
+     * conductivity. The point changes to the material of that permittivity. Solvers read the material of every point
+     * on each step, except for their cached stable time step
+     *
+     * @param permittivity Relative permittivity of the point
+     */
+    void setPermittivity(double permittivity);
+
+    /**
+     * Get the ID of the material of this point in the MaterialTable
+     *
+     * @return Material ID
+     */
+    inline MaterialTable::Id getMaterialId() const { return this->material; }
+
+    /**
+     * Get the properties and precomputed update coefficients of the material of this point
+     *
+     * @return Reference to the material in the MaterialTable
+     */
+    inline const Material &getMaterial() const { return MaterialTable::getMaterial(this->material); }
+
+    /**
+     * Change the material of this point, its conductivity becomes the material's
+     *
+     * @param material ID of the material in the MaterialTable
+     */
+    void setMaterial(MaterialTable::Id material);
+
     /**
      * Overload the >> operator to support easy output of Point coordinates
      *
@@ -156,43 +207,49 @@ public:
         return outs;
     }
 
-    inline const FieldVector &getRk4Y1() const {return this->rk4Y1;}
-
-    inline void setRk4Y1(const FieldVector &rk4Y1) { this->rk4Y1 = rk4Y1;}
-
-    inline const FieldVector &getRk4Y2() const { return this->rk4Y2;}
-
-    inline void setRk4Y2(const FieldVector &rk4Y2) { this->rk4Y2 = rk4Y2;}
-
-    inline const FieldVector &getRk4Y3() const {return this->rk4Y3;}
-
-    inline void setRk4Y3(const FieldVector &rk4Y3) {this->rk4Y3 = rk4Y3;}
-
-    inline const FieldVector &getRk4K1() const {return this->rk4K1;}
-
-    inline void setRk4K1(const FieldVector &rk4K1) {this->rk4K1 = rk4K1;}
+    /**
+     * Get the low storage Runge-Kutta register of the electric field, i.e. the accumulated stage increment
+     *
+     * @return Reference to the electric field register
+     */
+    inline FieldVector &getElectricFieldRegister() { return this->eFieldRegister; }
 
-    inline const FieldVector &getRk4K2() const{ return this->rk4K2;}
+    /**
+     * Get the low storage Runge-Kutta register of the magnetic field, i.e. the accumulated stage increment
+     *
+     * @return Reference to the magnetic field register
+     */
+    inline FieldVector &getMagneticFieldRegister() { return this->bFieldRegister; }
 
-    inline void setRk4K2(const FieldVector &rk4K2) { this->rk4K2 = rk4K2;}
+private:
+    typedef std::pair<double, FieldVector> FieldMapEntry;
 
-    inline const FieldVector &getRk4K3() const {return this->rk4K3;}
+    struct FieldHistories {
+        FieldHistory eField, bField, currentField; // currentField stays empty on points that never conduct
 
-    inline void setRk4K3(const FieldVector &rk4K3) { this->rk4K3 = rk4K3;}
+        explicit FieldHistories(FieldHistoryPool *pool) : eField(FieldHistory::allocator_type(pool)),
+                                                          bField(FieldHistory::allocator_type(pool)),
+                                                          currentField(FieldHistory::allocator_type(pool)) {}
+    };
 
-    inline void setRk4K4(const FieldVector &rk4K4) { this->rk4K4 = rk4K4;}
+    double i, j, k, voltage, conductivity;
+    FieldVector eFieldRegister, bFieldRegister;
+    MaterialTable::Id material;
+    std::uint8_t classification; // a Classification, stored in a byte next to the material
+    FieldHistories *fields; // allocated from the pool given to the constructor, next to the entries of the maps
 
-    inline FieldVector getRk4K4() { return this->rk4K4;}
-private:
-    typedef std::pair<double, FieldVector> FieldMapEntry;
+    /**
+     * Allocate and construct the field histories of a point
+     *
+     * @param pool Pool to allocate the histories and their entries from, the system allocator if nullptr
+     * @return Pointer to the histories
+     */
+    static FieldHistories *createFieldHistories(FieldHistoryPool *pool);
 
-    double i, j, k, permittivity, voltage, conductivity;
-    FieldVector rk4Y1, rk4Y2, rk4Y3;
-    FieldVector rk4K1, rk4K2, rk4K3, rk4K4;
-    Classification classification;
-    std::map<double, FieldVector>* eField;
-    std::map<double, FieldVector>* bField;
-    std::map<double, FieldVector>* currentField;
+    /**
+     * Destroy the field histories of this point and return them to their pool
+     */
+    void destroyFieldHistories();
 };
 
 #endif //QUANTUM_FOUNDRY_POINT_H
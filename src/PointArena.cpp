@@ -0,0 +1,55 @@
+#include "PointArena.h"
+
+PointArena::PointArena() {
+    this->freeSlots = nullptr;
+    this->blockUsed = POINT_ARENA_BLOCK_SIZE; // no block yet
+    this->pointsCreated = this->pointsDestroyed = 0;
+}
+
+// Points are not destroyed one by one, every entry of their histories lives in historyPool, released with it
+PointArena::~PointArena() {
+    for (Slot *block : blocks)
+        ::operator delete(block);
+}
+
+Point *PointArena::createPoint(double i, double j, double k, Point::Classification c, MaterialTable::Id material) {
+    Slot *slot;
+
+    if (freeSlots) {
+        slot = freeSlots;
+        freeSlots = slot->next;
+    } else {
+        if (blockUsed == POINT_ARENA_BLOCK_SIZE) {
+            blocks.push_back(static_cast<Slot *>(::operator new(sizeof(Slot) * POINT_ARENA_BLOCK_SIZE)));
+            blockUsed = 0;
+        }
+
+        slot = blocks.back() + blockUsed++;
+    }
+
+    pointsCreated++;
+
+    return new (slot->storage) Point(i, j, k, c, material, &historyPool);
+}
+
+void PointArena::destroyPoint(Point *point) {
+    point->~Point();
+
+    auto slot = reinterpret_cast<Slot *>(point);
+    slot->next = freeSlots;
+    freeSlots = slot;
+    pointsDestroyed++;
+}
+
+ArenaStatistics PointArena::getStatistics() const {
+    ArenaStatistics statistics;
+
+    statistics.pointsCreated = pointsCreated;
+    statistics.livePoints = pointsCreated - pointsDestroyed;
+    statistics.historyAllocations = historyPool.getNumAllocations();
+    statistics.liveHistoryAllocations = historyPool.getNumLiveAllocations();
+    statistics.systemAllocations = blocks.size() + historyPool.getNumSystemAllocations();
+    statistics.reservedBytes = blocks.size() * sizeof(Slot) * POINT_ARENA_BLOCK_SIZE + historyPool.getReservedBytes();
+
+    return statistics;
+}
@@ -0,0 +1,87 @@
+#ifndef _POINTARENA_H
+#define _POINTARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "Point.h"
+#include "MaterialTable.h"
+#include "FieldHistoryPool.h"
+
+#define POINT_ARENA_BLOCK_SIZE 4096 // points placed in every block requested from the system
+
+/**
+ * Allocation counters of a PointArena, for comparing setup and teardown costs
+ */
+typedef struct {
+    std::uint64_t pointsCreated; // points constructed so far, including recycled slots
+    std::uint64_t livePoints; // points created and not destroyed yet
+    std::uint64_t historyAllocations; // field histories and their entries allocated so far
+    std::uint64_t liveHistoryAllocations; // field histories and entries in use
+    std::uint64_t systemAllocations; // blocks requested from the system allocator for points and histories
+    std::size_t reservedBytes; // bytes held in those blocks
+} ArenaStatistics;
+
+/**
+ * Class PointArena owns the Points of a PointManager and the entries of their field histories. Points are placed
+ * side by side in large blocks instead of being allocated one by one, and their histories draw from a shared
+ * FieldHistoryPool, so building a grid costs a few thousand system allocations instead of several per point.
+ * Destroying the arena releases every block at once without visiting the points. Individual points, e.g. the ghost
+ * layer, can still be destroyed early, their slots are reused by the next points created
+ */
+class PointArena {
+public:
+    PointArena();
+
+    /**
+     * Destructor, releases all points and field history entries in bulk. Pointers to them become invalid
+     */
+    ~PointArena();
+
+    PointArena(const PointArena &) = delete;
+
+    PointArena &operator=(const PointArena &) = delete;
+
+    /**
+     * Construct a point in the arena, its field histories allocate from the arena's pool
+     *
+     * @param i I coordinate of the point
+     * @param j J coordinate of the point
+     * @param k K coordinate of the point
+     * @param c Classification of the point
+     * @param material ID of the material at the points location in the MaterialTable
+     * @return Pointer to the point, owned by the arena
+     */
+    Point *createPoint(double i, double j, double k, Point::Classification c = Point::Unclassified,
+                       MaterialTable::Id material = MaterialTable::Vacuum);
+
+    /**
+     * Destroy a point created by this arena before the arena itself, returning its slot and history entries
+     *
+     * @param point Pointer returned by createPoint
+     */
+    void destroyPoint(Point *point);
+
+    /**
+     * Get the allocation counters of the arena
+     *
+     * @return Counters of points, field history entries and system allocations
+     */
+    ArenaStatistics getStatistics() const;
+
+private:
+    typedef union Slot {
+        Slot *next; // while free
+        alignas(Point) char storage[sizeof(Point)]; // while in use
+    } Slot;
+
+    FieldHistoryPool historyPool; // declared before the blocks, the points in them use it
+    std::vector<Slot *> blocks;
+    Slot *freeSlots; // slots of destroyed points
+    std::size_t blockUsed; // slots handed out from the newest block
+    std::uint64_t pointsCreated, pointsDestroyed;
+};
+
+#endif //QUANTUMFOUNDRY_POINTARENA_H
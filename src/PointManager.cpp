@@ -1,51 +1,252 @@
 #include "PointManager.h"
 
+/**
+ * Write the components of a FieldVector to a binary output stream
+ */
+static void writeFieldVector(std::ostream &outs, const FieldVector &field) {
+    writeBinary(outs, field.getIComp());
+    writeBinary(outs, field.getJComp());
+    writeBinary(outs, field.getKComp());
+}
+
+/**
+ * Read the components of a FieldVector from a binary input stream
+ */
+static FieldVector readFieldVector(std::istream &ins) {
+    double iComp = readBinary<double>(ins);
+    double jComp = readBinary<double>(ins);
+    double kComp = readBinary<double>(ins);
+
+    return FieldVector(iComp, jComp, kComp);
+}
+
+const char PointManager::checkpointMagic[8] = {'M', 'E', 'S', 'C', 'K', 'P', 'T', '\0'};
+const std::uint32_t PointManager::checkpointVersion;
+
 PointManager::PointManager(int pointsPerDim, double startBound = -5.0, double endBound = 5.0,
                            std::string *initialVoltagePath = nullptr) {
+    initializeState();
+
     this->numPointsPerDim = pointsPerDim;
     this->startBound = startBound;
     this->endBound = endBound;
     this->spacingDelta = calculateSpacingDelta(); // Calculate the spacing between points
 
-    this->vacuumPermittivity = 1; // set relative permittivity in a vacuum
-    this->gaasPermittivity = 12; // set relative permittivity in gallium arsenide
-
-    this->pointMap = new std::unordered_map<Coordinates, Point *, CoordinateHasher>();
-
-    this->nullPoint = new Point(-1000.0, -1000.0, -1000.0, Point::Null,
-                                -1); // Point representing a null value, i.e a point that does not exist
-    this->nullPoint->setVoltage(0.0);
-
     if (initialVoltagePath != nullptr)
         importInitialVoltages(initialVoltagePath); // create necessary points and set voltages
     else
         generatePoints();
+
+    buildGhostLayer();
 }
 
 //TODO deprecate?
 PointManager::PointManager(double spacingDelta, double startBound = -5.0, double endBound = 5.0) {
+    initializeState();
+
     this->spacingDelta = spacingDelta;
     this->startBound = startBound;
     this->endBound = endBound;
     this->numPointsPerDim = pow(calculateTotalNumPts(), 1.0 / 3.0);
 
-    this->vacuumPermittivity = 1; // set relative permittivity in a vacuum
-    this->gaasPermittivity = 12; // set relative permittivity in gallium arsenide
+    generatePoints(); // create all points to be used in the simulation
+    buildGhostLayer();
+}
+
+PointManager::PointManager(double spacingDelta, double startBound, double endBound, const Coordinates &lowCorner,
+                           const int numPoints[3]) {
+    initializeState();
 
-    this->nullPoint = new Point(-1000.0, -1000.0, -1000.0, Point::Null,
-                                -1); // Point representing a null value, i.e a point that does not exist
-    this->nullPoint->setVoltage(0.0);
+    this->spacingDelta = spacingDelta;
+    this->startBound = startBound;
+    this->endBound = endBound;
+    this->numPointsPerDim = getNumPointsPerAxis();
 
-    generatePoints(); // create all points to be used in the simulation
+    generatePoints(lowCorner, numPoints);
+    buildGhostLayer();
 }
 
-PointManager::~PointManager() {
-    delete nullPoint;
+PointManager::PointManager(const std::vector<double> &iCoordinates, const std::vector<double> &jCoordinates,
+                           const std::vector<double> &kCoordinates) {
+    const std::vector<double> *coordinates[] = {&iCoordinates, &jCoordinates, &kCoordinates};
+
+    this->spacingDelta = std::numeric_limits<double>::max();
+    this->startBound = std::numeric_limits<double>::max();
+    this->endBound = std::numeric_limits<double>::lowest();
+
+    for (int axis = 0; axis < 3; axis++) {
+        const std::vector<double> &axisPoints = *coordinates[axis];
+
+        if (axisPoints.size() < 2)
+            throw std::invalid_argument("A graded axis needs at least two points");
+
+        for (std::size_t n = 1; n < axisPoints.size(); n++) {
+            if (axisPoints[n] <= axisPoints[n - 1])
+                throw std::invalid_argument("The coordinates of a graded axis must be increasing");
+
+            this->spacingDelta = std::min(this->spacingDelta, axisPoints[n] - axisPoints[n - 1]);
+        }
+
+        this->axisCoordinates[axis] = axisPoints;
+        this->startBound = std::min(this->startBound, axisPoints.front());
+        this->endBound = std::max(this->endBound, axisPoints.back());
+    }
+
+    this->numPointsPerDim = (int) iCoordinates.size();
+    initializeState(); // after the checks, nothing is allocated for rejected coordinates
+
+    generateGradedPoints();
+    buildGhostLayer();
+}
+
+std::vector<double> PointManager::createGradedAxis(double startBound, double endBound, double fineStart,
+                                                   double fineEnd, double fineSpacing, double maxSpacing,
+                                                   double growth) {
+    if (!(startBound <= fineStart && fineStart <= fineEnd && fineEnd <= endBound))
+        throw std::invalid_argument("The evenly spaced region must lie between the bounds");
+
+    if (fineSpacing <= 0 || maxSpacing < fineSpacing || growth < 1)
+        throw std::invalid_argument("Graded spacing must be positive and grow away from the evenly spaced region");
+
+    std::vector<double> before, coordinates;
+
+    // towards the start bound, the spacing grows from the fine spacing
+    double coordinate = fineStart, spacing = fineSpacing;
+
+    while (coordinate - startBound > spacing / 2) {
+        spacing = std::min(spacing * growth, maxSpacing);
+        coordinate = coordinate - spacing < startBound + spacing / 2 ? startBound : coordinate - spacing;
+        before.push_back(coordinate);
+    }
+
+    coordinates.assign(before.rbegin(), before.rend());
+
+    for (int n = 0; fineStart + n * fineSpacing <= fineEnd + fineSpacing / 2; n++)
+        coordinates.push_back(fineStart + n * fineSpacing);
+
+    // towards the end bound
+    coordinate = coordinates.back();
+    spacing = fineSpacing;
+
+    while (endBound - coordinate > spacing / 2) {
+        spacing = std::min(spacing * growth, maxSpacing);
+        coordinate = endBound - coordinate < spacing * 1.5 ? endBound : coordinate + spacing;
+        coordinates.push_back(coordinate);
+    }
+
+    if (coordinates.back() < endBound) // the fine region ends within half a spacing of the bound
+        coordinates.back() = endBound;
+
+    return coordinates;
+}
+
+PointManager::PointManager(std::istream &checkpoint) {
+    char magic[sizeof(checkpointMagic)];
+    checkpoint.read(magic, sizeof(magic));
+
+    if (!checkpoint || std::memcmp(magic, checkpointMagic, sizeof(magic)) != 0)
+        throw std::invalid_argument("Input stream is not a simulation checkpoint");
+
+    auto version = readBinary<std::uint32_t>(checkpoint);
+
+    if (version < 1 || version > checkpointVersion)
+        throw std::invalid_argument("Unsupported checkpoint version");
+
+    initializeState();
+
+    this->restoredCheckpointVersion = version;
+    this->numPointsPerDim = readBinary<int>(checkpoint);
+    this->upperMaterial = MaterialTable::findMaterial(readBinary<int>(checkpoint));
+    this->lowerMaterial = MaterialTable::findMaterial(readBinary<int>(checkpoint));
+    this->spacingDelta = readBinary<double>(checkpoint);
+    this->startBound = readBinary<double>(checkpoint);
+    this->endBound = readBinary<double>(checkpoint);
+
+    for (int axis = 0; version >= 2 && axis < 3; axis++) { // version 1 only knew evenly spaced grids
+        auto numCoordinates = readBinary<std::uint64_t>(checkpoint);
+
+        for (std::uint64_t n = 0; n < numCoordinates; n++)
+            axisCoordinates[axis].push_back(readBinary<double>(checkpoint));
+    }
+
+    if (version >= 3) { // the boundary conditions and difference scheme, versions before reset them to the defaults
+        for (bool &periodicAxis : periodic)
+            periodicAxis = readBinary<std::uint8_t>(checkpoint) != 0;
+
+        for (int face = 0; face < 6; face++) {
+            this->absorbingLayerThickness[face] = readBinary<double>(checkpoint);
+            this->symmetry[face] = static_cast<Symmetry>(readBinary<std::int32_t>(checkpoint));
+            this->symmetryPlane[face] = readBinary<double>(checkpoint);
+        }
+
+        this->differenceScheme = static_cast<DifferenceScheme>(readBinary<std::int32_t>(checkpoint));
+        this->ghostWidth = readBinary<std::int32_t>(checkpoint);
+        this->fullDomainOutput = readBinary<std::uint8_t>(checkpoint) != 0;
+    }
+
+    double time = readBinary<double>(checkpoint);
+    auto numPoints = readBinary<std::uint64_t>(checkpoint);
+
+    this->pointMap->reserve(numPoints);
+
+    for (std::uint64_t n = 0; n < numPoints; n++) {
+        double i = readBinary<double>(checkpoint);
+        double j = readBinary<double>(checkpoint);
+        double k = readBinary<double>(checkpoint);
+        auto classification = static_cast<Point::Classification>(readBinary<std::int32_t>(checkpoint));
+        double permittivity = readBinary<double>(checkpoint);
+        double conductivity = readBinary<double>(checkpoint);
+
+        auto entry = arena->createPoint(i, j, k, classification, MaterialTable::findMaterial(permittivity));
+        entry->setConductivity(conductivity);
+        entry->setVoltage(readBinary<double>(checkpoint));
+        entry->clearFieldHistory(); // drop the default zero fields, only the checkpointed time level is restored
+
+        auto flags = readBinary<std::uint8_t>(checkpoint);
+
+        if (flags & HasElectricField)
+            entry->setElectricField(readFieldVector(checkpoint), time);
+
+        if (flags & HasMagneticField)
+            entry->setMagneticField(readFieldVector(checkpoint), time);
+
+        if (flags & HasCurrentField)
+            entry->setCurrentField(readFieldVector(checkpoint), time);
+
+        pointMap->insert(pair<Coordinates, Point *>(Coordinates(i, j, k), entry));
+    }
+
+    buildGhostLayer();
+}
 
-    for(auto p : *pointMap)
-        delete p.second;
+void PointManager::initializeState() {
+    this->conductivityRevision = 0;
+    this->absorbingLayerRevision = 0;
+    this->layoutRevision = 0;
+    this->fieldRevision = 0;
+    std::fill(this->absorbingLayerThickness, this->absorbingLayerThickness + 6, 0.0);
+    std::fill(this->periodic, this->periodic + 3, false);
+    std::fill(this->symmetry, this->symmetry + 6, NoSymmetry);
+    std::fill(this->symmetryPlane, this->symmetryPlane + 6, 0.0);
+    this->fullDomainOutput = false;
+    this->restoredCheckpointVersion = 0;
+    this->externalGhostFill = false;
+    this->stencilsBuilt = false;
+
+    this->upperMaterial = MaterialTable::Vacuum; // a vacuum above the middle of the k axis
+    this->lowerMaterial = MaterialTable::GalliumArsenide; // gallium arsenide below it
 
+    this->pointMap = new std::unordered_map<Coordinates, Point *, CoordinateHasher>();
+    this->ghostMap = new PointCollection();
+    this->arena = new PointArena();
+    this->ghostWidth = 1;
+    this->differenceScheme = SecondOrder;
+}
+
+PointManager::~PointManager() {
+    delete ghostMap;
     delete pointMap;
+    delete arena; // releases every point and field history in bulk
 }
 
 double PointManager::getBoundsDiff() const {
@@ -86,29 +287,57 @@ int PointManager::calculateTotalNumPts() const {
  */
 void PointManager::generatePoints() {
     //TODO is there a more efficient way of initializing the 3D space? This is O(n^3)
-    double midLevel = getMidPointBetweenBounds();
-
     for (double i = startBound; i <= endBound; i += spacingDelta) {
         for (double j = startBound; j <= endBound; j += spacingDelta) {
             for (double k = startBound; k <= endBound; k += spacingDelta) {
                 auto ptCoor = Coordinates(i, j, k);
-                Point::Classification classification = classifyPoint(ptCoor);
-
-                if (k > midLevel) { // Point is in a vacuum
-                    auto entry = new Point(i, j, k, classification, vacuumPermittivity);
-                    pointMap->insert(pair<Coordinates, Point *>(ptCoor, entry));
-                } else if (k < midLevel) { // point is in gallium arsenide
-                    auto entry = new Point(i, j, k, classification, gaasPermittivity);
-                    pointMap->insert(pair<Coordinates, Point *>(ptCoor, entry));
-                } else { // point is in substrate
-                    auto entry = new Point(i, j, k, classification, 1);
-                    pointMap->insert(pair<Coordinates, Point *>(ptCoor, entry));
-                }
+                pointMap->insert(pair<Coordinates, Point *>(ptCoor, createPoint(ptCoor)));
+            }
+        }
+    }
+}
+
+void PointManager::generatePoints(const Coordinates &lowCorner, const int numPoints[3]) {
+    double i = lowCorner.getI();
+
+    // repeated additions like generatePoints, so the neighbors of a point are found at its coordinates +- spacingDelta
+    for (int m = 0; m < numPoints[IAxis]; m++, i += spacingDelta) {
+        double j = lowCorner.getJ();
+
+        for (int n = 0; n < numPoints[JAxis]; n++, j += spacingDelta) {
+            double k = lowCorner.getK();
+
+            for (int o = 0; o < numPoints[KAxis]; o++, k += spacingDelta) {
+                auto ptCoor = Coordinates(i, j, k);
+                pointMap->insert(pair<Coordinates, Point *>(ptCoor, createPoint(ptCoor)));
+            }
+        }
+    }
+}
+
+void PointManager::generateGradedPoints() {
+    for (double i : axisCoordinates[IAxis]) {
+        for (double j : axisCoordinates[JAxis]) {
+            for (double k : axisCoordinates[KAxis]) {
+                auto ptCoor = Coordinates(i, j, k);
+                pointMap->insert(pair<Coordinates, Point *>(ptCoor, createPoint(ptCoor)));
             }
         }
     }
 }
 
+Point *PointManager::createPoint(const Coordinates &ptCoor) {
+    double midLevel = getStartBound(KAxis) + (getEndBound(KAxis) - getStartBound(KAxis)) / 2;
+    Point::Classification classification = classifyPoint(ptCoor);
+
+    if (ptCoor.getK() > midLevel) // Point is in a vacuum
+        return arena->createPoint(ptCoor.getI(), ptCoor.getJ(), ptCoor.getK(), classification, upperMaterial);
+    else if (ptCoor.getK() < midLevel) // point is in gallium arsenide
+        return arena->createPoint(ptCoor.getI(), ptCoor.getJ(), ptCoor.getK(), classification, lowerMaterial);
+    else // point is in substrate
+        return arena->createPoint(ptCoor.getI(), ptCoor.getJ(), ptCoor.getK(), classification, MaterialTable::Vacuum);
+}
+
 void PointManager::importInitialVoltages(std::string *initialVoltagePath) {
     std::ifstream inputFile(*initialVoltagePath);
 
@@ -124,17 +353,17 @@ void PointManager::importInitialVoltages(std::string *initialVoltagePath) {
         Point::Classification classification = classifyPoint(ptCoor);
 
         if (k == midLevel){
-            auto entry = new Point(i, j, k, classification, 1);
+            auto entry = arena->createPoint(i, j, k, classification, MaterialTable::Vacuum);
             entry->setConductivity(conductivity);
             entry->setVoltage(voltage);
             pointMap->insert(pair<Coordinates, Point*>(ptCoor, entry));
         }else if (k > midLevel){
-            auto entry = new Point(i, j, k, classification, vacuumPermittivity);
+            auto entry = arena->createPoint(i, j, k, classification, upperMaterial);
             entry->setConductivity(conductivity);
             entry->setVoltage(voltage);
             pointMap->insert(pair<Coordinates, Point*>(ptCoor, entry));
         }else{
-            auto entry = new Point(i, j, k, classification, gaasPermittivity);
+            auto entry = arena->createPoint(i, j, k, classification, lowerMaterial);
             entry->setConductivity(conductivity);
             entry->setVoltage(voltage);
             pointMap->insert(pair<Coordinates, Point*>(ptCoor, entry));
@@ -143,45 +372,473 @@ void PointManager::importInitialVoltages(std::string *initialVoltagePath) {
 }
 
 Point* PointManager::getPoint(Coordinates target) const {
-    if (pointMap->find(target) == pointMap->end()) // coordinates not contained in unordered_map
-        return nullPoint;
-    else
-        return pointMap->at(target);
+    auto point = pointMap->find(target);
+
+    if (point != pointMap->end())
+        return point->second;
+
+    auto ghost = ghostMap->find(target);
+
+    return ghost == ghostMap->end() ? nullptr : ghost->second;
 }
 
 Point* PointManager::getPointerToPoint(const Coordinates &target) {
-    auto x = pointMap->find(target);
+    return getPoint(target);
+}
 
-    if (x == pointMap->end())
-        return nullPoint;
+double PointManager::getSpacingDelta() const { return this->spacingDelta; }
 
-    return pointMap->at(target);
+int PointManager::getNumPointsPerAxis() const { return getAxisIndex(endBound) + 1; }
+
+int PointManager::getAxisIndex(double coordinate) const {
+    return (int) std::floor((coordinate - startBound) / spacingDelta + 0.5);
 }
 
-double PointManager::getSpacingDelta() const { return this->spacingDelta; }
+int PointManager::getNumPoints(Axis axis) const {
+    return isGraded() ? (int) axisCoordinates[axis].size() : getNumPointsPerAxis();
+}
+
+int PointManager::getAxisIndex(Axis axis, double coordinate) const {
+    if (!isGraded())
+        return getAxisIndex(coordinate);
+
+    const std::vector<double> &coordinates = axisCoordinates[axis];
+    auto next = std::lower_bound(coordinates.begin(), coordinates.end(), coordinate);
+
+    if (next == coordinates.begin())
+        return 0;
+
+    if (next == coordinates.end() || coordinate - *(next - 1) < *next - coordinate) // the previous point is nearer
+        return (int) (next - coordinates.begin()) - 1;
+
+    return (int) (next - coordinates.begin());
+}
+
+double PointManager::getNeighborCoordinate(Axis axis, double coordinate, int offset) const {
+    if (!isGraded())
+        return coordinate + offset * spacingDelta;
+
+    const std::vector<double> &coordinates = axisCoordinates[axis];
+    auto found = std::lower_bound(coordinates.begin(), coordinates.end(), coordinate);
+
+    if (found == coordinates.end() || *found != coordinate) // not a point of the grid
+        return std::numeric_limits<double>::quiet_NaN();
+
+    int last = (int) coordinates.size() - 1;
+    int target = (int) (found - coordinates.begin()) + offset;
+
+    if (target < 0) // continue the first spacing before the start
+        return coordinates[0] + target * (coordinates[1] - coordinates[0]);
+
+    if (target > last) // continue the last spacing past the end
+        return coordinates[last] + (target - last) * (coordinates[last] - coordinates[last - 1]);
+
+    return coordinates[target];
+}
+
+bool PointManager::isGraded() const { return !axisCoordinates[IAxis].empty(); }
+
+double PointManager::getStartBound(Axis axis) const {
+    return isGraded() ? axisCoordinates[axis].front() : startBound;
+}
+
+double PointManager::getEndBound(Axis axis) const {
+    return isGraded() ? axisCoordinates[axis].back() : endBound;
+}
 
 Point* PointManager::getNextINeighbor(const Coordinates &pt) {
-    return getPointerToPoint(Coordinates(pt.getI() + spacingDelta, pt.getJ(), pt.getK()));
+    return getPointerToPoint(Coordinates(getNeighborCoordinate(IAxis, pt.getI(), 1), pt.getJ(), pt.getK()));
 }
 
 Point* PointManager::getPrevINeighbor(const Coordinates &pt) {
-    return this->getPointerToPoint(Coordinates(pt.getI() - spacingDelta, pt.getJ(), pt.getK()));
+    return this->getPointerToPoint(Coordinates(getNeighborCoordinate(IAxis, pt.getI(), -1), pt.getJ(), pt.getK()));
 }
 
 Point* PointManager::getNextJNeighbor(const Coordinates &pt) {
-    return this->getPointerToPoint(Coordinates(pt.getI(), pt.getJ() + spacingDelta, pt.getK()));
+    return this->getPointerToPoint(Coordinates(pt.getI(), getNeighborCoordinate(JAxis, pt.getJ(), 1), pt.getK()));
 }
 
 Point* PointManager::getPrevJNeighbor(const Coordinates &pt) {
-    return this->getPointerToPoint(Coordinates(pt.getI(), pt.getJ() - spacingDelta, pt.getK()));
+    return this->getPointerToPoint(Coordinates(pt.getI(), getNeighborCoordinate(JAxis, pt.getJ(), -1), pt.getK()));
 }
 
 Point* PointManager::getNextKNeighbor(const Coordinates &pt) {
-    return this->getPointerToPoint(Coordinates(pt.getI(), pt.getJ(), pt.getK() + spacingDelta));
+    return this->getPointerToPoint(Coordinates(pt.getI(), pt.getJ(), getNeighborCoordinate(KAxis, pt.getK(), 1)));
 }
 
 Point* PointManager::getPrevKNeighbor(const Coordinates &pt) {
-    return this->getPointerToPoint(Coordinates(pt.getI(), pt.getJ(), pt.getK() - spacingDelta));
+    return this->getPointerToPoint(Coordinates(pt.getI(), pt.getJ(), getNeighborCoordinate(KAxis, pt.getK(), -1)));
+}
+
+PointManager::Stencil PointManager::getStencil(const Coordinates &target) {
+    Stencil stencil;
+    stencil.point = getPointerToPoint(target);
+    stencil.neighbors[NextI] = getNextINeighbor(target);
+    stencil.neighbors[PrevI] = getPrevINeighbor(target);
+    stencil.neighbors[NextJ] = getNextJNeighbor(target);
+    stencil.neighbors[PrevJ] = getPrevJNeighbor(target);
+    stencil.neighbors[NextK] = getNextKNeighbor(target);
+    stencil.neighbors[PrevK] = getPrevKNeighbor(target);
+    std::fill(stencil.farNeighbors, stencil.farNeighbors + 6, nullptr);
+    std::fill(stencil.axisIndices, stencil.axisIndices + 3, 0);
+
+    if (stencil.point && stencil.point->getClassification() != Point::Ghost) {
+        if (axisWeights[IAxis].empty())
+            calculateAxisWeights();
+
+        stencil.axisIndices[IAxis] = getAxisIndex(IAxis, target.getI());
+        stencil.axisIndices[JAxis] = getAxisIndex(JAxis, target.getJ());
+        stencil.axisIndices[KAxis] = getAxisIndex(KAxis, target.getK());
+
+        if (differenceScheme == FourthOrder)
+            findFarNeighbors(stencil);
+    }
+
+    return stencil;
+}
+
+void PointManager::calculateAxisWeights() {
+    for (int axis = 0; axis < 3; axis++) {
+        int numPoints = getNumPoints((Axis) axis);
+
+        axisWeights[axis].assign(numPoints, AxisWeights());
+
+        for (int index = 0; index < numPoints; index++) {
+            AxisWeights &weights = axisWeights[axis][index];
+            double center = isGraded() ? axisCoordinates[axis][index] : startBound + index * spacingDelta;
+            double nextSpacing = getNeighborCoordinate((Axis) axis, center, 1) - center;
+            double prevSpacing = center - getNeighborCoordinate((Axis) axis, center, -1);
+            double totalSpacing = nextSpacing + prevSpacing;
+
+            // second order accurate for any pair of spacings, the usual central differences when they are equal
+            weights.gradient[0] = prevSpacing / (nextSpacing * totalSpacing);
+            weights.gradient[1] = -nextSpacing / (prevSpacing * totalSpacing);
+            weights.gradientCenter = (nextSpacing - prevSpacing) / (nextSpacing * prevSpacing);
+            weights.farGradient[0] = weights.farGradient[1] = 0.0;
+
+            weights.laplacian[0] = 2 / (nextSpacing * totalSpacing);
+            weights.laplacian[1] = 2 / (prevSpacing * totalSpacing);
+            weights.farLaplacian[0] = weights.farLaplacian[1] = 0.0;
+            weights.laplacianCenter = -2 / (nextSpacing * prevSpacing);
+        }
+    }
+
+    // (-f(x+2h) + 8 f(x+h) - 8 f(x-h) + f(x-2h)) / 12h and (-f(x+2h) + 16 f(x+h) - 30 f(x) + 16 f(x-h) - f(x-2h)) / 12h^2
+    double h = spacingDelta;
+
+    fourthOrderWeights.gradient[0] = 2 / (3 * h);
+    fourthOrderWeights.gradient[1] = -2 / (3 * h);
+    fourthOrderWeights.gradientCenter = 0.0;
+    fourthOrderWeights.farGradient[0] = -1 / (12 * h);
+    fourthOrderWeights.farGradient[1] = 1 / (12 * h);
+    fourthOrderWeights.laplacian[0] = fourthOrderWeights.laplacian[1] = 4 / (3 * h * h);
+    fourthOrderWeights.farLaplacian[0] = fourthOrderWeights.farLaplacian[1] = -1 / (12 * h * h);
+    fourthOrderWeights.laplacianCenter = -5 / (2 * h * h);
+}
+
+void PointManager::findFarNeighbors(Stencil &stencil) {
+    Coordinates center = stencil.point->getCoordinates();
+
+    for (int axis = 0; axis < 3; axis++) {
+        double coordinates[] = {center.getI(), center.getJ(), center.getK()};
+        double centerCoordinate = coordinates[axis];
+
+        coordinates[axis] = getNeighborCoordinate((Axis) axis, centerCoordinate, 2);
+        Point *next = getPointerToPoint(Coordinates(coordinates[0], coordinates[1], coordinates[2]));
+        coordinates[axis] = getNeighborCoordinate((Axis) axis, centerCoordinate, -2);
+        Point *prev = getPointerToPoint(Coordinates(coordinates[0], coordinates[1], coordinates[2]));
+
+        // a bounded ghost does not continue the field, so the point keeps the second order weights along the axis
+        if (!next || !prev || (!periodic[axis] && (next->getClassification() == Point::Ghost ||
+                                                   prev->getClassification() == Point::Ghost)))
+            continue;
+
+        stencil.farNeighbors[2 * axis] = next;
+        stencil.farNeighbors[2 * axis + 1] = prev;
+    }
+}
+
+const std::vector<PointManager::Stencil> &PointManager::getStencils() {
+    if (!stencilsBuilt) {
+        stencils.clear();
+        stencils.reserve(pointMap->size());
+
+        for (const auto &p : *pointMap)
+            stencils.push_back(getStencil(p.first));
+
+        stencilsBuilt = true;
+    }
+
+    return stencils;
+}
+
+void PointManager::setGhostWidth(int width) {
+    if (width < 1)
+        throw std::invalid_argument("The ghost layer must be at least one point wide");
+
+    if (width < 2 && differenceScheme == FourthOrder)
+        throw std::invalid_argument("Fourth order differences need a ghost layer two points wide");
+
+    this->ghostWidth = width;
+    deleteGhostLayer();
+    buildGhostLayer();
+}
+
+int PointManager::getGhostWidth() const { return this->ghostWidth; }
+
+void PointManager::setDifferenceScheme(DifferenceScheme scheme) {
+    if (scheme != SecondOrder && isGraded())
+        throw std::invalid_argument("Fourth order differences need evenly spaced points");
+
+    this->differenceScheme = scheme;
+    this->stencilsBuilt = false;
+    layoutRevision++;
+
+    if (scheme == FourthOrder && ghostWidth < 2)
+        setGhostWidth(2);
+}
+
+PointManager::DifferenceScheme PointManager::getDifferenceScheme() const { return this->differenceScheme; }
+
+const std::vector<PointManager::Ghost> &PointManager::getGhosts() const { return this->ghosts; }
+
+/**
+ * Copy a field of a point into a ghost point at a given time, overwriting the previous fill at that time
+ *
+ * @param signs Factor of each component, -1 for the components that are odd across a symmetry plane
+ */
+static void fillGhostField(FieldVector *(Point::*getField)(double), void (Point::*setField)(FieldVector, double),
+                           Point *source, Point *ghost, double time, const double signs[3]) {
+    FieldVector *sourceField = (source->*getField)(time);
+
+    if (!sourceField) // the field was not calculated at this time yet
+        return;
+
+    FieldVector value(signs[0] * sourceField->getIComp(), signs[1] * sourceField->getJComp(),
+                      signs[2] * sourceField->getKComp());
+    FieldVector *ghostField = (ghost->*getField)(time);
+
+    if (ghostField)
+        *ghostField = value;
+    else
+        (ghost->*setField)(value, time);
+}
+
+void PointManager::fillGhostFields(double time) {
+    if (externalGhostFill)
+        return;
+
+    fieldRevision++;
+
+    const double copySigns[] = {1.0, 1.0, 1.0};
+    double electricSigns[3], magneticSigns[3];
+
+    for (const auto &ghost : ghosts) {
+        Point *source = ghost.image ? ghost.image : ghost.source;
+
+        if (ghost.symmetry == NoSymmetry) {
+            fillGhostField(&Point::getElectricField, &Point::setElectricField, source, ghost.point, time, copySigns);
+            fillGhostField(&Point::getMagneticField, &Point::setMagneticField, source, ghost.point, time, copySigns);
+        } else {
+            getReflectionSigns(ghost.symmetry, (Axis) (ghost.direction / 2), false, electricSigns);
+            getReflectionSigns(ghost.symmetry, (Axis) (ghost.direction / 2), true, magneticSigns);
+
+            fillGhostField(&Point::getElectricField, &Point::setElectricField, source, ghost.point, time, electricSigns);
+            fillGhostField(&Point::getMagneticField, &Point::setMagneticField, source, ghost.point, time, magneticSigns);
+        }
+    }
+}
+
+void PointManager::fillGhostVoltages() {
+    if (externalGhostFill)
+        return;
+
+    for (const auto &ghost : ghosts) {
+        if (!ghost.image)
+            ghost.point->setVoltage(0.0);
+        else if (ghost.symmetry == ElectricWall) // odd, i.e. 0 on the plane
+            ghost.point->setVoltage(-ghost.image->getVoltage());
+        else
+            ghost.point->setVoltage(ghost.image->getVoltage());
+    }
+}
+
+void PointManager::getReflectionSigns(Symmetry symmetry, Axis axis, bool magnetic, double signs[3]) {
+    // a reflection flips the normal component of a polar vector like E and the tangential ones of an axial vector
+    // like B, an electric wall additionally makes both fields odd
+    double wallSign = symmetry == ElectricWall ? -1.0 : 1.0;
+
+    for (int component = 0; component < 3; component++)
+        signs[component] = (component == axis) != magnetic ? -wallSign : wallSign;
+}
+
+void PointManager::setSymmetry(Face face, Symmetry symmetry) {
+    Axis axis = (Axis) (face / 2);
+    Face opposite = (Face) (face % 2 == 0 ? face + 1 : face - 1);
+
+    if (symmetry != NoSymmetry && periodic[axis])
+        throw std::invalid_argument("A periodic axis can not have symmetry planes");
+
+    if (symmetry != NoSymmetry && absorbingLayerThickness[face] > 0)
+        throw std::invalid_argument("A face with an absorbing layer can not be a symmetry plane");
+
+    if (symmetry != NoSymmetry && this->symmetry[opposite] != NoSymmetry)
+        throw std::invalid_argument("Only one face of an axis can be a symmetry plane");
+
+    double plane = face % 2 == 0 ? std::numeric_limits<double>::max() : std::numeric_limits<double>::lowest();
+
+    for (const auto &p : *pointMap) {
+        const double coordinates[] = {p.first.getI(), p.first.getJ(), p.first.getK()};
+        plane = face % 2 == 0 ? std::min(plane, coordinates[axis]) : std::max(plane, coordinates[axis]);
+    }
+
+    this->symmetry[face] = symmetry;
+    this->symmetryPlane[face] = plane;
+    deleteGhostLayer();
+    buildGhostLayer();
+}
+
+PointManager::Symmetry PointManager::getSymmetry(Face face) const { return this->symmetry[face]; }
+
+void PointManager::setFullDomainOutput(bool fullDomain) { this->fullDomainOutput = fullDomain; }
+
+bool PointManager::hasFullDomainOutput() const { return this->fullDomainOutput; }
+
+std::vector<PointManager::MirrorImage> PointManager::getMirrorImages(const Coordinates &target) const {
+    std::vector<MirrorImage> images(1, MirrorImage{target, 0});
+
+    if (!fullDomainOutput)
+        return images;
+
+    for (int face = 0; face < 6; face++) {
+        if (symmetry[face] == NoSymmetry)
+            continue;
+
+        std::size_t numImages = images.size(); // images across the earlier planes are reflected as well
+
+        for (std::size_t index = 0; index < numImages; index++) {
+            const Coordinates &c = images[index].coordinates;
+            double coordinates[] = {c.getI(), c.getJ(), c.getK()};
+
+            if (coordinates[face / 2] == symmetryPlane[face]) // on the plane, its own image
+                continue;
+
+            coordinates[face / 2] = 2 * symmetryPlane[face] - coordinates[face / 2];
+            images.push_back(MirrorImage{Coordinates(coordinates[0], coordinates[1], coordinates[2]),
+                                         images[index].faces | (1 << face)});
+        }
+    }
+
+    return images;
+}
+
+FieldVector PointManager::reflectField(const FieldVector &field, const MirrorImage &image, bool magnetic) const {
+    double components[] = {field.getIComp(), field.getJComp(), field.getKComp()};
+    double signs[3];
+
+    for (int face = 0; face < 6; face++) {
+        if (!(image.faces & (1 << face)))
+            continue;
+
+        getReflectionSigns(symmetry[face], (Axis) (face / 2), magnetic, signs);
+
+        for (int component = 0; component < 3; component++)
+            components[component] *= signs[component];
+    }
+
+    return FieldVector(components[0], components[1], components[2]);
+}
+
+double PointManager::reflectVoltage(double voltage, const MirrorImage &image) const {
+    for (int face = 0; face < 6; face++)
+        if ((image.faces & (1 << face)) && symmetry[face] == ElectricWall)
+            voltage = -voltage;
+
+    return voltage;
+}
+
+void PointManager::setPeriodic(Axis axis, bool periodic) {
+    if (periodic && isGraded())
+        throw std::invalid_argument("The axes of a graded grid can not be periodic");
+
+    if (periodic && (absorbingLayerThickness[2 * axis] > 0 || absorbingLayerThickness[2 * axis + 1] > 0))
+        throw std::invalid_argument("A periodic axis can not have absorbing layers");
+
+    if (periodic && (symmetry[2 * axis] != NoSymmetry || symmetry[2 * axis + 1] != NoSymmetry))
+        throw std::invalid_argument("A periodic axis can not have symmetry planes");
+
+    this->periodic[axis] = periodic;
+    deleteGhostLayer();
+    buildGhostLayer();
+}
+
+bool PointManager::isPeriodic(Axis axis) const { return this->periodic[axis]; }
+
+void PointManager::setExternalGhostFill(bool external) { this->externalGhostFill = external; }
+
+bool PointManager::hasExternalGhostFill() const { return this->externalGhostFill; }
+
+void PointManager::buildGhostLayer() {
+    const int offsets[6][3] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    double period = getNumPointsPerAxis() * spacingDelta; // the point after the end face is the start face
+
+    for (const auto &p : *pointMap) {
+        for (int direction = 0; direction < 6; direction++) {
+            for (int depth = 1; depth <= ghostWidth; depth++) {
+                Axis axis = (Axis) (direction / 2);
+                double coordinates[] = {p.first.getI(), p.first.getJ(), p.first.getK()};
+                coordinates[axis] = getNeighborCoordinate(axis, coordinates[axis], direction % 2 == 0 ? depth : -depth);
+                Coordinates ghostCoor(coordinates[0], coordinates[1], coordinates[2]);
+
+                if (pointMap->find(ghostCoor) != pointMap->end()) // the neighbor is simulated
+                    break;
+
+                if (ghostMap->find(ghostCoor) != ghostMap->end()) // already bordering another point
+                    continue;
+
+                Point *image = nullptr;
+                Symmetry mirror = NoSymmetry;
+                int face = direction % 2 == 0 ? 2 * axis + 1 : 2 * axis; // the next neighbor lies beyond the end face
+                double sourceCoordinates[] = {p.first.getI(), p.first.getJ(), p.first.getK()};
+
+                if (periodic[direction / 2]) { // wrap around to the opposite face, one period back
+                    Coordinates imageCoor(ghostCoor.getI() - offsets[direction][0] * period,
+                                          ghostCoor.getJ() - offsets[direction][1] * period,
+                                          ghostCoor.getK() - offsets[direction][2] * period);
+                    auto found = pointMap->find(imageCoor);
+                    image = found == pointMap->end() ? nullptr : found->second;
+                } else if (symmetry[face] != NoSymmetry && sourceCoordinates[axis] == symmetryPlane[face]) {
+                    coordinates[axis] = 2 * symmetryPlane[face] - coordinates[axis]; // mirror across the plane
+                    auto found = pointMap->find(Coordinates(coordinates[0], coordinates[1], coordinates[2]));
+
+                    if (found != pointMap->end()) { // otherwise the ghost copies the point it borders
+                        image = found->second;
+                        mirror = symmetry[face];
+                    }
+                }
+
+                auto entry = arena->createPoint(ghostCoor.getI(), ghostCoor.getJ(), ghostCoor.getK(), Point::Ghost,
+                                       p.second->getMaterialId());
+                entry->setConductivity(p.second->getConductivity());
+                ghostMap->insert(pair<Coordinates, Point *>(ghostCoor, entry));
+                ghosts.push_back({entry, p.second, image, (Neighbor) direction, depth, mirror});
+            }
+        }
+    }
+
+    this->stencilsBuilt = false; // the stencils point into the old ghost layer
+    layoutRevision++;
+    fieldRevision++; // the new ghosts are not filled yet
+}
+
+void PointManager::deleteGhostLayer() {
+    for (auto p : *ghostMap)
+        arena->destroyPoint(p.second);
+
+    ghostMap->clear();
+    ghosts.clear();
+    this->stencilsBuilt = false;
+    layoutRevision++;
 }
 
 void PointManager::setVoltage(Coordinates target, double voltage) {
@@ -190,10 +847,34 @@ void PointManager::setVoltage(Coordinates target, double voltage) {
 }
 
 void PointManager::setConductivity(Coordinates target, double conductivity) {
-    if (checkPointExists(target))
+    if (checkPointExists(target)) {
         pointMap->at(target)->setConductivity(conductivity);
+        conductivityRevision++;
+    }
+}
+
+void PointManager::setMaterial(const Coordinates &target, MaterialTable::Id material) {
+    if (checkPointExists(target)) {
+        pointMap->at(target)->setMaterial(material);
+        conductivityRevision++; // the point takes on the conductivity of the material
+    }
+}
+
+MaterialTable::Id PointManager::getMaterialId(const Coordinates &target) const {
+    if (!checkPointExists(target))
+        throw std::invalid_argument("Point does not exist");
+
+    return pointMap->at(target)->getMaterialId();
 }
 
+std::uint64_t PointManager::getConductivityRevision() const { return this->conductivityRevision; }
+
+std::uint64_t PointManager::getLayoutRevision() const { return this->layoutRevision; }
+
+std::uint64_t PointManager::getFieldRevision() const { return this->fieldRevision; }
+
+ArenaStatistics PointManager::getAllocationStatistics() const { return this->arena->getStatistics(); }
+
 std::unordered_map<Coordinates, Point*, CoordinateHasher> *PointManager::getCollectionOfPoints() { return pointMap; }
 
 bool PointManager::checkPointExists(const Coordinates &target) const {
@@ -211,7 +892,9 @@ void PointManager::logConductivityAndVoltageToFile(const std::string &filePath)
         throw std::invalid_argument("File path to log voltage does not exist");
 
     for (auto p : *pointMap) {
-        logFile << *p.second << " " << p.second->getConductivity() << " " << p.second->getVoltage() << std::endl;
+        for (const auto &image : getMirrorImages(p.first))
+            logFile << image.coordinates << " " << p.second->getConductivity() << " "
+                    << reflectVoltage(p.second->getVoltage(), image) << std::endl;
     }
 
     logFile.close();
@@ -226,7 +909,8 @@ void PointManager::logElectricFieldToFile(const std::string &filePath, double ti
     for (auto p : *pointMap) {
         auto eField = p.second->getElectricField(time);
 
-        logFile << p.first << " " << *eField << std::endl;
+        for (const auto &image : getMirrorImages(p.first))
+            logFile << image.coordinates << " " << reflectField(*eField, image, false) << std::endl;
     }
 
     logFile.close();
@@ -241,7 +925,8 @@ void PointManager::logMagneticFieldToFile(const std::string &filePath, double ti
     for (auto p : *pointMap) {
         auto magneticField = p.second->getMagneticField(time);
 
-        logFile << p.first << " " << *magneticField << std::endl;
+        for (const auto &image : getMirrorImages(p.first))
+            logFile << image.coordinates << " " << reflectField(*magneticField, image, true) << std::endl;
     }
 
     logFile.close();
@@ -253,10 +938,14 @@ void PointManager::logCurrentFieldToFile(const std::string &filePath, double tim
     if (!logFile)
         throw std::invalid_argument("File path log current field does not exist");
 
+    FieldVector zeroVector(0, 0, 0);
+
     for (auto p : *pointMap) {
         auto currentField = p.second->getCurrentField(time);
 
-        logFile << p.first << " " << *currentField << std::endl;
+        for (const auto &image : getMirrorImages(p.first))
+            logFile << image.coordinates << " " << reflectField(currentField ? *currentField : zeroVector, image, false)
+                    << std::endl;
     }
 
     logFile.close();
@@ -284,15 +973,26 @@ FieldVector *PointManager::getCurrentField(const Coordinates &target, double tim
 }
 
 Point::Classification PointManager::classifyPoint(const Coordinates &ptCoor) {
+    const double noMargins[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    return classifyPoint(ptCoor, noMargins);
+}
+
+Point::Classification PointManager::classifyPoint(const Coordinates &ptCoor, const double margins[6]) const {
     int pos = 0;
 
     double iCoor = ptCoor.getI();
     double jCoor = ptCoor.getJ();
     double kCoor = ptCoor.getK();
 
-    pos += (iCoor == startBound || iCoor == endBound); // if point lies on an x axis bound
-    pos += (jCoor == startBound || jCoor == endBound); // if point lies on a y axis bound
-    pos += (kCoor == startBound || kCoor == endBound); // if point lies on a z axis bound
+    bool bottom = kCoor <= getStartBound(KAxis) + margins[KStartFace];
+    bool top = kCoor >= getEndBound(KAxis) - margins[KEndFace];
+
+    // if point lies on an x axis bound
+    pos += (iCoor <= getStartBound(IAxis) + margins[IStartFace] || iCoor >= getEndBound(IAxis) - margins[IEndFace]);
+    // if point lies on a y axis bound
+    pos += (jCoor <= getStartBound(JAxis) + margins[JStartFace] || jCoor >= getEndBound(JAxis) - margins[JEndFace]);
+    pos += (bottom || top); // if point lies on a z axis bound
 
     switch (pos) {
         case 0: // point is not in a special position within the cube
@@ -305,14 +1005,74 @@ Point::Classification PointManager::classifyPoint(const Coordinates &ptCoor) {
             break;
     }
 
-    if (kCoor == startBound) // point is on the top face
+    if (bottom) // point is on the bottom face
         return Point::Bottom;
-    else if (kCoor == endBound) // point is on the bottom face
+    else if (top) // point is on the top face
         return Point::Top;
     else // point must be a side face
         return Point::Side_Face;
 }
 
+void PointManager::setAbsorbingLayerThickness(Face face, double thickness) {
+    if (thickness < 0 || thickness > getBoundsDiff())
+        throw std::invalid_argument("Absorbing layer thickness must be between 0 and the size of the cube");
+
+    if (thickness > 0 && periodic[face / 2])
+        throw std::invalid_argument("A periodic axis can not have absorbing layers");
+
+    if (thickness > 0 && symmetry[face] != NoSymmetry)
+        throw std::invalid_argument("A face with an absorbing layer can not be a symmetry plane");
+
+    absorbingLayerThickness[face] = thickness;
+    absorbingLayerRevision++;
+}
+
+double PointManager::getAbsorbingLayerThickness(Face face) const { return absorbingLayerThickness[face]; }
+
+std::uint64_t PointManager::getAbsorbingLayerRevision() const { return this->absorbingLayerRevision; }
+
+Point::Classification PointManager::classifyAbsorbingLayerPoint(const Coordinates &target) const {
+    // a face without a layer must not classify the points on it as absorbing
+    double margins[6];
+
+    for (int face = 0; face < 6; face++)
+        margins[face] = absorbingLayerThickness[face] > 0 ? absorbingLayerThickness[face] : -getBoundsDiff();
+
+    return classifyPoint(target, margins);
+}
+
+double PointManager::calculateAbsorbingLayerAttenuation(const Coordinates &target) const {
+    if (classifyAbsorbingLayerPoint(target) == Point::Normal)
+        return 0.0;
+
+    return calculateAbsorbingLayerAttenuation(target, IAxis) + calculateAbsorbingLayerAttenuation(target, JAxis) +
+           calculateAbsorbingLayerAttenuation(target, KAxis);
+}
+
+double PointManager::calculateAbsorbingLayerAttenuation(const Coordinates &target, Axis axis) const {
+    const double coordinates[] = {target.getI(), target.getJ(), target.getK()};
+    double coordinate = coordinates[axis];
+    double attenuation = 0.0;
+
+    for (int face = 2 * axis; face < 2 * axis + 2; face++) {
+        double thickness = absorbingLayerThickness[face];
+
+        if (thickness <= 0)
+            continue;
+
+        double depth = face % 2 == 0 ? getStartBound(axis) + thickness - coordinate
+                                     : coordinate - (getEndBound(axis) - thickness);
+        depth = std::min(std::max(depth / thickness, 0.0), 1.0);
+
+        // the integral of the attenuation over the layer and back is -ln(ABSORBING_LAYER_REFLECTION)
+        double maxAttenuation = -(ABSORBING_LAYER_GRADING_ORDER + 1) * std::log(ABSORBING_LAYER_REFLECTION) /
+                                (2 * thickness);
+        attenuation += maxAttenuation * std::pow(depth, ABSORBING_LAYER_GRADING_ORDER);
+    }
+
+    return attenuation;
+}
+
 Point::Classification PointManager::getClassification(const Coordinates &target) {
     if (!checkPointExists(target)) // target point does not exist
         return Point::Unclassified;
@@ -330,15 +1090,12 @@ double PointManager::getConductivity(Coordinates target) {
     return checkPointExists(target) ? pointMap->at(target)->getConductivity() : -1;
 }
 
-bool PointManager::checkIfNullPoint(const Point &target) {
-    return target == *nullPoint;
-}
-
 void PointManager::setCurrentField(const Coordinates &target, FieldVector field, double time) {
     if (!checkPointExists(target)) // point doesn't exist
         return;
 
     getPointerToPoint(target)->setCurrentField(field, time);
+    fieldRevision++;
 }
 
 void PointManager::setElectricField(const Coordinates &target, FieldVector field, double time) {
@@ -346,6 +1103,7 @@ void PointManager::setElectricField(const Coordinates &target, FieldVector field
         return;
 
     getPointerToPoint(target)->setElectricField(field, time);
+    fieldRevision++;
 }
 
 void PointManager::setMagneticField(const Coordinates &target, FieldVector magneticField, double time) {
@@ -353,4 +1111,72 @@ void PointManager::setMagneticField(const Coordinates &target, FieldVector magne
         return;
 
     this->getPointerToPoint(target)->setMagneticField(magneticField, time);
+    fieldRevision++;
 }
+
+
+void PointManager::writeCheckpoint(std::ostream &outs, double time) {
+    outs.write(checkpointMagic, sizeof(checkpointMagic));
+    writeBinary(outs, checkpointVersion);
+
+    writeBinary(outs, numPointsPerDim);
+    // the layer permittivities are kept as whole numbers, as before there was a material table
+    writeBinary(outs, (int) MaterialTable::getMaterial(upperMaterial).permittivity);
+    writeBinary(outs, (int) MaterialTable::getMaterial(lowerMaterial).permittivity);
+    writeBinary(outs, spacingDelta);
+    writeBinary(outs, startBound);
+    writeBinary(outs, endBound);
+
+    for (const auto &coordinates : axisCoordinates) { // empty on an evenly spaced grid
+        writeBinary(outs, (std::uint64_t) coordinates.size());
+
+        for (double coordinate : coordinates)
+            writeBinary(outs, coordinate);
+    }
+
+    for (bool periodicAxis : periodic)
+        writeBinary(outs, (std::uint8_t) periodicAxis);
+
+    for (int face = 0; face < 6; face++) {
+        writeBinary(outs, absorbingLayerThickness[face]);
+        writeBinary(outs, (std::int32_t) symmetry[face]);
+        writeBinary(outs, symmetryPlane[face]);
+    }
+
+    writeBinary(outs, (std::int32_t) differenceScheme);
+    writeBinary(outs, (std::int32_t) ghostWidth);
+    writeBinary(outs, (std::uint8_t) fullDomainOutput);
+
+    writeBinary(outs, time);
+    writeBinary(outs, (std::uint64_t) pointMap->size());
+
+    for (const auto &p : *pointMap) {
+        Point *pt = p.second;
+        FieldVector *eField = pt->getElectricField(time);
+        FieldVector *bField = pt->getMagneticField(time);
+        FieldVector *jField = pt->getCurrentField(time);
+
+        writeBinary(outs, p.first.getI());
+        writeBinary(outs, p.first.getJ());
+        writeBinary(outs, p.first.getK());
+        writeBinary(outs, (std::int32_t) pt->getClassification());
+        writeBinary(outs, pt->getPermittivity());
+        writeBinary(outs, pt->getConductivity());
+        writeBinary(outs, pt->getVoltage());
+
+        std::uint8_t flags = (eField ? HasElectricField : 0) | (bField ? HasMagneticField : 0) |
+                (jField ? HasCurrentField : 0);
+        writeBinary(outs, flags);
+
+        if (eField)
+            writeFieldVector(outs, *eField);
+
+        if (bField)
+            writeFieldVector(outs, *bField);
+
+        if (jField)
+            writeFieldVector(outs, *jField);
+    }
+}
+
+std::uint32_t PointManager::getCheckpointVersion() const { return this->restoredCheckpointVersion; }
@@ -6,16 +6,84 @@
 #include <string>
 #include <fstream>
 #include <utility>
+#include <istream>
+#include <ostream>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
 
 #include "Point.h"
+#include "PointArena.h"
 #include "CoordinateHasher.h"
 #include "Coordinates.h"
+#include "BinaryStream.h"
 
 using std::pair;
 
+#define ABSORBING_LAYER_REFLECTION 1.0e-4 // reflection of a normally incident wave after a round trip through a layer
+#define ABSORBING_LAYER_GRADING_ORDER 3 // the attenuation grows with this power of the depth into a layer
+
 class PointManager {
 public:
     typedef std::unordered_map<Coordinates, Point*, CoordinateHasher> PointCollection;
+    typedef enum {IAxis, JAxis, KAxis} Axis;
+    typedef enum {NextI, PrevI, NextJ, PrevJ, NextK, PrevK} Neighbor;
+    typedef enum {IStartFace, IEndFace, JStartFace, JEndFace, KStartFace, KEndFace} Face;
+    typedef enum {SecondOrder, FourthOrder, CompactFourthOrder} DifferenceScheme;
+    typedef enum {NoSymmetry, ElectricWall, MagneticWall} Symmetry;
+
+    /**
+     * The weights turning the values at a point and its neighbors along one axis into derivatives along that axis.
+     * They follow from the distances to the neighbors, so the same sweeps run on evenly spaced and graded grids, and
+     * only depend on the index of the point along the axis and the difference scheme
+     */
+    typedef struct {
+        double gradient[2]; // weight of the next and the previous neighbor in the first derivative
+        double gradientCenter; // weight of the point in the first derivative, 0 if evenly spaced
+        double farGradient[2]; // weight of the second next and previous neighbor in the first derivative
+        double laplacian[2]; // weight of the next and the previous neighbor in the second derivative
+        double farLaplacian[2]; // weight of the second next and previous neighbor in the second derivative
+        double laplacianCenter; // weight of the point in the second derivative
+    } AxisWeights;
+
+    /**
+     * A point together with its six neighbors, indexed by Neighbor. Neighbors outside of the simulation are points of
+     * the ghost layer. The second neighbors along an axis only take part in the FourthOrder scheme, away from the
+     * bounded faces. The weights are shared by every point at the same index along an axis, see getAxisWeights
+     */
+    typedef struct {
+        Point *point;
+        Point *neighbors[6];
+        Point *farNeighbors[6]; // second neighbor in the direction of each neighbor, nullptr if it takes no part
+        std::int32_t axisIndices[3]; // index of the point along each axis, into the weights of the axis
+    } Stencil;
+
+    /**
+     * A point of the ghost layer around the simulation. The ghost lies depth points away from the source point in the
+     * direction of the given neighbor, source being the simulated point it borders. If the direction is along a
+     * periodic axis, image is the simulated point the ghost wraps around to on the opposite face. If the source lies on
+     * a symmetry plane, image is the simulated point the ghost mirrors and symmetry the condition of the plane.
+     * Otherwise image is nullptr
+     */
+    typedef struct {
+        Point *point;
+        Point *source;
+        Point *image;
+        Neighbor direction;
+        int depth;
+        Symmetry symmetry;
+    } Ghost;
+
+    /**
+     * The mirror image of a point across one or more symmetry planes
+     */
+    typedef struct {
+        Coordinates coordinates;
+        int faces; // bit (1 << face) is set for every Face whose symmetry plane the image is reflected across
+    } MirrorImage;
 
     /**
      * Constructor based on the number of points per dimension and axis bounds
@@ -35,6 +103,57 @@ public:
      */
     PointManager(double spacingDelta, double startBound, double endBound);
 
+    /**
+     * Constructor for a box shaped part of the cube between the bounds, e.g. a refined patch of a coarser
+     * PointManager. Classification, permittivity and axis indices follow the whole cube, but only the points of the
+     * box are generated, so the ghost layer lines the faces of the box
+     *
+     * @param spacingDelta Spacing between each generated point
+     * @param startBound Starting bound of the whole cube on each axis
+     * @param endBound Ending bound of the whole cube on each axis
+     * @param lowCorner Coordinates of the box's first point
+     * @param numPoints Number of points of the box along each axis, indexed by Axis
+     */
+    PointManager(double spacingDelta, double startBound, double endBound, const Coordinates &lowCorner,
+                 const int numPoints[3]);
+
+    /**
+     * Constructor for a graded grid, with the coordinates of the points given separately along each axis, e.g. fine
+     * spacing across a thin device layer and coarser spacing in the vacuum around it. The cube becomes a box spanning
+     * the first to the last coordinate of each axis, and the permittivity follows the middle of the k axis
+     *
+     * @param iCoordinates Increasing coordinates of the points along the i axis, at least two
+     * @param jCoordinates Increasing coordinates of the points along the j axis, at least two
+     * @param kCoordinates Increasing coordinates of the points along the k axis, at least two
+     */
+    PointManager(const std::vector<double> &iCoordinates, const std::vector<double> &jCoordinates,
+                 const std::vector<double> &kCoordinates);
+
+    /**
+     * Create the coordinates of a graded axis: evenly spaced by fineSpacing across a region of interest, with the
+     * spacing growing by a constant ratio from point to point outside of it until it reaches maxSpacing. The last
+     * spacing before each bound is stretched or shrunk for the axis to end on the bound
+     *
+     * @param startBound First coordinate of the axis
+     * @param endBound Last coordinate of the axis
+     * @param fineStart Start of the evenly spaced region, a point lies on it
+     * @param fineEnd End of the evenly spaced region
+     * @param fineSpacing Spacing inside the region
+     * @param maxSpacing Largest spacing outside of the region
+     * @param growth Ratio between neighboring spacings outside of the region, at least 1
+     * @return Increasing coordinates of the points along the axis
+     */
+    static std::vector<double> createGradedAxis(double startBound, double endBound, double fineStart, double fineEnd,
+                                                double fineSpacing, double maxSpacing, double growth);
+
+    /**
+     * Constructor restoring the grid, boundary conditions, materials and fields from a checkpoint written by
+     * writeCheckpoint
+     *
+     * @param checkpoint Binary input stream positioned at the start of the checkpoint
+     */
+    explicit PointManager(std::istream &checkpoint);
+
     /**
      * PointManager Destructor.
      * Responsible for releasing the collection of points held on the heap
@@ -63,7 +182,74 @@ public:
     int getTotalNumberPoints() const;
 
     /**
-     * Get the spacing delta between generated points
+     * Get the number of points along each axis of the simulated cube
+     *
+     * @return Number of points along one axis
+     */
+    int getNumPointsPerAxis() const;
+
+    /**
+     * Get the index of a coordinate along an axis, i.e. the number of spacing deltas between it and the start bound
+     *
+     * @param coordinate Coordinate along any axis
+     * @return Index of the nearest point along the axis
+     */
+    int getAxisIndex(double coordinate) const;
+
+    /**
+     * Get the number of points along an axis, which may differ between the axes of a graded grid
+     *
+     * @param axis Axis to count the points along
+     * @return Number of points along the axis
+     */
+    int getNumPoints(Axis axis) const;
+
+    /**
+     * Get the index of a coordinate along an axis of an evenly spaced or graded grid
+     *
+     * @param axis Axis of the coordinate
+     * @param coordinate Coordinate along the axis
+     * @return Index of the nearest point along the axis
+     */
+    int getAxisIndex(Axis axis, double coordinate) const;
+
+    /**
+     * Get the coordinate of the point a number of points away along an axis. Beyond the first and the last point the
+     * spacing at that end continues
+     *
+     * @param axis Axis to move along
+     * @param coordinate Coordinate of a point along the axis
+     * @param offset Number of points to move, negative towards the start bound
+     * @return Coordinate of the point offset points away
+     */
+    double getNeighborCoordinate(Axis axis, double coordinate, int offset) const;
+
+    /**
+     * Check if the points are spaced by coordinate arrays instead of a single spacing delta. Solvers working on dense
+     * arrays of evenly spaced points reject graded grids
+     *
+     * @return true if the grid is graded
+     */
+    bool isGraded() const;
+
+    /**
+     * Get the first coordinate along an axis
+     *
+     * @param axis Axis of the bound
+     * @return Coordinate of the first point along the axis
+     */
+    double getStartBound(Axis axis) const;
+
+    /**
+     * Get the last coordinate along an axis
+     *
+     * @param axis Axis of the bound
+     * @return Coordinate of the last point along the axis
+     */
+    double getEndBound(Axis axis) const;
+
+    /**
+     * Get the spacing delta between generated points, the smallest spacing along any axis of a graded grid
      *
      * @return Spacing delta between points
      */
@@ -73,7 +259,7 @@ public:
      * Get point based on coordinates
      *
      * @param target Coordinates class representing the point's coordinates
-     * @return Point object if coordinates are valid, otherwise a point with all coordinates of -1000 is returned
+     * @return Point object if coordinates are valid or in the ghost layer, otherwise nullptr
      */
     Point* getPoint(Coordinates target) const;
 
@@ -81,7 +267,8 @@ public:
      * Get a reference to a point at the given coordinates
      *
      * @param target Coordinates of the Point to get
-     * @return Reference to the point at the given coordinates
+     * @return Reference to the point at the given coordinates, a ghost point if the coordinates are in the ghost layer
+     * and nullptr if they are outside of both
      */
     Point* getPointerToPoint(const Coordinates &target);
 
@@ -133,6 +320,194 @@ public:
      */
     Point* getPrevKNeighbor(const Coordinates &pt);
 
+    /**
+     * Get a point and its six neighbors
+     *
+     * @param target Coordinates of the point
+     * @return Stencil of the point, the neighbors of a simulated point are never nullptr
+     */
+    Stencil getStencil(const Coordinates &target);
+
+    /**
+     * Get the derivative weights of a simulated point's stencil along an axis: the fourth order central differences
+     * where the stencil has second neighbors along the axis, else the second order weights at its index
+     *
+     * @param stencil Stencil of a simulated point
+     * @param axis Axis to differentiate along
+     * @return Weights of the point and its neighbors along the axis
+     */
+    inline const AxisWeights &getAxisWeights(const Stencil &stencil, Axis axis) const {
+        return stencil.farNeighbors[2 * axis] ? fourthOrderWeights : axisWeights[axis][stencil.axisIndices[axis]];
+    }
+
+    /**
+     * Get the stencils of all simulated points. Neighbors outside of the simulation are ghost points, so sweeps over
+     * the stencils need no checks for missing neighbors. The list is built on first use
+     *
+     * @return Reference to the stencils
+     */
+    const std::vector<Stencil> &getStencils();
+
+    /**
+     * Set the number of ghost points added beyond every boundary point, i.e. the largest stencil reach. The ghost layer
+     * is rebuilt and the previously filled ghost values are lost
+     *
+     * @param width Width of the ghost layer, at least 1
+     */
+    void setGhostWidth(int width);
+
+    /**
+     * Get the number of ghost points beyond every boundary point
+     *
+     * @return Width of the ghost layer
+     */
+    int getGhostWidth() const;
+
+    /**
+     * Select the finite differences the solvers take the curl, gradient and Laplacian with.
+     * SecondOrder uses the six neighbors of a point. FourthOrder adds the second neighbors along each axis and widens
+     * the ghost layer to 2. CompactFourthOrder couples the derivatives of neighboring points along every line of
+     * points, see FieldSolver, and the Laplacian to the twelve diagonal neighbors, see InitialVoltageCalculator, so
+     * its stencils keep the second order weights. Within reach of a bounded face the ghosts only carry the boundary
+     * condition, so the points there close the fourth order schemes with the second order weights. Graded grids only
+     * support SecondOrder
+     *
+     * @param scheme Finite differences to use
+     */
+    void setDifferenceScheme(DifferenceScheme scheme);
+
+    /**
+     * Get the finite differences the solvers take the derivatives with
+     *
+     * @return Selected scheme
+     */
+    DifferenceScheme getDifferenceScheme() const;
+
+    /**
+     * Get all points of the ghost layer
+     *
+     * @return Reference to the ghost points
+     */
+    const std::vector<Ghost> &getGhosts() const;
+
+    /**
+     * Fill the electric and magnetic fields of the ghost layer at a given time. Ghosts on a periodic axis copy the
+     * point they wrap around to, every other ghost copies the point it borders, i.e. the fields do not change across
+     * the boundary. Must be called before every sweep reading neighbor fields at that time. Does nothing while the
+     * ghosts are filled externally
+     *
+     * @param time Time of the fields to fill
+     */
+    void fillGhostFields(double time);
+
+    /**
+     * Fill the voltage of the ghost layer. Ghosts on a periodic axis take the voltage of the point they wrap around
+     * to, every other ghost is grounded. Does nothing while the ghosts are filled externally
+     */
+    void fillGhostVoltages();
+
+    /**
+     * Leave the ghost layer to the owner of the PointManager, e.g. a MeshHierarchy interpolating the ghosts of a
+     * refined patch from the coarser level. fillGhostFields and fillGhostVoltages then leave the ghost values untouched
+     *
+     * @param external true to fill the ghosts externally, false to fill them from the boundary conditions
+     */
+    void setExternalGhostFill(bool external);
+
+    /**
+     * Check if the ghost layer is filled by the owner of the PointManager
+     *
+     * @return true if fillGhostFields and fillGhostVoltages leave the ghosts untouched
+     */
+    bool hasExternalGhostFill() const;
+
+    /**
+     * Make an axis periodic or bounded. Along a periodic axis the point after the end face is the point on the start
+     * face, so the cube is a single unit cell of a structure repeating along that axis. The ghost layer is rebuilt and
+     * the previously filled ghost values are lost. The Yee solver reads the periodicity again before its next step,
+     * the brick solver only when it is constructed. The axes of a graded grid can not be periodic
+     *
+     * @param axis Axis to change
+     * @param periodic true to wrap around, false to bound the axis by its faces
+     */
+    void setPeriodic(Axis axis, bool periodic);
+
+    /**
+     * Check if an axis wraps around
+     *
+     * @param axis Axis to check
+     * @return true if the axis is periodic
+     */
+    bool isPeriodic(Axis axis) const;
+
+    /**
+     * Make the outermost points of a face a mirror symmetry plane, so a run covers half of a symmetric device, or a
+     * quarter with planes along two axes. The ghosts beyond the face mirror the points inside:
+     * ElectricWall is a perfect electric conductor, the tangential E and the normal B are odd across the plane and
+     * the voltage is 0 on it (Dirichlet). MagneticWall is a perfect magnetic conductor, the tangential B and the normal
+     * E are odd across the plane and the voltage is even (Neumann), e.g. the planes through the axis of a rod.
+     * For a box shaped PointManager the face is the face of the box. The ghost layer is rebuilt and the previously
+     * filled ghost values are lost. Periodic axes, faces with an absorbing layer and the opposite face of a plane can
+     * not be symmetry planes
+     *
+     * @param face Face of the simulated points to turn into a symmetry plane
+     * @param symmetry Condition of the plane, NoSymmetry to restore the face's boundary
+     */
+    void setSymmetry(Face face, Symmetry symmetry);
+
+    /**
+     * Get the mirror condition of a face
+     *
+     * @param face Face of the simulated points
+     * @return Condition of the symmetry plane, NoSymmetry if the face is not one
+     */
+    Symmetry getSymmetry(Face face) const;
+
+    /**
+     * Log the full domain of a run reduced by symmetry planes. Every logger, including OutputScheduler, then writes
+     * each point together with its mirror images across the planes, the fields and voltages reflected with the
+     * parity of each plane
+     *
+     * @param fullDomain true to write the mirror images, false to write the simulated points only
+     */
+    void setFullDomainOutput(bool fullDomain);
+
+    /**
+     * Check if the loggers write the mirror images of the points
+     *
+     * @return true if the full domain is logged
+     */
+    bool hasFullDomainOutput() const;
+
+    /**
+     * Get the locations a point is logged at, see setFullDomainOutput. Points on a symmetry plane are their own image
+     * across it
+     *
+     * @param target Coordinates of a simulated point
+     * @return The point itself followed by its mirror images if the full domain is logged
+     */
+    std::vector<MirrorImage> getMirrorImages(const Coordinates &target) const;
+
+    /**
+     * Reflect a field of a point onto one of its mirror images
+     *
+     * @param field Field at the point
+     * @param image Mirror image of the point
+     * @param magnetic true for the magnetic field, which reflects like an axial vector, false for the electric and
+     * current fields
+     * @return Field at the mirror image
+     */
+    FieldVector reflectField(const FieldVector &field, const MirrorImage &image, bool magnetic) const;
+
+    /**
+     * Reflect the voltage of a point onto one of its mirror images
+     *
+     * @param voltage Voltage at the point
+     * @param image Mirror image of the point
+     * @return Voltage at the mirror image
+     */
+    double reflectVoltage(double voltage, const MirrorImage &image) const;
+
     /**
      * Set the voltage at a specific point if the point exists
      *
@@ -157,6 +532,111 @@ public:
      */
     double getConductivity(Coordinates target);
 
+    /**
+     * Set the material of a given point, e.g. one defined with MaterialTable::defineMaterial
+     *
+     * @param target Coordinates of the point
+     * @param material ID of the material in the MaterialTable
+     */
+    void setMaterial(const Coordinates &target, MaterialTable::Id material);
+
+    /**
+     * Get the material of a given point
+     *
+     * @param target Coordinates of the point
+     * @return ID of the point's material in the MaterialTable
+     */
+    MaterialTable::Id getMaterialId(const Coordinates &target) const;
+
+    /**
+     * Get a counter that changes every time the conductivity of a point is set through this PointManager.
+     * Solvers compare it against the value they last saw to know when cached lists of conducting points are stale
+     *
+     * @return Conductivity revision counter
+     */
+    std::uint64_t getConductivityRevision() const;
+
+    /**
+     * Get a counter that changes every time the ghost layer is rebuilt or the difference scheme is selected, i.e. every
+     * time the stencils are rebuilt. Solvers compare it against the value they last saw to know when structures built
+     * over the stencils are stale
+     *
+     * @return Layout revision counter
+     */
+    std::uint64_t getLayoutRevision() const;
+
+    /**
+     * Get a counter that changes every time a field is set through this PointManager, the ghost fields are filled or
+     * the ghost layer is rebuilt. Solvers compare it against the value they last saw to know when values derived from
+     * the fields are stale. Fields set on the points directly do not change it
+     *
+     * @return Field revision counter
+     */
+    std::uint64_t getFieldRevision() const;
+
+    /**
+     * Get the allocation counters of the arena holding the points and their field histories, ghost points included
+     *
+     * @return Allocation counters of the points
+     */
+    ArenaStatistics getAllocationStatistics() const;
+
+    /**
+     * Set the thickness of the absorbing layer inside a face of the cube. Waves entering the layer are attenuated
+     * gradually, so they leave the simulation instead of reflecting off the face. Faces of periodic axes can not have
+     * a layer
+     *
+     * @param face Face to line with the layer
+     * @param thickness Thickness of the layer in coordinate units, 0 removes the layer
+     */
+    void setAbsorbingLayerThickness(Face face, double thickness);
+
+    /**
+     * Get the thickness of the absorbing layer inside a face of the cube
+     *
+     * @param face Face of the cube
+     * @return Thickness of the layer, 0 if the face has none
+     */
+    double getAbsorbingLayerThickness(Face face) const;
+
+    /**
+     * Get a counter that changes every time an absorbing layer thickness is set.
+     * Solvers compare it against the value they last saw to know when cached attenuation coefficients are stale
+     *
+     * @return Absorbing layer revision counter
+     */
+    std::uint64_t getAbsorbingLayerRevision() const;
+
+    /**
+     * Classify a location by the absorbing layers it lies in, like classifyPoint does with the faces of the cube:
+     * Normal outside of every layer, Top, Bottom or Side_Face inside a single layer, Edge inside two layers of
+     * different axes and Corner inside three
+     *
+     * @param target Coordinates of the location, it does not need to be a point
+     * @return Classification of the location within the absorbing layers
+     */
+    Point::Classification classifyAbsorbingLayerPoint(const Coordinates &target) const;
+
+    /**
+     * Calculate the attenuation per unit length at a location. It grows from 0 at the inner side of a layer with the
+     * ABSORBING_LAYER_GRADING_ORDER power of the depth, such that a normally incident wave is reflected with an
+     * amplitude of ABSORBING_LAYER_REFLECTION. Overlapping layers at edges and corners add up
+     *
+     * @param target Coordinates of the location, it does not need to be a point
+     * @return Attenuation per unit length, multiply by the local wave speed to get the damping rate of the fields
+     */
+    double calculateAbsorbingLayerAttenuation(const Coordinates &target) const;
+
+    /**
+     * Calculate the attenuation per unit length at a location due to the layers of the two faces normal to an axis,
+     * i.e. the attenuation of the derivatives along that axis in a perfectly matched layer
+     *
+     * @param target Coordinates of the location, it does not need to be a point
+     * @param axis Axis normal to the faces
+     * @return Attenuation per unit length along the axis
+     */
+    double calculateAbsorbingLayerAttenuation(const Coordinates &target, Axis axis) const;
+
     /**
      * Get a pointer to the hashmap containing all generated points
      *
@@ -274,14 +754,6 @@ public:
      */
     double getMidPointBetweenBounds();
 
-    /**
-     * Check if a given point is considered to be null
-     *
-     * @param target Const qualified point target to check
-     * @return true if target is equal to the null Point, false otherwise
-     */
-    bool checkIfNullPoint(const Point &target);
-
     /**
     * Set the current field at a given point
     *
@@ -309,11 +781,78 @@ public:
      */
     void setMagneticField(const Coordinates& target, FieldVector magneticField, double time);
 
+    /**
+     * Serialize the grid parameters, the boundary conditions and difference scheme, each point's material properties
+     * and the electric, magnetic and current fields at a single time level into a binary stream. Fields at any other
+     * time are not written
+     *
+     * @param outs Binary output stream to write the checkpoint to
+     * @param time Time level of the fields to write
+     */
+    void writeCheckpoint(std::ostream &outs, double time);
+
+    /**
+     * Get the version of the checkpoint this grid was restored from, so the parts of the checkpoint written after the
+     * grid's can be read according to it
+     *
+     * @return Checkpoint version, 0 if the grid was not restored from a checkpoint
+     */
+    std::uint32_t getCheckpointVersion() const;
+
 private:
-    int numPointsPerDim, vacuumPermittivity, gaasPermittivity; //num points per dimension
+    typedef enum {HasElectricField = 1, HasMagneticField = 2, HasCurrentField = 4} CheckpointFieldFlags;
+
+    static const char checkpointMagic[8];
+    static const std::uint32_t checkpointVersion = 4;
+
+    int numPointsPerDim; //num points per dimension
+    MaterialTable::Id upperMaterial, lowerMaterial; // materials above and below the middle of the k axis
     double spacingDelta, startBound, endBound;
+    std::uint64_t conductivityRevision, absorbingLayerRevision, layoutRevision, fieldRevision;
+    double absorbingLayerThickness[6]; // indexed by Face
+    bool periodic[3]; // indexed by Axis
+    Symmetry symmetry[6]; // indexed by Face
+    double symmetryPlane[6]; // coordinate of the outermost points of each face along its axis, set with its symmetry
+    bool fullDomainOutput;
+    std::uint32_t restoredCheckpointVersion;
+    std::vector<double> axisCoordinates[3]; // coordinates of the points along each axis of a graded grid, else empty
+    bool externalGhostFill;
     std::unordered_map<Coordinates, Point*, CoordinateHasher>* pointMap;
-    Point *nullPoint;
+    PointCollection *ghostMap;
+    PointArena *arena; // owns the points of both maps
+    std::vector<Ghost> ghosts;
+    int ghostWidth;
+    DifferenceScheme differenceScheme;
+    std::vector<Stencil> stencils;
+    bool stencilsBuilt;
+    std::vector<AxisWeights> axisWeights[3]; // second order weights by index along each axis, built with the stencils
+    AxisWeights fourthOrderWeights; // of every axis a stencil has second neighbors along
+
+    /**
+     * Set the members shared by all constructors to their defaults: no boundary conditions or absorbing layers, the
+     * default materials, second order differences and empty point maps in a new arena
+     */
+    void initializeState();
+
+    /**
+     * Add ghost points beyond every point missing a neighbor, up to the ghost width
+     */
+    void buildGhostLayer();
+
+    /**
+     * Delete all ghost points
+     */
+    void deleteGhostLayer();
+
+    /**
+     * Get the factors that mirror the components of a field across a symmetry plane
+     *
+     * @param symmetry Condition of the plane
+     * @param axis Axis normal to the plane
+     * @param magnetic true for the magnetic field, an axial vector
+     * @param signs Receives the factor of each component, indexed by Axis
+     */
+    static void getReflectionSigns(Symmetry symmetry, Axis axis, bool magnetic, double signs[3]);
 
     /**
      * Calculate the total number of points based on given bounds and spacing delta
@@ -330,11 +869,55 @@ private:
      */
     Point::Classification classifyPoint(const Coordinates& ptCoor);
 
+    /**
+     * Classify a given location based on the faces of the cube it lies within a margin of
+     *
+     * @param ptCoor Coordinates of the location
+     * @param margins Distance from each face, indexed by Face, within which a location counts as lying on the face
+     * @return Enum entry representing the location's classification
+     */
+    Point::Classification classifyPoint(const Coordinates& ptCoor, const double margins[6]) const;
+
     /**
     * Generate all points within the given parameters, i.e. bounds, spacing delta, and total number of points
     */
     void generatePoints();
 
+    /**
+     * Generate the points of a graded grid from the coordinate arrays
+     */
+    void generateGradedPoints();
+
+    /**
+     * Calculate the second order derivative weights at every index along each axis from the distances to the
+     * neighboring coordinates, and the fourth order weights from the spacing
+     */
+    void calculateAxisWeights();
+
+    /**
+     * Set the second neighbors of a stencil along every axis whose second neighbors are simulated points or periodic
+     * ghosts, the fourth order central differences are taken along these axes
+     *
+     * @param stencil Stencil with the point set
+     */
+    void findFarNeighbors(Stencil &stencil);
+
+    /**
+     * Generate the points of a box, see the box constructor
+     *
+     * @param lowCorner Coordinates of the box's first point
+     * @param numPoints Number of points of the box along each axis
+     */
+    void generatePoints(const Coordinates &lowCorner, const int numPoints[3]);
+
+    /**
+     * Create a classified point with the permittivity of the material at its height, without adding it to the points
+     *
+     * @param ptCoor Coordinates of the point
+     * @return Newly allocated point
+     */
+    Point *createPoint(const Coordinates &ptCoor);
+
     /**
      * Import initial voltages from a file.
      * File format needs to be of the form: iCoordinate jCoordinate kCoordinate voltage
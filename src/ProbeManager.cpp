@@ -0,0 +1,174 @@
+#include "ProbeManager.h"
+
+#include <algorithm>
+
+const int ProbeManager::valuesPerPoint;
+
+ProbeManager::ProbeManager(PointManager *pm, const std::string &outputPathPrefix, int samplesPerFlush) {
+    if (samplesPerFlush <= 0)
+        throw std::invalid_argument("Probe buffers must hold at least one sample");
+
+    this->pm = pm;
+    this->outputPathPrefix = outputPathPrefix;
+    this->samplesPerFlush = samplesPerFlush;
+}
+
+ProbeManager::~ProbeManager() {
+    for (auto &probe : probes) {
+        try {
+            flushProbe(probe);
+        } catch (const std::exception &e) { // never throw from the destructor
+            std::cerr << e.what() << std::endl;
+        }
+    }
+}
+
+void ProbeManager::addPointProbe(const std::string &name, const Coordinates &target) {
+    if (!pm->checkPointExists(target))
+        throw std::invalid_argument("Probe point does not exist");
+
+    addProbe(name, std::vector<Point *>(1, pm->getPointerToPoint(target)));
+}
+
+void ProbeManager::addLineProbe(const std::string &name, const Coordinates &start, PointManager::Axis axis,
+                                double length) {
+    double spacingDelta = pm->getSpacingDelta();
+    std::vector<Point *> points;
+
+    if (pm->isGraded()) { // walk from point to point, the spacing changes along the line
+        double coordinates[] = {start.getI(), start.getJ(), start.getK()};
+        double end = coordinates[axis] + length + spacingDelta / 2;
+        Coordinates target(coordinates[0], coordinates[1], coordinates[2]);
+
+        while (coordinates[axis] <= end && pm->checkPointExists(target)) {
+            points.push_back(pm->getPointerToPoint(target));
+            coordinates[axis] = pm->getNeighborCoordinate(axis, coordinates[axis], 1);
+            target = Coordinates(coordinates[0], coordinates[1], coordinates[2]);
+        }
+    } else {
+        auto numSteps = (int) std::floor(length / spacingDelta + 0.5);
+
+        for (int n = 0; n <= numSteps; n++) {
+            double offset = n * spacingDelta;
+            Coordinates target(start.getI() + (axis == PointManager::IAxis ? offset : 0),
+                               start.getJ() + (axis == PointManager::JAxis ? offset : 0),
+                               start.getK() + (axis == PointManager::KAxis ? offset : 0));
+
+            if (pm->checkPointExists(target))
+                points.push_back(pm->getPointerToPoint(target));
+        }
+    }
+
+    if (points.empty())
+        throw std::invalid_argument("Probe line does not contain any points");
+
+    addProbe(name, points);
+}
+
+void ProbeManager::addPlaneProbe(const std::string &name, PointManager::Axis normal, double position) {
+    double tolerance = pm->getSpacingDelta() / 2;
+    std::vector<Point *> points;
+
+    for (const auto &p : *pm->getCollectionOfPoints()) {
+        double coordinate = normal == PointManager::IAxis ? p.first.getI() :
+                            normal == PointManager::JAxis ? p.first.getJ() : p.first.getK();
+
+        if (std::abs(coordinate - position) < tolerance)
+            points.push_back(p.second);
+    }
+
+    if (points.empty())
+        throw std::invalid_argument("Probe plane does not contain any points");
+
+    // Hash map iteration order is arbitrary, keep probe files in a stable i, j, k order
+    std::sort(points.begin(), points.end(), [](const Point *lhs, const Point *rhs) {
+        Coordinates a = lhs->getCoordinates(), b = rhs->getCoordinates();
+
+        if (a.getI() != b.getI())
+            return a.getI() < b.getI();
+
+        if (a.getJ() != b.getJ())
+            return a.getJ() < b.getJ();
+
+        return a.getK() < b.getK();
+    });
+
+    addProbe(name, points);
+}
+
+void ProbeManager::addProbe(const std::string &name, const std::vector<Point *> &points) {
+    Probe probe;
+    probe.filePath = outputPathPrefix + name;
+    probe.points = points;
+    probe.samples.resize(samplesPerFlush * (1 + valuesPerPoint * points.size()));
+    probe.bufferedSamples = 0;
+    probe.fileCreated = false;
+
+    probes.push_back(probe);
+}
+
+void ProbeManager::sample(double time) {
+    const FieldVector zeroVector(0, 0, 0);
+
+    for (auto &probe : probes) {
+        if (probe.bufferedSamples == samplesPerFlush)
+            flushProbe(probe);
+
+        double *sample = &probe.samples[probe.bufferedSamples * (1 + valuesPerPoint * probe.points.size())];
+        *sample++ = time;
+
+        for (Point *p : probe.points) {
+            const FieldVector *fields[] = {p->getElectricField(time), p->getMagneticField(time),
+                                           p->getCurrentField(time)};
+
+            for (const FieldVector *field : fields) {
+                const FieldVector &value = field ? *field : zeroVector; // missing fields are recorded as zero
+
+                *sample++ = value.getIComp();
+                *sample++ = value.getJComp();
+                *sample++ = value.getKComp();
+            }
+        }
+
+        probe.bufferedSamples++;
+    }
+}
+
+void ProbeManager::flush() {
+    for (auto &probe : probes)
+        flushProbe(probe);
+}
+
+int ProbeManager::getNumberOfProbes() const {
+    return probes.size();
+}
+
+void ProbeManager::flushProbe(Probe &probe) {
+    if (probe.bufferedSamples == 0)
+        return;
+
+    // The first flush truncates any file left over from a previous run, later flushes append
+    std::fstream probeFile(probe.filePath, probe.fileCreated ? std::ios::out | std::ios::app : std::ios::out);
+
+    if (!probeFile.is_open())
+        throw std::invalid_argument("File path to log probe does not exist");
+
+    const double *sample = probe.samples.data();
+
+    for (int s = 0; s < probe.bufferedSamples; s++) {
+        double time = *sample++;
+
+        for (Point *p : probe.points) {
+            probeFile << time << " " << *p;
+
+            for (int v = 0; v < valuesPerPoint; v++)
+                probeFile << " " << *sample++;
+
+            probeFile << "\n";
+        }
+    }
+
+    probeFile.close();
+    probe.bufferedSamples = 0;
+    probe.fileCreated = true;
+}
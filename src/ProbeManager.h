@@ -0,0 +1,120 @@
+#ifndef _PROBEMANAGER_H
+#define _PROBEMANAGER_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <cmath>
+
+#include "PointManager.h"
+#include "Coordinates.h"
+#include "FieldVector.h"
+
+/**
+ * Class ProbeManager is responsible for recording the electric, magnetic and current fields at a small set of
+ * points every time step, without logging the whole grid.
+ * Probes are registered before the run, samples are collected into preallocated buffers and each probe is
+ * flushed to its own file once its buffer is full and when flush() is called.
+ * Each line of a probe file has the form (curly braces are present for documentation purposes only):
+ * {time} {Point i comp.} {Point j comp.} {Point k comp.} {E. Field i j k comps.} {M. Field i j k comps.} {J. Field i j k comps.}
+ */
+class ProbeManager {
+public:
+    /**
+     * Construct a ProbeManager for the points of a given PointManager
+     *
+     * @param pm PointManager that contains all points for the simulation
+     * @param outputPathPrefix Prefix prepended to each probe name to form the probe's file path
+     * @param samplesPerFlush Number of time steps buffered in memory before a probe is written to its file
+     */
+    ProbeManager(PointManager *pm, const std::string &outputPathPrefix, int samplesPerFlush = 1000);
+
+    /**
+     * Destructor, flushes any samples that have not been written yet
+     */
+    ~ProbeManager();
+
+    /**
+     * Register a probe at a single point
+     *
+     * @param name Name of the probe, used as the suffix of its file path
+     * @param target Coordinates of the point to record
+     */
+    void addPointProbe(const std::string &name, const Coordinates &target);
+
+    /**
+     * Register a probe recording every point along an axis aligned line, both ends inclusive
+     *
+     * @param name Name of the probe, used as the suffix of its file path
+     * @param start Coordinates of the first point on the line
+     * @param axis Axis the line runs along
+     * @param length Length of the line along the axis
+     */
+    void addLineProbe(const std::string &name, const Coordinates &start, PointManager::Axis axis, double length);
+
+    /**
+     * Register a probe recording every point in a plane normal to an axis
+     *
+     * @param name Name of the probe, used as the suffix of its file path
+     * @param normal Axis normal to the plane
+     * @param position Coordinate of the plane along the normal axis
+     */
+    void addPlaneProbe(const std::string &name, PointManager::Axis normal, double position);
+
+    /**
+     * Record the fields of every probed point at a given time
+     *
+     * @param time Time of the fields to record
+     */
+    void sample(double time);
+
+    /**
+     * Write all buffered samples to their probe files
+     */
+    void flush();
+
+    /**
+     * Get the number of registered probes
+     *
+     * @return Number of registered probes
+     */
+    int getNumberOfProbes() const;
+
+private:
+    /**
+     * A registered probe, the points it records and its buffered samples.
+     * Each buffered sample holds the time followed by the 9 field components of every point
+     */
+    struct Probe {
+        std::string filePath;
+        std::vector<Point *> points;
+        std::vector<double> samples;
+        int bufferedSamples;
+        bool fileCreated;
+    };
+
+    static const int valuesPerPoint = 9;
+
+    PointManager *pm;
+    std::string outputPathPrefix;
+    int samplesPerFlush;
+    std::vector<Probe> probes;
+
+    /**
+     * Create a probe and preallocate its sample buffer
+     *
+     * @param name Name of the probe
+     * @param points Points recorded by the probe
+     */
+    void addProbe(const std::string &name, const std::vector<Point *> &points);
+
+    /**
+     * Write a probe's buffered samples to its file and empty the buffer
+     *
+     * @param probe Probe to flush
+     */
+    void flushProbe(Probe &probe);
+};
+
+#endif //QUANTUMFOUNDRY_PROBEMANAGER_H
@@ -0,0 +1,515 @@
+#include "ReducedSolver.h"
+
+const int ReducedSolver::numComponents;
+
+ReducedSolver::ReducedSolver(PointManager *pm, PointManager::Axis invariantAxis, double sliceCoordinate,
+                             double timeStep, double drudeScatteringTime) {
+    this->pm = pm;
+    checkPointManager();
+
+    this->geometry = Planar;
+    this->axes[0] = (PointManager::Axis) ((invariantAxis + 1) % 3);
+    this->axes[1] = (PointManager::Axis) ((invariantAxis + 2) % 3);
+    this->axes[2] = invariantAxis;
+    this->spacingDelta = pm->getSpacingDelta();
+    this->numU = this->numV = pm->getNumPointsPerAxis();
+
+    this->origin[axes[0]] = pm->getStartBound();
+    this->origin[axes[1]] = pm->getStartBound();
+    this->origin[invariantAxis] = pm->getStartBound() + pm->getAxisIndex(sliceCoordinate) * spacingDelta;
+
+    this->periodic[UAxis] = pm->isPeriodic(axes[0]);
+    this->periodic[VAxis] = pm->isPeriodic(axes[1]);
+
+    this->timeStep = timeStep;
+    this->currentTime = 0.0;
+    this->drudeScatteringTime = drudeScatteringTime;
+    this->initEFieldCalculated = false;
+
+    readCrossSection();
+    calculateCoefficients();
+}
+
+ReducedSolver::ReducedSolver(PointManager *pm, PointManager::Axis symmetryAxis, const Coordinates &axisPoint,
+                             double timeStep, double drudeScatteringTime) {
+    this->pm = pm;
+    checkPointManager();
+
+    this->geometry = Axisymmetric;
+    this->axes[0] = symmetryAxis;
+    this->axes[1] = (PointManager::Axis) ((symmetryAxis + 1) % 3);
+    this->axes[2] = (PointManager::Axis) ((symmetryAxis + 2) % 3);
+    this->spacingDelta = pm->getSpacingDelta();
+
+    if (pm->isPeriodic(axes[1]) || pm->isPeriodic(axes[2]))
+        throw std::invalid_argument("Only the symmetry axis of an axisymmetric solver can be periodic");
+
+    // the symmetry axis passes through the nearest line of points
+    const double axisCoordinates[] = {axisPoint.getI(), axisPoint.getJ(), axisPoint.getK()};
+    this->origin[symmetryAxis] = pm->getStartBound();
+
+    for (int axis = 1; axis < 3; axis++)
+        this->origin[axes[axis]] = pm->getStartBound() + pm->getAxisIndex(axisCoordinates[axes[axis]]) * spacingDelta;
+
+    double maxRadius = 0.0;
+
+    for (const auto &p : *pm->getCollectionOfPoints()) {
+        const double coordinates[] = {p.first.getI(), p.first.getJ(), p.first.getK()};
+        maxRadius = std::max(maxRadius, std::hypot(coordinates[axes[1]] - origin[axes[1]],
+                                                   coordinates[axes[2]] - origin[axes[2]]));
+    }
+
+    this->numU = pm->getNumPointsPerAxis();
+    this->numV = std::max(2, (int) std::ceil(maxRadius / spacingDelta - 1.0e-9) + 1);
+
+    this->periodic[UAxis] = pm->isPeriodic(symmetryAxis);
+    this->periodic[VAxis] = false;
+
+    this->timeStep = timeStep;
+    this->currentTime = 0.0;
+    this->drudeScatteringTime = drudeScatteringTime;
+    this->initEFieldCalculated = false;
+
+    readCrossSection();
+    calculateCoefficients();
+}
+
+void ReducedSolver::checkPointManager() const {
+    if (pm->isGraded())
+        throw std::invalid_argument("The reduced solvers need evenly spaced points");
+
+    if (pm->getDifferenceScheme() != PointManager::SecondOrder)
+        throw std::invalid_argument("The reduced solvers only support second order differences");
+
+    for (int face = PointManager::IStartFace; face <= PointManager::KEndFace; face++) {
+        if (pm->getSymmetry((PointManager::Face) face) != PointManager::NoSymmetry)
+            throw std::invalid_argument("The reduced solvers do not support symmetry planes");
+
+        if (pm->getAbsorbingLayerThickness((PointManager::Face) face) > 0)
+            throw std::invalid_argument("The reduced solvers do not support absorbing layers");
+    }
+}
+
+void ReducedSolver::readCrossSection() {
+    std::size_t totalNumPoints = getTotalNumberPoints();
+    std::vector<bool> found(totalNumPoints, false);
+
+    for (auto &component : components)
+        component.assign(totalNumPoints, 0.0);
+
+    permittivity.assign(totalNumPoints, 1.0);
+    conductivity.assign(totalNumPoints, 0.0);
+    voltage.assign(totalNumPoints, 0.0);
+
+    int originIndex[3];
+
+    for (int axis = 0; axis < 3; axis++)
+        originIndex[axis] = pm->getAxisIndex(origin[axis]);
+
+    for (const auto &p : *pm->getCollectionOfPoints()) {
+        const double coordinates[] = {p.first.getI(), p.first.getJ(), p.first.getK()};
+        int index[3];
+
+        for (int axis = 0; axis < 3; axis++)
+            index[axis] = pm->getAxisIndex(coordinates[axis]) - originIndex[axis];
+
+        // planar: the plane through the slice, axisymmetric: the half plane on the positive side of the axis
+        if (index[axes[2]] != 0 || index[axes[0]] < 0 || index[axes[1]] < 0)
+            continue;
+
+        if (index[axes[0]] >= numU || index[axes[1]] >= numV)
+            continue;
+
+        std::size_t n = getIndex(index[axes[0]], index[axes[1]]);
+        permittivity[n] = p.second->getPermittivity();
+        conductivity[n] = p.second->getConductivity();
+        voltage[n] = p.second->getVoltage();
+        found[n] = true;
+    }
+
+    if (geometry == Planar)
+        return;
+
+    // past the half plane the outermost points continue out to the farthest radius
+    for (int u = 0; u < numU; u++) {
+        for (int v = 1; v < numV; v++) {
+            std::size_t n = getIndex(u, v);
+
+            if (found[n] || !found[n - 1])
+                continue;
+
+            permittivity[n] = permittivity[n - 1];
+            conductivity[n] = conductivity[n - 1];
+            voltage[n] = voltage[n - 1];
+            found[n] = true;
+        }
+    }
+}
+
+std::ptrdiff_t ReducedSolver::getNextOffset(ReducedAxis axis, int position) const {
+    std::ptrdiff_t stride = axis == UAxis ? numV : 1;
+    int numPoints = axis == UAxis ? numU : numV;
+
+    if (position < numPoints - 1)
+        return stride;
+
+    return periodic[axis] ? -(numPoints - 1) * stride : 0;
+}
+
+std::ptrdiff_t ReducedSolver::getPrevOffset(ReducedAxis axis, int position) const {
+    std::ptrdiff_t stride = axis == UAxis ? numV : 1;
+    int numPoints = axis == UAxis ? numU : numV;
+
+    if (position > 0)
+        return stride;
+
+    return periodic[axis] ? -(numPoints - 1) * stride : 0;
+}
+
+void ReducedSolver::calculateCoefficients() {
+    std::size_t totalNumPoints = getTotalNumberPoints();
+
+    currentDecay = std::exp(-timeStep / drudeScatteringTime);
+    double gainFactor = -std::expm1(-timeStep / drudeScatteringTime); // 1 - currentDecay
+
+    for (int direction = 0; direction < 3; direction++) {
+        electricCoefficient[direction].assign(totalNumPoints, 0.0);
+        currentGain[direction].assign(totalNumPoints, 0.0);
+
+        for (int u = 0; u < numU; u++) {
+            for (int v = 0; v < numV; v++) {
+                std::size_t index = getIndex(u, v);
+                std::ptrdiff_t next = direction == 0 ? getNextOffset(UAxis, u) :
+                                      direction == 1 ? getNextOffset(VAxis, v) : 0;
+
+                if (direction < 2 && next == 0) // no edge past the last point
+                    continue;
+
+                // E along w sits on the point itself, along u and v on the edge to the next point
+                double edgePermittivity = (permittivity[index] + permittivity[index + next]) / 2;
+                double conductivityA = conductivity[index], conductivityB = conductivity[index + next];
+
+                // an edge only conducts if both of its points do, the harmonic mean is zero otherwise
+                double edgeConductivity = conductivityA + conductivityB == 0 ? 0 :
+                                          2 * conductivityA * conductivityB / (conductivityA + conductivityB);
+
+                electricCoefficient[direction][index] = timeStep * SPEED_OF_LIGHT_SQUARED / edgePermittivity;
+                currentGain[direction][index] = edgeConductivity * gainFactor;
+            }
+        }
+    }
+}
+
+void ReducedSolver::calculateInitialVoltage() {
+    // successive over-relaxation of the Laplacian, (1 / m) d/dv (m dV/dv) + d^2V/du^2 with the metric m of v. On the
+    // symmetry axis the radial part becomes 4 (V(1) - V(0)) / h^2
+    double relaxation = 2 / (1 + std::sin(M_PI / std::max(numU, numV)));
+    double maxChange, maxVoltage;
+
+    do {
+        maxChange = 0.0;
+        maxVoltage = 0.0;
+
+        for (int u = 0; u < numU; u++) {
+            for (int v = 0; v < numV; v++) {
+                std::size_t index = getIndex(u, v);
+
+                if (conductivity[index] > 0) // electrodes keep their voltage
+                    continue;
+
+                std::ptrdiff_t nextU = getNextOffset(UAxis, u), prevU = getPrevOffset(UAxis, u);
+                std::ptrdiff_t nextV = getNextOffset(VAxis, v), prevV = getPrevOffset(VAxis, v);
+                bool onAxis = geometry == Axisymmetric && v == 0;
+                double weightNext = onAxis ? 4.0 : getMetric(2 * v + 1) / getMetric(2 * v);
+                double weightPrev = onAxis ? 0.0 : getMetric(2 * v - 1) / getMetric(2 * v);
+
+                // the voltage beyond a bounded face is 0
+                double neighborSum = (nextU ? voltage[index + nextU] : 0.0) + (prevU ? voltage[index - prevU] : 0.0) +
+                                     weightNext * (nextV ? voltage[index + nextV] : 0.0) +
+                                     weightPrev * (prevV ? voltage[index - prevV] : 0.0);
+                double change = relaxation * (neighborSum / (2 + weightNext + weightPrev) - voltage[index]);
+
+                voltage[index] += change;
+                maxChange = std::max(maxChange, std::fabs(change));
+                maxVoltage = std::max(maxVoltage, std::fabs(voltage[index]));
+            }
+        }
+    } while (maxChange > REDUCED_VOLTAGE_TOLERANCE * maxVoltage);
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        int u;
+        double v, cosine, sine;
+
+        if (p.second->getConductivity() > 0 || !locatePoint(p.first, u, v, cosine, sine))
+            continue;
+
+        p.second->setVoltage(interpolate(voltage.data(), false, false, false, u, v));
+    }
+}
+
+void ReducedSolver::calculateAndSetInitialElectricField() {
+    if (initEFieldCalculated)
+        throw std::invalid_argument("The initial electric field was already calculated");
+
+    double *eU = getComponent(ElectricU), *eV = getComponent(ElectricV);
+
+    for (int u = 0; u < numU; u++) {
+        for (int v = 0; v < numV; v++) {
+            std::size_t index = getIndex(u, v);
+            std::ptrdiff_t nextU = getNextOffset(UAxis, u), nextV = getNextOffset(VAxis, v);
+
+            // nothing varies along w, so E along w is 0
+            if (nextU)
+                eU[index] = (voltage[index] - voltage[index + nextU]) / spacingDelta;
+
+            if (nextV)
+                eV[index] = (voltage[index] - voltage[index + nextV]) / spacingDelta;
+        }
+    }
+
+    this->initEFieldCalculated = true;
+}
+
+void ReducedSolver::calculateNextFields() {
+    calculateNextMagneticField();
+    calculateNextCurrentField();
+    calculateNextElectricField();
+
+    this->currentTime = getNextTime();
+}
+
+void ReducedSolver::calculateNextMagneticField() {
+    double scale = timeStep / spacingDelta;
+    const double *eU = getComponent(ElectricU), *eV = getComponent(ElectricV), *eW = getComponent(ElectricW);
+    double *bU = getComponent(MagneticU), *bV = getComponent(MagneticV), *bW = getComponent(MagneticW);
+
+    // dB/dt = -curl E with d/dw = 0: curl_u = (1 / m) d/dv (m E_w), curl_v = -dE_w/du, curl_w = dE_v/du - dE_u/dv
+    for (int u = 0; u < numU; u++) {
+        for (int v = 0; v < numV; v++) {
+            std::size_t index = getIndex(u, v);
+            std::ptrdiff_t nextU = getNextOffset(UAxis, u), nextV = getNextOffset(VAxis, v);
+
+            if (nextV)
+                bU[index] -= scale * (getMetric(2 * v + 2) * eW[index + nextV] - getMetric(2 * v) * eW[index]) /
+                             getMetric(2 * v + 1);
+
+            if (nextU)
+                bV[index] += scale * (eW[index + nextU] - eW[index]);
+
+            if (nextU && nextV)
+                bW[index] -= scale * ((eV[index + nextU] - eV[index]) - (eU[index + nextV] - eU[index]));
+        }
+    }
+}
+
+void ReducedSolver::calculateNextCurrentField() {
+    std::size_t totalNumPoints = getTotalNumberPoints();
+
+    // J(t + dt / 2) = J(t - dt / 2) * exp(-dt / tau) + conductivity * E(t) * (1 - exp(-dt / tau))
+    for (int direction = 0; direction < 3; direction++) {
+        double *current = getComponent((Component) (CurrentU + direction));
+        const double *eField = getComponent((Component) (ElectricU + direction));
+        const double *gain = currentGain[direction].data();
+
+        for (std::size_t index = 0; index < totalNumPoints; index++)
+            current[index] = current[index] * currentDecay + gain[index] * eField[index];
+    }
+}
+
+void ReducedSolver::calculateNextElectricField() {
+    double inverseSpacing = 1 / spacingDelta;
+    double permeability = VACUUM_PERMEABILITY;
+    const double *bU = getComponent(MagneticU), *bV = getComponent(MagneticV), *bW = getComponent(MagneticW);
+    const double *jU = getComponent(CurrentU), *jV = getComponent(CurrentV), *jW = getComponent(CurrentW);
+    double *eU = getComponent(ElectricU), *eV = getComponent(ElectricV), *eW = getComponent(ElectricW);
+
+    // dE/dt = c^2 / permittivity * (curl B - mu0 * J), the tangential components on the faces of bounded axes are not
+    // updated. On the symmetry axis E_phi vanishes and curl_z B follows from the circulation of B_phi around the axis
+    for (int u = 0; u < numU; u++) {
+        for (int v = 0; v < numV; v++) {
+            std::size_t index = getIndex(u, v);
+            std::ptrdiff_t prevU = getPrevOffset(UAxis, u), prevV = getPrevOffset(VAxis, v);
+            bool edgeU = getNextOffset(UAxis, u) != 0, edgeV = getNextOffset(VAxis, v) != 0;
+            bool interiorU = prevU && edgeU, interiorV = prevV && edgeV;
+            bool onAxis = geometry == Axisymmetric && v == 0;
+
+            if (edgeU && (interiorV || onAxis)) {
+                double curl = onAxis ? 4 * bW[index] * inverseSpacing :
+                              (getMetric(2 * v + 1) * bW[index] - getMetric(2 * v - 1) * bW[index - prevV]) *
+                              inverseSpacing / getMetric(2 * v);
+
+                eU[index] += electricCoefficient[0][index] * (curl - permeability * jU[index]);
+            }
+
+            if (edgeV && interiorU) {
+                double curl = -(bW[index] - bW[index - prevU]) * inverseSpacing;
+
+                eV[index] += electricCoefficient[1][index] * (curl - permeability * jV[index]);
+            }
+
+            if (interiorU && interiorV) {
+                double curl = ((bV[index] - bV[index - prevU]) - (bU[index] - bU[index - prevV])) * inverseSpacing;
+
+                eW[index] += electricCoefficient[2][index] * (curl - permeability * jW[index]);
+            }
+        }
+    }
+}
+
+double ReducedSolver::calculateStableTimeStep(double safetyFactor) const {
+    double minPermittivity = std::numeric_limits<double>::max();
+    double maxPlasmaFrequencySquared = 0.0;
+
+    for (std::size_t index = 0; index < getTotalNumberPoints(); index++) {
+        minPermittivity = std::min(minPermittivity, permittivity[index]);
+
+        // w_p^2 = c^2 * mu0 * conductivity / (permittivity * tau)
+        double plasmaFrequencySquared = SPEED_OF_LIGHT_SQUARED * VACUUM_PERMEABILITY * conductivity[index] /
+                (permittivity[index] * drudeScatteringTime);
+        maxPlasmaFrequencySquared = std::max(maxPlasmaFrequencySquared, plasmaFrequencySquared);
+    }
+
+    double maxWaveSpeed = std::sqrt(SPEED_OF_LIGHT_SQUARED / minPermittivity);
+    double stableTimeStep = spacingDelta / ((geometry == Planar ? std::sqrt(2.0) : 2.0) * maxWaveSpeed);
+
+    if (maxPlasmaFrequencySquared > 0)
+        stableTimeStep = std::min(stableTimeStep, 2 / std::sqrt(maxPlasmaFrequencySquared));
+
+    return safetyFactor * stableTimeStep;
+}
+
+void ReducedSolver::setTimeStep(double timeStep) {
+    if (timeStep <= 0)
+        throw std::invalid_argument("Time step must be positive");
+
+    this->timeStep = timeStep;
+    calculateCoefficients();
+}
+
+double ReducedSolver::getTimeStep() const { return timeStep; }
+
+double ReducedSolver::getNextTime() const { return currentTime + timeStep; }
+
+double ReducedSolver::getCurrentTime() const { return currentTime; }
+
+ReducedSolver::Geometry ReducedSolver::getGeometry() const { return geometry; }
+
+int ReducedSolver::getNumPoints(ReducedAxis axis) const { return axis == UAxis ? numU : numV; }
+
+std::size_t ReducedSolver::getTotalNumberPoints() const { return (std::size_t) numU * numV; }
+
+PointManager::Axis ReducedSolver::getPointManagerAxis(Component component) const { return axes[component % 3]; }
+
+double ReducedSolver::interpolate(Component component, int u, double v) const {
+    // E and J sit half a spacing ahead along their own direction, B along the other direction of the plane
+    int direction = component % 3;
+    bool magnetic = component >= MagneticU && component <= MagneticW;
+    bool staggeredU = magnetic ? direction != 0 : direction == 0;
+    bool staggeredV = magnetic ? direction != 1 : direction == 1;
+
+    return interpolate(components[component].data(), staggeredU, staggeredV, direction != 0, u, v);
+}
+
+double ReducedSolver::interpolate(const double *values, bool staggeredU, bool staggeredV, bool odd, int u,
+                                  double v) const {
+    double position = staggeredV ? v - 0.5 : v;
+
+    if (geometry == Axisymmetric && odd && position < 0) // between the axis, where the value is 0, and the first one
+        return position + 0.5 <= 0 ? 0.0 : interpolate(values, staggeredU, staggeredV, odd, u, 0.5) * 2 * v;
+
+    int lower = (int) std::floor(position);
+    double fraction = position - lower;
+    int lastV = staggeredV && !periodic[VAxis] ? numV - 2 : numV - 1;
+    int lastU = staggeredU && !periodic[UAxis] ? numU - 2 : numU - 1;
+    double sum = 0.0, weightSum = 0.0;
+
+    // the 1 or 2 locations along v around the position, each averaged over the 1 or 2 locations along u
+    for (int side = 0; side < 2; side++) {
+        int locationV = lower + side;
+        double weight = side == 0 ? 1 - fraction : fraction;
+
+        if (periodic[VAxis])
+            locationV = (locationV % numV + numV) % numV;
+
+        if (weight == 0 || locationV < 0 || locationV > lastV)
+            continue;
+
+        for (int corner = 0; corner < (staggeredU ? 2 : 1); corner++) {
+            int locationU = u - corner;
+
+            if (periodic[UAxis])
+                locationU = (locationU + numU) % numU;
+
+            if (locationU < 0 || locationU > lastU)
+                continue;
+
+            sum += weight * values[getIndex(locationU, locationV)];
+            weightSum += weight;
+        }
+    }
+
+    return weightSum == 0 ? 0.0 : sum / weightSum;
+}
+
+bool ReducedSolver::locatePoint(const Coordinates &coordinates, int &u, double &v, double &cosine,
+                                double &sine) const {
+    const double point[] = {coordinates.getI(), coordinates.getJ(), coordinates.getK()};
+
+    u = pm->getAxisIndex(point[axes[0]]) - pm->getAxisIndex(origin[axes[0]]);
+
+    if (geometry == Planar) {
+        v = pm->getAxisIndex(point[axes[1]]) - pm->getAxisIndex(origin[axes[1]]);
+        cosine = 1.0;
+        sine = 0.0;
+    } else {
+        double radial = point[axes[1]] - origin[axes[1]], azimuthal = point[axes[2]] - origin[axes[2]];
+        double radius = std::hypot(radial, azimuthal);
+
+        v = radius / spacingDelta;
+        cosine = radius > 0 ? radial / radius : 1.0;
+        sine = radius > 0 ? azimuthal / radius : 0.0;
+    }
+
+    return u >= 0 && u < numU && v >= 0 && v <= numV - 1 + 1.0e-9;
+}
+
+void ReducedSolver::exportFieldsToPointManager() {
+    const Component firstComponents[] = {ElectricU, MagneticU, CurrentU};
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        int u;
+        double v, cosine, sine;
+
+        if (!locatePoint(p.first, u, v, cosine, sine))
+            continue;
+
+        for (int field = 0; field < 3; field++) {
+            if (firstComponents[field] == CurrentU && p.second->getConductivity() == 0)
+                continue;
+
+            double reduced[3], components[3];
+
+            for (int direction = 0; direction < 3; direction++)
+                reduced[direction] = interpolate((Component) (firstComponents[field] + direction), u, v);
+
+            // rotate (z, r, phi) of the half plane to the azimuth of the point, planar grids are not rotated
+            components[axes[0]] = reduced[0];
+            components[axes[1]] = reduced[1] * cosine - reduced[2] * sine;
+            components[axes[2]] = reduced[1] * sine + reduced[2] * cosine;
+
+            FieldVector value(components[0], components[1], components[2]);
+            FieldVector *stored = field == 0 ? p.second->getElectricField(currentTime) :
+                                  field == 1 ? p.second->getMagneticField(currentTime) :
+                                  p.second->getCurrentField(currentTime);
+
+            if (stored)
+                *stored = value;
+            else if (field == 0)
+                p.second->setElectricField(value, currentTime);
+            else if (field == 1)
+                p.second->setMagneticField(value, currentTime);
+            else
+                p.second->setCurrentField(value, currentTime);
+        }
+    }
+}
@@ -0,0 +1,276 @@
+#ifndef _REDUCEDSOLVER_H
+#define _REDUCEDSOLVER_H
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+
+#include "FieldSolver.h"
+#include "PointManager.h"
+#include "Coordinates.h"
+
+#define REDUCED_VOLTAGE_TOLERANCE 1.0e-9 // largest change of a voltage in the last sweep, relative to the largest voltage
+
+/**
+ * Class ReducedSolver advances the fields of a device that does not vary along one direction on a two dimensional
+ * staggered Yee grid, like YeeSolver does in three dimensions. Planar geometries are invariant along one axis, e.g. a
+ * long straight wire, axisymmetric geometries are invariant around one axis, e.g. a rod and its surroundings. Either
+ * costs the points of a single cross section instead of the whole cube.
+ * The reduced plane is spanned by u and v, w is the invariant direction. Planar solvers take (u, v, w) from the axes
+ * of the PointManager following the invariant axis cyclically, axisymmetric solvers use (z, r, phi), z along the
+ * symmetry axis. Materials are read from the points of the PointManager in the cross section, the fields are written
+ * back into every point with exportFieldsToPointManager, so the PointManager loggers work unchanged
+ */
+class ReducedSolver {
+public:
+    typedef enum {Planar, Axisymmetric} Geometry;
+
+    typedef enum {
+        ElectricU, ElectricV, ElectricW, MagneticU, MagneticV, MagneticW, CurrentU, CurrentV, CurrentW
+    } Component;
+
+    typedef enum {UAxis, VAxis} ReducedAxis;
+
+    static const int numComponents = 9;
+
+    /**
+     * Construct a solver for a geometry invariant along one axis. The cross section is the plane of points normal to
+     * the invariant axis through sliceCoordinate, e.g. of a PointManager box a single point thick
+     *
+     * @param pm PointManager that contains the points of the simulation
+     * @param invariantAxis Axis along which nothing varies
+     * @param sliceCoordinate Coordinate along the invariant axis of the points to read the materials from
+     * @param timeStep Time step to take when calculating each field
+     * @param drudeScatteringTime Drude scattering time constant
+     */
+    ReducedSolver(PointManager *pm, PointManager::Axis invariantAxis, double sliceCoordinate, double timeStep,
+                  double drudeScatteringTime);
+
+    /**
+     * Construct a solver for a geometry invariant around an axis of the PointManager. The cross section is the half
+     * plane starting at the symmetry axis and extending along the axis following it cyclically, e.g. +i for a symmetry
+     * axis along k. The radii reach the farthest point of the PointManager, past the half plane the materials of its
+     * outermost points continue
+     *
+     * @param pm PointManager that contains the points of the simulation
+     * @param symmetryAxis Axis of the PointManager parallel to the symmetry axis
+     * @param axisPoint Any location on the symmetry axis
+     * @param timeStep Time step to take when calculating each field
+     * @param drudeScatteringTime Drude scattering time constant
+     */
+    ReducedSolver(PointManager *pm, PointManager::Axis symmetryAxis, const Coordinates &axisPoint, double timeStep,
+                  double drudeScatteringTime);
+
+    /**
+     * Calculate the voltages of the cross section from the voltages of its conducting points by relaxing the reduced
+     * Laplacian until the voltages settle within REDUCED_VOLTAGE_TOLERANCE, and store them in the non conducting
+     * points of the PointManager. The voltage beyond bounded faces is 0 like in InitialVoltageCalculator
+     */
+    void calculateInitialVoltage();
+
+    /**
+     * Calculate the initial electric field on every edge of the cross section from the voltages of its two points
+     */
+    void calculateAndSetInitialElectricField();
+
+    /**
+     * Advance all fields by one time step with the leapfrog of YeeSolver. Tangential E on the faces of bounded axes
+     * is held fixed, periodic axes wrap around and on the symmetry axis the fields follow from their symmetry
+     */
+    void calculateNextFields();
+
+    /**
+     * Get the next time step that will be calculated upon the next call of calculateNextFields
+     *
+     * @return double representing the next time for which all fields will be calculated at
+     */
+    double getNextTime() const;
+
+    /**
+     * Get the time of the electric field currently held by the solver
+     *
+     * @return Current time of the electric field, the magnetic field is half a time step ahead of it
+     */
+    double getCurrentTime() const;
+
+    /**
+     * Calculate the largest stable time step of the leapfrog scheme, spacingDelta / (sqrt(2) * fastest wave speed) on
+     * a planar grid and spacingDelta / (2 * fastest wave speed) on an axisymmetric grid, whose update on the symmetry
+     * axis is stiffer, further limited to 2 / (largest plasma frequency)
+     *
+     * @param safetyFactor Fraction of the stability limit to return
+     * @return Largest stable time step scaled by the safety factor
+     */
+    double calculateStableTimeStep(double safetyFactor = 0.9) const;
+
+    /**
+     * Set the time step of the following calls of calculateNextFields and recompute the update coefficients
+     *
+     * @param timeStep Time step to take
+     */
+    void setTimeStep(double timeStep);
+
+    /**
+     * Get the time step of the next call of calculateNextFields
+     *
+     * @return Time step to take
+     */
+    double getTimeStep() const;
+
+    /**
+     * Interpolate the staggered fields onto every point of the PointManager and store them at the current time,
+     * overwriting the fields stored at that time. Axisymmetric fields are rotated from (r, phi, z) into the axes of the
+     * PointManager. The current is only stored on conducting points
+     */
+    void exportFieldsToPointManager();
+
+    /**
+     * Get the geometry of the cross section
+     *
+     * @return Planar or Axisymmetric
+     */
+    Geometry getGeometry() const;
+
+    /**
+     * Get the number of points of the cross section along one of its axes
+     *
+     * @param axis Axis of the cross section
+     * @return Number of points along the axis
+     */
+    int getNumPoints(ReducedAxis axis) const;
+
+    /**
+     * Get the total number of points of the cross section
+     *
+     * @return Number of points
+     */
+    std::size_t getTotalNumberPoints() const;
+
+    /**
+     * Get the index of a point of the cross section in the component arrays
+     *
+     * @param u Index of the point along u
+     * @param v Index of the point along v, the distance from the symmetry axis in spacing deltas if axisymmetric
+     * @return Index of the point in the contiguous arrays
+     */
+    inline std::size_t getIndex(int u, int v) const { return (std::size_t) u * numV + v; }
+
+    /**
+     * Get the contiguous array holding one component of a field, e.g. to start from fields that do not follow from the
+     * initial voltages. Components sit at the locations of YeeSolver with the invariant direction left out
+     *
+     * @param component Field component to get
+     * @return Pointer to the first element of the component's array
+     */
+    inline double *getComponent(Component component) { return components[component].data(); }
+
+    inline const double *getComponent(Component component) const { return components[component].data(); }
+
+    /**
+     * Get the axis of the PointManager a direction of the reduced grid lies along. For an axisymmetric grid v and w
+     * are the radial and azimuthal directions on the half plane the materials are read from
+     *
+     * @param component Any component along the direction
+     * @return Axis of the PointManager
+     */
+    PointManager::Axis getPointManagerAxis(Component component) const;
+
+private:
+    PointManager *pm;
+    Geometry geometry;
+    PointManager::Axis axes[3]; // axis of the PointManager along u, v and w
+    double origin[3]; // coordinates of the point at u = v = 0, indexed by Axis
+    int numU, numV;
+    double spacingDelta, timeStep, currentTime, drudeScatteringTime, currentDecay;
+    bool initEFieldCalculated;
+    bool periodic[2]; // periodicity of u and v
+    std::vector<double> components[numComponents];
+    std::vector<double> permittivity, conductivity, voltage;
+    std::vector<double> electricCoefficient[3]; // timeStep * c^2 / permittivity at each E location
+    std::vector<double> currentGain[3]; // conductivity * (1 - currentDecay) at each E location
+
+    /**
+     * Allocate the arrays and read the materials and voltages of the cross section from the PointManager
+     */
+    void readCrossSection();
+
+    /**
+     * Check that the PointManager is a single evenly spaced cube with the second order differences the reduced grid
+     * supports
+     */
+    void checkPointManager() const;
+
+    /**
+     * Get the offset from a location to the next location along u or v, wrapping around on a periodic axis
+     *
+     * @return Offset to add to the location's index, 0 if the location is the last one of a bounded axis
+     */
+    std::ptrdiff_t getNextOffset(ReducedAxis axis, int position) const;
+
+    /**
+     * Get the offset from a location to the previous location along u or v, wrapping around on a periodic axis
+     *
+     * @return Offset to subtract from the location's index, 0 if the location is the first one of a bounded axis
+     */
+    std::ptrdiff_t getPrevOffset(ReducedAxis axis, int position) const;
+
+    /**
+     * Get the metric of the v axis, the radius on an axisymmetric grid and 1 on a planar grid
+     *
+     * @param halfIndex Twice the index along v, odd for the locations between two points
+     * @return Metric at the location
+     */
+    inline double getMetric(int halfIndex) const { return geometry == Planar ? 1.0 : 0.5 * halfIndex * spacingDelta; }
+
+    /**
+     * Precompute the update coefficients of each E location from the materials of the points it connects
+     */
+    void calculateCoefficients();
+
+    void calculateNextMagneticField();
+
+    void calculateNextCurrentField();
+
+    void calculateNextElectricField();
+
+    /**
+     * Interpolate a staggered component at a point of the cross section and a distance along v
+     *
+     * @param component Component to interpolate
+     * @param u Index of the point along u
+     * @param v Distance along v in spacing deltas, need not be a whole number on an axisymmetric grid
+     * @return Interpolated value of the component
+     */
+    double interpolate(Component component, int u, double v) const;
+
+    /**
+     * Interpolate values held at the points or between the points of the cross section, averaging along u like
+     * YeeSolver and linearly along v. Radial and azimuthal components vanish on the symmetry axis
+     *
+     * @param values Values at each location
+     * @param staggeredU true if the locations sit half a spacing ahead along u
+     * @param staggeredV true if the locations sit half a spacing ahead along v
+     * @param odd true if the values vanish on the symmetry axis of an axisymmetric grid
+     * @param u Index of the point along u
+     * @param v Distance along v in spacing deltas
+     * @return Interpolated value
+     */
+    double interpolate(const double *values, bool staggeredU, bool staggeredV, bool odd, int u, double v) const;
+
+    /**
+     * Locate a point of the PointManager in the cross section
+     *
+     * @param coordinates Coordinates of the point
+     * @param u Receives the index of the point along u
+     * @param v Receives the distance of the point along v in spacing deltas
+     * @param cosine Receives the cosine of the azimuth of the point from the half plane, 1 on a planar grid
+     * @param sine Receives the sine of the azimuth of the point from the half plane, 0 on a planar grid
+     * @return true if the point lies inside of the cross section
+     */
+    bool locatePoint(const Coordinates &coordinates, int &u, double &v, double &cosine, double &sine) const;
+};
+
+#endif //QUANTUMFOUNDRY_REDUCEDSOLVER_H
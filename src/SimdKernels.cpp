@@ -0,0 +1,165 @@
+#include "SimdKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define SIMD_KERNELS_X86 0
+#endif
+
+SimdDispatch::InstructionSet SimdDispatch::selectedInstructionSet = SimdDispatch::getSupportedInstructionSet();
+
+SimdDispatch::InstructionSet SimdDispatch::getSupportedInstructionSet() {
+#if SIMD_KERNELS_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
+        return AVX512Instructions;
+
+    if (__builtin_cpu_supports("avx2"))
+        return AVX2Instructions;
+#endif
+
+    return ScalarInstructions;
+}
+
+SimdDispatch::InstructionSet SimdDispatch::getInstructionSet() { return selectedInstructionSet; }
+
+void SimdDispatch::setInstructionSet(InstructionSet instructionSet) {
+    if (instructionSet > getSupportedInstructionSet())
+        throw std::invalid_argument(std::string("Instruction set is not supported by this CPU: ") +
+                                    getName(instructionSet));
+
+    selectedInstructionSet = instructionSet;
+}
+
+const char *SimdDispatch::getName(InstructionSet instructionSet) {
+    switch (instructionSet) {
+        case AVX2Instructions:
+            return "AVX2";
+        case AVX512Instructions:
+            return "AVX-512";
+        default:
+            return "scalar";
+    }
+}
+
+#if SIMD_KERNELS_X86
+
+/*
+ * Defines the vector versions of the three row kernels for one instruction set and scalar type. The vector loops
+ * process WIDTH points per iteration and leave the remaining points of the row to the scalar kernels
+ */
+#define DEFINE_VECTOR_ROW_KERNELS(SUFFIX, TARGET, SCALAR, VECTOR, WIDTH, LOAD, STORE, SET1, ADD, SUB, MUL)        \
+__attribute__((target(TARGET)))                                                                                     \
+static void updateMagneticRow##SUFFIX(SCALAR *b, const SCALAR *a, std::ptrdiff_t aStride, const SCALAR *c,          \
+                                      std::ptrdiff_t cStride, SCALAR scale, std::size_t count) {                    \
+    VECTOR scaleVector = SET1(scale);                                                                               \
+    std::size_t k = 0;                                                                                              \
+                                                                                                                    \
+    for (; k + WIDTH <= count; k += WIDTH) {                                                                        \
+        VECTOR curl = SUB(SUB(LOAD(a + k + aStride), LOAD(a + k)), SUB(LOAD(c + k + cStride), LOAD(c + k)));        \
+        STORE(b + k, SUB(LOAD(b + k), MUL(scaleVector, curl)));                                                     \
+    }                                                                                                               \
+                                                                                                                    \
+    ScalarRowKernels<SCALAR>::updateMagneticRow(b + k, a + k, aStride, c + k, cStride, scale, count - k);           \
+}                                                                                                                   \
+                                                                                                                    \
+__attribute__((target(TARGET)))                                                                                     \
+static void updateElectricRow##SUFFIX(SCALAR *e, const SCALAR *coefficient, const SCALAR *current, const SCALAR *a, \
+                                      std::ptrdiff_t aStride, const SCALAR *c, std::ptrdiff_t cStride,              \
+                                      SCALAR inverseSpacing, SCALAR permeability, std::size_t count) {              \
+    VECTOR inverseSpacingVector = SET1(inverseSpacing), permeabilityVector = SET1(permeability);                    \
+    std::size_t k = 0;                                                                                              \
+                                                                                                                    \
+    for (; k + WIDTH <= count; k += WIDTH) {                                                                        \
+        VECTOR curl = SUB(SUB(LOAD(a + k), LOAD(a + k - aStride)), SUB(LOAD(c + k), LOAD(c + k - cStride)));        \
+        VECTOR source = SUB(MUL(curl, inverseSpacingVector), MUL(permeabilityVector, LOAD(current + k)));           \
+        STORE(e + k, ADD(LOAD(e + k), MUL(LOAD(coefficient + k), source)));                                         \
+    }                                                                                                               \
+                                                                                                                    \
+    ScalarRowKernels<SCALAR>::updateElectricRow(e + k, coefficient + k, current + k, a + k, aStride, c + k,         \
+                                                cStride, inverseSpacing, permeability, count - k);                  \
+}                                                                                                                   \
+                                                                                                                    \
+__attribute__((target(TARGET)))                                                                                     \
+static void updateCurrentRow##SUFFIX(SCALAR *current, const SCALAR *gain, const SCALAR *e, SCALAR decay,            \
+                                     std::size_t count) {                                                           \
+    VECTOR decayVector = SET1(decay);                                                                               \
+    std::size_t k = 0;                                                                                              \
+                                                                                                                    \
+    for (; k + WIDTH <= count; k += WIDTH)                                                                          \
+        STORE(current + k, ADD(MUL(decayVector, LOAD(current + k)), MUL(LOAD(gain + k), LOAD(e + k))));             \
+                                                                                                                    \
+    ScalarRowKernels<SCALAR>::updateCurrentRow(current + k, gain + k, e + k, decay, count - k);                     \
+}
+
+DEFINE_VECTOR_ROW_KERNELS(AVX2, "avx2", double, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd,
+                          _mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd)
+
+DEFINE_VECTOR_ROW_KERNELS(AVX2, "avx2", float, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps,
+                          _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps)
+
+DEFINE_VECTOR_ROW_KERNELS(AVX512, "avx512f", double, __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd,
+                          _mm512_add_pd, _mm512_sub_pd, _mm512_mul_pd)
+
+DEFINE_VECTOR_ROW_KERNELS(AVX512, "avx512f", float, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps,
+                          _mm512_add_ps, _mm512_sub_ps, _mm512_mul_ps)
+
+#undef DEFINE_VECTOR_ROW_KERNELS
+
+/*
+ * Defines the dispatching row kernels of RowKernels<SCALAR, SCALAR>
+ */
+#define DEFINE_DISPATCHED_ROW_KERNEL(SCALAR, KERNEL, PARAMETERS, ARGUMENTS)                                          \
+void RowKernels<SCALAR, SCALAR>::KERNEL PARAMETERS {                                                                \
+    switch (SimdDispatch::getInstructionSet()) {                                                                    \
+        case SimdDispatch::AVX512Instructions:                                                                      \
+            return KERNEL##AVX512 ARGUMENTS;                                                                        \
+        case SimdDispatch::AVX2Instructions:                                                                        \
+            return KERNEL##AVX2 ARGUMENTS;                                                                          \
+        default:                                                                                                    \
+            return ScalarRowKernels<SCALAR>::KERNEL ARGUMENTS;                                                      \
+    }                                                                                                               \
+}
+
+#else
+
+#define DEFINE_DISPATCHED_ROW_KERNEL(SCALAR, KERNEL, PARAMETERS, ARGUMENTS)                                          \
+void RowKernels<SCALAR, SCALAR>::KERNEL PARAMETERS {                                                                \
+    return ScalarRowKernels<SCALAR>::KERNEL ARGUMENTS;                                                              \
+}
+
+#endif
+
+DEFINE_DISPATCHED_ROW_KERNEL(double, updateMagneticRow,
+                             (double *b, const double *a, std::ptrdiff_t aStride, const double *c,
+                              std::ptrdiff_t cStride, double scale, std::size_t count),
+                             (b, a, aStride, c, cStride, scale, count))
+
+DEFINE_DISPATCHED_ROW_KERNEL(double, updateElectricRow,
+                             (double *e, const double *coefficient, const double *current, const double *a,
+                              std::ptrdiff_t aStride, const double *c, std::ptrdiff_t cStride,
+                              double inverseSpacing, double permeability, std::size_t count),
+                             (e, coefficient, current, a, aStride, c, cStride, inverseSpacing, permeability, count))
+
+DEFINE_DISPATCHED_ROW_KERNEL(double, updateCurrentRow,
+                             (double *current, const double *gain, const double *e, double decay, std::size_t count),
+                             (current, gain, e, decay, count))
+
+DEFINE_DISPATCHED_ROW_KERNEL(float, updateMagneticRow,
+                             (float *b, const float *a, std::ptrdiff_t aStride, const float *c,
+                              std::ptrdiff_t cStride, float scale, std::size_t count),
+                             (b, a, aStride, c, cStride, scale, count))
+
+DEFINE_DISPATCHED_ROW_KERNEL(float, updateElectricRow,
+                             (float *e, const float *coefficient, const float *current, const float *a,
+                              std::ptrdiff_t aStride, const float *c, std::ptrdiff_t cStride,
+                              float inverseSpacing, float permeability, std::size_t count),
+                             (e, coefficient, current, a, aStride, c, cStride, inverseSpacing, permeability, count))
+
+DEFINE_DISPATCHED_ROW_KERNEL(float, updateCurrentRow,
+                             (float *current, const float *gain, const float *e, float decay, std::size_t count),
+                             (current, gain, e, decay, count))
+
+#undef DEFINE_DISPATCHED_ROW_KERNEL
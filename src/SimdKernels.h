@@ -0,0 +1,132 @@
+#ifndef _SIMDKERNELS_H
+#define _SIMDKERNELS_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Class SimdDispatch detects the vector instruction sets supported by the CPU at run time and selects the one used by
+ * the RowKernels. The best supported instruction set is selected by default, it can be lowered to compare the vector
+ * kernels against the scalar ones
+ */
+class SimdDispatch {
+public:
+    typedef enum {
+        ScalarInstructions, // plain C++, always available
+        AVX2Instructions, // 256 bit vectors, 4 doubles or 8 floats per instruction
+        AVX512Instructions // 512 bit vectors, 8 doubles or 16 floats per instruction
+    } InstructionSet;
+
+    /**
+     * Get the widest instruction set supported by the CPU and the compiler
+     *
+     * @return Best supported instruction set
+     */
+    static InstructionSet getSupportedInstructionSet();
+
+    /**
+     * Get the instruction set used by the RowKernels
+     *
+     * @return Selected instruction set
+     */
+    static InstructionSet getInstructionSet();
+
+    /**
+     * Select the instruction set used by the RowKernels
+     *
+     * @param instructionSet Instruction set to use, throws std::invalid_argument if it is not supported
+     */
+    static void setInstructionSet(InstructionSet instructionSet);
+
+    /**
+     * Get a printable name of an instruction set
+     *
+     * @param instructionSet Instruction set to name
+     * @return Name of the instruction set
+     */
+    static const char *getName(InstructionSet instructionSet);
+
+private:
+    static InstructionSet selectedInstructionSet;
+};
+
+/**
+ * Class ScalarRowKernels holds the scalar implementation of the Yee update kernels. Every kernel updates count
+ * consecutive grid points along the innermost (k) axis, neighbors along the other axes are reached with array strides.
+ * Values are loaded as Scalar and combined in Accumulator precision
+ */
+template <typename Scalar, typename Accumulator = Scalar>
+class ScalarRowKernels {
+public:
+    /**
+     * b = b - scale * ((a[+aStride] - a) - (c[+cStride] - c)), i.e. dB/dt = -curl E with forward differences
+     */
+    static void updateMagneticRow(Scalar *b, const Scalar *a, std::ptrdiff_t aStride, const Scalar *c,
+                                  std::ptrdiff_t cStride, Accumulator scale, std::size_t count) {
+        for (std::size_t k = 0; k < count; k++)
+            b[k] = (Scalar) (b[k] - scale * (((Accumulator) a[k + aStride] - a[k]) -
+                                             ((Accumulator) c[k + cStride] - c[k])));
+    }
+
+    /**
+     * e = e + coefficient * (((a - a[-aStride]) - (c - c[-cStride])) * inverseSpacing - permeability * current),
+     * i.e. dE/dt = c^2 / permittivity * (curl B - mu0 * J) with backward differences
+     */
+    static void updateElectricRow(Scalar *e, const Scalar *coefficient, const Scalar *current, const Scalar *a,
+                                  std::ptrdiff_t aStride, const Scalar *c, std::ptrdiff_t cStride,
+                                  Accumulator inverseSpacing, Accumulator permeability, std::size_t count) {
+        for (std::size_t k = 0; k < count; k++) {
+            Accumulator curl = ((Accumulator) a[k] - a[k - aStride]) - ((Accumulator) c[k] - c[k - cStride]);
+            e[k] = (Scalar) (e[k] + coefficient[k] * (curl * inverseSpacing - permeability * current[k]));
+        }
+    }
+
+    /**
+     * current = decay * current + gain * e, the exact exponential update of the Drude current
+     */
+    static void updateCurrentRow(Scalar *current, const Scalar *gain, const Scalar *e, Accumulator decay,
+                                 std::size_t count) {
+        for (std::size_t k = 0; k < count; k++)
+            current[k] = (Scalar) (decay * current[k] + (Accumulator) gain[k] * e[k]);
+    }
+};
+
+/**
+ * Class RowKernels holds the Yee update kernels used by the solvers. When storage and accumulation precision match,
+ * the kernels process 4 or 8 (AVX2) or 8 or 16 (AVX-512) grid points per instruction using the instruction set selected
+ * by SimdDispatch and fall back to ScalarRowKernels otherwise.
+ * The vector kernels perform the same operations in the same order as the scalar ones, so the results are identical
+ */
+template <typename Scalar, typename Accumulator = Scalar>
+class RowKernels : public ScalarRowKernels<Scalar, Accumulator> {
+};
+
+template <>
+class RowKernels<double, double> {
+public:
+    static void updateMagneticRow(double *b, const double *a, std::ptrdiff_t aStride, const double *c,
+                                  std::ptrdiff_t cStride, double scale, std::size_t count);
+
+    static void updateElectricRow(double *e, const double *coefficient, const double *current, const double *a,
+                                  std::ptrdiff_t aStride, const double *c, std::ptrdiff_t cStride,
+                                  double inverseSpacing, double permeability, std::size_t count);
+
+    static void updateCurrentRow(double *current, const double *gain, const double *e, double decay,
+                                 std::size_t count);
+};
+
+template <>
+class RowKernels<float, float> {
+public:
+    static void updateMagneticRow(float *b, const float *a, std::ptrdiff_t aStride, const float *c,
+                                  std::ptrdiff_t cStride, float scale, std::size_t count);
+
+    static void updateElectricRow(float *e, const float *coefficient, const float *current, const float *a,
+                                  std::ptrdiff_t aStride, const float *c, std::ptrdiff_t cStride,
+                                  float inverseSpacing, float permeability, std::size_t count);
+
+    static void updateCurrentRow(float *current, const float *gain, const float *e, float decay, std::size_t count);
+};
+
+#endif //QUANTUMFOUNDRY_SIMDKERNELS_H
@@ -0,0 +1,534 @@
+#include "YeeSolver.h"
+
+template <typename Scalar, typename Accumulator>
+BasicYeeSolver<Scalar, Accumulator>::BasicYeeSolver(PointManager *pm, double timeStep, double drudeScatteringTime)
+        : grid(pm) {
+    this->pm = pm;
+    this->timeStep = timeStep;
+    this->currentTime = 0.0;
+    this->drudeScatteringTime = drudeScatteringTime;
+    this->initEFieldCalculated = false;
+    this->absorbingLayerRevision = std::numeric_limits<std::uint64_t>::max();
+    this->conductivityRevision = pm->getConductivityRevision(); // the grid copied the materials just now
+
+    for (int axis = 0; axis < 3; axis++)
+        this->periodic[axis] = pm->isPeriodic((PointManager::Axis) axis);
+
+    calculateCoefficients();
+}
+
+template <typename Scalar, typename Accumulator>
+std::ptrdiff_t BasicYeeSolver<Scalar, Accumulator>::getNextOffset(PointManager::Axis axis, int position) const {
+    std::ptrdiff_t stride = grid.getStride(axis);
+    int numPoints = grid.getNumPoints(axis);
+
+    if (position < numPoints - 1)
+        return stride;
+
+    return periodic[axis] ? -(numPoints - 1) * stride : 0;
+}
+
+template <typename Scalar, typename Accumulator>
+std::ptrdiff_t BasicYeeSolver<Scalar, Accumulator>::getPrevOffset(PointManager::Axis axis, int position) const {
+    std::ptrdiff_t stride = grid.getStride(axis);
+    int numPoints = grid.getNumPoints(axis);
+
+    if (position > 0)
+        return stride;
+
+    return periodic[axis] ? -(numPoints - 1) * stride : 0;
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::calculateCoefficients() {
+    const PointManager::Axis axes[] = {PointManager::IAxis, PointManager::JAxis, PointManager::KAxis};
+    std::size_t totalNumPoints = grid.getTotalNumberPoints();
+
+    currentDecay = std::exp(-timeStep / drudeScatteringTime);
+    double gainFactor = -std::expm1(-timeStep / drudeScatteringTime); // 1 - currentDecay
+
+    for (int axis = 0; axis < 3; axis++) {
+        electricCoefficient[axis].assign(totalNumPoints, 0.0);
+        currentGain[axis].assign(totalNumPoints, 0.0);
+
+        for (int i = 0; i < grid.getNumPoints(PointManager::IAxis); i++) {
+            for (int j = 0; j < grid.getNumPoints(PointManager::JAxis); j++) {
+                for (int k = 0; k < grid.getNumPoints(PointManager::KAxis); k++) {
+                    int position = axis == 0 ? i : axis == 1 ? j : k;
+                    std::ptrdiff_t next = getNextOffset(axes[axis], position);
+
+                    if (next == 0) // no edge past the last point
+                        continue;
+
+                    std::size_t index = grid.getIndex(i, j, k);
+                    double permittivity = (grid.getPermittivity(index) + grid.getPermittivity(index + next)) / 2;
+                    double conductivityA = grid.getConductivity(index);
+                    double conductivityB = grid.getConductivity(index + next);
+
+                    // an edge only conducts if both of its points do, the harmonic mean is zero otherwise
+                    double conductivity = conductivityA + conductivityB == 0 ? 0 :
+                                          2 * conductivityA * conductivityB / (conductivityA + conductivityB);
+
+                    electricCoefficient[axis][index] = timeStep * SPEED_OF_LIGHT_SQUARED / permittivity;
+                    currentGain[axis][index] = conductivity * gainFactor;
+                }
+            }
+        }
+    }
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::updateCoefficients() {
+    bool changed = conductivityRevision != pm->getConductivityRevision();
+
+    for (int axis = 0; axis < 3; axis++)
+        changed = changed || periodic[axis] != pm->isPeriodic((PointManager::Axis) axis);
+
+    if (!changed)
+        return;
+
+    grid.copyMaterials();
+    conductivityRevision = pm->getConductivityRevision();
+
+    for (int axis = 0; axis < 3; axis++)
+        periodic[axis] = pm->isPeriodic((PointManager::Axis) axis);
+
+    calculateCoefficients();
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::calculateAndSetInitialElectricField() {
+    if (initEFieldCalculated)
+        throw std::invalid_argument("The initial electric field was already calculated");
+
+    updateCoefficients(); // the edges across a periodic boundary take the voltage difference too
+
+    const typename Grid::Component components[] = {Grid::ElectricI, Grid::ElectricJ, Grid::ElectricK};
+    const PointManager::Axis axes[] = {PointManager::IAxis, PointManager::JAxis, PointManager::KAxis};
+    double spacingDelta = grid.getSpacingDelta();
+
+    for (int axis = 0; axis < 3; axis++) {
+        Scalar *eField = grid.getComponent(components[axis]);
+
+        for (int i = 0; i < grid.getNumPoints(PointManager::IAxis); i++) {
+            for (int j = 0; j < grid.getNumPoints(PointManager::JAxis); j++) {
+                for (int k = 0; k < grid.getNumPoints(PointManager::KAxis); k++) {
+                    int position = axis == 0 ? i : axis == 1 ? j : k;
+                    std::ptrdiff_t next = getNextOffset(axes[axis], position);
+
+                    if (next == 0) // no edge past the last point
+                        continue;
+
+                    std::size_t index = grid.getIndex(i, j, k);
+                    eField[index] = (Scalar) ((grid.getVoltage(index) - grid.getVoltage(index + next)) / spacingDelta);
+                }
+            }
+        }
+    }
+
+    this->initEFieldCalculated = true;
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::calculateNextFields() {
+    updateCoefficients();
+    updateMatchedLayers();
+
+    calculateNextMagneticField();
+    applyMatchedLayers(false);
+    calculateNextCurrentField();
+    calculateNextElectricField();
+    applyMatchedLayers(true);
+
+    this->currentTime = getNextTime();
+}
+
+template <typename Scalar, typename Accumulator>
+double BasicYeeSolver<Scalar, Accumulator>::calculateStableTimeStep(double safetyFactor) const {
+    double minPermittivity = std::numeric_limits<double>::max();
+    double maxPlasmaFrequencySquared = 0.0;
+
+    for (std::size_t index = 0; index < grid.getTotalNumberPoints(); index++) {
+        double permittivity = grid.getPermittivity(index);
+        minPermittivity = std::min(minPermittivity, permittivity);
+
+        // w_p^2 = c^2 * mu0 * conductivity / (permittivity * tau)
+        double plasmaFrequencySquared = SPEED_OF_LIGHT_SQUARED * VACUUM_PERMEABILITY * grid.getConductivity(index) /
+                (permittivity * drudeScatteringTime);
+        maxPlasmaFrequencySquared = std::max(maxPlasmaFrequencySquared, plasmaFrequencySquared);
+    }
+
+    double maxWaveSpeed = std::sqrt(SPEED_OF_LIGHT_SQUARED / minPermittivity);
+    double stableTimeStep = grid.getSpacingDelta() / (std::sqrt(3.0) * maxWaveSpeed);
+
+    if (maxPlasmaFrequencySquared > 0)
+        stableTimeStep = std::min(stableTimeStep, 2 / std::sqrt(maxPlasmaFrequencySquared));
+
+    return safetyFactor * stableTimeStep;
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::setTimeStep(double timeStep) {
+    if (timeStep <= 0)
+        throw std::invalid_argument("Time step must be positive");
+
+    this->timeStep = timeStep;
+    this->absorbingLayerRevision = std::numeric_limits<std::uint64_t>::max(); // the decays depend on the time step
+    calculateCoefficients();
+}
+
+template <typename Scalar, typename Accumulator>
+double BasicYeeSolver<Scalar, Accumulator>::getTimeStep() const { return timeStep; }
+
+template <typename Scalar, typename Accumulator>
+double BasicYeeSolver<Scalar, Accumulator>::getNextTime() const { return currentTime + timeStep; }
+
+template <typename Scalar, typename Accumulator>
+double BasicYeeSolver<Scalar, Accumulator>::getCurrentTime() const { return currentTime; }
+
+template <typename Scalar, typename Accumulator>
+const typename BasicYeeSolver<Scalar, Accumulator>::Grid &BasicYeeSolver<Scalar, Accumulator>::getGrid() const {
+    return grid;
+}
+
+template <typename Scalar, typename Accumulator>
+typename BasicYeeSolver<Scalar, Accumulator>::Grid &BasicYeeSolver<Scalar, Accumulator>::getGrid() { return grid; }
+
+template <typename Scalar, typename Accumulator>
+double BasicYeeSolver<Scalar, Accumulator>::calculateFieldEnergy() const {
+    const typename Grid::Component components[] = {Grid::ElectricI, Grid::ElectricJ, Grid::ElectricK,
+                                                   Grid::MagneticI, Grid::MagneticJ, Grid::MagneticK};
+    std::size_t totalNumPoints = grid.getTotalNumberPoints();
+    Accumulator electricEnergy = 0, magneticEnergy = 0;
+
+    for (int component = 0; component < 6; component++) {
+        const Scalar *field = grid.getComponent(components[component]);
+
+        for (std::size_t index = 0; index < totalNumPoints; index++) {
+            Accumulator value = field[index];
+
+            if (component < 3)
+                electricEnergy += (Accumulator) grid.getPermittivity(index) * value * value;
+            else
+                magneticEnergy += value * value;
+        }
+    }
+
+    double volume = std::pow(grid.getSpacingDelta(), 3);
+
+    return 0.5 * ((double) electricEnergy + SPEED_OF_LIGHT_SQUARED * (double) magneticEnergy) * volume;
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::updateMatchedLayers() {
+    if (absorbingLayerRevision == pm->getAbsorbingLayerRevision())
+        return;
+
+    // target, source, axis and sign of each derivative in dB/dt = -curl E and dE/dt = c^2 / permittivity * curl B
+    const struct {
+        typename Grid::Component target, source;
+        PointManager::Axis axis;
+        int sign;
+    } terms[12] = {{Grid::MagneticI, Grid::ElectricK, PointManager::JAxis, 1},
+                   {Grid::MagneticI, Grid::ElectricJ, PointManager::KAxis, -1},
+                   {Grid::MagneticJ, Grid::ElectricI, PointManager::KAxis, 1},
+                   {Grid::MagneticJ, Grid::ElectricK, PointManager::IAxis, -1},
+                   {Grid::MagneticK, Grid::ElectricJ, PointManager::IAxis, 1},
+                   {Grid::MagneticK, Grid::ElectricI, PointManager::JAxis, -1},
+                   {Grid::ElectricI, Grid::MagneticK, PointManager::JAxis, 1},
+                   {Grid::ElectricI, Grid::MagneticJ, PointManager::KAxis, -1},
+                   {Grid::ElectricJ, Grid::MagneticI, PointManager::KAxis, 1},
+                   {Grid::ElectricJ, Grid::MagneticK, PointManager::IAxis, -1},
+                   {Grid::ElectricK, Grid::MagneticJ, PointManager::IAxis, 1},
+                   {Grid::ElectricK, Grid::MagneticI, PointManager::JAxis, -1}};
+
+    // E components sit half a spacing ahead along their own axis, B components along the other two
+    const int offsets[6] = {1, 2, 4, 6, 5, 3};
+    int numPoints[] = {grid.getNumPoints(PointManager::IAxis), grid.getNumPoints(PointManager::JAxis),
+                       grid.getNumPoints(PointManager::KAxis)};
+    double spacingDelta = grid.getSpacingDelta(), startBound = pm->getStartBound();
+
+    for (int term = 0; term < 12; term++) {
+        MatchedLayerTerm &layerTerm = matchedLayerTerms[term];
+        int component = terms[term].target, ownAxis = component % 3;
+        bool electric = component < 3;
+
+        layerTerm.target = terms[term].target;
+        layerTerm.source = terms[term].source;
+        layerTerm.axis = terms[term].axis;
+        layerTerm.sign = terms[term].sign;
+        layerTerm.indices.clear();
+        layerTerm.decay.clear();
+
+        for (int i = 0; i < numPoints[0]; i++) {
+            for (int j = 0; j < numPoints[1]; j++) {
+                for (int k = 0; k < numPoints[2]; k++) {
+                    int position[] = {i, j, k};
+                    bool updated = true;
+
+                    // only the locations the update kernels write to, the tangential E on bounded faces stays fixed
+                    for (int axis = 0; axis < 3; axis++) {
+                        bool hasNext = getNextOffset((PointManager::Axis) axis, position[axis]) != 0;
+                        bool hasPrev = getPrevOffset((PointManager::Axis) axis, position[axis]) != 0;
+
+                        if (axis == ownAxis)
+                            updated = updated && (!electric || hasNext);
+                        else if (electric)
+                            updated = updated && hasPrev && hasNext;
+                        else
+                            updated = updated && hasNext;
+                    }
+
+                    if (!updated)
+                        continue;
+
+                    Coordinates location(startBound + (i + 0.5 * (offsets[component] & 1)) * spacingDelta,
+                                         startBound + (j + 0.5 * ((offsets[component] >> 1) & 1)) * spacingDelta,
+                                         startBound + (k + 0.5 * ((offsets[component] >> 2) & 1)) * spacingDelta);
+                    double attenuation = pm->calculateAbsorbingLayerAttenuation(location, layerTerm.axis);
+
+                    if (attenuation <= 0)
+                        continue;
+
+                    std::size_t index = grid.getIndex(i, j, k);
+                    double waveSpeed = std::sqrt(SPEED_OF_LIGHT_SQUARED / grid.getPermittivity(index));
+
+                    layerTerm.indices.push_back(index);
+                    layerTerm.decay.push_back((Scalar) std::exp(-waveSpeed * attenuation * timeStep));
+                }
+            }
+        }
+
+        layerTerm.convolution.assign(layerTerm.indices.size(), 0.0);
+    }
+
+    absorbingLayerRevision = pm->getAbsorbingLayerRevision();
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::applyMatchedLayers(bool electric) {
+    Accumulator inverseSpacing = 1 / grid.getSpacingDelta();
+    Accumulator scale = timeStep / grid.getSpacingDelta();
+
+    for (int term = electric ? 6 : 0; term < (electric ? 12 : 6); term++) {
+        MatchedLayerTerm &layerTerm = matchedLayerTerms[term];
+        Scalar *field = grid.getComponent(layerTerm.target);
+        const Scalar *source = grid.getComponent(layerTerm.source);
+        const Scalar *coefficient = electricCoefficient[layerTerm.target % 3].data();
+        std::ptrdiff_t stride = grid.getStride(layerTerm.axis);
+
+        // psi = decay * psi + (decay - 1) * difference, added to the field like the difference itself
+        for (std::size_t n = 0; n < layerTerm.indices.size(); n++) {
+            std::size_t index = layerTerm.indices[n];
+            Accumulator decay = layerTerm.decay[n];
+            Accumulator &convolution = layerTerm.convolution[n];
+
+            if (electric) { // backward differences of B
+                convolution = decay * convolution + (decay - 1) * ((Accumulator) source[index] - source[index - stride]);
+                field[index] = (Scalar) (field[index] + coefficient[index] * inverseSpacing * layerTerm.sign * convolution);
+            } else { // forward differences of E
+                convolution = decay * convolution + (decay - 1) * ((Accumulator) source[index + stride] - source[index]);
+                field[index] = (Scalar) (field[index] - scale * layerTerm.sign * convolution);
+            }
+        }
+    }
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::calculateNextMagneticField() {
+    typedef RowKernels<Scalar, Accumulator> Kernels;
+    int numI = grid.getNumPoints(PointManager::IAxis);
+    int numJ = grid.getNumPoints(PointManager::JAxis);
+    int numK = grid.getNumPoints(PointManager::KAxis);
+    std::ptrdiff_t wrapK = getNextOffset(PointManager::KAxis, numK - 1);
+    std::size_t lastK = numK - 1;
+    Accumulator scale = timeStep / grid.getSpacingDelta();
+
+    const Scalar *eI = grid.getComponent(Grid::ElectricI);
+    const Scalar *eJ = grid.getComponent(Grid::ElectricJ);
+    const Scalar *eK = grid.getComponent(Grid::ElectricK);
+    Scalar *bI = grid.getComponent(Grid::MagneticI);
+    Scalar *bJ = grid.getComponent(Grid::MagneticJ);
+    Scalar *bK = grid.getComponent(Grid::MagneticK);
+
+    // dB/dt = -curl E, each B component sits on the face enclosed by the four E edges it curls around.
+    // The faces of a row of points along k are updated together by the vectorized row kernels, the last face of a
+    // periodic row wraps around to the first edge separately
+    for (int i = 0; i < numI; i++) {
+        for (int j = 0; j < numJ; j++) {
+            std::size_t row = grid.getIndex(i, j, 0);
+            std::ptrdiff_t nextI = getNextOffset(PointManager::IAxis, i);
+            std::ptrdiff_t nextJ = getNextOffset(PointManager::JAxis, j);
+
+            if (nextJ) {
+                Kernels::updateMagneticRow(bI + row, eK + row, nextJ, eJ + row, 1, scale, numK - 1);
+
+                if (wrapK)
+                    Kernels::updateMagneticRow(bI + row + lastK, eK + row + lastK, nextJ, eJ + row + lastK, wrapK,
+                                               scale, 1);
+            }
+
+            if (nextI) {
+                Kernels::updateMagneticRow(bJ + row, eI + row, 1, eK + row, nextI, scale, numK - 1);
+
+                if (wrapK)
+                    Kernels::updateMagneticRow(bJ + row + lastK, eI + row + lastK, wrapK, eK + row + lastK, nextI,
+                                               scale, 1);
+            }
+
+            if (nextI && nextJ)
+                Kernels::updateMagneticRow(bK + row, eJ + row, nextI, eI + row, nextJ, scale, numK);
+        }
+    }
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::calculateNextCurrentField() {
+    const typename Grid::Component eComponents[] = {Grid::ElectricI, Grid::ElectricJ, Grid::ElectricK};
+    const typename Grid::Component jComponents[] = {Grid::CurrentI, Grid::CurrentJ, Grid::CurrentK};
+    std::size_t totalNumPoints = grid.getTotalNumberPoints();
+
+    // J(t + dt / 2) = J(t - dt / 2) * exp(-dt / tau) + conductivity * E(t) * (1 - exp(-dt / tau))
+    for (int axis = 0; axis < 3; axis++)
+        RowKernels<Scalar, Accumulator>::updateCurrentRow(grid.getComponent(jComponents[axis]),
+                                                          currentGain[axis].data(),
+                                                          grid.getComponent(eComponents[axis]), currentDecay,
+                                                          totalNumPoints);
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::calculateNextElectricField() {
+    typedef RowKernels<Scalar, Accumulator> Kernels;
+    int numI = grid.getNumPoints(PointManager::IAxis);
+    int numJ = grid.getNumPoints(PointManager::JAxis);
+    int numK = grid.getNumPoints(PointManager::KAxis);
+    std::ptrdiff_t wrapK = getPrevOffset(PointManager::KAxis, 0);
+    int numInteriorK = wrapK ? numK - 1 : numK - 2; // edges from k = 1 on, k = 0 wraps around separately
+    int numEdgesK = wrapK ? numK : numK - 1;
+    Accumulator inverseSpacing = 1 / grid.getSpacingDelta();
+    Accumulator permeability = VACUUM_PERMEABILITY;
+
+    const Scalar *bI = grid.getComponent(Grid::MagneticI);
+    const Scalar *bJ = grid.getComponent(Grid::MagneticJ);
+    const Scalar *bK = grid.getComponent(Grid::MagneticK);
+    const Scalar *jI = grid.getComponent(Grid::CurrentI);
+    const Scalar *jJ = grid.getComponent(Grid::CurrentJ);
+    const Scalar *jK = grid.getComponent(Grid::CurrentK);
+    Scalar *eI = grid.getComponent(Grid::ElectricI);
+    Scalar *eJ = grid.getComponent(Grid::ElectricJ);
+    Scalar *eK = grid.getComponent(Grid::ElectricK);
+    const Scalar *coefficientI = electricCoefficient[0].data();
+    const Scalar *coefficientJ = electricCoefficient[1].data();
+    const Scalar *coefficientK = electricCoefficient[2].data();
+
+    // dE/dt = c^2 / permittivity * (curl B - mu0 * J), the tangential components on the faces of bounded axes are not
+    // updated. On a bounded k axis I and J edges skip the first and last point of each row, K edges skip the last one
+    for (int i = 0; i < numI; i++) {
+        for (int j = 0; j < numJ; j++) {
+            std::size_t row = grid.getIndex(i, j, 0);
+            std::ptrdiff_t prevI = getPrevOffset(PointManager::IAxis, i);
+            std::ptrdiff_t prevJ = getPrevOffset(PointManager::JAxis, j);
+            bool edgeI = getNextOffset(PointManager::IAxis, i) != 0;
+            bool edgeJ = getNextOffset(PointManager::JAxis, j) != 0;
+            bool interiorI = prevI && edgeI;
+            bool interiorJ = prevJ && edgeJ;
+
+            if (edgeI && interiorJ) {
+                if (numInteriorK > 0)
+                    Kernels::updateElectricRow(eI + row + 1, coefficientI + row + 1, jI + row + 1, bK + row + 1, prevJ,
+                                               bJ + row + 1, 1, inverseSpacing, permeability, numInteriorK);
+
+                if (wrapK)
+                    Kernels::updateElectricRow(eI + row, coefficientI + row, jI + row, bK + row, prevJ, bJ + row,
+                                               wrapK, inverseSpacing, permeability, 1);
+            }
+
+            if (edgeJ && interiorI) {
+                if (numInteriorK > 0)
+                    Kernels::updateElectricRow(eJ + row + 1, coefficientJ + row + 1, jJ + row + 1, bI + row + 1, 1,
+                                               bK + row + 1, prevI, inverseSpacing, permeability, numInteriorK);
+
+                if (wrapK)
+                    Kernels::updateElectricRow(eJ + row, coefficientJ + row, jJ + row, bI + row, wrapK, bK + row,
+                                               prevI, inverseSpacing, permeability, 1);
+            }
+
+            if (interiorI && interiorJ)
+                Kernels::updateElectricRow(eK + row, coefficientK + row, jK + row, bJ + row, prevI, bI + row,
+                                           prevJ, inverseSpacing, permeability, numEdgesK);
+        }
+    }
+}
+
+template <typename Scalar, typename Accumulator>
+double BasicYeeSolver<Scalar, Accumulator>::averageAroundPoint(typename Grid::Component component, int i, int j, int k,
+                                                               int offsets) const {
+    const Scalar *values = grid.getComponent(component);
+    int position[] = {i, j, k};
+    int numPoints[] = {grid.getNumPoints(PointManager::IAxis), grid.getNumPoints(PointManager::JAxis),
+                       grid.getNumPoints(PointManager::KAxis)};
+    double sum = 0.0;
+    int count = 0;
+
+    // visit the 1, 2 or 4 staggered locations surrounding the point
+    for (int corner = 0; corner < 8; corner++) {
+        if (corner & ~offsets)
+            continue;
+
+        int index[3];
+        bool exists = true;
+
+        for (int axis = 0; axis < 3; axis++) {
+            index[axis] = position[axis] - ((corner >> axis) & 1);
+
+            if (periodic[axis]) { // the location before the first point is the one after the last point
+                index[axis] = (index[axis] + numPoints[axis]) % numPoints[axis];
+                continue;
+            }
+
+            // staggered along this axis: valid locations lie between the first and the last point
+            int lastIndex = (offsets >> axis) & 1 ? numPoints[axis] - 2 : numPoints[axis] - 1;
+            exists = exists && index[axis] >= 0 && index[axis] <= lastIndex;
+        }
+
+        if (exists) {
+            sum += values[grid.getIndex(index[0], index[1], index[2])];
+            count++;
+        }
+    }
+
+    return count == 0 ? 0.0 : sum / count;
+}
+
+template <typename Scalar, typename Accumulator>
+void BasicYeeSolver<Scalar, Accumulator>::exportFieldsToPointManager() {
+    for (int i = 0; i < grid.getNumPoints(PointManager::IAxis); i++) {
+        for (int j = 0; j < grid.getNumPoints(PointManager::JAxis); j++) {
+            for (int k = 0; k < grid.getNumPoints(PointManager::KAxis); k++) {
+                std::size_t index = grid.getIndex(i, j, k);
+                Point *p = grid.getPoint(index);
+
+                if (!p)
+                    continue;
+
+                // E components sit half a spacing ahead along their own axis, B components along the other two
+                p->setElectricField(FieldVector(averageAroundPoint(Grid::ElectricI, i, j, k, 1),
+                                                averageAroundPoint(Grid::ElectricJ, i, j, k, 2),
+                                                averageAroundPoint(Grid::ElectricK, i, j, k, 4)), currentTime);
+
+                p->setMagneticField(FieldVector(averageAroundPoint(Grid::MagneticI, i, j, k, 6),
+                                                averageAroundPoint(Grid::MagneticJ, i, j, k, 5),
+                                                averageAroundPoint(Grid::MagneticK, i, j, k, 3)), currentTime);
+
+                if (grid.getConductivity(index) != 0)
+                    p->setCurrentField(FieldVector(averageAroundPoint(Grid::CurrentI, i, j, k, 1),
+                                                   averageAroundPoint(Grid::CurrentJ, i, j, k, 2),
+                                                   averageAroundPoint(Grid::CurrentK, i, j, k, 4)), currentTime);
+            }
+        }
+    }
+}
+
+template class BasicYeeSolver<double>;
+template class BasicYeeSolver<float>;
+template class BasicYeeSolver<float, double>;
@@ -0,0 +1,214 @@
+#ifndef _YEESOLVER_H
+#define _YEESOLVER_H
+
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+
+#include "FieldSolver.h"
+#include "FieldGrid.h"
+#include "SimdKernels.h"
+#include "PointManager.h"
+
+/**
+ * Class BasicYeeSolver is an alternative to FieldSolver which advances the fields with the finite difference time domain
+ * method on a staggered Yee grid: every component of E lives on the edge between two points, every component of B on
+ * the face between four points, and E and B are leapfrogged half a time step apart.
+ * Each step costs a single curl of E and a single curl of B over a one spacing delta stencil and the solver only keeps
+ * one time level of each field. Materials and initial voltages are read from the same PointManager as FieldSolver,
+ * results are written back into the PointManager's points with exportFieldsToPointManager so the PointManager loggers
+ * can be used with either engine.
+ * Fields and update coefficients are stored as Scalar while every stencil and reduction is evaluated in Accumulator,
+ * so float storage can be combined with double arithmetic to halve the memory traffic without losing the accuracy of
+ * the sums. YeeSolver, SinglePrecisionYeeSolver and MixedPrecisionYeeSolver name the supported combinations
+ */
+template <typename Scalar, typename Accumulator = Scalar>
+class BasicYeeSolver {
+public:
+    typedef BasicFieldGrid<Scalar> Grid;
+
+    /**
+     * Construct a new BasicYeeSolver object
+     *
+     * @param pm PointManager that contains all points for the simulation
+     * @param timeStep Time step to take when calculating each field
+     * @param drudeScatteringTime Drude scattering time constant
+     */
+    BasicYeeSolver(PointManager *pm, double timeStep, double drudeScatteringTime);
+
+    /**
+     * Calculate the initial electric field on every edge from the voltages of the two points the edge connects
+     */
+    void calculateAndSetInitialElectricField();
+
+    /**
+     * Advance all fields by one time step.
+     * B is taken from t - timeStep / 2 to t + timeStep / 2, J is advanced with the exact exponential update and E is
+     * taken from t to t + timeStep. Tangential E on the faces of bounded axes is held fixed, periodic axes wrap around
+     */
+    void calculateNextFields();
+
+    /**
+     * Get the next time step that will be calculated upon the next call of calculateNextFields
+     *
+     * @return double representing the next time for which all fields will be calculated at
+     */
+    double getNextTime() const;
+
+    /**
+     * Get the time of the electric field currently held by the solver
+     *
+     * @return Current time of the electric field, the magnetic field is half a time step ahead of it
+     */
+    double getCurrentTime() const;
+
+    /**
+     * Calculate the largest stable time step of the leapfrog scheme, spacingDelta / (sqrt(3) * fastest wave speed),
+     * further limited to 2 / (largest plasma frequency) by the explicit coupling of current and electric field
+     *
+     * @param safetyFactor Fraction of the stability limit to return
+     * @return Largest stable time step scaled by the safety factor
+     */
+    double calculateStableTimeStep(double safetyFactor = 0.9) const;
+
+    /**
+     * Set the time step of the following calls of calculateNextFields and recompute the update coefficients
+     *
+     * @param timeStep Time step to take
+     */
+    void setTimeStep(double timeStep);
+
+    /**
+     * Get the time step of the next call of calculateNextFields
+     *
+     * @return Time step to take
+     */
+    double getTimeStep() const;
+
+    /**
+     * Calculate the electromagnetic energy held by the grid, 1/2 * sum(permittivity * |E|^2 + c^2 * |B|^2) * volume,
+     * in units of the vacuum permittivity. The sum is accumulated in Accumulator precision
+     *
+     * @return Electromagnetic energy of the grid
+     */
+    double calculateFieldEnergy() const;
+
+    /**
+     * Interpolate the staggered fields onto the points and store them in the PointManager at the current time.
+     * The current is only stored on conducting points, fields that already exist at the current time are not replaced
+     */
+    void exportFieldsToPointManager();
+
+    /**
+     * Get the grid holding the staggered fields
+     *
+     * @return Reference to the solver's grid
+     */
+    const Grid &getGrid() const;
+
+    /**
+     * Get the grid holding the staggered fields, e.g. to start from fields that do not follow from the initial
+     * voltages
+     *
+     * @return Reference to the solver's grid
+     */
+    Grid &getGrid();
+
+private:
+    PointManager *pm;
+    Grid grid;
+    double timeStep, currentTime, drudeScatteringTime, currentDecay;
+    bool initEFieldCalculated;
+    bool periodic[3]; // periodicity of each axis when the coefficients were calculated
+    std::uint64_t conductivityRevision; // of the PointManager when the coefficients were calculated
+    std::vector<Scalar> electricCoefficient[3]; // timeStep * c^2 / permittivity on each edge
+    std::vector<Scalar> currentGain[3]; // conductivity * (1 - currentDecay) on each edge
+
+    /**
+     * One of the two derivatives in the curl that updates a component. Inside the absorbing layers of the faces normal
+     * to the derivative's axis, the derivative is convolved with the response of a perfectly matched layer, which is
+     * tracked by one recursively updated value per location
+     */
+    struct MatchedLayerTerm {
+        typename Grid::Component target, source;
+        PointManager::Axis axis;
+        int sign; // sign of the derivative in the curl
+        std::vector<std::size_t> indices; // locations of target inside the layers
+        std::vector<Scalar> decay; // exp(-dampingRate * timeStep) of the derivative at each location
+        std::vector<Accumulator> convolution; // convolved derivative at each location, in differences of source
+    };
+
+    MatchedLayerTerm matchedLayerTerms[12]; // the first six update B, the last six E
+    std::uint64_t absorbingLayerRevision;
+
+    /**
+     * Get the offset from a location to the next location along an axis, wrapping around from the last location to
+     * the first one on a periodic axis
+     *
+     * @param axis Axis to step along
+     * @param position Index of the location along the axis
+     * @return Offset to add to the location's index, 0 if the location is the last one of a bounded axis
+     */
+    std::ptrdiff_t getNextOffset(PointManager::Axis axis, int position) const;
+
+    /**
+     * Get the offset from a location to the previous location along an axis, wrapping around from the first location
+     * to the last one on a periodic axis
+     *
+     * @param axis Axis to step along
+     * @param position Index of the location along the axis
+     * @return Offset to subtract from the location's index, 0 if the location is the first one of a bounded axis
+     */
+    std::ptrdiff_t getPrevOffset(PointManager::Axis axis, int position) const;
+
+    /**
+     * Precompute the per edge update coefficients from the materials of the two points each edge connects
+     */
+    void calculateCoefficients();
+
+    /**
+     * Copy the materials and periodicity of the PointManager again and recalculate the coefficients, if a conductivity
+     * was set or an axis was made periodic or bounded since they were calculated
+     */
+    void updateCoefficients();
+
+    /**
+     * Rebuild the locations of the perfectly matched layer terms and their decay per time step if any absorbing layer
+     * changed since they were last built. The convolutions restart from zero
+     */
+    void updateMatchedLayers();
+
+    /**
+     * Add the convolution of the perfectly matched layer terms to the E or B components updated last
+     *
+     * @param electric true after the E update, false after the B update
+     */
+    void applyMatchedLayers(bool electric);
+
+    void calculateNextMagneticField();
+
+    void calculateNextCurrentField();
+
+    void calculateNextElectricField();
+
+    /**
+     * Average the values of a staggered component that exist around a point
+     *
+     * @param component Component to average
+     * @param i Index of the point along the i axis
+     * @param j Index of the point along the j axis
+     * @param k Index of the point along the k axis
+     * @param offsets Bit mask of the axes (1 = i, 2 = j, 4 = k) along which the component sits half a spacing ahead
+     * @return Average of the component around the point
+     */
+    double averageAroundPoint(typename Grid::Component component, int i, int j, int k, int offsets) const;
+};
+
+typedef BasicYeeSolver<double> YeeSolver;
+typedef BasicYeeSolver<float> SinglePrecisionYeeSolver;
+typedef BasicYeeSolver<float, double> MixedPrecisionYeeSolver;
+
+#endif //QUANTUMFOUNDRY_YEESOLVER_H
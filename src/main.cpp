@@ -6,13 +6,19 @@
 #define LOG_INIT_ELEC_FIELD true
 #define CALC_NEXT_FIELDS true
 #define LOG_MAG_FIELD true
+#define USE_YEE_SOLVER false
+#define USE_STABLE_TIME_STEP true
+#define PERIODIC_K_AXIS true // the bottom face follows the top face
 
 #define TIME_STEP 0.00125
+#define YEE_SOLVER_TYPE YeeSolver // YeeSolver, SinglePrecisionYeeSolver, MixedPrecisionYeeSolver or a BrickYeeSolver
 
 #include "PointManager.h"
 #include "InitialVoltageCalculator.h"
 #include "DevicePointImporter.h"
 #include "FieldSolver.h"
+#include "YeeSolver.h"
+#include "BrickYeeSolver.h"
 
 #include <iostream>
 #include <chrono>
@@ -47,6 +53,11 @@ int main() {
     cout << "Finished importing points" << endl;
 #endif
 
+#if PERIODIC_K_AXIS
+    cout << "Wrapping the k axis around" << endl;
+    pointManager->setPeriodic(PointManager::KAxis, true);
+#endif
+
 #if CALC_INIT_VOLTAGE
     InitialVoltageCalculator ivc(pointManager);
     std::cout << "Calculating initial voltage." << std::endl;
@@ -58,7 +69,16 @@ int main() {
     pointManager->logVoltageToFile("../out/initial-voltages"); //TODO fix file path due to CLion
 #endif
 
+#if USE_YEE_SOLVER
+    auto fs = new YEE_SOLVER_TYPE(pointManager, TIME_STEP, DRUDE_SCATTERING_TIME);
+#else
     auto fs = new FieldSolver(pointManager, TIME_STEP, DRUDE_SCATTERING_TIME);
+#endif
+
+#if USE_STABLE_TIME_STEP
+    fs->setTimeStep(fs->calculateStableTimeStep());
+    cout << "Using the largest stable time step: " << fs->getTimeStep() << endl;
+#endif
 
 #if CALC_INIT_ELEC_FIELD
     cout << "Calculating initial electric field" << endl;
@@ -66,6 +86,9 @@ int main() {
 #endif
 
 #if LOG_INIT_ELEC_FIELD
+#if USE_YEE_SOLVER
+    fs->exportFieldsToPointManager();
+#endif
     cout << "Saving calculated electric fields." << endl;
     pointManager->logElectricFieldToFile("../out/e-field", 0); // TODO fix file path due to CLion
 #endif
@@ -75,9 +98,13 @@ int main() {
     fs->calculateNextFields();
 #endif
 
+#if USE_YEE_SOLVER
+    fs->exportFieldsToPointManager();
+#endif
+
 #if LOG_MAG_FIELD
     cout << "Saving magnetic field" << endl;
-    pointManager->logMagneticFieldToFile("../out/b-field", TIME_STEP); // TODO fix file path due to CLion
+    pointManager->logMagneticFieldToFile("../out/b-field", fs->getCurrentTime()); // TODO fix file path due to CLion
 #endif
 
     cout << "Simulation complete" << endl;
@@ -0,0 +1,144 @@
+#define NUM_VECTORS 4096 // small enough to stay in cache, so the arithmetic is measured rather than memory bandwidth
+#define NUM_REPETITIONS 2000
+#define TIME_STEP 0.00125
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/FieldVector.h"
+#include "../src/FieldArray.h"
+
+using namespace std;
+
+/**
+ * FieldVector as it was before expression templates, every operator returns a new vector and - is + (-1 * rhs)
+ */
+class EagerFieldVector {
+public:
+    EagerFieldVector() : i(0.0), j(0.0), k(0.0) {}
+
+    EagerFieldVector(double iComp, double jComp, double kComp) : i(iComp), j(jComp), k(kComp) {}
+
+    friend EagerFieldVector operator+(const EagerFieldVector &lhs, const EagerFieldVector &rhs) {
+        return EagerFieldVector(lhs.i + rhs.i, lhs.j + rhs.j, lhs.k + rhs.k);
+    }
+
+    friend EagerFieldVector operator*(double scalar, const EagerFieldVector &rhs) {
+        return EagerFieldVector(scalar * rhs.i, scalar * rhs.j, scalar * rhs.k);
+    }
+
+    EagerFieldVector &operator=(const EagerFieldVector &rhs) {
+        if (this == &rhs)
+            return *this;
+
+        this->i = rhs.i;
+        this->j = rhs.j;
+        this->k = rhs.k;
+
+        return *this;
+    }
+
+    double i, j, k;
+};
+
+/**
+ * Time a benchmark over NUM_REPETITIONS runs and print the time per vector of the fastest run
+ *
+ * @param name Name of the benchmark
+ * @param run Benchmark to time
+ * @return Fastest time per vector in nanoseconds
+ */
+template <typename Benchmark>
+double timeBenchmark(const string &name, Benchmark run) {
+    double fastest = INFINITY;
+
+    for (int repetition = 0; repetition < NUM_REPETITIONS; repetition++) {
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        run();
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+        fastest = min(fastest, chrono::duration<double, nano>(end - begin).count() / NUM_VECTORS);
+    }
+
+    cout << name << ": " << fastest << " ns per vector" << endl;
+
+    return fastest;
+}
+
+int main() {
+    cout << "Benchmark FieldVector Runge-Kutta combination y + (h / 6) * (k1 + 2 * k2 + 2 * k3 + k4)" << endl;
+
+    mt19937 generator(42);
+    uniform_real_distribution<double> distribution(-1.0, 1.0);
+    const double h = TIME_STEP;
+
+    // the same values in every layout: raw components, eager vectors, expression template vectors and field arrays
+    vector<double> raw[5];
+    vector<double> rawResult(3 * NUM_VECTORS);
+    vector<EagerFieldVector> eager[5];
+    vector<EagerFieldVector> eagerResult(NUM_VECTORS);
+    vector<FieldVector> lazy[5];
+    vector<FieldVector> lazyResult(NUM_VECTORS);
+    FieldArray arrays[5] = {FieldArray(3 * NUM_VECTORS), FieldArray(3 * NUM_VECTORS), FieldArray(3 * NUM_VECTORS),
+                            FieldArray(3 * NUM_VECTORS), FieldArray(3 * NUM_VECTORS)};
+    FieldArray arrayResult(3 * NUM_VECTORS);
+
+    for (int operand = 0; operand < 5; operand++) {
+        for (int n = 0; n < NUM_VECTORS; n++) {
+            double i = distribution(generator), j = distribution(generator), k = distribution(generator);
+
+            raw[operand].push_back(i);
+            raw[operand].push_back(j);
+            raw[operand].push_back(k);
+            eager[operand].push_back(EagerFieldVector(i, j, k));
+            lazy[operand].push_back(FieldVector(i, j, k));
+            arrays[operand][3 * n] = i;
+            arrays[operand][3 * n + 1] = j;
+            arrays[operand][3 * n + 2] = k;
+        }
+    }
+
+    double handWritten = timeBenchmark("Hand-written loop", [&]() {
+        const double *y = raw[0].data(), *k1 = raw[1].data(), *k2 = raw[2].data(), *k3 = raw[3].data();
+        const double *k4 = raw[4].data();
+        double *result = rawResult.data();
+
+        for (int n = 0; n < 3 * NUM_VECTORS; n++)
+            result[n] = y[n] + (h / 6) * (k1[n] + 2 * k2[n] + 2 * k3[n] + k4[n]);
+    });
+
+    timeBenchmark("Eager FieldVector temporaries", [&]() {
+        for (int n = 0; n < NUM_VECTORS; n++)
+            eagerResult[n] = eager[0][n] + (h / 6) * (eager[1][n] + (2 * eager[2][n]) + (2 * eager[3][n]) +
+                                                      eager[4][n]);
+    });
+
+    double expression = timeBenchmark("Expression template FieldVector", [&]() {
+        for (int n = 0; n < NUM_VECTORS; n++)
+            lazyResult[n] = lazy[0][n] + (h / 6) * (lazy[1][n] + (2 * lazy[2][n]) + (2 * lazy[3][n]) + lazy[4][n]);
+    });
+
+    double array = timeBenchmark("Expression template FieldArray", [&]() {
+        arrayResult = arrays[0] + (h / 6) * (arrays[1] + (2 * arrays[2]) + (2 * arrays[3]) + arrays[4]);
+    });
+
+    // every variant performs the same operations in the same order, so the results must be identical
+    bool identical = true;
+
+    for (int n = 0; n < NUM_VECTORS; n++) {
+        FieldVector expected(rawResult[3 * n], rawResult[3 * n + 1], rawResult[3 * n + 2]);
+
+        identical = identical && lazyResult[n] == expected;
+        identical = identical && eagerResult[n].i == rawResult[3 * n] && arrayResult[3 * n] == rawResult[3 * n];
+    }
+
+    cout << "Results are " << (identical ? "identical" : "DIFFERENT") << endl;
+    cout << "Expression template FieldVector / hand-written: " << expression / handWritten << endl;
+    cout << "Expression template FieldArray / hand-written: " << array / handWritten << endl;
+
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#define POINTS_PER_DIM 101
+#define NUM_TIME_LEVELS 2 // field entries stored per point besides the initial magnetic field, as after a few steps
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "../src/PointManager.h"
+#include "../src/PointArena.h"
+
+using namespace std;
+
+static std::uint64_t numSystemAllocations = 0;
+
+void *operator new(std::size_t size) {
+    numSystemAllocations++;
+
+    if (void *p = malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { free(p); }
+
+/**
+ * Time a phase of a benchmark and count the system allocations it makes
+ *
+ * @param run Phase to time
+ * @param allocations Receives the number of system allocations of the phase
+ * @return Time of the phase in milliseconds
+ */
+template <typename Phase>
+double timePhase(Phase run, std::uint64_t &allocations) {
+    std::uint64_t allocationsBefore = numSystemAllocations;
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    run();
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+    allocations = numSystemAllocations - allocationsBefore;
+
+    return chrono::duration<double, milli>(end - begin).count();
+}
+
+/**
+ * Give a point the field entries of a few time steps
+ */
+void fillHistory(Point *p) {
+    for (int level = 1; level <= NUM_TIME_LEVELS; level++) {
+        p->setElectricField(FieldVector(level, 0, 0), level);
+        p->setMagneticField(FieldVector(0, level, 0), level);
+    }
+}
+
+int main() {
+    cout << "Benchmark setting up and tearing down a " << POINTS_PER_DIM << "^3 grid" << endl;
+
+    vector<Point *> points;
+    points.reserve(POINTS_PER_DIM * POINTS_PER_DIM * POINTS_PER_DIM); // only the points themselves are timed
+
+    // a single run of each, a grid is built once per simulation. Both set up on memory fresh from the system, the
+    // arena's blocks are too large to be served from what the points allocated one by one left behind
+    std::uint64_t allocations;
+
+    cout << "Points allocated one by one" << endl;
+
+    double individualSetup = timePhase([&]() {
+        for (int i = 0; i < POINTS_PER_DIM; i++)
+            for (int j = 0; j < POINTS_PER_DIM; j++)
+                for (int k = 0; k < POINTS_PER_DIM; k++) {
+                    points.push_back(new Point(i, j, k, Point::Normal));
+                    fillHistory(points.back());
+                }
+    }, allocations);
+
+    cout << "  setup: " << individualSetup << " ms, " << allocations << " system allocations" << endl;
+
+    double individualTeardown = timePhase([&]() {
+        for (Point *p : points)
+            delete p;
+
+        points.clear();
+    }, allocations);
+
+    cout << "  teardown: " << individualTeardown << " ms" << endl;
+    cout << "Points allocated from an arena" << endl;
+
+    PointArena *arena = nullptr;
+
+    double arenaSetup = timePhase([&]() {
+        arena = new PointArena();
+
+        for (int i = 0; i < POINTS_PER_DIM; i++)
+            for (int j = 0; j < POINTS_PER_DIM; j++)
+                for (int k = 0; k < POINTS_PER_DIM; k++) {
+                    points.push_back(arena->createPoint(i, j, k, Point::Normal));
+                    fillHistory(points.back());
+                }
+    }, allocations);
+
+    ArenaStatistics statistics = arena->getStatistics();
+
+    cout << "  setup: " << arenaSetup << " ms, " << allocations << " system allocations" << endl;
+
+    double arenaTeardown = timePhase([&]() {
+        delete arena;
+        points.clear();
+    }, allocations);
+
+    cout << "  teardown: " << arenaTeardown << " ms" << endl;
+    cout << "  " << statistics.livePoints << " points, " << statistics.liveHistoryAllocations
+         << " history allocations in " << statistics.systemAllocations << " blocks of "
+         << statistics.reservedBytes / (1 << 20) << " MiB" << endl;
+
+    cout << "Speedup of the arena: " << individualSetup / arenaSetup << "x setup, "
+         << individualTeardown / arenaTeardown << "x teardown" << endl;
+
+    cout << "PointManager" << endl;
+
+    PointManager *pm = nullptr;
+    double time = timePhase([&]() { pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1); }, allocations);
+
+    statistics = pm->getAllocationStatistics();
+    cout << "  setup: " << time << " ms, " << allocations << " system allocations, " << statistics.livePoints
+         << " points including ghosts in " << statistics.systemAllocations << " blocks" << endl;
+
+    time = timePhase([&]() { delete pm; }, allocations);
+    cout << "  teardown: " << time << " ms" << endl;
+
+    return 0;
+}
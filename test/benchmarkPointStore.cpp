@@ -0,0 +1,195 @@
+#define POINTS_PER_DIM 48
+#define NUM_REPETITIONS 5
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/MortonPointStore.h"
+
+using namespace std;
+
+/**
+ * Time a benchmark over NUM_REPETITIONS runs and print the time per point of the fastest run
+ *
+ * @param name Name of the benchmark
+ * @param numPoints Number of points each run visits
+ * @param run Benchmark to time, returns a checksum of the points it visited
+ * @param checksum Receives the checksum of the last run
+ * @return Fastest time per point in nanoseconds
+ */
+template <typename Benchmark>
+double timeBenchmark(const string &name, size_t numPoints, Benchmark run, double &checksum) {
+    double fastest = INFINITY;
+
+    for (int repetition = 0; repetition < NUM_REPETITIONS; repetition++) {
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        checksum = run();
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+        fastest = min(fastest, chrono::duration<double, nano>(end - begin).count() / numPoints);
+    }
+
+    cout << "  " << name << ": " << fastest << " ns per point" << endl;
+
+    return fastest;
+}
+
+/**
+ * The hash CoordinateHasher used before it hashed lattice points by their Morton key, for comparison
+ */
+struct ComponentHasher {
+    size_t operator()(const Coordinates &p) const {
+        return ((hash<double>()(p.getI()) ^ (hash<double>()(p.getJ()) << 1)) >> 1) ^ (hash<double>()(p.getK()) << 1);
+    }
+};
+
+/**
+ * Print how evenly a map spreads its points over its buckets
+ */
+template <typename Map>
+void printOccupancy(const string &name, const Map &map) {
+    size_t largestBucket = 0, emptyBuckets = 0;
+
+    for (size_t bucket = 0; bucket < map.bucket_count(); bucket++) {
+        largestBucket = max(largestBucket, map.bucket_size(bucket));
+        emptyBuckets += map.bucket_size(bucket) == 0;
+    }
+
+    cout << "  " << name << ": " << map.bucket_count() << " buckets, " << emptyBuckets << " empty, largest holds "
+         << largestBucket << " points" << endl;
+}
+
+int main() {
+    cout << "Benchmark the Morton ordered point store against the CoordinateHasher map on a " << POINTS_PER_DIM
+         << "^3 lattice" << endl;
+
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    auto points = pm->getCollectionOfPoints();
+
+    for (auto &p : *points)
+        p.second->setVoltage(p.first.getI() + POINTS_PER_DIM * (p.first.getJ() + POINTS_PER_DIM * p.first.getK()));
+
+    MortonPointStore store(pm);
+    unordered_map<Coordinates, Point *, ComponentHasher> componentPoints(points->begin(), points->end());
+    size_t numPoints = points->size();
+
+    printOccupancy("CoordinateHasher", *points);
+    printOccupancy("component hash", componentPoints);
+
+    const int offsets[6][3] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    double hashedSum, mortonSum;
+    bool passed = true;
+
+    cout << "Iterate over every point" << endl;
+
+    double hashedIteration = timeBenchmark("CoordinateHasher map", numPoints, [&]() {
+        double sum = 0.0;
+
+        for (auto &p : *points)
+            sum += p.second->getVoltage();
+
+        return sum;
+    }, hashedSum);
+
+    double mortonIteration = timeBenchmark("Morton store", numPoints, [&]() {
+        double sum = 0.0;
+
+        for (const auto &entry : store)
+            sum += entry.point->getVoltage();
+
+        return sum;
+    }, mortonSum);
+
+    passed = passed && hashedSum == mortonSum;
+
+    cout << "Look up every point in lattice order" << endl;
+
+    double hashedLookup = timeBenchmark("CoordinateHasher map", numPoints, [&]() {
+        double sum = 0.0;
+
+        for (int i = 0; i < POINTS_PER_DIM; i++)
+            for (int j = 0; j < POINTS_PER_DIM; j++)
+                for (int k = 0; k < POINTS_PER_DIM; k++)
+                    sum += points->find(Coordinates(i, j, k))->second->getVoltage();
+
+        return sum;
+    }, hashedSum);
+
+    double componentLookup = timeBenchmark("component hash map", numPoints, [&]() {
+        double sum = 0.0;
+
+        for (int i = 0; i < POINTS_PER_DIM; i++)
+            for (int j = 0; j < POINTS_PER_DIM; j++)
+                for (int k = 0; k < POINTS_PER_DIM; k++)
+                    sum += componentPoints.find(Coordinates(i, j, k))->second->getVoltage();
+
+        return sum;
+    }, mortonSum);
+
+    passed = passed && hashedSum == mortonSum;
+
+    double mortonLookup = timeBenchmark("Morton store", numPoints, [&]() {
+        double sum = 0.0;
+
+        for (int i = 0; i < POINTS_PER_DIM; i++)
+            for (int j = 0; j < POINTS_PER_DIM; j++)
+                for (int k = 0; k < POINTS_PER_DIM; k++)
+                    sum += store.find(i, j, k)->getVoltage();
+
+        return sum;
+    }, mortonSum);
+
+    passed = passed && hashedSum == mortonSum;
+
+    cout << "Visit the six neighbors of every point" << endl;
+
+    double hashedNeighbors = timeBenchmark("CoordinateHasher map", numPoints, [&]() {
+        double sum = 0.0;
+
+        for (auto &p : *points) {
+            for (const auto &offset : offsets) {
+                auto neighbor = points->find(Coordinates(p.first.getI() + offset[0], p.first.getJ() + offset[1],
+                                                         p.first.getK() + offset[2]));
+
+                if (neighbor != points->end())
+                    sum += neighbor->second->getVoltage();
+            }
+        }
+
+        return sum;
+    }, hashedSum);
+
+    double mortonNeighbors = timeBenchmark("Morton store", numPoints, [&]() {
+        double sum = 0.0;
+
+        for (const auto &entry : store) {
+            for (int direction = 0; direction < 6; direction++) {
+                Point *neighbor = store.findNeighbor(entry.key, (PointManager::Neighbor) direction);
+
+                if (neighbor)
+                    sum += neighbor->getVoltage();
+            }
+        }
+
+        return sum;
+    }, mortonSum);
+
+    passed = passed && hashedSum == mortonSum;
+
+    cout << "Speedup of the Morton store: " << hashedIteration / mortonIteration << "x iterating, "
+         << hashedLookup / mortonLookup << "x looking up, " << hashedNeighbors / mortonNeighbors
+         << "x visiting neighbors" << (passed ? "" : " (checksums DIFFER)") << endl;
+    cout << "Speedup of the Morton keyed CoordinateHasher over the component hash: " << componentLookup / hashedLookup
+         << "x looking up" << endl;
+
+    delete pm;
+
+    return passed ? 0 : 1;
+}
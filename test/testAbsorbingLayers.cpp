@@ -0,0 +1,223 @@
+#define SMALL_POINTS_PER_DIM 41 // the faces are 20 spacings away from the pulse
+#define REFERENCE_POINTS_PER_DIM 81 // the faces are too far away for their reflections to reach the probe in time
+#define PULSE_WIDTH 2.0
+#define PROBE_DISTANCE 8 // distance of the probe from the pulse, towards the end face of the i axis
+#define LAYER_THICKNESS 8.0
+#define NUM_STEPS 120 // long enough for a reflection off the small cube's faces to pass the probe
+#define MAX_REFLECTION 0.01
+#define MIN_IMPROVEMENT 10.0 // the layers must reflect at least this many times less than the bare faces
+// the FieldSolver runs on an octant of each cube, bounded by symmetry planes through the pulse
+#define FIELD_SOLVER_SMALL_POINTS_PER_DIM 33 // the faces are 16 spacings away from the pulse
+#define FIELD_SOLVER_REFERENCE_POINTS_PER_DIM 57
+#define FIELD_SOLVER_PROBE_DISTANCE 3
+#define FIELD_SOLVER_NUM_STEPS 28
+#define FIELD_SOLVER_MAX_REFLECTION 0.005
+// the bare faces already absorb most of the pulse, their ghosts copy the field, and the collocated differences of the
+// graded damping reflect a little of what is left
+#define FIELD_SOLVER_MIN_IMPROVEMENT 4.0
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/YeeSolver.h"
+#include "../src/FieldSolver.h"
+
+using namespace std;
+
+/**
+ * Start a pulse in the center of a cube and record the electric field at a probe next to it. The pulse is the discrete
+ * curl of a gaussian, so it has no divergence and radiates away completely: the probe only sees the outgoing pulse and
+ * whatever the faces of the cube reflect back
+ *
+ * @param pointsPerDim Number of points along each axis of the cube
+ * @param layerThickness Thickness of the absorbing layer on every face, 0 for none
+ * @param timeStep Time step of the run, the same for every cube
+ * @return Electric field at the probe after every step
+ */
+vector<double> recordProbe(int pointsPerDim, double layerThickness, double timeStep) {
+    auto pointManager = new PointManager(pointsPerDim, 0, pointsPerDim - 1, nullptr);
+    int center = pointsPerDim / 2;
+
+    for (int face = PointManager::IStartFace; face <= PointManager::KEndFace; face++)
+        pointManager->setAbsorbingLayerThickness((PointManager::Face) face, layerThickness);
+
+    YeeSolver solver(pointManager, timeStep, DRUDE_SCATTERING_TIME);
+    YeeSolver::Grid &grid = solver.getGrid();
+    double *eI = grid.getComponent(YeeSolver::Grid::ElectricI);
+    double *eJ = grid.getComponent(YeeSolver::Grid::ElectricJ);
+    std::size_t strideI = grid.getStride(PointManager::IAxis), strideJ = grid.getStride(PointManager::JAxis);
+
+    // E = curl (0, 0, A) with A a gaussian on the K faces, differenced like the electric field update
+    vector<double> potential(grid.getTotalNumberPoints(), 0.0);
+
+    for (int i = 0; i < pointsPerDim; i++) {
+        for (int j = 0; j < pointsPerDim; j++) {
+            for (int k = 0; k < pointsPerDim; k++) {
+                double di = i + 0.5 - center, dj = j + 0.5 - center, dk = k - center;
+                potential[grid.getIndex(i, j, k)] = exp(-(di * di + dj * dj + dk * dk) / (2 * PULSE_WIDTH * PULSE_WIDTH));
+            }
+        }
+    }
+
+    for (int i = 1; i < pointsPerDim - 1; i++) {
+        for (int j = 1; j < pointsPerDim - 1; j++) {
+            for (int k = 1; k < pointsPerDim - 1; k++) {
+                std::size_t index = grid.getIndex(i, j, k);
+
+                eI[index] = potential[index] - potential[index - strideJ];
+                eJ[index] = potential[index - strideI] - potential[index];
+            }
+        }
+    }
+
+    // the pulse circles around the k axis, so it points along j at the probe
+    std::size_t probe = grid.getIndex(center + PROBE_DISTANCE, center, center);
+    vector<double> samples;
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        solver.calculateNextFields();
+        samples.push_back(eJ[probe]);
+    }
+
+    delete pointManager;
+
+    return samples;
+}
+
+/**
+ * Start a pulse in the center of a vacuum cube and record the electric field at a probe next to it with the
+ * collocated FieldSolver, see recordProbe. The pulse is the central difference curl of a gaussian, which the solver's
+ * central differences see as free of divergence. Only the octant above the center is simulated, the planes through the
+ * center are electric walls across i and j, where the pulse's tangential field is odd, and a magnetic wall across k
+ *
+ * @param pointsPerDim Number of points along each axis of the cube
+ * @param layerThickness Thickness of the absorbing layer on every face, 0 for none
+ * @param timeStep Time step of the run, the same for every cube
+ * @return Electric field at the probe after every step
+ */
+vector<double> recordFieldSolverProbe(int pointsPerDim, double layerThickness, double timeStep) {
+    int center = pointsPerDim / 2;
+    const int numPoints[] = {center + 1, center + 1, center + 1};
+    auto pointManager = new PointManager(1.0, 0, pointsPerDim - 1, Coordinates(center, center, center), numPoints);
+
+    pointManager->setSymmetry(PointManager::IStartFace, PointManager::ElectricWall);
+    pointManager->setSymmetry(PointManager::JStartFace, PointManager::ElectricWall);
+    pointManager->setSymmetry(PointManager::KStartFace, PointManager::MagneticWall);
+
+    for (int face = PointManager::IEndFace; face <= PointManager::KEndFace; face += 2)
+        pointManager->setAbsorbingLayerThickness((PointManager::Face) face, layerThickness);
+
+    auto potential = [center](double i, double j, double k) {
+        double di = i - center, dj = j - center, dk = k - center;
+        return exp(-(di * di + dj * dj + dk * dk) / (2 * PULSE_WIDTH * PULSE_WIDTH));
+    };
+
+    for (auto &p : *pointManager->getCollectionOfPoints()) {
+        double i = p.first.getI(), j = p.first.getJ(), k = p.first.getK();
+
+        p.second->setMaterial(MaterialTable::Vacuum);
+        p.second->setElectricField(FieldVector((potential(i, j + 1, k) - potential(i, j - 1, k)) / 2,
+                                               (potential(i - 1, j, k) - potential(i + 1, j, k)) / 2, 0), 0);
+    }
+
+    FieldSolver solver(pointManager, timeStep, DRUDE_SCATTERING_TIME);
+    Coordinates probe(center + FIELD_SOLVER_PROBE_DISTANCE, center, center);
+    vector<double> samples;
+
+    for (int step = 0; step < FIELD_SOLVER_NUM_STEPS; step++) {
+        solver.calculateNextFields();
+        samples.push_back(pointManager->getElectricField(probe, solver.getCurrentTime())->getJComp());
+    }
+
+    delete pointManager;
+
+    return samples;
+}
+
+/**
+ * Calculate the reflection at the probe as the largest difference to the reference run relative to the largest
+ * reference field
+ */
+double calculateReflection(const vector<double> &reference, const vector<double> &samples) {
+    double maxDifference = 0.0, maxMagnitude = 0.0;
+
+    for (size_t step = 0; step < reference.size(); step++) {
+        maxDifference = max(maxDifference, fabs(samples[step] - reference[step]));
+        maxMagnitude = max(maxMagnitude, fabs(reference[step]));
+    }
+
+    return maxDifference / maxMagnitude;
+}
+
+/**
+ * The absorbing layers of the YeeSolver must reflect at most MAX_REFLECTION of the outgoing pulse
+ */
+bool testYeeSolver() {
+    cout << "YeeSolver" << endl;
+
+    // the time step only depends on the spacing and the materials, which all cubes share
+    auto timeStepManager = new PointManager(SMALL_POINTS_PER_DIM, 0, SMALL_POINTS_PER_DIM - 1, nullptr);
+    double timeStep = YeeSolver(timeStepManager, 1.0, DRUDE_SCATTERING_TIME).calculateStableTimeStep();
+    delete timeStepManager;
+
+    cout << "Running the reference cube with " << REFERENCE_POINTS_PER_DIM << " points per axis" << endl;
+    vector<double> reference = recordProbe(REFERENCE_POINTS_PER_DIM, 0.0, timeStep);
+
+    cout << "Running the small cube without absorbing layers" << endl;
+    double bareReflection = calculateReflection(reference, recordProbe(SMALL_POINTS_PER_DIM, 0.0, timeStep));
+
+    cout << "Running the small cube with " << LAYER_THICKNESS << " spacings thick absorbing layers" << endl;
+    double layerReflection = calculateReflection(reference, recordProbe(SMALL_POINTS_PER_DIM, LAYER_THICKNESS,
+                                                                        timeStep));
+
+    bool passed = layerReflection <= MAX_REFLECTION && layerReflection * MIN_IMPROVEMENT <= bareReflection;
+
+    cout << "Reflection without absorbing layers: " << bareReflection << endl;
+    cout << "Reflection with absorbing layers: " << layerReflection << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+/**
+ * The absorbing layers of the FieldSolver must reflect at most FIELD_SOLVER_MAX_REFLECTION of the outgoing pulse
+ */
+bool testFieldSolver() {
+    cout << "FieldSolver" << endl;
+
+    auto timeStepManager = new PointManager(FIELD_SOLVER_SMALL_POINTS_PER_DIM, 0, FIELD_SOLVER_SMALL_POINTS_PER_DIM - 1,
+                                            nullptr);
+    double timeStep = FieldSolver(timeStepManager, 1.0, DRUDE_SCATTERING_TIME).calculateStableTimeStep();
+    delete timeStepManager;
+
+    cout << "Running the reference cube with " << FIELD_SOLVER_REFERENCE_POINTS_PER_DIM << " points per axis" << endl;
+    vector<double> reference = recordFieldSolverProbe(FIELD_SOLVER_REFERENCE_POINTS_PER_DIM, 0.0, timeStep);
+
+    cout << "Running the small cube without absorbing layers" << endl;
+    double bareReflection = calculateReflection(reference, recordFieldSolverProbe(FIELD_SOLVER_SMALL_POINTS_PER_DIM,
+                                                                                  0.0, timeStep));
+
+    cout << "Running the small cube with " << LAYER_THICKNESS << " spacings thick absorbing layers" << endl;
+    double layerReflection = calculateReflection(reference, recordFieldSolverProbe(FIELD_SOLVER_SMALL_POINTS_PER_DIM,
+                                                                                   LAYER_THICKNESS, timeStep));
+
+    bool passed = layerReflection <= FIELD_SOLVER_MAX_REFLECTION &&
+                  layerReflection * FIELD_SOLVER_MIN_IMPROVEMENT <= bareReflection;
+
+    cout << "Reflection without absorbing layers: " << bareReflection << endl;
+    cout << "Reflection with absorbing layers: " << layerReflection << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test absorbing layers" << endl;
+
+    bool passed = testYeeSolver();
+    passed = testFieldSolver() && passed;
+
+    return passed ? 0 : 1;
+}
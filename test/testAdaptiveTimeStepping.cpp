@@ -0,0 +1,129 @@
+#define POINTS_PER_DIM 9
+#define CENTER 4
+#define PULSE_WIDTH 1.5
+#define TOLERANCE 1.0e-6 // small enough to reject the stable time step
+#define MIN_ERROR_RATIO 0.01 // an estimate of the wrong order would accept steps far more accurate than asked for
+#define NUM_REFERENCE_STEPS 16 // steps of the reference run per adaptive step
+#define UNREACHABLE_TOLERANCE 1.0e-30 // far below the rounding error of the fields
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+
+using namespace std;
+
+/**
+ * Create a periodic cube with a gaussian pulse of the electric field around the center
+ */
+PointManager *createPulse() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+
+    for (int axis = 0; axis < 3; axis++)
+        pm->setPeriodic((PointManager::Axis) axis, true);
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        double di = p.first.getI() - CENTER, dj = p.first.getJ() - CENTER, dk = p.first.getK() - CENTER;
+        double pulse = exp(-(di * di + dj * dj + dk * dk) / (2 * PULSE_WIDTH * PULSE_WIDTH));
+
+        p.second->setElectricField(FieldVector(0, 0, pulse), 0);
+    }
+
+    return pm;
+}
+
+/**
+ * The error of an adaptive step must meet the tolerance without falling far below it, for the third and the fourth
+ * order scheme
+ *
+ * @param scheme Low storage Runge-Kutta scheme to advance the fields with
+ * @param name Name of the scheme to report
+ */
+bool testStepError(LowStorageRungeKutta::Scheme scheme, const string &name) {
+    PointManager *pm = createPulse(), *reference = createPulse();
+    FieldSolver solver(pm, 1.0, DRUDE_SCATTERING_TIME);
+    FieldSolver referenceSolver(reference, 1.0, DRUDE_SCATTERING_TIME);
+
+    solver.setTimeIntegrator(scheme);
+    solver.setTimeStep(solver.calculateStableTimeStep());
+    solver.enableAdaptiveTimeStepping(TOLERANCE);
+    solver.calculateNextFields();
+
+    double time = solver.getCurrentTime();
+
+    // the same step in many small steps, whose error is negligible against the tolerance
+    referenceSolver.setTimeIntegrator(scheme);
+    referenceSolver.setTimeStep(time / NUM_REFERENCE_STEPS);
+
+    for (int step = 0; step < NUM_REFERENCE_STEPS; step++)
+        referenceSolver.calculateNextFields();
+
+    double maxDifference = 0.0, maxMagnitude = 0.0;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        FieldVector *eField = p.second->getElectricField(time);
+        FieldVector *referenceField = reference->getElectricField(p.first, referenceSolver.getCurrentTime());
+
+        maxDifference = max(maxDifference, calculateMaxComponent(*eField - *referenceField));
+        maxMagnitude = max(maxMagnitude, calculateMaxComponent(*referenceField));
+    }
+
+    double errorRatio = maxDifference / maxMagnitude / TOLERANCE;
+    bool passed = solver.getRejectedStepCount() > 0 && errorRatio <= 1.0 && errorRatio >= MIN_ERROR_RATIO;
+
+    cout << "  " << name << ": error " << errorRatio << " of the tolerance after " << solver.getRejectedStepCount()
+         << " rejected steps" << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete pm;
+    delete reference;
+
+    return passed;
+}
+
+/**
+ * A tolerance below the rounding error can never be met, the step must give up after a bounded number of retries and
+ * leave the solver as it was before the step
+ */
+bool testUnreachableTolerance() {
+    PointManager *pm = createPulse();
+    FieldSolver solver(pm, 1.0, DRUDE_SCATTERING_TIME);
+    double timeStep = solver.calculateStableTimeStep();
+
+    solver.setTimeStep(timeStep);
+    solver.enableAdaptiveTimeStepping(UNREACHABLE_TOLERANCE);
+    bool thrown = false;
+
+    try {
+        solver.calculateNextFields();
+    } catch (const runtime_error &) {
+        thrown = true;
+    }
+
+    bool unchanged = solver.getCurrentTime() == 0 && solver.getTimeStep() == timeStep;
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        unchanged = unchanged && p.second->getElectricField(solver.getNextTime()) == nullptr;
+
+    bool passed = thrown && unchanged && solver.getRejectedStepCount() == MAX_STEP_RETRIES;
+
+    cout << "  unreachable tolerance: " << (thrown ? "gave up" : "did not give up") << " after "
+         << solver.getRejectedStepCount() << " rejected steps" << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete pm;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test the adaptive time stepping" << endl;
+
+    bool passed = testStepError(LowStorageRungeKutta::Williamson3, "Williamson3");
+    passed = testStepError(LowStorageRungeKutta::CarpenterKennedy4, "CarpenterKennedy4") && passed;
+    passed = testUnreachableTolerance() && passed;
+
+    return passed ? 0 : 1;
+}
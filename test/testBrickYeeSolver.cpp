@@ -0,0 +1,136 @@
+#define NUM_STEPS 12 // short enough for the fields to still be away from most of the cube
+#define ROD_POINTS_PER_DIM 45 // not a multiple of the brick size, so the last bricks extend past the cube
+#define PULSE_POINTS_PER_DIM 48 // a multiple of the brick size, so every axis can be periodic
+#define PULSE_WIDTH 1.5
+#define TOLERANCE 1.0e-14
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/YeeSolver.h"
+#include "../src/BrickYeeSolver.h"
+
+using namespace std;
+
+/**
+ * Run the dense and the brick solver side by side and compare every field component at every point after each step
+ *
+ * @param name Name of the run
+ * @param dense Dense solver, already set up
+ * @param bricks Brick solver with the same fields
+ * @return true if the fields agree
+ */
+bool compareSolvers(const string &name, YeeSolver &dense, BrickYeeSolver &bricks) {
+    const YeeSolver::Grid &denseGrid = dense.getGrid();
+    const BrickYeeSolver::Grid &brickGrid = bricks.getGrid();
+    double maxDifference = 0.0, maxMagnitude = 0.0;
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        dense.calculateNextFields();
+        bricks.calculateNextFields();
+
+        for (int component = 0; component < YeeSolver::Grid::numComponents; component++) {
+            const double *values = denseGrid.getComponent((YeeSolver::Grid::Component) component);
+
+            for (int i = 0; i < denseGrid.getNumPoints(PointManager::IAxis); i++) {
+                for (int j = 0; j < denseGrid.getNumPoints(PointManager::JAxis); j++) {
+                    for (int k = 0; k < denseGrid.getNumPoints(PointManager::KAxis); k++) {
+                        double expected = values[denseGrid.getIndex(i, j, k)];
+                        double actual = brickGrid.getValue((BrickYeeSolver::Grid::Component) component, i, j, k);
+
+                        maxDifference = max(maxDifference, fabs(expected - actual));
+                        maxMagnitude = max(maxMagnitude, fabs(expected));
+                    }
+                }
+            }
+        }
+    }
+
+    // the fields reach one point further per step, so a brick must stay inactive
+    double relativeError = maxMagnitude == 0 ? 0.0 : maxDifference / maxMagnitude;
+    bool passed = relativeError <= TOLERANCE && brickGrid.getNumActiveBricks() < brickGrid.getTotalNumberBricks();
+
+    cout << "  " << name << ": " << brickGrid.getNumActiveBricks() << " of " << brickGrid.getTotalNumberBricks()
+         << " bricks active, relative error " << relativeError << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+/**
+ * A conducting rod along k, held at a voltage over its upper half
+ */
+bool testRod() {
+    auto pointManager = new PointManager(ROD_POINTS_PER_DIM, 0, ROD_POINTS_PER_DIM - 1, nullptr);
+    int center = ROD_POINTS_PER_DIM / 2;
+
+    for (int k = 0; k < ROD_POINTS_PER_DIM; k++) {
+        auto pt = Coordinates(center, center, k);
+
+        pointManager->setConductivity(pt, 1.0);
+        pointManager->setVoltage(pt, k < center ? 0.0 : 1.0);
+    }
+
+    YeeSolver dense(pointManager, 1.0, DRUDE_SCATTERING_TIME);
+    BrickYeeSolver bricks(pointManager, 1.0, DRUDE_SCATTERING_TIME);
+    double timeStep = dense.calculateStableTimeStep();
+
+    dense.setTimeStep(timeStep);
+    dense.calculateAndSetInitialElectricField();
+    bricks.setTimeStep(timeStep);
+    bricks.calculateAndSetInitialElectricField();
+
+    bool passed = compareSolvers("rod", dense, bricks);
+    delete pointManager;
+
+    return passed;
+}
+
+/**
+ * A pulse near a corner of a cube that is periodic along every axis, so the pulse crosses the faces
+ */
+bool testPeriodicPulse() {
+    auto pointManager = new PointManager(PULSE_POINTS_PER_DIM, 0, PULSE_POINTS_PER_DIM - 1, nullptr);
+
+    for (int axis = PointManager::IAxis; axis <= PointManager::KAxis; axis++)
+        pointManager->setPeriodic((PointManager::Axis) axis, true);
+
+    YeeSolver dense(pointManager, 1.0, DRUDE_SCATTERING_TIME);
+    BrickYeeSolver bricks(pointManager, 1.0, DRUDE_SCATTERING_TIME);
+    double timeStep = dense.calculateStableTimeStep();
+
+    dense.setTimeStep(timeStep);
+    bricks.setTimeStep(timeStep);
+
+    YeeSolver::Grid &denseGrid = dense.getGrid();
+    double *eJ = denseGrid.getComponent(YeeSolver::Grid::ElectricJ);
+
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 8; j++) {
+            for (int k = 0; k < 8; k++) {
+                double di = i - 2.0, dj = j - 3.5, dk = k - 4.0;
+                double value = exp(-(di * di + dj * dj + dk * dk) / (2 * PULSE_WIDTH * PULSE_WIDTH));
+
+                eJ[denseGrid.getIndex(i, j, k)] = value;
+                bricks.getGrid().setValue(BrickYeeSolver::Grid::ElectricJ, i, j, k, value);
+            }
+        }
+    }
+
+    bool passed = compareSolvers("periodic pulse", dense, bricks);
+    delete pointManager;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test brick Yee solver against the dense Yee solver" << endl;
+
+    bool passed = testRod();
+    passed = testPeriodicPulse() && passed;
+
+    return passed ? 0 : 1;
+}
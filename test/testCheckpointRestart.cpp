@@ -0,0 +1,169 @@
+#define POINTS_PER_DIM 9
+#define CENTER 4
+#define LAYER_THICKNESS 2.0
+#define PULSE_WIDTH 1.5
+#define ROD_CONDUCTIVITY 2.0
+#define TOLERANCE 1.0e-4 // of the adaptive time stepping
+#define STEPS_BEFORE 5 // steps taken before the checkpoint
+#define STEPS_AFTER 5 // steps taken after it, by the continuous and the restored run
+
+#include <iostream>
+#include <sstream>
+#include <cmath>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+#include "testHelpers.h"
+
+using namespace std;
+
+/**
+ * Count the ghosts of a grid that mirror or wrap around to a simulated point
+ */
+std::size_t countImageGhosts(const PointManager &pm) {
+    std::size_t count = 0;
+
+    for (const auto &ghost : pm.getGhosts())
+        count += ghost.image != nullptr;
+
+    return count;
+}
+
+/**
+ * A restored grid must keep its periodic axes, absorbing layers, symmetry planes, difference scheme and ghost width,
+ * and rebuild the same ghost layer from them
+ */
+bool testBoundarySettings() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+
+    pm->setPeriodic(PointManager::IAxis, true);
+    pm->setAbsorbingLayerThickness(PointManager::KEndFace, LAYER_THICKNESS);
+    pm->setSymmetry(PointManager::JStartFace, PointManager::MagneticWall);
+    pm->setDifferenceScheme(PointManager::FourthOrder);
+    pm->setGhostWidth(3);
+    pm->setFullDomainOutput(true);
+
+    stringstream checkpoint;
+    pm->writeCheckpoint(checkpoint, 0);
+
+    auto restored = new PointManager(checkpoint);
+    bool passed = restored->getDifferenceScheme() == PointManager::FourthOrder && restored->getGhostWidth() == 3 &&
+                  restored->hasFullDomainOutput() && restored->getGhosts().size() == pm->getGhosts().size() &&
+                  countImageGhosts(*restored) == countImageGhosts(*pm);
+
+    for (int axis = 0; axis < 3; axis++)
+        passed = passed && restored->isPeriodic((PointManager::Axis) axis) == pm->isPeriodic((PointManager::Axis) axis);
+
+    for (int face = 0; face < 6; face++) {
+        auto f = (PointManager::Face) face;
+        passed = passed && restored->getSymmetry(f) == pm->getSymmetry(f) &&
+                 restored->getAbsorbingLayerThickness(f) == pm->getAbsorbingLayerThickness(f);
+    }
+
+    // the images of a point lie across the same symmetry plane
+    Coordinates target(1, 2, 3);
+    auto images = pm->getMirrorImages(target), restoredImages = restored->getMirrorImages(target);
+    passed = passed && images.size() == 2 && restoredImages.size() == images.size() &&
+             restoredImages[1].coordinates == images[1].coordinates;
+
+    delete pm;
+    delete restored;
+
+    return report("boundary settings", passed);
+}
+
+/**
+ * Check that two fields are both missing or equal bit for bit
+ */
+bool isIdentical(const FieldVector *a, const FieldVector *b) {
+    if (!a || !b)
+        return a == b;
+
+    return a->getIComp() == b->getIComp() && a->getJComp() == b->getJComp() && a->getKComp() == b->getKComp();
+}
+
+/**
+ * Create a grid with a periodic axis, an absorbing layer, a conducting rod along k and a gaussian pulse around the
+ * center
+ */
+PointManager *createGrid() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+
+    pm->setPeriodic(PointManager::IAxis, true);
+    pm->setAbsorbingLayerThickness(PointManager::KEndFace, LAYER_THICKNESS);
+
+    for (int k = 0; k < POINTS_PER_DIM; k++)
+        pm->setConductivity(Coordinates(CENTER, CENTER, k), ROD_CONDUCTIVITY);
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        double di = p.first.getI() - CENTER, dj = p.first.getJ() - CENTER, dk = p.first.getK() - CENTER;
+        double pulse = exp(-(di * di + dj * dj + dk * dk) / (2 * PULSE_WIDTH * PULSE_WIDTH));
+
+        p.second->setElectricField(FieldVector(pulse, 0, pulse), 0);
+    }
+
+    return pm;
+}
+
+/**
+ * A run restored from a checkpoint taken after a few steps must continue bit for bit like the uninterrupted run, with
+ * the solver settings that differ from the defaults kept
+ *
+ * @param adaptive true to adapt the time step, else a fixed time step is taken
+ */
+bool testRestart(bool adaptive) {
+    PointManager *pm = createGrid();
+    auto solver = new FieldSolver(pm, 1.0, DRUDE_SCATTERING_TIME);
+
+    solver->setCurrentIntegrator(FieldSolver::RungeKutta4);
+    solver->setTimeIntegrator(LowStorageRungeKutta::Williamson3);
+    solver->setTimeStep(solver->calculateStableTimeStep());
+
+    if (adaptive)
+        solver->enableAdaptiveTimeStepping(TOLERANCE);
+
+    for (int step = 0; step < STEPS_BEFORE; step++)
+        solver->calculateNextFields();
+
+    stringstream checkpoint;
+    solver->writeCheckpoint(checkpoint);
+
+    auto restoredPm = new PointManager(checkpoint);
+    auto restored = new FieldSolver(restoredPm, checkpoint);
+
+    for (int step = 0; step < STEPS_AFTER; step++) {
+        solver->calculateNextFields();
+        restored->calculateNextFields();
+    }
+
+    double time = solver->getCurrentTime();
+    bool passed = restored->getCurrentTime() == time && restored->getTimeStep() == solver->getTimeStep() &&
+                  restored->getRejectedStepCount() == solver->getRejectedStepCount();
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        Point *restoredPoint = restoredPm->getPoint(p.first);
+
+        passed = passed && restoredPoint->getElectricField(time) &&
+                 isIdentical(p.second->getElectricField(time), restoredPoint->getElectricField(time)) &&
+                 isIdentical(p.second->getMagneticField(time), restoredPoint->getMagneticField(time)) &&
+                 isIdentical(p.second->getCurrentField(time), restoredPoint->getCurrentField(time));
+    }
+
+    delete solver;
+    delete restored;
+    delete pm;
+    delete restoredPm;
+
+    return report(string(adaptive ? "adaptive" : "fixed") + " time step restart", passed);
+}
+
+int main(){
+    cout << "Test restarting from a checkpoint" << endl;
+
+    bool passed = testBoundarySettings();
+    passed = testRestart(false) && passed;
+    passed = testRestart(true) && passed;
+
+    return passed ? 0 : 1;
+}
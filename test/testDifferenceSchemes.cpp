@@ -0,0 +1,353 @@
+#define COARSE_POINTS_PER_DIM 12 // one wavelength across the periodic cube
+#define LAPLACE_POINTS_PER_DIM 9 // spacings of the bounded cube, doubled for the fine run
+#define LAPLACE_AMPLITUDE 1.0e6 // the voltage calculator stops once no voltage changes in the first 3 decimals
+#define TIME_STEP_SAFETY 0.25 // keeps the error of the time integrator below the error of the differences
+#define PULSE_POINTS_PER_DIM 12
+#define PULSE_STEPS 24 // long enough for the pulse to reflect off the faces a few times
+#define PULSE_WIDTH 1.5
+#define MAX_POINT_CURL_ERROR 1.0e-2 // relative to the wavenumber, at the coarse resolution
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+#include "../src/InitialVoltageCalculator.h"
+
+using namespace std;
+
+const PointManager::DifferenceScheme schemes[] = {PointManager::SecondOrder, PointManager::FourthOrder,
+                                                  PointManager::CompactFourthOrder};
+const string schemeNames[] = {"second order", "fourth order", "compact fourth order"};
+
+/**
+ * Create a cube of points one apart that is periodic along every axis
+ */
+PointManager *createPeriodicCube(int pointsPerDim, PointManager::DifferenceScheme scheme) {
+    auto pm = new PointManager(pointsPerDim, 0, pointsPerDim - 1, nullptr);
+
+    for (int axis = PointManager::IAxis; axis <= PointManager::KAxis; axis++)
+        pm->setPeriodic((PointManager::Axis) axis, true);
+
+    pm->setDifferenceScheme(scheme);
+
+    return pm;
+}
+
+/**
+ * Take the electric field of a periodic potential, i.e. its gradient, and return the largest error
+ */
+double calculateGradientError(int pointsPerDim, PointManager::DifferenceScheme scheme) {
+    PointManager *pm = createPeriodicCube(pointsPerDim, scheme);
+    double wavenumber = 2 * M_PI / pointsPerDim;
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        p.second->setVoltage(sin(wavenumber * p.first.getI()) * sin(wavenumber * p.first.getJ()) *
+                             sin(wavenumber * p.first.getK()));
+
+    FieldSolver solver(pm, 1.0, DRUDE_SCATTERING_TIME);
+    solver.calculateAndSetInitialElectricField();
+
+    double error = 0.0;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        double si = sin(wavenumber * p.first.getI()), ci = cos(wavenumber * p.first.getI());
+        double sj = sin(wavenumber * p.first.getJ()), cj = cos(wavenumber * p.first.getJ());
+        double sk = sin(wavenumber * p.first.getK()), ck = cos(wavenumber * p.first.getK());
+        FieldVector expected = -wavenumber * FieldVector(ci * sj * sk, si * cj * sk, si * sj * ck);
+
+        error = max(error, calculateMaxComponent(*p.second->getElectricField(0) - expected));
+    }
+
+    delete pm;
+
+    return error / wavenumber;
+}
+
+/**
+ * Get the fields of a plane wave in vacuum travelling diagonally across the i-j plane with E along k
+ */
+void getPlaneWave(const Coordinates &c, double wavenumber, double time, FieldVector &eField, FieldVector &bField) {
+    double phase = wavenumber * (c.getI() + c.getJ()) - std::sqrt(2.0) * wavenumber * SPEED_OF_LIGHT * time;
+
+    eField = FieldVector(0, 0, sin(phase));
+    bField = (sin(phase) / (std::sqrt(2.0) * SPEED_OF_LIGHT)) * FieldVector(1, -1, 0); // direction of travel x E / c
+}
+
+/**
+ * Propagate a plane wave a quarter of its period across the periodic cube and return the largest error of E
+ */
+double calculateWaveError(int pointsPerDim, PointManager::DifferenceScheme scheme) {
+    PointManager *pm = createPeriodicCube(pointsPerDim, scheme);
+    double wavenumber = 2 * M_PI / pointsPerDim;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        FieldVector eField, bField;
+        getPlaneWave(p.first, wavenumber, 0, eField, bField);
+
+        p.second->setPermittivity(1.0); // a single material, the layers would scatter the wave
+        p.second->setElectricField(eField, 0);
+        *p.second->getMagneticField(0) = bField;
+    }
+
+    FieldSolver solver(pm, 1.0, DRUDE_SCATTERING_TIME);
+    double endTime = M_PI / (2 * std::sqrt(2.0) * wavenumber * SPEED_OF_LIGHT);
+    int numSteps = (int) std::ceil(endTime / solver.calculateStableTimeStep(TIME_STEP_SAFETY));
+
+    solver.setTimeStep(endTime / numSteps);
+
+    for (int step = 0; step < numSteps; step++)
+        solver.calculateNextFields();
+
+    double error = 0.0;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        FieldVector eField, bField;
+        getPlaneWave(p.first, wavenumber, solver.getCurrentTime(), eField, bField);
+
+        error = max(error, calculateMaxComponent(*p.second->getElectricField(solver.getCurrentTime()) - eField));
+    }
+
+    delete pm;
+
+    return error;
+}
+
+/**
+ * The gradient of a smooth periodic potential must converge at the order of each scheme
+ */
+bool testGradientConvergence() {
+    bool passed = true;
+    const double minOrders[] = {1.9, 3.8, 3.8};
+
+    for (int scheme = 0; scheme < 3; scheme++) {
+        double coarseError = calculateGradientError(COARSE_POINTS_PER_DIM, schemes[scheme]);
+        double fineError = calculateGradientError(2 * COARSE_POINTS_PER_DIM, schemes[scheme]);
+        double order = std::log2(coarseError / fineError);
+        bool schemePassed = order > minOrders[scheme];
+
+        cout << "  gradient, " << schemeNames[scheme] << ": relative error " << coarseError << " coarse and "
+             << fineError << " fine, order " << order << (schemePassed ? " (passed)" : " (FAILED)") << endl;
+
+        passed = passed && schemePassed;
+    }
+
+    return passed;
+}
+
+/**
+ * The fourth order schemes on the coarse spacing must propagate a plane wave as accurately as the second order
+ * scheme on half of it, i.e. with 8 times fewer points
+ */
+bool testWaveAtHalfResolution() {
+    double fineSecondOrderError = calculateWaveError(2 * COARSE_POINTS_PER_DIM, PointManager::SecondOrder);
+    bool passed = true;
+
+    cout << "  wave, second order with " << 2 * COARSE_POINTS_PER_DIM << " points per axis: error "
+         << fineSecondOrderError << endl;
+
+    for (int scheme = 1; scheme < 3; scheme++) {
+        double coarseError = calculateWaveError(COARSE_POINTS_PER_DIM, schemes[scheme]);
+        bool schemePassed = coarseError < fineSecondOrderError;
+
+        cout << "  wave, " << schemeNames[scheme] << " with " << COARSE_POINTS_PER_DIM << " points per axis: error "
+             << coarseError << (schemePassed ? " (passed)" : " (FAILED)") << endl;
+
+        passed = passed && schemePassed;
+    }
+
+    return passed;
+}
+
+/**
+ * Hold the faces of a bounded cube at a harmonic potential and return the largest error of the voltages inside
+ */
+double calculateLaplaceError(int spacings, PointManager::DifferenceScheme scheme) {
+    auto pm = new PointManager(1.0 / spacings, 0, 1);
+    pm->setDifferenceScheme(scheme);
+
+    auto potential = [](const Coordinates &c) {
+        return LAPLACE_AMPLITUDE * sinh(std::sqrt(2.0) * M_PI * c.getI()) * sin(M_PI * c.getJ()) *
+               sin(M_PI * c.getK()) / sinh(std::sqrt(2.0) * M_PI);
+    };
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        if (p.second->getClassification() != Point::Normal) { // electrodes on the faces
+            pm->setConductivity(p.first, 1.0);
+            p.second->setVoltage(potential(p.first));
+        }
+    }
+
+    // the voltage calculator reports every sweep, keep the summary readable
+    streambuf *output = cout.rdbuf(nullptr);
+
+    InitialVoltageCalculator calculator(pm);
+    calculator.calculateInitialVoltage();
+
+    cout.rdbuf(output);
+
+    double error = 0.0;
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        error = max(error, fabs(p.second->getVoltage() - potential(p.first)));
+
+    delete pm;
+
+    return error / LAPLACE_AMPLITUDE;
+}
+
+/**
+ * The voltages between electrodes must converge faster with the fourth order schemes, with the points next to the
+ * faces closed by the second order differences
+ */
+bool testLaplaceConvergence() {
+    bool passed = true;
+    const double minOrders[] = {1.9, 2.8, 3.8};
+
+    for (int scheme = 0; scheme < 3; scheme++) {
+        double coarseError = calculateLaplaceError(LAPLACE_POINTS_PER_DIM - 1, schemes[scheme]);
+        double fineError = calculateLaplaceError(2 * (LAPLACE_POINTS_PER_DIM - 1), schemes[scheme]);
+        double order = std::log2(coarseError / fineError);
+        bool schemePassed = order > minOrders[scheme];
+
+        cout << "  laplace, " << schemeNames[scheme] << ": relative error " << coarseError << " coarse and "
+             << fineError << " fine, order " << order << (schemePassed ? " (passed)" : " (FAILED)") << endl;
+
+        passed = passed && schemePassed;
+    }
+
+    return passed;
+}
+
+/**
+ * Let a pulse reflect off the faces of a bounded cube, the closures must keep the fields from growing
+ */
+bool testBoundedPulse() {
+    bool passed = true;
+
+    for (int scheme = 1; scheme < 3; scheme++) {
+        auto pm = new PointManager(PULSE_POINTS_PER_DIM, 0, PULSE_POINTS_PER_DIM - 1, nullptr);
+        double center = (PULSE_POINTS_PER_DIM - 1) / 2.0;
+
+        pm->setDifferenceScheme(schemes[scheme]);
+
+        for (auto &p : *pm->getCollectionOfPoints()) {
+            double di = p.first.getI() - center, dj = p.first.getJ() - center, dk = p.first.getK() - center;
+            p.second->setElectricField(FieldVector(0, exp(-(di * di + dj * dj + dk * dk) /
+                                                          (2 * PULSE_WIDTH * PULSE_WIDTH)), 0), 0);
+        }
+
+        FieldSolver solver(pm, 1.0, DRUDE_SCATTERING_TIME);
+        solver.setTimeStep(solver.calculateStableTimeStep());
+
+        for (int step = 0; step < PULSE_STEPS; step++)
+            solver.calculateNextFields();
+
+        double maxField = 0.0;
+
+        for (auto &p : *pm->getCollectionOfPoints())
+            maxField = max(maxField, calculateMaxComponent(*p.second->getElectricField(solver.getCurrentTime())));
+
+        bool schemePassed = maxField < 1.0;
+
+        cout << "  bounded pulse, " << schemeNames[scheme] << ": largest field " << maxField << " after "
+             << PULSE_STEPS << " steps" << (schemePassed ? " (passed)" : " (FAILED)") << endl;
+
+        passed = passed && schemePassed;
+        delete pm;
+    }
+
+    return passed;
+}
+
+/**
+ * Remove the electric field of every point and ghost at a time, keeping the magnetic field
+ */
+void eraseElectricField(PointManager *pm, double time) {
+    vector<Point *> points;
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        points.push_back(p.second);
+
+    for (const auto &ghost : pm->getGhosts())
+        points.push_back(ghost.point);
+
+    for (Point *p : points) {
+        FieldVector bField = *p->getMagneticField(time);
+
+        p->eraseFields(time);
+        p->setMagneticField(bField, time);
+    }
+}
+
+/**
+ * The compact curl at single points must come from a solve of the current fields: that of a plane wave, and after the
+ * initial electric field replaced it at the same time, that of a gradient, which vanishes
+ */
+bool testPointCurl() {
+    PointManager *pm = createPeriodicCube(COARSE_POINTS_PER_DIM, PointManager::CompactFourthOrder);
+    double wavenumber = 2 * M_PI / COARSE_POINTS_PER_DIM;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        p.second->setElectricField(FieldVector(0, 0, sin(wavenumber * (p.first.getI() + p.first.getJ()))), 0);
+        p.second->setVoltage(sin(wavenumber * p.first.getI()) * sin(wavenumber * p.first.getJ()));
+    }
+
+    pm->fillGhostFields(0);
+
+    FieldSolver solver(pm, 1.0, DRUDE_SCATTERING_TIME);
+    double waveError = 0.0, gradientCurl = 0.0;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        FieldVector expected = wavenumber * cos(wavenumber * (p.first.getI() + p.first.getJ())) * FieldVector(1, -1, 0);
+        waveError = max(waveError, calculateMaxComponent(solver.calculateCurl(FieldSolver::ElectricField, p.first) -
+                                                         expected));
+    }
+
+    eraseElectricField(pm, 0);
+    solver.calculateAndSetInitialElectricField();
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        gradientCurl = max(gradientCurl, calculateMaxComponent(solver.calculateCurl(FieldSolver::ElectricField,
+                                                                                   p.first)));
+
+    // bounding an axis rebuilds the ghost layer, the lines along it lose their wraparound
+    pm->setPeriodic(PointManager::IAxis, false);
+    pm->fillGhostFields(0);
+
+    FieldSolver freshSolver(pm, 1.0, DRUDE_SCATTERING_TIME);
+    bool relaidOut = true;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        FieldVector difference = solver.calculateCurl(FieldSolver::ElectricField, p.first) -
+                                 freshSolver.calculateCurl(FieldSolver::ElectricField, p.first);
+        relaidOut = relaidOut && calculateMaxComponent(difference) == 0;
+    }
+
+    bool passed = waveError / wavenumber < MAX_POINT_CURL_ERROR && gradientCurl / wavenumber < MAX_POINT_CURL_ERROR &&
+                  relaidOut;
+
+    cout << "  compact curl at single points: error " << waveError / wavenumber << ", curl of the gradient "
+         << gradientCurl / wavenumber << (relaidOut ? "" : ", stale after bounding an axis")
+         << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete pm;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test the convergence of the difference schemes" << endl;
+
+    bool passed = testGradientConvergence();
+    passed = testWaveAtHalfResolution() && passed;
+    passed = testLaplaceConvergence() && passed;
+    passed = testBoundedPulse() && passed;
+    passed = testPointCurl() && passed;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+#define POINTS_PER_DIM 5
+#define TOLERANCE 1.0e-14 // relative, a few roundings of the closed form
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+
+using namespace std;
+
+/**
+ * Take a single step of the exponential current update in a periodic cube of uniform fields and conductivity, and
+ * compare the current of every point against the closed form solution of dJ/dt = (conductivity * E - J) / tau for the
+ * electric field held over the step
+ *
+ * @param name Name of the case
+ * @param conductivity Conductivity of every point
+ * @param stepRatio Time step as a multiple of the scattering time
+ * @param initialCurrent Current density at the start of the step
+ * @param gainFraction 1 - exp(-stepRatio), evaluated by the caller so that it stays exact for tiny ratios
+ * @return true if the current matches the closed form
+ */
+bool testStep(const string &name, double conductivity, double stepRatio, const FieldVector &initialCurrent,
+              double gainFraction) {
+    const FieldVector eField(1.0, -2.0, 3.0);
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+
+    for (int axis = 0; axis < 3; axis++)
+        pm->setPeriodic((PointManager::Axis) axis, true);
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        pm->setConductivity(p.first, conductivity);
+        p.second->setElectricField(eField, 0);
+        p.second->setCurrentField(initialCurrent, 0);
+    }
+
+    FieldSolver solver(pm, stepRatio * DRUDE_SCATTERING_TIME, DRUDE_SCATTERING_TIME);
+    solver.setCurrentIntegrator(FieldSolver::Exponential);
+    solver.calculateNextFields();
+
+    FieldVector expected = ((1.0 - gainFraction) * initialCurrent) + ((conductivity * gainFraction) * eField);
+    double scale = calculateMaxComponent(expected), maxError = 0.0;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        FieldVector *current = p.second->getCurrentField(solver.getCurrentTime());
+        maxError = max(maxError, calculateMaxComponent(*current - expected) / scale);
+    }
+
+    delete pm;
+
+    bool passed = maxError <= TOLERANCE;
+    cout << "  " << name << ": relative error " << maxError << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test the exponential Drude current update" << endl;
+
+    const FieldVector initialCurrent(0.5, 0.0, -0.5), noCurrent(0, 0, 0);
+    double tinyRatio = 1.0e-10;
+
+    // the current forgets its start and settles at conductivity * E
+    bool passed = testStep("long step, decay limit", 2.0, 50.0, initialCurrent, 1.0);
+
+    // almost no conductivity, the current only decays
+    passed = testStep("small conductivity", 1.0e-9, 0.1, initialCurrent, 1.0 - exp(-0.1)) && passed;
+
+    // 1 - exp(-x) would cancel to ~7 digits, the series does not
+    passed = testStep("short step, series limit", 1.0, tinyRatio, noCurrent,
+                      tinyRatio * (1.0 - tinyRatio / 2 * (1.0 - tinyRatio / 3))) && passed;
+
+    // conductivity * dt far beyond the stability limit of an explicit update
+    passed = testStep("large conductivity times step", 1.0e8, 5.0, initialCurrent, 1.0 - exp(-5.0)) && passed;
+
+    return passed ? 0 : 1;
+}
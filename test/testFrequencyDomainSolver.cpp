@@ -0,0 +1,180 @@
+#define POINTS_PER_DIM 16
+#define SOURCE_I 5 // the sheet of source current normal to i
+#define SLAB_START 9 // the conducting slab between the source and the far wall
+#define SLAB_END 11
+#define SLAB_CONDUCTIVITY 1.0e-3
+#define SCATTERING_TIME 1.0e-9 // comparable to the periods, so the Drude current lags the field noticeably
+#define FIELD_TOLERANCE 1.0e-6 // relative to the largest field
+
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+#include "../src/FrequencyDomainSolver.h"
+
+using namespace std;
+
+typedef complex<double> Complex;
+
+/**
+ * Get the Drude conductivity of a point along i at an angular frequency
+ */
+Complex calculateDrudeConductivity(int i, double angularFrequency) {
+    bool conducting = i >= SLAB_START && i <= SLAB_END;
+
+    return conducting ? SLAB_CONDUCTIVITY / Complex(1.0, angularFrequency * SCATTERING_TIME) : 0.0;
+}
+
+/**
+ * Solve the one dimensional Helmholtz equation of E_k along i with the same differences and E_k = 0 on both walls,
+ *     -(E[i + 1] - 2 E[i] + E[i - 1]) / h^2 - w^2 / c^2 E[i] + i w mu0 sigma(w) E[i] = -i w mu0 J[i]
+ * with the Thomas algorithm
+ */
+vector<Complex> solveSheetSource(double angularFrequency) {
+    int n = POINTS_PER_DIM;
+    vector<Complex> diagonal(n), rhs(n, 0.0), field(n, 0.0);
+    Complex iwmu(0.0, angularFrequency * VACUUM_PERMEABILITY);
+
+    for (int i = 1; i < n - 1; i++) {
+        diagonal[i] = 2.0 - angularFrequency * angularFrequency / SPEED_OF_LIGHT_SQUARED +
+                      iwmu * calculateDrudeConductivity(i, angularFrequency);
+        rhs[i] = i == SOURCE_I ? -iwmu : 0.0;
+    }
+
+    // eliminate the sub diagonal of -1 downwards, then substitute back upwards
+    for (int i = 2; i < n - 1; i++) {
+        Complex factor = -1.0 / diagonal[i - 1];
+        diagonal[i] -= factor * -1.0;
+        rhs[i] -= factor * rhs[i - 1];
+    }
+
+    for (int i = n - 2; i >= 1; i--)
+        field[i] = (rhs[i] + field[i + 1]) / diagonal[i];
+
+    return field;
+}
+
+/**
+ * A sheet of current along k between two walls normal to i drives a field that only varies along i. Every frequency
+ * of a batch must match the one dimensional solution, in the phasors and in the fields exported at two times of the
+ * period
+ */
+bool testSheetSource() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    pm->setPeriodic(PointManager::JAxis, true);
+    pm->setPeriodic(PointManager::KAxis, true);
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        p.second->setPermittivity(1.0); // the layers would vary along k
+
+        if (p.first.getI() >= SLAB_START && p.first.getI() <= SLAB_END)
+            pm->setConductivity(p.first, SLAB_CONDUCTIVITY);
+    }
+
+    FrequencyDomainSolver solver(pm, SCATTERING_TIME);
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        if (p.first.getI() == SOURCE_I)
+            solver.addSourceCurrent(p.first, FieldVector(0, 0, 1));
+
+    vector<double> angularFrequencies;
+
+    for (double wavenumber : {0.2, 0.5, 0.9})
+        angularFrequencies.push_back(wavenumber * sqrt(SPEED_OF_LIGHT_SQUARED));
+
+    bool passed = solver.solve(angularFrequencies);
+    const FieldGrid &grid = solver.getGrid();
+
+    for (int frequency = 0; frequency < solver.getNumFrequencies(); frequency++) {
+        double w = solver.getAngularFrequency(frequency);
+        vector<Complex> expected = solveSheetSource(w);
+        double maxField = 0.0, difference = 0.0;
+
+        for (const Complex &e : expected)
+            maxField = max(maxField, abs(e));
+
+        for (int i = 0; i < grid.getNumPoints(PointManager::IAxis); i++) {
+            for (int j = 0; j < grid.getNumPoints(PointManager::JAxis); j++) {
+                for (int k = 0; k < grid.getNumPoints(PointManager::KAxis); k++) {
+                    size_t index = grid.getIndex(i, j, k);
+
+                    difference = max(difference, abs(solver.getElectricField(frequency, PointManager::KAxis, index) -
+                                                     expected[i]));
+                    difference = max(difference, abs(solver.getElectricField(frequency, PointManager::IAxis, index)));
+                    difference = max(difference, abs(solver.getElectricField(frequency, PointManager::JAxis, index)));
+                }
+            }
+        }
+
+        // the exported field is Re(E * exp(i w t)) and the current follows it through the Drude conductivity
+        double exportDifference = 0.0, currentDifference = 0.0, maxCurrent = 0.0;
+
+        for (int i = SLAB_START; i <= SLAB_END; i++)
+            maxCurrent = max(maxCurrent, abs(calculateDrudeConductivity(i, w) * expected[i]));
+
+        for (double time : {0.0, M_PI / (2 * w)}) {
+            Complex phase = polar(1.0, w * time);
+            solver.exportFieldsToPointManager(frequency, time);
+
+            for (auto &p : *pm->getCollectionOfPoints()) {
+                int i = pm->getAxisIndex(p.first.getI());
+
+                exportDifference = max(exportDifference, fabs(p.second->getElectricField(time)->getKComp() -
+                                                              real(expected[i] * phase)));
+
+                if (p.second->getConductivity() > 0)
+                    currentDifference = max(currentDifference,
+                                            fabs(p.second->getCurrentField(time)->getKComp() -
+                                                 real(calculateDrudeConductivity(i, w) * expected[i] * phase)));
+            }
+        }
+
+        bool frequencyPassed = difference < FIELD_TOLERANCE * maxField &&
+                               exportDifference < FIELD_TOLERANCE * maxField &&
+                               currentDifference < FIELD_TOLERANCE * maxCurrent;
+        passed = passed && frequencyPassed;
+
+        cout << "  sheet source at w = " << w << ": " << solver.getNumIterations(frequency) << " iterations, residual "
+             << solver.getRelativeResidual(frequency) << ", largest difference " << difference / maxField
+             << " of the phasors, " << exportDifference / maxField << " of the exported field and "
+             << currentDifference / maxCurrent << " of the exported current"
+             << (frequencyPassed ? " (passed)" : " (FAILED)") << endl;
+    }
+
+    delete pm;
+
+    return passed;
+}
+
+/**
+ * Without a source every frequency is solved by the zero field straight away
+ */
+bool testWithoutSource() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    FrequencyDomainSolver solver(pm, SCATTERING_TIME);
+
+    bool passed = solver.solve({1.0e8, 2.0e8});
+
+    for (int frequency = 0; frequency < solver.getNumFrequencies(); frequency++)
+        passed = passed && solver.getNumIterations(frequency) == 0;
+
+    cout << "  without source: " << (passed ? "(passed)" : "(FAILED)") << endl;
+
+    delete pm;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test the frequency domain solver against a one dimensional solution" << endl;
+
+    bool passed = testSheetSource();
+    passed = testWithoutSource() && passed;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+#define BOUND 10.0
+#define LAYER_START -1.0 // the evenly spaced layer of the k axis, e.g. a thin device
+#define LAYER_END 1.0
+#define FINE_SPACING 0.25
+#define MAX_SPACING 2.0
+#define GROWTH 1.4
+#define TOLERANCE 1.0e-9
+#define VOLTAGE_TOLERANCE 1.0e-2 // the voltage calculator stops once no voltage changes in the first 3 decimals
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+#include "../src/InitialVoltageCalculator.h"
+
+using namespace std;
+
+/**
+ * A quadratic potential with a vanishing Laplacian, the second order differences of a graded grid are exact for it
+ */
+double quadraticVoltage(const Coordinates &c) {
+    double i = c.getI(), j = c.getJ(), k = c.getK();
+
+    return i * i + 2 * j * j - 3 * k * k + i * j + 0.5 * j * k;
+}
+
+/**
+ * Create a grid graded along every axis, evenly spaced across the layer of the k axis and the center of the others
+ */
+PointManager *createGradedGrid() {
+    return new PointManager(PointManager::createGradedAxis(-BOUND, BOUND, -2, 2, 2 * FINE_SPACING, MAX_SPACING, GROWTH),
+                            PointManager::createGradedAxis(-BOUND, BOUND, -2, 2, 2 * FINE_SPACING, MAX_SPACING, GROWTH),
+                            PointManager::createGradedAxis(-BOUND, BOUND, LAYER_START, LAYER_END, FINE_SPACING,
+                                                           MAX_SPACING, GROWTH));
+}
+
+/**
+ * The gradient of a quadratic potential and the curl of a quadratic field must be exact inside the grid
+ */
+bool testDerivatives() {
+    PointManager *pm = createGradedGrid();
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        double i = p.first.getI(), j = p.first.getJ(), k = p.first.getK();
+
+        p.second->setVoltage(quadraticVoltage(p.first));
+        *p.second->getMagneticField(0) = FieldVector(j * j + k, i * k, i * i - j * k);
+    }
+
+    FieldSolver solver(pm, 1.0, DRUDE_SCATTERING_TIME);
+    solver.calculateAndSetInitialElectricField();
+
+    double gradientError = 0.0, curlError = 0.0, laplacianError = 0.0;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        if (p.second->getClassification() != Point::Normal) // the ghosts beyond the faces break the polynomials
+            continue;
+
+        double i = p.first.getI(), j = p.first.getJ(), k = p.first.getK();
+        FieldVector expectedField(-(2 * i + j), -(4 * j + i + 0.5 * k), -(-6 * k + 0.5 * j));
+        FieldVector expectedCurl(-k - i, 1 - 2 * i, k - 2 * j); // curl of (j^2 + k, i k, i^2 - j k)
+
+        gradientError = max(gradientError, calculateMaxComponent(*p.second->getElectricField(0) - expectedField));
+        curlError = max(curlError, calculateMaxComponent(solver.calculateCurl(FieldSolver::MagneticField, p.first, 0) -
+                                                         expectedCurl));
+
+        PointManager::Stencil stencil = pm->getStencil(p.first);
+        double laplacian = 0.0;
+
+        for (int axis = 0; axis < 3; axis++) {
+            const PointManager::AxisWeights &weights = pm->getAxisWeights(stencil, (PointManager::Axis) axis);
+
+            laplacian += weights.laplacianCenter * stencil.point->getVoltage() +
+                         weights.laplacian[0] * stencil.neighbors[2 * axis]->getVoltage() +
+                         weights.laplacian[1] * stencil.neighbors[2 * axis + 1]->getVoltage();
+        }
+
+        laplacianError = max(laplacianError, fabs(laplacian));
+    }
+
+    bool passed = gradientError < TOLERANCE && curlError < TOLERANCE && laplacianError < TOLERANCE;
+
+    cout << "  derivatives: gradient error " << gradientError << ", curl error " << curlError << ", laplacian error "
+         << laplacianError << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete pm;
+
+    return passed;
+}
+
+/**
+ * Hold the faces of the grid at the quadratic potential, the voltages inside must follow it
+ */
+bool testLaplacian() {
+    PointManager *pm = createGradedGrid();
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        if (p.second->getClassification() != Point::Normal) { // electrodes on the faces
+            pm->setConductivity(p.first, 1.0);
+            p.second->setVoltage(quadraticVoltage(p.first));
+        }
+    }
+
+    // the voltage calculator reports every sweep, keep the summary readable
+    streambuf *output = cout.rdbuf(nullptr);
+
+    InitialVoltageCalculator calculator(pm);
+    calculator.calculateInitialVoltage();
+
+    cout.rdbuf(output);
+
+    double error = 0.0, maxVoltage = 0.0;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        error = max(error, fabs(p.second->getVoltage() - quadraticVoltage(p.first)));
+        maxVoltage = max(maxVoltage, fabs(quadraticVoltage(p.first)));
+    }
+
+    bool passed = error / maxVoltage < VOLTAGE_TOLERANCE;
+
+    cout << "  laplacian: relative voltage error " << error / maxVoltage << (passed ? " (passed)" : " (FAILED)")
+         << endl;
+
+    delete pm;
+
+    return passed;
+}
+
+/**
+ * The graded grid must hold far fewer points than an evenly spaced grid resolving the layer
+ */
+bool testPointCount() {
+    PointManager *graded = createGradedGrid();
+    int numPerAxis = (int) std::floor(2 * BOUND / FINE_SPACING + 0.5) + 1;
+    long evenCount = (long) numPerAxis * numPerAxis * numPerAxis;
+
+    bool passed = graded->getTotalNumberPoints() * 10 < evenCount;
+
+    cout << "  point count: " << graded->getNumPoints(PointManager::IAxis) << " x "
+         << graded->getNumPoints(PointManager::JAxis) << " x " << graded->getNumPoints(PointManager::KAxis) << " = "
+         << graded->getTotalNumberPoints() << " graded instead of " << evenCount << (passed ? " (passed)" : " (FAILED)")
+         << endl;
+
+    delete graded;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test graded grid spacing" << endl;
+
+    bool passed = testDerivatives();
+    passed = testLaplacian() && passed;
+    passed = testPointCount() && passed;
+
+    return passed ? 0 : 1;
+}
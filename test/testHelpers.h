@@ -0,0 +1,20 @@
+#ifndef _TESTHELPERS_H
+#define _TESTHELPERS_H
+
+#include <iostream>
+#include <string>
+
+/**
+ * Print the outcome of a check and pass it on
+ *
+ * @param name Name of the check
+ * @param passed true if the check passed
+ * @return passed
+ */
+inline bool report(const std::string &name, bool passed) {
+    std::cout << "  " << name << (passed ? " (passed)" : " (FAILED)") << std::endl;
+
+    return passed;
+}
+
+#endif //QUANTUMFOUNDRY_TESTHELPERS_H
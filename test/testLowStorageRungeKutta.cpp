@@ -0,0 +1,120 @@
+#define END_TIME 1.0
+#define COARSE_STEPS 20
+#define ORDER_TOLERANCE 0.2 // the observed order of two step sizes differing by 2 only approaches the formal order
+#define NUM_STABILITY_STEPS 1000
+#define STABILITY_MARGIN 0.01 // relative distance from the limit at which stability is checked on either side
+
+#include <iostream>
+#include <complex>
+#include <cmath>
+#include <string>
+
+#include "../src/LowStorageRungeKutta.h"
+
+using namespace std;
+
+typedef complex<double> Complex;
+
+/**
+ * Integrate dU/dt = L(t, U) with the coefficients of a scheme, using a single register like the solvers do
+ *
+ * @param rk Scheme to integrate with
+ * @param rightHandSide L(t, U)
+ * @param initial U at time 0
+ * @param timeStep Time step
+ * @param numSteps Number of steps to take
+ * @return U after the last step
+ */
+template <typename RightHandSide>
+Complex integrate(const LowStorageRungeKutta &rk, RightHandSide rightHandSide, Complex initial, double timeStep,
+                  long numSteps) {
+    Complex u = initial;
+
+    for (long step = 0; step < numSteps; step++) {
+        Complex du = 0.0;
+        double time = step * timeStep;
+
+        for (int stage = 0; stage < rk.getNumStages(); stage++) {
+            du = rk.getA(stage) * du + timeStep * rightHandSide(time + rk.getC(stage) * timeStep, u);
+            u += rk.getB(stage) * du;
+        }
+    }
+
+    return u;
+}
+
+/**
+ * Halving the time step must cut the error by 2 to the power of the order of the scheme, for an autonomous problem
+ * and for one whose right hand side depends on time, which also checks the stage times
+ *
+ * @param rk Scheme to check
+ * @param name Name of the scheme to report
+ * @return true if both problems converge at the order of the scheme
+ */
+bool testOrder(const LowStorageRungeKutta &rk, const string &name) {
+    const Complex eigenvalue(-0.5, 2.0);
+    auto oscillator = [&](double, Complex u) { return eigenvalue * u; };
+    auto gaussian = [](double t, Complex u) { return -2.0 * t * u; }; // U = exp(-t^2)
+    double timeStep = END_TIME / COARSE_STEPS;
+
+    Complex exactOscillator = exp(eigenvalue * END_TIME), exactGaussian = exp(-END_TIME * END_TIME);
+    double oscillatorErrors[2], gaussianErrors[2];
+
+    for (int refinement = 0; refinement < 2; refinement++) {
+        long numSteps = COARSE_STEPS << refinement;
+        double step = timeStep / (1 << refinement);
+
+        oscillatorErrors[refinement] = abs(integrate(rk, oscillator, 1.0, step, numSteps) - exactOscillator);
+        gaussianErrors[refinement] = abs(integrate(rk, gaussian, 1.0, step, numSteps) - exactGaussian);
+    }
+
+    double oscillatorOrder = log2(oscillatorErrors[0] / oscillatorErrors[1]);
+    double gaussianOrder = log2(gaussianErrors[0] / gaussianErrors[1]);
+
+    bool passed = fabs(oscillatorOrder - rk.getOrder()) <= ORDER_TOLERANCE &&
+                  fabs(gaussianOrder - rk.getOrder()) <= ORDER_TOLERANCE;
+
+    cout << "  " << name << " order " << rk.getOrder() << ": observed " << oscillatorOrder << " (oscillator), "
+         << gaussianOrder << " (time dependent)" << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+/**
+ * A wave on the imaginary axis must not grow over many steps just inside the stability limit, and must grow just
+ * outside of it
+ *
+ * @param rk Scheme to check
+ * @param name Name of the scheme to report
+ * @param expectedLimit Known limit of the scheme, 0 if it is only checked by running
+ * @return true if the limit separates the stable from the unstable steps
+ */
+bool testStabilityLimit(const LowStorageRungeKutta &rk, const string &name, double expectedLimit) {
+    double limit = rk.getImaginaryStabilityLimit();
+    auto wave = [](double, Complex u) { return Complex(0.0, 1.0) * u; };
+
+    double inside = abs(integrate(rk, wave, 1.0, (1 - STABILITY_MARGIN) * limit, NUM_STABILITY_STEPS));
+    double outside = abs(integrate(rk, wave, 1.0, (1 + STABILITY_MARGIN) * limit, NUM_STABILITY_STEPS));
+    bool passed = inside <= 1.0 && outside > 1.0 && (expectedLimit == 0 || fabs(limit - expectedLimit) < 1.0e-9);
+
+    cout << "  " << name << " stability limit " << limit << ": amplitude " << inside << " inside, " << outside
+         << " outside" << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test the low storage Runge-Kutta schemes" << endl;
+
+    LowStorageRungeKutta williamson(LowStorageRungeKutta::Williamson3);
+    LowStorageRungeKutta carpenterKennedy(LowStorageRungeKutta::CarpenterKennedy4);
+
+    bool passed = testOrder(williamson, "Williamson3");
+    passed = testOrder(carpenterKennedy, "CarpenterKennedy4") && passed;
+
+    // every 3 stage scheme of order 3 has the amplification factor 1 + z + z^2 / 2 + z^3 / 6, stable up to sqrt(3)
+    passed = testStabilityLimit(williamson, "Williamson3", sqrt(3.0)) && passed;
+    passed = testStabilityLimit(carpenterKennedy, "CarpenterKennedy4", 0) && passed;
+
+    return passed ? 0 : 1;
+}
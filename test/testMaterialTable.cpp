@@ -0,0 +1,203 @@
+#define POINTS_PER_DIM 9
+#define MID_LEVEL 4 // the k index of the boundary between the gallium arsenide and the vacuum
+#define SAPPHIRE_PERMITTIVITY 9.4
+#define ROD_CONDUCTIVITY 2.0
+#define FRACTIONAL_PERMITTIVITY 2.5 // was truncated to a whole number before points had materials
+#define CONDUCTIVITY_STEP 0.001 // gives every point of the cube its own conductivity, more than the table could hold
+
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <stdexcept>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+#include "../src/MaterialTable.h"
+#include "testHelpers.h"
+
+using namespace std;
+
+namespace {
+    // read during the static initialization of this translation unit, which may run before that of the table
+    const Material staticGalliumArsenide = MaterialTable::getMaterial(MaterialTable::GalliumArsenide);
+    const string staticName = MaterialTable::getMaterialName(MaterialTable::GalliumArsenide);
+}
+
+/**
+ * The default materials must be in place during static initialization and hold the coefficients defining them again
+ * would derive
+ */
+bool testDefaultMaterials() {
+    bool passed = staticName == "gallium arsenide" && staticGalliumArsenide.permittivity == 12.0 &&
+                  MaterialTable::defineMaterial("vacuum", 1.0) == MaterialTable::Vacuum &&
+                  MaterialTable::defineMaterial("gallium arsenide", 12.0) == MaterialTable::GalliumArsenide;
+
+    for (MaterialTable::Id id = MaterialTable::Vacuum; id <= MaterialTable::GalliumArsenide; id++) {
+        const Material &material = MaterialTable::getMaterial(id);
+
+        passed = passed && material.waveSpeedSquared == SPEED_OF_LIGHT_SQUARED / material.permittivity &&
+                 material.waveSpeed == sqrt(material.waveSpeedSquared);
+    }
+
+    return report("default materials", passed);
+}
+
+/**
+ * The points of the layered cube must be made of gallium arsenide below the middle of the k axis and of vacuum above
+ */
+bool testLayers() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    bool passed = true;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        MaterialTable::Id expected = p.first.getK() < MID_LEVEL ? MaterialTable::GalliumArsenide : MaterialTable::Vacuum;
+
+        passed = passed && p.second->getMaterialId() == expected &&
+                 p.second->getPermittivity() == (expected == MaterialTable::Vacuum ? 1.0 : 12.0);
+    }
+
+    delete pm;
+
+    return report("layered cube: " + to_string(sizeof(Point)) + " bytes per point", passed);
+}
+
+/**
+ * A user defined material must carry its coefficients to the points made of it, and giving one of them a conductivity
+ * must only change that point, which stays made of the material
+ */
+bool testUserMaterial() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    MaterialTable::Id sapphire = MaterialTable::defineMaterial("sapphire", SAPPHIRE_PERMITTIVITY);
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        if (p.first.getK() < MID_LEVEL)
+            pm->setMaterial(p.first, sapphire);
+
+    Coordinates rodStart(MID_LEVEL, MID_LEVEL, 0), rodEnd(MID_LEVEL, MID_LEVEL, 1);
+    pm->setConductivity(rodStart, ROD_CONDUCTIVITY);
+    pm->setConductivity(rodEnd, ROD_CONDUCTIVITY);
+
+    const Material &material = MaterialTable::getMaterial(sapphire);
+    Point *rod = pm->getPoint(rodStart);
+    bool passed = MaterialTable::getMaterialId("sapphire") == sapphire &&
+                  fabs(material.waveSpeedSquared - SPEED_OF_LIGHT_SQUARED / SAPPHIRE_PERMITTIVITY) <=
+                  1.0e-15 * material.waveSpeedSquared &&
+                  fabs(material.waveSpeed - sqrt(material.waveSpeedSquared)) <= 1.0e-15 * material.waveSpeed;
+
+    passed = passed && rod->getMaterialId() == sapphire && pm->getMaterialId(rodEnd) == sapphire &&
+             rod->getPermittivity() == SAPPHIRE_PERMITTIVITY && rod->getConductivity() == ROD_CONDUCTIVITY;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        if (p.first.getK() >= MID_LEVEL)
+            passed = passed && p.second->getMaterialId() == MaterialTable::Vacuum;
+        else if (!(p.first == rodStart) && !(p.first == rodEnd))
+            passed = passed && p.second->getMaterialId() == sapphire && p.second->getConductivity() == 0;
+    }
+
+    delete pm;
+
+    return report("user defined material", passed);
+}
+
+/**
+ * A material can be defined again with the same properties, but not redefined with others
+ */
+bool testRedefinition() {
+    MaterialTable::Id sapphire = MaterialTable::defineMaterial("sapphire", SAPPHIRE_PERMITTIVITY);
+    bool rejected = false;
+
+    try {
+        MaterialTable::defineMaterial("sapphire", SAPPHIRE_PERMITTIVITY, ROD_CONDUCTIVITY);
+    } catch (const invalid_argument &) {
+        rejected = true;
+    }
+
+    return report("redefinition", rejected && MaterialTable::getMaterialId("sapphire") == sapphire &&
+                                  MaterialTable::getMaterial(sapphire).conductivity == 0);
+}
+
+/**
+ * Every point must keep its own conductivity without adding materials, and the PointManager must count the changes
+ */
+bool testArbitraryConductivities() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    std::size_t numMaterials = MaterialTable::getNumMaterials();
+    std::uint64_t revision = pm->getConductivityRevision();
+    double conductivity = 0;
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        pm->setConductivity(p.first, conductivity += CONDUCTIVITY_STEP);
+
+    bool passed = MaterialTable::getNumMaterials() == numMaterials &&
+                  pm->getConductivityRevision() == revision + pm->getTotalNumberPoints();
+
+    conductivity = 0;
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        passed = passed && p.second->getConductivity() == (conductivity += CONDUCTIVITY_STEP);
+
+    delete pm;
+
+    return report(to_string(POINTS_PER_DIM * POINTS_PER_DIM * POINTS_PER_DIM) + " distinct conductivities", passed);
+}
+
+/**
+ * A checkpoint must restore the permittivity and conductivity of every point exactly
+ */
+bool testCheckpoint() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    Coordinates target(1, 2, 3);
+
+    pm->getPoint(target)->setPermittivity(FRACTIONAL_PERMITTIVITY);
+    pm->setConductivity(target, ROD_CONDUCTIVITY);
+
+    stringstream checkpoint;
+    pm->writeCheckpoint(checkpoint, 0);
+
+    auto restored = new PointManager(checkpoint);
+    bool passed = restored->getTotalNumberPoints() == pm->getTotalNumberPoints();
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        passed = passed && restored->getMaterialId(p.first) == p.second->getMaterialId() &&
+                 restored->getConductivity(p.first) == p.second->getConductivity();
+
+    passed = passed && restored->getPoint(target)->getPermittivity() == FRACTIONAL_PERMITTIVITY &&
+             restored->getConductivity(target) == ROD_CONDUCTIVITY;
+
+    delete pm;
+    delete restored;
+
+    return report("checkpoint", passed);
+}
+
+/**
+ * The table must refuse more permittivities than a byte can address
+ */
+bool testTableFull() {
+    bool full = false;
+    double permittivity = 1000.0;
+
+    try {
+        while (true)
+            MaterialTable::findMaterial(permittivity++);
+    } catch (const length_error &) {
+        full = true;
+    }
+
+    return report("full table", full && MaterialTable::getNumMaterials() == MAX_MATERIALS);
+}
+
+int main(){
+    cout << "Test the material table" << endl;
+
+    bool passed = testDefaultMaterials();
+    passed = testLayers() && passed;
+    passed = testUserMaterial() && passed;
+    passed = testRedefinition() && passed;
+    passed = testArbitraryConductivities() && passed;
+    passed = testCheckpoint() && passed;
+    passed = testTableFull() && passed; // last, it fills the table
+
+    return passed ? 0 : 1;
+}
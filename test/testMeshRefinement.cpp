@@ -0,0 +1,165 @@
+#define POINTS_PER_DIM 17 // three blocks along each axis, the last one a single plane of points
+#define NUM_STEPS 4
+#define PULSE_CENTER 11.5 // inside the second block, far enough from its faces for a single patch
+#define PULSE_WIDTH 1.0 // too narrow for the coarse spacing, resolved by the fine spacing
+#define ROD_CENTER 8
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+#include "../src/InitialVoltageCalculator.h"
+#include "../src/MeshHierarchy.h"
+
+using namespace std;
+
+/**
+ * Set the electric field of every point to a gaussian pulse polarized along j
+ */
+void setPulse(PointManager *pm) {
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        double di = p.first.getI() - PULSE_CENTER, dj = p.first.getJ() - PULSE_CENTER, dk = p.first.getK() - PULSE_CENTER;
+        FieldVector field(0, exp(-(di * di + dj * dj + dk * dk) / (2 * PULSE_WIDTH * PULSE_WIDTH)), 0);
+
+        if (p.second->getElectricField(0))
+            *p.second->getElectricField(0) = field;
+        else
+            p.second->setElectricField(field, 0);
+    }
+
+    pm->fillGhostFields(0);
+}
+
+/**
+ * Propagate a narrow pulse on the coarse spacing, with a patch around the pulse and on the fine spacing everywhere,
+ * then compare the coarse points of the first two runs against the fine run
+ */
+bool testPulse() {
+    auto coarse = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    auto refined = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    auto fine = new PointManager(1.0 / REFINEMENT_RATIO, 0, POINTS_PER_DIM - 1);
+
+    setPulse(coarse);
+    setPulse(refined);
+    setPulse(fine);
+
+    FieldSolver coarseSolver(coarse, 1.0, DRUDE_SCATTERING_TIME);
+    FieldSolver fineSolver(fine, 1.0, DRUDE_SCATTERING_TIME);
+    MeshHierarchy hierarchy(refined, 1.0, DRUDE_SCATTERING_TIME); // refines around the steep field of the pulse
+
+    for (int patch = 0; patch < hierarchy.getNumPatches(); patch++) // start the patches from the exact pulse
+        setPulse(hierarchy.getPatch(patch));
+
+    double timeStep = hierarchy.calculateStableTimeStep();
+    coarseSolver.setTimeStep(timeStep);
+    fineSolver.setTimeStep(timeStep / REFINEMENT_RATIO);
+    hierarchy.setTimeStep(timeStep);
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        coarseSolver.calculateNextFields();
+        hierarchy.calculateNextFields();
+
+        for (int subStep = 0; subStep < REFINEMENT_RATIO; subStep++)
+            fineSolver.calculateNextFields();
+    }
+
+    double coarseError = 0.0, refinedError = 0.0, maxMagnitude = 0.0;
+
+    for (auto &p : *coarse->getCollectionOfPoints()) {
+        const FieldVector &expected = *fine->getElectricField(p.first, fineSolver.getCurrentTime());
+        const FieldVector &coarseField = *p.second->getElectricField(coarseSolver.getCurrentTime());
+        const FieldVector &refinedField = *refined->getElectricField(p.first, hierarchy.getCurrentTime());
+
+        coarseError = max(coarseError, calculateMaxComponent(coarseField - expected));
+        refinedError = max(refinedError, calculateMaxComponent(refinedField - expected));
+        maxMagnitude = max(maxMagnitude, calculateMaxComponent(expected));
+    }
+
+    // the patch must carry the accuracy of the fine spacing onto the coarse points it covers
+    bool passed = hierarchy.getNumPatches() > 0 && refinedError < 0.5 * coarseError;
+
+    cout << "  pulse: " << hierarchy.getNumPatches() << " patches, " << hierarchy.getTotalNumberPoints()
+         << " points instead of " << fine->getTotalNumberPoints() << ", relative error " << refinedError / maxMagnitude << " refined and "
+         << coarseError / maxMagnitude << " coarse" << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete coarse;
+    delete refined;
+    delete fine;
+
+    return passed;
+}
+
+/**
+ * Hold a conducting rod along k at 1 over its upper half and calculate the voltages around it
+ */
+void setRod(PointManager *pm) {
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        if (p.first.getI() != ROD_CENTER || p.first.getJ() != ROD_CENTER)
+            continue;
+
+        // the fine point between the halves lies halfway between their voltages, like it does on a patch
+        double voltage = p.first.getK() >= ROD_CENTER ? 1.0 : p.first.getK() > ROD_CENTER - 1 ? 0.5 : 0.0;
+
+        pm->setConductivity(p.first, 1.0);
+        pm->setVoltage(p.first, voltage);
+    }
+}
+
+/**
+ * Calculate the voltages around a rod on the coarse spacing, with patches along the rod and on the fine spacing
+ * everywhere, then compare the coarse points of the first two against the fine voltages
+ */
+bool testRodVoltage() {
+    auto coarse = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    auto refined = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    auto fine = new PointManager(1.0 / REFINEMENT_RATIO, 0, POINTS_PER_DIM - 1);
+
+    setRod(coarse);
+    setRod(refined);
+    setRod(fine);
+
+    InitialVoltageCalculator coarseCalculator(coarse);
+    InitialVoltageCalculator fineCalculator(fine);
+    MeshHierarchy hierarchy(refined, 1.0, DRUDE_SCATTERING_TIME); // refines around the conducting points
+
+    // the voltage calculator reports every sweep, keep the summary readable
+    streambuf *output = cout.rdbuf(nullptr);
+
+    coarseCalculator.calculateInitialVoltage();
+    fineCalculator.calculateInitialVoltage();
+    hierarchy.calculateInitialVoltage();
+
+    cout.rdbuf(output);
+
+    double coarseError = 0.0, refinedError = 0.0;
+
+    for (auto &p : *coarse->getCollectionOfPoints()) {
+        double expected = fine->getVoltage(p.first);
+
+        coarseError = max(coarseError, fabs(p.second->getVoltage() - expected));
+        refinedError = max(refinedError, fabs(refined->getVoltage(p.first) - expected));
+    }
+
+    bool passed = hierarchy.getNumPatches() > 0 && refinedError < coarseError;
+
+    cout << "  rod voltage: " << hierarchy.getNumPatches() << " patches, largest difference " << refinedError
+         << " refined and " << coarseError << " coarse" << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete coarse;
+    delete refined;
+    delete fine;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test mesh refinement against the coarse and the fine spacing" << endl;
+
+    bool passed = testPulse();
+    passed = testRodVoltage() && passed;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+#define POINTS_PER_DIM 11
+#define NUM_RANDOM_KEYS 10000
+
+#include <iostream>
+#include <random>
+#include <cstdint>
+#include <unordered_set>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/MortonPointStore.h"
+
+using namespace std;
+
+/**
+ * Keys must interleave the index bits, i lowest, and decode back to the same indices
+ */
+bool testEncoding() {
+    mt19937 generator(42);
+    uniform_int_distribution<uint32_t> distribution(0, (1U << MORTON_BITS_PER_AXIS) - 1);
+    bool passed = MortonPointStore::encode(1, 0, 0) == 1 && MortonPointStore::encode(0, 1, 0) == 2 &&
+                  MortonPointStore::encode(0, 0, 1) == 4 && MortonPointStore::encode(3, 0, 0) == 9;
+
+    for (int n = 0; n < NUM_RANDOM_KEYS; n++) {
+        uint32_t i = distribution(generator), j = distribution(generator), k = distribution(generator);
+        uint32_t decodedI, decodedJ, decodedK;
+
+        MortonPointStore::decode(MortonPointStore::encode(i, j, k), decodedI, decodedJ, decodedK);
+        passed = passed && decodedI == i && decodedJ == j && decodedK == k;
+    }
+
+    cout << "  encoding: " << NUM_RANDOM_KEYS << " random keys" << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+/**
+ * Lattice coordinates, ghosts below 0 included, must hash to the Morton key of their offset indices, so no two points of
+ * a grid share a hash. Coordinates off the lattice must still hash equal when they compare equal
+ */
+bool testHasher() {
+    CoordinateHasher hasher;
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    unordered_set<size_t> hashes;
+    bool passed = hasher(Coordinates(0, 0, 0)) == MortonPointStore::encode(LATTICE_INDEX_OFFSET, LATTICE_INDEX_OFFSET,
+                                                                          LATTICE_INDEX_OFFSET) &&
+                  hasher(Coordinates(-1, 2, 3)) == MortonPointStore::encode(LATTICE_INDEX_OFFSET - 1,
+                                                                           LATTICE_INDEX_OFFSET + 2,
+                                                                           LATTICE_INDEX_OFFSET + 3) &&
+                  hasher(Coordinates(0.5, 0, 0)) == hasher(Coordinates(0.5, 0, 0)) &&
+                  hasher(Coordinates(-0.0, 0, 0)) == hasher(Coordinates(0, 0, 0));
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        hashes.insert(hasher(p.first));
+
+    for (const auto &ghost : pm->getGhosts())
+        hashes.insert(hasher(ghost.point->getCoordinates()));
+
+    passed = passed && hashes.size() == pm->getCollectionOfPoints()->size() + pm->getGhosts().size();
+
+    cout << "  hasher: " << hashes.size() << " distinct hashes" << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete pm;
+
+    return passed;
+}
+
+/**
+ * Every point of a PointManager must be found at its indices, iterated over in increasing key order and reach the
+ * same neighbors as the PointManager
+ */
+bool testStore(PointManager *pm, const string &name) {
+    MortonPointStore store(pm);
+    auto points = pm->getCollectionOfPoints();
+    const int offsets[6][3] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    bool passed = store.size() == points->size();
+    uint64_t previousKey = 0;
+
+    for (auto entry = store.begin(); entry != store.end(); ++entry) {
+        passed = passed && (entry == store.begin() || entry->key > previousKey);
+        previousKey = entry->key;
+    }
+
+    for (auto &p : *points) {
+        int i = pm->getAxisIndex(PointManager::IAxis, p.first.getI());
+        int j = pm->getAxisIndex(PointManager::JAxis, p.first.getJ());
+        int k = pm->getAxisIndex(PointManager::KAxis, p.first.getK());
+        uint64_t key = MortonPointStore::encode(i, j, k);
+
+        passed = passed && store.find(i, j, k) == p.second && store.find(key) == p.second;
+
+        for (int direction = 0; direction < 6; direction++) {
+            Coordinates neighbor(pm->getNeighborCoordinate(PointManager::IAxis, p.first.getI(), offsets[direction][0]),
+                                 pm->getNeighborCoordinate(PointManager::JAxis, p.first.getJ(), offsets[direction][1]),
+                                 pm->getNeighborCoordinate(PointManager::KAxis, p.first.getK(), offsets[direction][2]));
+            auto expected = points->find(neighbor);
+
+            passed = passed && store.findNeighbor(key, (PointManager::Neighbor) direction) ==
+                               (expected == points->end() ? nullptr : expected->second);
+        }
+    }
+
+    passed = passed && store.find(-1, 0, 0) == nullptr && store.find(POINTS_PER_DIM, 0, 0) == nullptr;
+
+    cout << "  " << name << ": " << store.size() << " points" << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test the Morton ordered point store" << endl;
+
+    bool passed = testEncoding();
+    passed = testHasher() && passed;
+
+    auto cube = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    passed = testStore(cube, "cube") && passed;
+    delete cube;
+
+    const int numPoints[] = {POINTS_PER_DIM, 3, 7};
+    auto box = new PointManager(1.0, 0, POINTS_PER_DIM - 1, Coordinates(0, 2, 1), numPoints);
+    passed = testStore(box, "box") && passed;
+    delete box;
+
+    return passed ? 0 : 1;
+}
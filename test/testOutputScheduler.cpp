@@ -0,0 +1,207 @@
+#define POINTS_PER_DIM 5
+#define NUM_STEPS 10
+#define TIME_STEP 1.0e-9 // below 1e-6, where times printed to 6 decimals would all be 0.000000
+#define STEP_INTERVAL 3
+#define WALL_CLOCK_INTERVAL 0.05 // seconds
+#define THRESHOLD 1.0
+#define LOG_PATH_PREFIX "output-scheduler-"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+#include "../src/OutputScheduler.h"
+#include "testHelpers.h"
+
+using namespace std;
+
+/**
+ * Count the lines of a log file and remove it
+ *
+ * @param path Path of the log file
+ * @return Number of lines, -1 if the file does not exist
+ */
+long consumeLog(const string &path) {
+    ifstream logFile(path);
+
+    if (!logFile.is_open())
+        return -1;
+
+    long numLines = 0;
+    string line;
+
+    while (getline(logFile, line))
+        numLines++;
+
+    logFile.close();
+    std::remove(path.c_str());
+
+    return numLines;
+}
+
+/**
+ * Update a scheduler for a run of steps and check which of them were logged, every logged step writing the whole grid
+ *
+ * @param scheduler Scheduler with a single rule logging to pathPrefix
+ * @param pm PointManager of the scheduler
+ * @param pathPrefix Prefix of the log files of the rule
+ * @param expected Steps expected to be logged
+ * @return true if exactly the expected steps were logged
+ */
+bool checkLoggedSteps(OutputScheduler &scheduler, PointManager *pm, const string &pathPrefix,
+                      const vector<std::uint64_t> &expected) {
+    bool passed = true;
+
+    for (std::uint64_t step = 0; step < NUM_STEPS; step++)
+        scheduler.update(step, step * TIME_STEP);
+
+    for (std::uint64_t step = 0; step < NUM_STEPS; step++) {
+        bool due = find(expected.begin(), expected.end(), step) != expected.end();
+        long numLines = consumeLog(pathPrefix + to_string(step));
+
+        passed = passed && numLines == (due ? (long) pm->getTotalNumberPoints() : -1);
+    }
+
+    return passed;
+}
+
+/**
+ * A rule logging every few steps must log the steps that are multiples of its interval, each to its own file although
+ * the times are too close to tell apart at the precision std::to_string prints
+ */
+bool testEveryNSteps() {
+    auto pm = new PointManager(POINTS_PER_DIM, 0, POINTS_PER_DIM - 1, nullptr);
+    OutputScheduler scheduler(pm);
+
+    scheduler.addEveryNStepsRule(OutputScheduler::ElectricField, STEP_INTERVAL, LOG_PATH_PREFIX "every-n-");
+    bool passed = checkLoggedSteps(scheduler, pm, LOG_PATH_PREFIX "every-n-", {0, 3, 6, 9});
+    delete pm;
+
+    return report("every " + to_string(STEP_INTERVAL) + " steps", passed);
+}
+
+/**
+ * A rule logging at given times must log the first step reaching each time, once for several times within one step
+ */
+bool testAtTimes() {
+    auto pm = new PointManager(POINTS_PER_DIM, 0, POINTS_PER_DIM - 1, nullptr);
+    OutputScheduler scheduler(pm);
+
+    scheduler.addAtTimesRule(OutputScheduler::MagneticField, {7.0 * TIME_STEP, 2.5 * TIME_STEP, 2.6 * TIME_STEP},
+                             LOG_PATH_PREFIX "at-times-");
+    bool passed = checkLoggedSteps(scheduler, pm, LOG_PATH_PREFIX "at-times-", {3, 7});
+    delete pm;
+
+    return report("at times", passed);
+}
+
+/**
+ * A wall clock rule must only log once its interval has passed, and then not again until it has passed once more
+ */
+bool testWallClock() {
+    auto pm = new PointManager(POINTS_PER_DIM, 0, POINTS_PER_DIM - 1, nullptr);
+    OutputScheduler scheduler(pm);
+
+    scheduler.addWallClockRule(OutputScheduler::CurrentField, WALL_CLOCK_INTERVAL, LOG_PATH_PREFIX "wall-clock-");
+    int numLogged = scheduler.update(0, 0);
+
+    this_thread::sleep_for(chrono::duration<double>(1.5 * WALL_CLOCK_INTERVAL));
+    numLogged += 10 * scheduler.update(1, TIME_STEP);
+    numLogged += 100 * scheduler.update(2, 2 * TIME_STEP);
+
+    bool passed = numLogged == 10 && consumeLog(LOG_PATH_PREFIX "wall-clock-1") == (long) pm->getTotalNumberPoints();
+    delete pm;
+
+    return report("wall clock", passed);
+}
+
+/**
+ * A threshold rule must log the checked steps at which a field exceeds the threshold somewhere on the grid
+ */
+bool testThreshold() {
+    auto pm = new PointManager(POINTS_PER_DIM, 0, POINTS_PER_DIM - 1, nullptr);
+    OutputScheduler scheduler(pm);
+    Coordinates center(POINTS_PER_DIM / 2, POINTS_PER_DIM / 2, POINTS_PER_DIM / 2);
+
+    // below the threshold up to step 4, above it from step 5 on
+    for (int step = 0; step < NUM_STEPS; step++)
+        pm->setElectricField(center, FieldVector(0, (step < 5 ? 0.5 : 1.5) * THRESHOLD, 0), step * TIME_STEP);
+
+    scheduler.addThresholdRule(OutputScheduler::ElectricField, THRESHOLD, LOG_PATH_PREFIX "threshold-", 2);
+    bool passed = checkLoggedSteps(scheduler, pm, LOG_PATH_PREFIX "threshold-", {6, 8});
+    delete pm;
+
+    return report("threshold", passed);
+}
+
+/**
+ * Rules due at the same step must each write their own file in one update, and a second rule for the same field and
+ * file must not write it twice
+ */
+bool testBatching() {
+    auto pm = new PointManager(POINTS_PER_DIM, 0, POINTS_PER_DIM - 1, nullptr);
+    OutputScheduler scheduler(pm);
+
+    scheduler.addEveryNStepsRule(OutputScheduler::ElectricField, 2, LOG_PATH_PREFIX "batch-e-");
+    scheduler.addEveryNStepsRule(OutputScheduler::MagneticField, 2, LOG_PATH_PREFIX "batch-b-");
+    scheduler.addAtTimesRule(OutputScheduler::ElectricField, {0.0}, LOG_PATH_PREFIX "batch-e-");
+
+    int numLogged = scheduler.update(0, 0);
+    long numPoints = (long) pm->getTotalNumberPoints();
+    bool passed = numLogged == 2 && consumeLog(LOG_PATH_PREFIX "batch-e-0") == numPoints &&
+                  consumeLog(LOG_PATH_PREFIX "batch-b-0") == numPoints;
+
+    passed = passed && scheduler.update(1, TIME_STEP) == 0;
+    delete pm;
+
+    return report("batching", passed);
+}
+
+/**
+ * Attaching a scheduler to a FieldSolver must log the initial fields for the rules starting with step 0, then the
+ * steps the solver takes
+ */
+bool testAttach() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        p.second->setElectricField(FieldVector(0, 0, 0), 0);
+
+    FieldSolver solver(pm, 1.0, DRUDE_SCATTERING_TIME);
+    OutputScheduler scheduler(pm);
+
+    solver.setTimeStep(solver.calculateStableTimeStep());
+    scheduler.addEveryNStepsRule(OutputScheduler::ElectricField, 2, LOG_PATH_PREFIX "attach-");
+    solver.attachOutputScheduler(&scheduler);
+
+    for (int step = 0; step < 2; step++)
+        solver.calculateNextFields();
+
+    long numPoints = (long) pm->getTotalNumberPoints();
+    bool passed = consumeLog(LOG_PATH_PREFIX "attach-0") == numPoints &&
+                  consumeLog(LOG_PATH_PREFIX "attach-1") == -1 && consumeLog(LOG_PATH_PREFIX "attach-2") == numPoints;
+    delete pm;
+
+    return report("attached to a field solver", passed);
+}
+
+int main(){
+    cout << "Test the output scheduler" << endl;
+
+    bool passed = testEveryNSteps();
+    passed = testAtTimes() && passed;
+    passed = testWallClock() && passed;
+    passed = testThreshold() && passed;
+    passed = testBatching() && passed;
+    passed = testAttach() && passed;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+#define POINTS_PER_DIM 9
+#define NUM_ARENA_POINTS 10000 // spans more than one block of points and of history entries
+
+#include <iostream>
+#include <vector>
+
+#include "../src/PointManager.h"
+#include "../src/PointArena.h"
+#include "../src/FieldVector.h"
+#include "testHelpers.h"
+
+using namespace std;
+
+/**
+ * Check that the electric, magnetic and current fields of a point at a time are the given vectors
+ */
+bool hasFields(Point &p, double time, double e, double b, double j) {
+    FieldVector *eField = p.getElectricField(time), *bField = p.getMagneticField(time);
+    FieldVector *jField = p.getCurrentField(time);
+
+    return eField && eField->getIComp() == e && bField && bField->getJComp() == b && jField && jField->getKComp() == j;
+}
+
+/**
+ * Points created outside of an arena must keep working on the system allocator, copies included
+ */
+bool testStandalonePoint() {
+    Point p(1, 2, 3);
+    bool passed = p.getCurrentField(0) == nullptr && p.getMagneticField(0) != nullptr;
+
+    p.setElectricField(FieldVector(1, 0, 0), 1.0);
+    p.setMagneticField(FieldVector(0, 2, 0), 1.0);
+    p.setCurrentField(FieldVector(0, 0, 3), 1.0);
+
+    Point copy(p), assigned;
+    assigned = p;
+    p.eraseFields(1.0);
+
+    passed = passed && hasFields(copy, 1.0, 1, 2, 3) && hasFields(assigned, 1.0, 1, 2, 3) &&
+             p.getElectricField(1.0) == nullptr && p.getCurrentField(1.0) == nullptr;
+
+    copy.clearFieldHistory();
+
+    return report("point without an arena", passed && copy.getMagneticField(0) == nullptr &&
+                                            assigned.getMagneticField(0) != nullptr);
+}
+
+/**
+ * The arena must count its points and history entries, reuse the slots and entries of destroyed points and only go to
+ * the system allocator for whole blocks
+ */
+bool testArena() {
+    PointArena arena;
+    vector<Point *> points;
+
+    for (int n = 0; n < NUM_ARENA_POINTS; n++) {
+        points.push_back(arena.createPoint(n, 0, 0, Point::Normal, MaterialTable::GalliumArsenide));
+        points.back()->setElectricField(FieldVector(n, 0, 0), 1.0);
+        points.back()->setMagneticField(FieldVector(0, n, 0), 1.0);
+        points.back()->setCurrentField(FieldVector(0, 0, n), 1.0);
+    }
+
+    bool passed = true;
+
+    for (int n = 0; n < NUM_ARENA_POINTS; n++)
+        passed = passed && points[n]->getCoordinates().getI() == n && hasFields(*points[n], 1.0, n, n, n) &&
+                 points[n]->getMaterialId() == MaterialTable::GalliumArsenide;
+
+    ArenaStatistics filled = arena.getStatistics();
+    std::uint64_t numPointBlocks = (NUM_ARENA_POINTS + POINT_ARENA_BLOCK_SIZE - 1) / POINT_ARENA_BLOCK_SIZE;
+    std::size_t pointBytes = numPointBlocks * POINT_ARENA_BLOCK_SIZE * sizeof(Point);
+    std::uint64_t numBlocks = numPointBlocks + (filled.reservedBytes - pointBytes) / FIELD_HISTORY_BLOCK_SIZE;
+
+    // each point has its histories, its initial magnetic field and one entry of every field at time 1
+    passed = report("filled arena", passed && filled.pointsCreated == NUM_ARENA_POINTS &&
+                                    filled.livePoints == NUM_ARENA_POINTS &&
+                                    filled.historyAllocations == 5 * NUM_ARENA_POINTS &&
+                                    filled.liveHistoryAllocations == 5 * NUM_ARENA_POINTS &&
+                                    filled.systemAllocations == numBlocks && numBlocks > numPointBlocks + 1 &&
+                                    filled.reservedBytes < 2 * NUM_ARENA_POINTS * (sizeof(Point) + 5 * 256));
+
+    Point *last = points.back();
+    arena.destroyPoint(last);
+    Point *recycled = arena.createPoint(-1, 0, 0);
+    ArenaStatistics refilled = arena.getStatistics();
+
+    passed = report("recycled slot", recycled == last && recycled->getElectricField(1.0) == nullptr &&
+                                     recycled->getMagneticField(0) != nullptr &&
+                                     refilled.livePoints == NUM_ARENA_POINTS &&
+                                     refilled.liveHistoryAllocations == 5 * NUM_ARENA_POINTS - 3 &&
+                                     refilled.systemAllocations == numBlocks) && passed;
+
+    // copies of an arena point share its pool, assigning to an arena point keeps the entries in the arena
+    Point standalone(0, 0, 0);
+    standalone.setElectricField(FieldVector(7, 0, 0), 2.0);
+    *recycled = standalone;
+    bool copied;
+    {
+        Point copy(*points[0]);
+        copied = hasFields(copy, 1.0, 0, 0, 0) && arena.getStatistics().liveHistoryAllocations ==
+                                                  refilled.liveHistoryAllocations + 1 + 5;
+    }
+
+    copied = copied && recycled->getElectricField(2.0)->getIComp() == 7 &&
+             arena.getStatistics().liveHistoryAllocations == refilled.liveHistoryAllocations + 1;
+
+    return report("copies", copied) && passed;
+}
+
+/**
+ * The PointManager must keep every point, ghosts included, in its arena and recycle the ghost layer when rebuilding it
+ */
+bool testPointManager() {
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    ArenaStatistics initial = pm->getAllocationStatistics();
+    std::uint64_t numPoints = pm->getTotalNumberPoints(), numGhosts = pm->getGhosts().size();
+
+    bool passed = initial.livePoints == numPoints + numGhosts && initial.pointsCreated == numPoints + numGhosts;
+
+    pm->setGhostWidth(2);
+    ArenaStatistics wide = pm->getAllocationStatistics();
+
+    passed = passed && wide.livePoints == numPoints + pm->getGhosts().size() &&
+             wide.pointsCreated == initial.pointsCreated + pm->getGhosts().size();
+
+    pm->setGhostWidth(1);
+    ArenaStatistics narrow = pm->getAllocationStatistics();
+
+    // the narrow ghost layer fits into the slots of the wide one
+    passed = passed && narrow.livePoints == initial.livePoints && narrow.systemAllocations == wide.systemAllocations &&
+             narrow.liveHistoryAllocations == initial.liveHistoryAllocations;
+
+    delete pm;
+
+    return report("point manager: " + to_string(initial.systemAllocations) + " system allocations for " +
+                  to_string(numPoints + numGhosts) + " points", passed);
+}
+
+int main(){
+    cout << "Test the point arena" << endl;
+
+    bool passed = testStandalonePoint();
+    passed = testArena() && passed;
+    passed = testPointManager() && passed;
+
+    return passed ? 0 : 1;
+}
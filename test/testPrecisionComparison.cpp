@@ -0,0 +1,130 @@
+#define CLOSE_GAP true
+
+#define NUM_STEPS 200
+#define POINT_MANAGER_PARAMETERS 101, 0, 100
+#define INITIAL_CONDUCTIVITY 1.0
+#define INITIAL_VOLTAGE 1.0
+#define REDUCED_PRECISION_TOLERANCE 1.0e-3 // float storage rounds E to ~1e-7, B is built from differences of E
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/YeeSolver.h"
+
+using namespace std;
+
+/**
+ * Run the rod test with a Yee solver of the given precision
+ *
+ * @param solver Solver built from the rod's PointManager
+ * @param timeStep Time step to take
+ */
+template <typename Solver>
+void runRod(Solver &solver, double timeStep) {
+    solver.setTimeStep(timeStep);
+    solver.calculateAndSetInitialElectricField();
+
+    for (int step = 0; step < NUM_STEPS; step++)
+        solver.calculateNextFields();
+}
+
+/**
+ * Calculate the largest difference between two grids over a range of components, relative to the largest magnitude
+ * of the reference grid over the same components
+ *
+ * @param reference Grid computed in double precision
+ * @param grid Grid computed in reduced precision
+ * @param first First component to compare
+ * @param last Last component to compare
+ * @return Largest relative difference, 0 if the reference is zero everywhere
+ */
+template <typename Grid>
+double calculateRelativeError(const FieldGrid &reference, const Grid &grid, FieldGrid::Component first,
+                              FieldGrid::Component last) {
+    double maxDifference = 0.0, maxMagnitude = 0.0;
+
+    for (int component = first; component <= last; component++) {
+        const double *expected = reference.getComponent((FieldGrid::Component) component);
+        const typename Grid::ScalarType *actual = grid.getComponent((typename Grid::Component) component);
+
+        for (std::size_t index = 0; index < reference.getTotalNumberPoints(); index++) {
+            maxDifference = max(maxDifference, fabs(expected[index] - (double) actual[index]));
+            maxMagnitude = max(maxMagnitude, fabs(expected[index]));
+        }
+    }
+
+    return maxMagnitude == 0 ? 0.0 : maxDifference / maxMagnitude;
+}
+
+/**
+ * Compare a reduced precision run of the rod test against the double precision run
+ *
+ * @param name Name of the precision mode
+ * @param reference Double precision solver after the run
+ * @param solver Reduced precision solver after the run
+ * @param tolerance Largest accepted relative error of any field
+ * @return true if every field is within the tolerance
+ */
+template <typename Solver>
+bool compareToReference(const string &name, const YeeSolver &reference, const Solver &solver, double tolerance) {
+    double eError = calculateRelativeError(reference.getGrid(), solver.getGrid(), FieldGrid::ElectricI,
+                                           FieldGrid::ElectricK);
+    double bError = calculateRelativeError(reference.getGrid(), solver.getGrid(), FieldGrid::MagneticI,
+                                           FieldGrid::MagneticK);
+    double jError = calculateRelativeError(reference.getGrid(), solver.getGrid(), FieldGrid::CurrentI,
+                                           FieldGrid::CurrentK);
+    double energyError = fabs(solver.calculateFieldEnergy() / reference.calculateFieldEnergy() - 1);
+    bool passed = max(max(eError, bError), max(jError, energyError)) <= tolerance;
+
+    cout << name << " relative error: E " << eError << ", B " << bError << ", J " << jError << ", energy "
+         << energyError << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test precision comparison" << endl;
+
+    cout << "Creating points" << endl;
+    auto pointManager = new PointManager(POINT_MANAGER_PARAMETERS, nullptr);
+
+    for(int k = 0; k <= 100; k++){
+        if(k == 50 && !CLOSE_GAP) // leave a gap at k = 50
+            continue;
+        auto pt = Coordinates(50, 50, k);
+
+        pointManager->setConductivity(pt, INITIAL_CONDUCTIVITY);
+
+        if(k <= 50)
+            pointManager->setVoltage(pt, 0); // i.e a wire with no current flow
+        else
+            pointManager->setVoltage(pt, INITIAL_VOLTAGE); // i.e a wire held at a potential
+    }
+
+    cout << "Running the rod in double precision" << endl;
+    YeeSolver reference(pointManager, 1.0, DRUDE_SCATTERING_TIME);
+    double timeStep = reference.calculateStableTimeStep();
+    runRod(reference, timeStep);
+
+    cout << "Running the rod in single precision" << endl;
+    bool passed;
+    {
+        SinglePrecisionYeeSolver solver(pointManager, timeStep, DRUDE_SCATTERING_TIME);
+        runRod(solver, timeStep);
+        passed = compareToReference("Single precision", reference, solver, REDUCED_PRECISION_TOLERANCE);
+    }
+
+    cout << "Running the rod in mixed precision" << endl;
+    {
+        MixedPrecisionYeeSolver solver(pointManager, timeStep, DRUDE_SCATTERING_TIME);
+        runRod(solver, timeStep);
+        passed = compareToReference("Mixed precision", reference, solver, REDUCED_PRECISION_TOLERANCE) && passed;
+    }
+
+    delete pointManager;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+#define POINTS_PER_DIM 5
+#define SAMPLES_PER_FLUSH 3
+#define TIME_STEP 0.5
+#define PLANE_POSITION 2
+#define LOG_PATH_PREFIX "probe-manager-"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/ProbeManager.h"
+#include "testHelpers.h"
+
+using namespace std;
+
+/**
+ * Read a probe file, each line holding the time, the coordinates of the point and the 9 field components
+ *
+ * @param path Path of the probe file
+ * @return Values of every line, empty if the file does not exist
+ */
+vector<vector<double>> readProbe(const string &path) {
+    ifstream probeFile(path);
+    vector<vector<double>> lines;
+    string line;
+
+    while (getline(probeFile, line)) {
+        istringstream values(line);
+        vector<double> row;
+        double value;
+
+        while (values >> value)
+            row.push_back(value);
+
+        lines.push_back(row);
+    }
+
+    return lines;
+}
+
+/**
+ * Give the electric field of a point a value identifying the time it is recorded at
+ */
+void setSampleField(PointManager *pm, const Coordinates &target, int sampleIndex) {
+    pm->setElectricField(target, FieldVector(sampleIndex, 0, 0), sampleIndex * TIME_STEP);
+}
+
+/**
+ * Samples must stay in the buffer until it is full, be written in order once the next sample needs the room, and
+ * the rest must be written by flush()
+ */
+bool testBuffering() {
+    auto pm = new PointManager(POINTS_PER_DIM, 0, POINTS_PER_DIM - 1, nullptr);
+    ProbeManager probes(pm, LOG_PATH_PREFIX, SAMPLES_PER_FLUSH);
+    Coordinates target(1, 2, 3);
+    string path = LOG_PATH_PREFIX "buffering";
+
+    std::remove(path.c_str());
+    probes.addPointProbe("buffering", target);
+
+    for (int s = 0; s < SAMPLES_PER_FLUSH; s++) {
+        setSampleField(pm, target, s);
+        probes.sample(s * TIME_STEP);
+    }
+
+    bool passed = readProbe(path).empty();
+
+    setSampleField(pm, target, SAMPLES_PER_FLUSH);
+    probes.sample(SAMPLES_PER_FLUSH * TIME_STEP);
+    passed = passed && readProbe(path).size() == SAMPLES_PER_FLUSH;
+
+    probes.flush();
+    vector<vector<double>> lines = readProbe(path);
+    passed = passed && lines.size() == SAMPLES_PER_FLUSH + 1;
+
+    for (std::size_t s = 0; s < lines.size() && passed; s++) {
+        // time, coordinates, E, then B and J, which were never set
+        passed = lines[s].size() == 13 && lines[s][0] == s * TIME_STEP && lines[s][1] == 1 && lines[s][2] == 2 &&
+                 lines[s][3] == 3 && lines[s][4] == s && lines[s][5] == 0 && lines[s][12] == 0;
+    }
+
+    std::remove(path.c_str());
+    delete pm;
+
+    return report("buffering", passed);
+}
+
+/**
+ * The first flush must replace a probe file left over from a previous run, later flushes must append to it
+ */
+bool testTruncateAndAppend() {
+    auto pm = new PointManager(POINTS_PER_DIM, 0, POINTS_PER_DIM - 1, nullptr);
+    string path = LOG_PATH_PREFIX "append";
+    ofstream stale(path);
+
+    stale << "left over from a previous run\n" << "and another line\n" << "and a third\n";
+    stale.close();
+
+    ProbeManager probes(pm, LOG_PATH_PREFIX, SAMPLES_PER_FLUSH);
+    probes.addPointProbe("append", Coordinates(0, 0, 0));
+
+    probes.sample(0);
+    probes.flush();
+    vector<vector<double>> first = readProbe(path);
+
+    probes.sample(TIME_STEP);
+    probes.sample(2 * TIME_STEP);
+    probes.flush();
+    probes.flush(); // nothing buffered, must not truncate
+    vector<vector<double>> second = readProbe(path);
+
+    bool passed = first.size() == 1 && first[0].size() == 13 && first[0][0] == 0 && second.size() == 3 &&
+                  second[0] == first[0] && second[1][0] == TIME_STEP && second[2][0] == 2 * TIME_STEP;
+
+    std::remove(path.c_str());
+    delete pm;
+
+    return report("truncate then append", passed);
+}
+
+/**
+ * A plane probe must record every point of the plane, in i, j, k order whatever the order of the point map
+ */
+bool testPlaneOrdering() {
+    auto pm = new PointManager(POINTS_PER_DIM, 0, POINTS_PER_DIM - 1, nullptr);
+    string path = LOG_PATH_PREFIX "plane";
+
+    {
+        ProbeManager probes(pm, LOG_PATH_PREFIX, SAMPLES_PER_FLUSH);
+        probes.addPlaneProbe("plane", PointManager::JAxis, PLANE_POSITION);
+        probes.sample(0);
+    } // the destructor flushes
+
+    vector<vector<double>> lines = readProbe(path);
+    bool passed = lines.size() == POINTS_PER_DIM * POINTS_PER_DIM;
+
+    for (std::size_t n = 0; n < lines.size() && passed; n++)
+        passed = lines[n][1] == n / POINTS_PER_DIM && lines[n][2] == PLANE_POSITION &&
+                 lines[n][3] == n % POINTS_PER_DIM;
+
+    std::remove(path.c_str());
+    delete pm;
+
+    return report("plane ordering", passed);
+}
+
+int main(){
+    cout << "Test the probe manager" << endl;
+
+    bool passed = testBuffering();
+    passed = testTruncateAndAppend() && passed;
+    passed = testPlaneOrdering() && passed;
+
+    return passed ? 0 : 1;
+}
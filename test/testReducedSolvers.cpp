@@ -0,0 +1,279 @@
+#define POINTS_PER_DIM 17
+#define CENTER 8 // the rod, the pulse and the symmetry axis lie at the center of the cross section
+#define NUM_STEPS 20
+#define PULSE_WIDTH 2.0
+#define FIELD_TOLERANCE 1.0e-9
+#define ROD_VOLTAGE 1.0e3 // the voltage calculator stops once no voltage changes in the first 3 decimals
+#define ROD_VOLTAGE_TOLERANCE 1.0e-3
+#define COAX_RADIUS 2 // radius of the inner conductor of the coaxial line
+#define COAX_TOLERANCE 1.0e-2
+#define MODE_ZERO 2.404825557695773 // first zero of the Bessel function J0
+#define MODE_TOLERANCE 2.0e-2
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+#include "../src/InitialVoltageCalculator.h"
+#include "../src/YeeSolver.h"
+#include "../src/ReducedSolver.h"
+
+using namespace std;
+
+/**
+ * Get the Bessel function of the first kind of order 0 or 1 from its power series
+ */
+double calculateBessel(int order, double x) {
+    double term = order == 0 ? 1.0 : x / 2, sum = term;
+
+    for (int m = 1; m < 40; m++) {
+        term *= -(x / 2) * (x / 2) / (m * (m + order));
+        sum += term;
+    }
+
+    return sum;
+}
+
+/**
+ * Create a slice of the cube a single point thick along k, the cross section of a planar solver
+ */
+PointManager *createSlice() {
+    const int numPoints[] = {POINTS_PER_DIM, POINTS_PER_DIM, 1};
+
+    return new PointManager(1.0, 0, POINTS_PER_DIM - 1, Coordinates(0, 0, 0), numPoints);
+}
+
+/**
+ * Turn the points on the line through the center along k into a conducting rod at the given voltage
+ */
+void setRod(PointManager *pm, double voltage) {
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        if (p.first.getI() == CENTER && p.first.getJ() == CENTER) {
+            pm->setConductivity(p.first, 1.0);
+            pm->setVoltage(p.first, voltage);
+        }
+    }
+}
+
+/**
+ * A pulse along k that does not vary along k must propagate like on the staggered grid of YeeSolver, which needs the
+ * whole cube periodic along k for it
+ */
+bool testPlanarPulse() {
+    auto cube = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    PointManager *slice = createSlice();
+
+    cube->setPeriodic(PointManager::KAxis, true);
+
+    for (PointManager *pm : {cube, slice}) {
+        for (auto &p : *pm->getCollectionOfPoints())
+            p.second->setPermittivity(1.0); // the layers would vary along k
+
+        setRod(pm, 0.0);
+    }
+
+    YeeSolver yee(cube, 1.0, DRUDE_SCATTERING_TIME);
+    ReducedSolver planar(slice, PointManager::KAxis, 0.0, 1.0, DRUDE_SCATTERING_TIME);
+    double *yeeField = yee.getGrid().getComponent(FieldGrid::ElectricK);
+    double *planarField = planar.getComponent(ReducedSolver::ElectricW);
+
+    for (int i = 0; i < POINTS_PER_DIM; i++) {
+        for (int j = 0; j < POINTS_PER_DIM; j++) {
+            double di = i - CENTER + 2, dj = j - CENTER; // off the rod, so the rod conducts a current
+            double pulse = exp(-(di * di + dj * dj) / (2 * PULSE_WIDTH * PULSE_WIDTH));
+
+            planarField[planar.getIndex(i, j)] = pulse;
+
+            for (int k = 0; k < POINTS_PER_DIM; k++)
+                yeeField[yee.getGrid().getIndex(i, j, k)] = pulse;
+        }
+    }
+
+    yee.setTimeStep(yee.calculateStableTimeStep());
+    planar.setTimeStep(yee.getTimeStep());
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        yee.calculateNextFields();
+        planar.calculateNextFields();
+    }
+
+    yee.exportFieldsToPointManager();
+    planar.exportFieldsToPointManager();
+
+    double difference = 0.0, maxField = 0.0, maxCurrent = 0.0, time = yee.getCurrentTime();
+
+    for (auto &p : *cube->getCollectionOfPoints()) {
+        Coordinates sliceCoordinates(p.first.getI(), p.first.getJ(), 0);
+
+        difference = max(difference, calculateMaxComponent(*p.second->getElectricField(time) -
+                                                           *slice->getElectricField(sliceCoordinates, time)));
+        difference = max(difference, calculateMaxComponent(*p.second->getMagneticField(time) -
+                                                           *slice->getMagneticField(sliceCoordinates, time)));
+        maxField = max(maxField, calculateMaxComponent(*p.second->getElectricField(time)));
+
+        if (p.second->getConductivity() > 0) {
+            FieldVector *current = slice->getCurrentField(sliceCoordinates, time);
+
+            difference = max(difference, calculateMaxComponent(*p.second->getCurrentField(time) - *current));
+            maxCurrent = max(maxCurrent, calculateMaxComponent(*current));
+        }
+    }
+
+    bool passed = maxCurrent > 0 && difference < FIELD_TOLERANCE * maxField;
+
+    cout << "  planar pulse: " << planar.getTotalNumberPoints() << " points instead of " << cube->getTotalNumberPoints()
+         << ", largest difference " << difference << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete cube;
+    delete slice;
+
+    return passed;
+}
+
+/**
+ * The voltages around an endless rod must match the voltages InitialVoltageCalculator finds on the cube periodic
+ * along the rod
+ */
+bool testPlanarRodVoltage() {
+    auto cube = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    PointManager *slice = createSlice();
+
+    cube->setPeriodic(PointManager::KAxis, true);
+    setRod(cube, ROD_VOLTAGE);
+    setRod(slice, ROD_VOLTAGE);
+
+    InitialVoltageCalculator calculator(cube);
+    ReducedSolver planar(slice, PointManager::KAxis, 0.0, 1.0, DRUDE_SCATTERING_TIME);
+
+    // the voltage calculator reports every sweep, keep the summary readable
+    streambuf *output = cout.rdbuf(nullptr);
+
+    calculator.calculateInitialVoltage();
+
+    cout.rdbuf(output);
+
+    planar.calculateInitialVoltage();
+
+    double difference = 0.0;
+
+    for (auto &p : *cube->getCollectionOfPoints())
+        difference = max(difference, fabs(p.second->getVoltage() -
+                                          slice->getVoltage(Coordinates(p.first.getI(), p.first.getJ(), 0))));
+
+    bool passed = difference / ROD_VOLTAGE < ROD_VOLTAGE_TOLERANCE;
+
+    cout << "  planar rod voltage: largest relative difference " << difference / ROD_VOLTAGE
+         << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete cube;
+    delete slice;
+
+    return passed;
+}
+
+/**
+ * The voltage between the conductors of a coaxial line must fall off with the logarithm of the radius
+ */
+bool testAxisymmetricCoax() {
+    auto pm = new PointManager(1.0, 0, 2 * CENTER);
+    pm->setPeriodic(PointManager::KAxis, true);
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        double di = p.first.getI() - CENTER, dj = p.first.getJ() - CENTER;
+
+        if (di * di + dj * dj <= COAX_RADIUS * COAX_RADIUS) {
+            pm->setConductivity(p.first, 1.0);
+            pm->setVoltage(p.first, 1.0);
+        }
+    }
+
+    ReducedSolver axisymmetric(pm, PointManager::KAxis, Coordinates(CENTER, CENTER, 0), 1.0, DRUDE_SCATTERING_TIME);
+    axisymmetric.calculateInitialVoltage();
+
+    // the voltage beyond the last radius is 0, i.e. the outer conductor lies one spacing past it
+    double outerRadius = axisymmetric.getNumPoints(ReducedSolver::VAxis);
+    double error = 0.0;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        double di = p.first.getI() - CENTER, dj = p.first.getJ() - CENTER;
+        double radius = sqrt(di * di + dj * dj);
+
+        if (radius < COAX_RADIUS)
+            continue;
+
+        double expected = log(outerRadius / radius) / log(outerRadius / COAX_RADIUS);
+        error = max(error, fabs(p.second->getVoltage() - expected));
+    }
+
+    bool passed = error < COAX_TOLERANCE;
+
+    cout << "  axisymmetric coax voltage: " << axisymmetric.getTotalNumberPoints() << " points instead of "
+         << pm->getTotalNumberPoints() << ", largest error " << error << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete pm;
+
+    return passed;
+}
+
+/**
+ * The lowest mode of a cylindrical cavity, E_z = J0(k r) cos(w t), must swing to -J0(k r) over half of its period
+ */
+bool testAxisymmetricCavityMode() {
+    auto pm = new PointManager(1.0, 0, 2 * CENTER);
+    pm->setPeriodic(PointManager::KAxis, true);
+
+    for (auto &p : *pm->getCollectionOfPoints())
+        p.second->setPermittivity(1.0);
+
+    ReducedSolver axisymmetric(pm, PointManager::KAxis, Coordinates(CENTER, CENTER, 0), 1.0, DRUDE_SCATTERING_TIME);
+
+    // E_z is held at 0 on the wall of the cavity, the last radius
+    double wallRadius = axisymmetric.getNumPoints(ReducedSolver::VAxis) - 1;
+    double wavenumber = MODE_ZERO / wallRadius;
+    double *eField = axisymmetric.getComponent(ReducedSolver::ElectricU);
+
+    for (int u = 0; u < axisymmetric.getNumPoints(ReducedSolver::UAxis); u++)
+        for (int v = 0; v < axisymmetric.getNumPoints(ReducedSolver::VAxis); v++)
+            eField[axisymmetric.getIndex(u, v)] = calculateBessel(0, wavenumber * v);
+
+    double halfPeriod = M_PI / (wavenumber * sqrt(SPEED_OF_LIGHT_SQUARED));
+    int numSteps = (int) ceil(halfPeriod / axisymmetric.calculateStableTimeStep());
+    axisymmetric.setTimeStep(halfPeriod / numSteps);
+
+    for (int step = 0; step < numSteps; step++)
+        axisymmetric.calculateNextFields();
+
+    axisymmetric.exportFieldsToPointManager();
+
+    double error = 0.0;
+
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        double di = p.first.getI() - CENTER, dj = p.first.getJ() - CENTER;
+        FieldVector expected(0, 0, -calculateBessel(0, wavenumber * sqrt(di * di + dj * dj)));
+
+        error = max(error, calculateMaxComponent(*p.second->getElectricField(axisymmetric.getCurrentTime()) - expected));
+    }
+
+    bool passed = error < MODE_TOLERANCE;
+
+    cout << "  axisymmetric cavity mode: " << numSteps << " steps, largest error " << error
+         << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete pm;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test the planar and axisymmetric reduced solvers" << endl;
+
+    bool passed = testPlanarPulse();
+    passed = testPlanarRodVoltage() && passed;
+    passed = testAxisymmetricCoax() && passed;
+    passed = testAxisymmetricCavityMode() && passed;
+
+    return passed ? 0 : 1;
+}
@@ -8,12 +8,20 @@
 #define LOG_MAGNETIC_FIELD true
 #define CALC_NEXT_FIELDS true
 #define CLOSE_GAP true
+#define WRITE_CHECKPOINTS false
+#define PROBE_ROD true
+#define USE_STABLE_TIME_STEP false // the stable step of the 101^3 grid is near 5e-9, some 10^6 steps to END_TIME
+#define PERIODIC_K_AXIS true // the bottom face follows the top face
+#define ADAPTIVE_TIME_STEP false
 
 #define TIME_STEP 0.00125
 #define END_TIME 0.00375
 #define POINT_MANAGER_PARAMETERS 101, 0, 100
 #define INITIAL_CONDUCTIVITY 1.0
 #define INITIAL_VOLTAGE 1.0
+#define CHECKPOINT_INTERVAL 1000 // steps, each checkpoint holds the whole grid
+#define LOG_STEP_INTERVAL 1
+#define ADAPTIVE_TIME_STEP_TOLERANCE 1.0e-3
 
 #define IMPORT_INIT_VOLTAGE_PATH "../ref/saved-initial-voltages/half-rod-initial-voltages"
 #define INIT_ELEC_FIELD_LOG_PATH "../out/e-field"
@@ -21,6 +29,8 @@
 #define CURRENT_FIELD_LOG_PATH "../out/currentField/j-field"
 #define ELECTRIC_FIELD_LOG_PATH "../out/electricField/e-field"
 #define MAGNETIC_FIELD_LOG_PATH "../out/magneticField/b-field"
+#define CHECKPOINT_PATH "../out/checkpoint"
+#define PROBE_LOG_PATH_PREFIX "../out/probes/"
 
 #include <iostream>
 #include <string>
@@ -29,6 +39,8 @@
 #include "../src/Coordinates.h"
 #include "../src/FieldSolver.h"
 #include "../src/InitialVoltageCalculator.h"
+#include "../src/ProbeManager.h"
+#include "../src/OutputScheduler.h"
 
 using namespace std;
 
@@ -59,6 +71,11 @@ int main(){
     }
 #endif
 
+#if PERIODIC_K_AXIS
+    cout << "Wrapping the k axis around" << endl;
+    pointManager->setPeriodic(PointManager::KAxis, true);
+#endif
+
 #if CALC_INIT_VOLTAGE
     cout << "Calculating initial voltage" << endl;
 
@@ -73,6 +90,16 @@ int main(){
 
     auto fs = new FieldSolver(pointManager, TIME_STEP, DRUDE_SCATTERING_TIME);
 
+#if USE_STABLE_TIME_STEP
+    fs->setTimeStep(fs->calculateStableTimeStep());
+    cout << "Using the largest stable time step: " << fs->getTimeStep() << endl;
+#endif
+
+#if ADAPTIVE_TIME_STEP
+    cout << "Adapting the time step to a relative tolerance of " << ADAPTIVE_TIME_STEP_TOLERANCE << endl;
+    fs->enableAdaptiveTimeStepping(ADAPTIVE_TIME_STEP_TOLERANCE);
+#endif
+
 #if CALC_INIT_ELEC_FIELD
     cout << "Calculating initial electric field" << endl;
     fs->calculateAndSetInitialElectricField();
@@ -89,45 +116,50 @@ int main(){
     pointManager->setConductivity(pt, INITIAL_CONDUCTIVITY);
 #endif
 
-#if CALC_NEXT_FIELDS
-    for(int i = 0; i <= END_TIME / TIME_STEP; i++){
-        cout << "Calculating all fields at time " << fs->getNextTime() << endl;
-        fs->calculateNextFields();
-    }
+#if WRITE_CHECKPOINTS
+    cout << "Writing a checkpoint every " << CHECKPOINT_INTERVAL << " steps to: " << CHECKPOINT_PATH << endl;
+    fs->setCheckpointInterval(CHECKPOINT_INTERVAL, CHECKPOINT_PATH);
 #endif
 
-#if LOG_CURRENT_FIELD
-    cout << "Saving curent field" << endl;
+#if PROBE_ROD
+    cout << "Probing the rod and its gap, saving to: " << PROBE_LOG_PATH_PREFIX << endl;
+    ProbeManager probes(pointManager, PROBE_LOG_PATH_PREFIX);
+    probes.addLineProbe("rod", Coordinates(50, 50, 0), PointManager::KAxis, 100);
+    probes.addPointProbe("gap", Coordinates(50, 50, 50));
+    probes.sample(0);
+    fs->attachProbeManager(&probes);
+#endif
 
-    for(int i = 0; i <= END_TIME / TIME_STEP; i++){
-        std::string JFieldLogPath = CURRENT_FIELD_LOG_PATH + std::to_string(TIME_STEP * i);
+    OutputScheduler scheduler(pointManager);
 
-        pointManager->logCurrentFieldToFile(JFieldLogPath, TIME_STEP * i);
-    }
+#if LOG_CURRENT_FIELD
+    cout << "Saving current field every " << LOG_STEP_INTERVAL << " steps to: " << CURRENT_FIELD_LOG_PATH << endl;
+    scheduler.addEveryNStepsRule(OutputScheduler::CurrentField, LOG_STEP_INTERVAL, CURRENT_FIELD_LOG_PATH);
 #endif
 
 #if LOG_ELECTRIC_FIELD
-    cout << "Saving electric field" << endl;
-
-    for(int i = 0; i <= END_TIME / TIME_STEP; i++){
-        double time = TIME_STEP * i;
-        std::string eFieldLogPath = ELECTRIC_FIELD_LOG_PATH + std::to_string(time);
-
-        pointManager->logElectricFieldToFile(eFieldLogPath, time);
-    }
+    cout << "Saving electric field every " << LOG_STEP_INTERVAL << " steps to: " << ELECTRIC_FIELD_LOG_PATH << endl;
+    scheduler.addEveryNStepsRule(OutputScheduler::ElectricField, LOG_STEP_INTERVAL, ELECTRIC_FIELD_LOG_PATH);
 #endif
 
 #if LOG_MAGNETIC_FIELD
-    cout << "Saving magnetic field" << endl;
+    cout << "Saving magnetic field every " << LOG_STEP_INTERVAL << " steps to: " << MAGNETIC_FIELD_LOG_PATH << endl;
+    scheduler.addEveryNStepsRule(OutputScheduler::MagneticField, LOG_STEP_INTERVAL, MAGNETIC_FIELD_LOG_PATH);
+#endif
 
-    for(int i = 0; i <= END_TIME / TIME_STEP; i++){
-        double time = TIME_STEP * i;
-        std::string bFieldLogPath = MAGNETIC_FIELD_LOG_PATH + std::to_string(time);
+    fs->attachOutputScheduler(&scheduler); // logs the initial fields
 
-        pointManager->logMagneticFieldToFile(bFieldLogPath, time);
+#if CALC_NEXT_FIELDS
+    while (fs->getCurrentTime() < END_TIME) { // the stable and adaptive time steps differ from TIME_STEP
+        cout << "Calculating all fields at time " << fs->getNextTime() << endl;
+        fs->calculateNextFields();
     }
 #endif
 
+#if PROBE_ROD
+    probes.flush();
+#endif
+
     delete fs;
     delete pointManager;
 
@@ -0,0 +1,172 @@
+#define NUM_STEPS 20
+#define POINT_MANAGER_PARAMETERS 21, 0, 20
+#define ROW_LENGTH 67 // not a multiple of any vector width, so the scalar remainder is exercised as well
+#define STRIDE 5
+#define DOUBLE_TOLERANCE 1.0e-14
+#define FLOAT_TOLERANCE 1.0e-6
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/YeeSolver.h"
+#include "../src/SimdKernels.h"
+
+using namespace std;
+
+/**
+ * Calculate the largest difference between two arrays relative to the largest magnitude of the expected array
+ */
+template <typename Scalar>
+double calculateRelativeError(const vector<Scalar> &expected, const vector<Scalar> &actual) {
+    double maxDifference = 0.0, maxMagnitude = 0.0;
+
+    for (size_t index = 0; index < expected.size(); index++) {
+        maxDifference = max(maxDifference, fabs((double) expected[index] - actual[index]));
+        maxMagnitude = max(maxMagnitude, fabs((double) expected[index]));
+    }
+
+    return maxMagnitude == 0 ? 0.0 : maxDifference / maxMagnitude;
+}
+
+/**
+ * Run every row kernel of the selected instruction set on random rows and compare with the scalar kernels
+ *
+ * @param tolerance Largest accepted relative difference
+ * @return true if every kernel agrees with the scalar kernels
+ */
+template <typename Scalar>
+bool testRowKernels(double tolerance) {
+    mt19937 generator(42);
+    uniform_real_distribution<double> distribution(-1.0, 1.0);
+    size_t size = ROW_LENGTH + 2 * STRIDE;
+    vector<Scalar> a(size), c(size), coefficient(size), current(size), field(size);
+
+    for (size_t index = 0; index < size; index++) {
+        a[index] = (Scalar) distribution(generator);
+        c[index] = (Scalar) distribution(generator);
+        coefficient[index] = (Scalar) distribution(generator);
+        current[index] = (Scalar) distribution(generator);
+        field[index] = (Scalar) distribution(generator);
+    }
+
+    Scalar scale = (Scalar) 0.3, inverseSpacing = (Scalar) 2.0, permeability = (Scalar) 0.7, decay = (Scalar) 0.9;
+    double maxError = 0.0;
+
+    // every row length up to ROW_LENGTH, starting STRIDE points in so backward differences stay inside the arrays
+    for (size_t count = 0; count <= ROW_LENGTH; count++) {
+        vector<Scalar> expected = field, actual = field;
+
+        ScalarRowKernels<Scalar>::updateMagneticRow(&expected[STRIDE], &a[STRIDE], STRIDE, &c[STRIDE], 1, scale,
+                                                    count);
+        RowKernels<Scalar>::updateMagneticRow(&actual[STRIDE], &a[STRIDE], STRIDE, &c[STRIDE], 1, scale, count);
+        maxError = max(maxError, calculateRelativeError(expected, actual));
+
+        expected = actual = field;
+        ScalarRowKernels<Scalar>::updateElectricRow(&expected[STRIDE], &coefficient[STRIDE], &current[STRIDE],
+                                                    &a[STRIDE], 1, &c[STRIDE], STRIDE, inverseSpacing, permeability,
+                                                    count);
+        RowKernels<Scalar>::updateElectricRow(&actual[STRIDE], &coefficient[STRIDE], &current[STRIDE], &a[STRIDE], 1,
+                                              &c[STRIDE], STRIDE, inverseSpacing, permeability, count);
+        maxError = max(maxError, calculateRelativeError(expected, actual));
+
+        expected = actual = current;
+        ScalarRowKernels<Scalar>::updateCurrentRow(&expected[STRIDE], &coefficient[STRIDE], &field[STRIDE], decay,
+                                                   count);
+        RowKernels<Scalar>::updateCurrentRow(&actual[STRIDE], &coefficient[STRIDE], &field[STRIDE], decay, count);
+        maxError = max(maxError, calculateRelativeError(expected, actual));
+    }
+
+    bool passed = maxError <= tolerance;
+    cout << "  row kernels (" << sizeof(Scalar) * 8 << " bit): relative error " << maxError
+         << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+/**
+ * Run the rod with the selected instruction set and with the scalar kernels and compare the final fields
+ *
+ * @param pointManager PointManager holding the rod
+ * @param tolerance Largest accepted relative difference
+ * @return true if the fields agree
+ */
+template <typename Scalar>
+bool testRod(PointManager *pointManager, double tolerance) {
+    typedef BasicYeeSolver<Scalar> Solver;
+    SimdDispatch::InstructionSet instructionSet = SimdDispatch::getInstructionSet();
+    Solver vectorized(pointManager, 1.0, DRUDE_SCATTERING_TIME), scalar(pointManager, 1.0, DRUDE_SCATTERING_TIME);
+    double timeStep = vectorized.calculateStableTimeStep();
+
+    vectorized.setTimeStep(timeStep);
+    vectorized.calculateAndSetInitialElectricField();
+    scalar.setTimeStep(timeStep);
+    scalar.calculateAndSetInitialElectricField();
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        SimdDispatch::setInstructionSet(instructionSet);
+        vectorized.calculateNextFields();
+        SimdDispatch::setInstructionSet(SimdDispatch::ScalarInstructions);
+        scalar.calculateNextFields();
+    }
+
+    SimdDispatch::setInstructionSet(instructionSet);
+    double maxError = 0.0;
+
+    for (int component = 0; component < Solver::Grid::numComponents; component++) {
+        const Scalar *expected = scalar.getGrid().getComponent((typename Solver::Grid::Component) component);
+        const Scalar *actual = vectorized.getGrid().getComponent((typename Solver::Grid::Component) component);
+        size_t size = scalar.getGrid().getTotalNumberPoints();
+
+        maxError = max(maxError, calculateRelativeError(vector<Scalar>(expected, expected + size),
+                                                        vector<Scalar>(actual, actual + size)));
+    }
+
+    bool passed = maxError <= tolerance;
+    cout << "  rod (" << sizeof(Scalar) * 8 << " bit): relative error " << maxError
+         << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test SIMD kernels" << endl;
+    cout << "Best supported instruction set: "
+         << SimdDispatch::getName(SimdDispatch::getSupportedInstructionSet()) << endl;
+
+    auto pointManager = new PointManager(POINT_MANAGER_PARAMETERS, nullptr);
+
+    for(int k = 0; k <= 20; k++){
+        auto pt = Coordinates(10, 10, k);
+
+        pointManager->setConductivity(pt, 1.0);
+        pointManager->setVoltage(pt, k < 10 ? 0.0 : 1.0);
+    }
+
+    const SimdDispatch::InstructionSet instructionSets[] = {SimdDispatch::AVX2Instructions,
+                                                            SimdDispatch::AVX512Instructions};
+    bool passed = true;
+
+    for (SimdDispatch::InstructionSet instructionSet : instructionSets) {
+        if (instructionSet > SimdDispatch::getSupportedInstructionSet()) {
+            cout << SimdDispatch::getName(instructionSet) << " is not supported, skipping" << endl;
+            continue;
+        }
+
+        cout << "Comparing " << SimdDispatch::getName(instructionSet) << " with the scalar kernels" << endl;
+        SimdDispatch::setInstructionSet(instructionSet);
+
+        passed = testRowKernels<double>(DOUBLE_TOLERANCE) && passed;
+        passed = testRowKernels<float>(FLOAT_TOLERANCE) && passed;
+        passed = testRod<double>(pointManager, DOUBLE_TOLERANCE) && passed;
+        passed = testRod<float>(pointManager, FLOAT_TOLERANCE) && passed;
+    }
+
+    delete pointManager;
+
+    return passed ? 0 : 1;
+}
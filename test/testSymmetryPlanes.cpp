@@ -0,0 +1,213 @@
+#define POINTS_PER_DIM 17
+#define CENTER 8 // the rod and the pulses lie on the symmetry planes through the center
+#define ROD_START 4
+#define ROD_END 12
+#define NUM_STEPS 6
+#define PULSE_WIDTH 1.5
+#define FIELD_TOLERANCE 1.0e-9
+#define OUTPUT_TOLERANCE 1.0e-5 // the loggers write 6 significant digits
+#define VOLTAGE_TOLERANCE 1.0e-2 // the voltage calculator stops once no voltage changes in the first 3 decimals
+#define LOG_PATH "symmetry-planes-e-field"
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/FieldSolver.h"
+#include "../src/InitialVoltageCalculator.h"
+
+using namespace std;
+
+/**
+ * Create the lower quarter of the cube, up to the planes through the center along i and j
+ */
+PointManager *createQuarter(PointManager::Symmetry symmetry) {
+    const int numPoints[] = {CENTER + 1, CENTER + 1, POINTS_PER_DIM};
+    auto pm = new PointManager(1.0, 0, POINTS_PER_DIM - 1, Coordinates(0, 0, 0), numPoints);
+
+    pm->setSymmetry(PointManager::IEndFace, symmetry);
+    pm->setSymmetry(PointManager::JEndFace, symmetry);
+
+    return pm;
+}
+
+/**
+ * Hold a conducting rod along k through the center at 1
+ */
+void setRod(PointManager *pm) {
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        if (p.first.getI() == CENTER && p.first.getJ() == CENTER && p.first.getK() >= ROD_START &&
+            p.first.getK() <= ROD_END) {
+            pm->setConductivity(p.first, 1.0);
+            pm->setVoltage(p.first, 1.0);
+        }
+    }
+}
+
+/**
+ * The voltages around a rod on the magnetic walls of a quarter of the cube must match the whole cube
+ */
+bool testRodVoltage() {
+    auto full = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    PointManager *quarter = createQuarter(PointManager::MagneticWall);
+
+    setRod(full);
+    setRod(quarter);
+
+    InitialVoltageCalculator fullCalculator(full);
+    InitialVoltageCalculator quarterCalculator(quarter);
+
+    // the voltage calculator reports every sweep, keep the summary readable
+    streambuf *output = cout.rdbuf(nullptr);
+
+    fullCalculator.calculateInitialVoltage();
+    quarterCalculator.calculateInitialVoltage();
+
+    cout.rdbuf(output);
+
+    double error = 0.0;
+
+    for (auto &p : *quarter->getCollectionOfPoints())
+        error = max(error, fabs(p.second->getVoltage() - full->getVoltage(p.first)));
+
+    bool passed = error < VOLTAGE_TOLERANCE;
+
+    cout << "  rod voltage: " << quarter->getTotalNumberPoints() << " points instead of "
+         << full->getTotalNumberPoints() << ", largest difference " << error << (passed ? " (passed)" : " (FAILED)")
+         << endl;
+
+    delete full;
+    delete quarter;
+
+    return passed;
+}
+
+/**
+ * Set the electric field of every point to a gaussian pulse around the center polarized along k, even across the
+ * planes through the center or, if odd, changing sign across the plane along i
+ */
+void setPulse(PointManager *pm, bool odd) {
+    for (auto &p : *pm->getCollectionOfPoints()) {
+        double di = p.first.getI() - CENTER, dj = p.first.getJ() - CENTER, dk = p.first.getK() - CENTER;
+        double pulse = exp(-(di * di + dj * dj + dk * dk) / (2 * PULSE_WIDTH * PULSE_WIDTH));
+
+        p.second->setElectricField(FieldVector(0, 0, odd ? di * pulse : pulse), 0);
+    }
+}
+
+/**
+ * Propagate a pulse across the whole cube and a reduced domain, then return the largest difference of the fields
+ * of the reduced domain
+ */
+double calculatePulseDifference(PointManager *full, PointManager *reduced, bool odd) {
+    setPulse(full, odd);
+    setPulse(reduced, odd);
+
+    FieldSolver fullSolver(full, 1.0, DRUDE_SCATTERING_TIME);
+    FieldSolver reducedSolver(reduced, 1.0, DRUDE_SCATTERING_TIME);
+
+    fullSolver.setTimeStep(fullSolver.calculateStableTimeStep());
+    reducedSolver.setTimeStep(fullSolver.calculateStableTimeStep());
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        fullSolver.calculateNextFields();
+        reducedSolver.calculateNextFields();
+    }
+
+    double difference = 0.0;
+    double time = fullSolver.getCurrentTime();
+
+    for (auto &p : *reduced->getCollectionOfPoints()) {
+        difference = max(difference, calculateMaxComponent(*p.second->getElectricField(time) -
+                                                           *full->getElectricField(p.first, time)));
+        difference = max(difference, calculateMaxComponent(*p.second->getMagneticField(time) -
+                                                           *full->getMagneticField(p.first, time)));
+    }
+
+    return difference;
+}
+
+/**
+ * An even pulse on the magnetic walls of a quarter and an odd pulse on the electric wall of a half of the cube must
+ * propagate like across the whole cube
+ */
+bool testPulse() {
+    auto full = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    PointManager *quarter = createQuarter(PointManager::MagneticWall);
+    double evenDifference = calculatePulseDifference(full, quarter, false);
+
+    delete full;
+    delete quarter;
+
+    const int numPoints[] = {CENTER + 1, POINTS_PER_DIM, POINTS_PER_DIM};
+    full = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    auto half = new PointManager(1.0, 0, POINTS_PER_DIM - 1, Coordinates(0, 0, 0), numPoints);
+    half->setSymmetry(PointManager::IEndFace, PointManager::ElectricWall);
+    double oddDifference = calculatePulseDifference(full, half, true);
+
+    delete full;
+    delete half;
+
+    bool passed = evenDifference < FIELD_TOLERANCE && oddDifference < FIELD_TOLERANCE;
+
+    cout << "  pulse: largest difference " << evenDifference << " on magnetic walls and " << oddDifference
+         << " on an electric wall" << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+/**
+ * The full domain output of a quarter must list every point of the whole cube with its field
+ */
+bool testFullDomainOutput() {
+    auto full = new PointManager(1.0, 0, POINTS_PER_DIM - 1);
+    PointManager *quarter = createQuarter(PointManager::MagneticWall);
+
+    setPulse(full, false);
+    setPulse(quarter, false);
+    quarter->setFullDomainOutput(true);
+    quarter->logElectricFieldToFile(LOG_PATH, 0);
+
+    ifstream logFile(LOG_PATH);
+    double i, j, k, eI, eJ, eK, difference = 0.0;
+    long numLines = 0;
+
+    while (logFile >> i >> j >> k >> eI >> eJ >> eK) {
+        FieldVector *expected = full->getElectricField(Coordinates(i, j, k), 0);
+
+        if (!expected) {
+            difference = std::numeric_limits<double>::infinity();
+            break;
+        }
+
+        difference = max(difference, calculateMaxComponent(FieldVector(eI, eJ, eK) - *expected));
+        numLines++;
+    }
+
+    logFile.close();
+    std::remove(LOG_PATH);
+
+    bool passed = numLines == full->getTotalNumberPoints() && difference < OUTPUT_TOLERANCE;
+
+    cout << "  full domain output: " << numLines << " lines for " << full->getTotalNumberPoints()
+         << " points, largest difference " << difference << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    delete full;
+    delete quarter;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test symmetry planes against the whole domain" << endl;
+
+    bool passed = testRodVoltage();
+    passed = testPulse() && passed;
+    passed = testFullDomainOutput() && passed;
+
+    return passed ? 0 : 1;
+}
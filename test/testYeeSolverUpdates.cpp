@@ -0,0 +1,117 @@
+#define NUM_STEPS 20
+#define POINTS_PER_DIM 21
+#define PULSE_WIDTH 1.5
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "../src/PointManager.h"
+#include "../src/Coordinates.h"
+#include "../src/YeeSolver.h"
+
+using namespace std;
+
+/**
+ * Run a solver built before a change of the PointManager and one built after it side by side, and compare every
+ * field component at every point after each step. Both must follow the change the same way
+ *
+ * @param name Name of the run
+ * @param before Solver constructed before the change
+ * @param after Solver constructed after the change, with the same fields
+ * @return true if the fields agree exactly
+ */
+bool compareSolvers(const string &name, YeeSolver &before, YeeSolver &after) {
+    double maxDifference = 0.0;
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        before.calculateNextFields();
+        after.calculateNextFields();
+
+        for (int component = 0; component < YeeSolver::Grid::numComponents; component++) {
+            const double *expected = after.getGrid().getComponent((YeeSolver::Grid::Component) component);
+            const double *actual = before.getGrid().getComponent((YeeSolver::Grid::Component) component);
+
+            for (std::size_t index = 0; index < after.getGrid().getTotalNumberPoints(); index++)
+                maxDifference = max(maxDifference, fabs(expected[index] - actual[index]));
+        }
+    }
+
+    bool passed = maxDifference == 0.0;
+    cout << "  " << name << ": largest difference " << maxDifference << (passed ? " (passed)" : " (FAILED)") << endl;
+
+    return passed;
+}
+
+/**
+ * A conducting rod along k with a gap at its center, which closes after the first solver was constructed
+ */
+bool testGapClosing() {
+    auto pointManager = new PointManager(POINTS_PER_DIM, 0, POINTS_PER_DIM - 1, nullptr);
+    int center = POINTS_PER_DIM / 2;
+
+    for (int k = 0; k < POINTS_PER_DIM; k++) {
+        auto pt = Coordinates(center, center, k);
+
+        if (k != center) // leave a gap
+            pointManager->setConductivity(pt, 1.0);
+        pointManager->setVoltage(pt, k < center ? 0.0 : 1.0);
+    }
+
+    YeeSolver before(pointManager, 1.0, DRUDE_SCATTERING_TIME);
+    pointManager->setConductivity(Coordinates(center, center, center), 1.0);
+    YeeSolver after(pointManager, 1.0, DRUDE_SCATTERING_TIME);
+    double timeStep = after.calculateStableTimeStep();
+
+    before.setTimeStep(timeStep);
+    after.setTimeStep(timeStep);
+    before.calculateAndSetInitialElectricField();
+    after.calculateAndSetInitialElectricField();
+
+    bool passed = compareSolvers("gap closing", before, after);
+    delete pointManager;
+
+    return passed;
+}
+
+/**
+ * A pulse at the start face of the k axis, which is made periodic after the first solver was constructed
+ */
+bool testPeriodicityChange() {
+    auto pointManager = new PointManager(POINTS_PER_DIM, 0, POINTS_PER_DIM - 1, nullptr);
+
+    YeeSolver before(pointManager, 1.0, DRUDE_SCATTERING_TIME);
+    pointManager->setPeriodic(PointManager::KAxis, true);
+    YeeSolver after(pointManager, 1.0, DRUDE_SCATTERING_TIME);
+    double timeStep = after.calculateStableTimeStep();
+
+    before.setTimeStep(timeStep);
+    after.setTimeStep(timeStep);
+
+    for (int i = 0; i < POINTS_PER_DIM; i++) {
+        for (int j = 0; j < POINTS_PER_DIM; j++) {
+            for (int k = 0; k < 4; k++) {
+                double di = i - POINTS_PER_DIM / 2, dj = j - POINTS_PER_DIM / 2, dk = k;
+                double value = exp(-(di * di + dj * dj + dk * dk) / (2 * PULSE_WIDTH * PULSE_WIDTH));
+                std::size_t index = after.getGrid().getIndex(i, j, k);
+
+                before.getGrid().getComponent(YeeSolver::Grid::ElectricJ)[index] = value;
+                after.getGrid().getComponent(YeeSolver::Grid::ElectricJ)[index] = value;
+            }
+        }
+    }
+
+    bool passed = compareSolvers("periodicity change", before, after);
+    delete pointManager;
+
+    return passed;
+}
+
+int main(){
+    cout << "Test Yee solver following changes of the PointManager" << endl;
+
+    bool passed = testGapClosing();
+    passed = testPeriodicityChange() && passed;
+
+    return passed ? 0 : 1;
+}